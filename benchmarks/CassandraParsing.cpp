@@ -0,0 +1,91 @@
+/* This benchmark measures the parsing of large POMDP files in Cassandra format.
+ *
+ * It writes a random sparse POMDP to a temporary file, where each
+ * state-action pair has a few successors and each end state a few possible
+ * observations, and then parses it with the sparse parser using different
+ * numbers of threads. If the model is small enough, it also parses it with
+ * the dense parser for comparison.
+ *
+ * Usage: cassandra_parsing [states] [actions] [observations] [threads]
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/POMDP/IO.hpp>
+
+namespace ai = AIToolbox;
+namespace pomdp = AIToolbox::POMDP;
+
+using Clock = std::chrono::steady_clock;
+
+void writeModel(const std::string & filename, const size_t S, const size_t A, const size_t O, ai::RandomEngine & rnd) {
+    constexpr size_t successors = 8, observations = 4;
+
+    std::uniform_int_distribution<size_t> state(0, S - 1), obs(0, O - 1);
+    std::uniform_real_distribution<double> reward(-1.0, 1.0);
+
+    std::ofstream file(filename);
+    file << "discount: 0.95\nvalues: reward\n";
+    file << "states: " << S << "\nactions: " << A << "\nobservations: " << O << "\n\n";
+
+    // Later entries override earlier ones, so we use consecutive end states
+    // from a random start to keep them distinct.
+    for (size_t a = 0; a < A; ++a) {
+        for (size_t s = 0; s < S; ++s) {
+            const size_t first = state(rnd);
+            for (size_t i = 0; i < successors; ++i)
+                file << "T: " << a << " : " << s << " : " << (first + i) % S << ' ' << 1.0 / successors << '\n';
+        }
+        for (size_t s1 = 0; s1 < S; ++s1) {
+            const size_t first = obs(rnd);
+            for (size_t i = 0; i < observations; ++i)
+                file << "O: " << a << " : " << s1 << " : " << (first + i) % O << ' ' << 1.0 / observations << '\n';
+        }
+        for (size_t s = 0; s < S; ++s)
+            file << "R: " << a << " : " << s << " : * : * " << reward(rnd) << '\n';
+    }
+}
+
+template <typename F>
+void run(const std::string & name, F && parse) {
+    const auto start = Clock::now();
+    const auto model = parse();
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    std::cout << std::left  << std::setw(20) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(1) << elapsed.count() << " ms"
+              << "    (S = " << model.getS() << ")\n";
+}
+
+int main(int argc, char ** argv) {
+    const size_t S = argc > 1 ? std::stoul(argv[1]) : 100000;
+    const size_t A = argc > 2 ? std::stoul(argv[2]) : 4;
+    const size_t O = argc > 3 ? std::stoul(argv[3]) : 16;
+    const unsigned threads = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    const std::string filename = "cassandra_parsing_benchmark.POMDP";
+
+    ai::RandomEngine rnd(ai::Seeder::getSeed());
+    writeModel(filename, S, A, O, rnd);
+
+    std::cout << "S = " << S << ", A = " << A << ", O = " << O << '\n';
+
+    // The dense parser needs S*S*A memory.
+    if (S <= 2000) {
+        run("dense", [&]{
+            std::ifstream file(filename);
+            return pomdp::parseCassandra(file);
+        });
+    }
+    for (unsigned t = 1; t <= threads; t *= 2)
+        run("sparse, " + std::to_string(t) + " threads", [&]{ return pomdp::parseCassandraSparse(filename, t); });
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,110 @@
+/* This benchmark compares the available LP backends on the algorithms of the
+ * library that solve many small LPs.
+ *
+ * Each algorithm is run once per backend, by changing the default backend
+ * used by the LPs it creates. For the Pruner we also report the statistics
+ * of the LP solves, to see the effect of warm starting.
+ *
+ * Usage: lp_backends [repetitions]
+ */
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/LP.hpp>
+#include <AIToolbox/Utils/Prune.hpp>
+
+#include <AIToolbox/MDP/Algorithms/LinearProgramming.hpp>
+#include <AIToolbox/MDP/Environments/CornerProblem.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/GapMin.hpp>
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
+#include <AIToolbox/POMDP/Algorithms/LinearSupport.hpp>
+#include <AIToolbox/POMDP/Algorithms/Witness.hpp>
+#include <AIToolbox/POMDP/Environments/TigerProblem.hpp>
+#include <AIToolbox/POMDP/Environments/ChengD35.hpp>
+
+namespace ai = AIToolbox;
+
+using Clock = std::chrono::steady_clock;
+
+const char * name(const ai::LP::Backend b) {
+    switch (b) {
+        case ai::LP::Backend::LpSolve:      return "lp_solve";
+        case ai::LP::Backend::DenseSimplex: return "DenseSimplex";
+        default:                            return "Automatic";
+    }
+}
+
+template <typename F>
+void run(const std::string & algorithm, const unsigned repetitions, F f) {
+    for (const auto backend : {ai::LP::Backend::LpSolve, ai::LP::Backend::DenseSimplex}) {
+        ai::LP::setDefaultBackend(backend);
+
+        ai::LP::Statistics stats;
+        const auto start = Clock::now();
+        for (unsigned i = 0; i < repetitions; ++i)
+            f(stats);
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+        std::cout << std::left  << std::setw(22) << algorithm
+                  << std::setw(14) << name(backend)
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(2) << elapsed.count() / repetitions << " ms";
+        if (stats.solves)
+            std::cout << std::setw(10) << stats.solves / repetitions << " solves"
+                      << std::setw(10) << stats.pivots / repetitions << " pivots"
+                      << std::setw(8)  << stats.warmStarts / repetitions << " warm";
+        std::cout << '\n';
+    }
+}
+
+int main(int argc, char ** argv) {
+    const unsigned repetitions = argc > 1 ? std::stoul(argv[1]) : 5;
+
+    // Random hyperplanes to prune; the seed is fixed so runs are comparable.
+    ai::RandomEngine rand(12345);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<ai::Hyperplane> hyperplanes;
+    for (size_t i = 0; i < 500; ++i)
+        hyperplanes.emplace_back(ai::Hyperplane::NullaryExpr(8, [&]{ return dist(rand); }));
+
+    const auto tiger = ai::POMDP::makeTigerProblem();
+    const auto cheng = ai::POMDP::makeChengD35();
+    const auto corner = ai::MDP::makeCornerProblem(ai::MDP::GridWorld(6, 6));
+
+    std::cout << "Average over " << repetitions << " repetitions.\n\n";
+
+    run("Pruner (S=8, 500)", repetitions, [&](ai::LP::Statistics & stats) {
+        auto copy = hyperplanes;
+        ai::Pruner prune(8);
+        prune(std::begin(copy), std::end(copy));
+
+        const auto & s = prune.getStatistics();
+        stats.solves += s.solves; stats.pivots += s.pivots; stats.warmStarts += s.warmStarts;
+    });
+    run("Witness (tiger)", repetitions, [&](ai::LP::Statistics &) {
+        ai::POMDP::Witness solver(8, 0.0);
+        solver(tiger);
+    });
+    run("IncrementalPruning", repetitions, [&](ai::LP::Statistics &) {
+        ai::POMDP::IncrementalPruning solver(8, 0.0);
+        solver(tiger);
+    });
+    run("LinearSupport", repetitions, [&](ai::LP::Statistics &) {
+        ai::POMDP::LinearSupport solver(8, 0.0);
+        solver(tiger);
+    });
+    run("GapMin (ChengD35)", repetitions, [&](ai::LP::Statistics &) {
+        ai::POMDP::GapMin solver(0.005, 3);
+        ai::POMDP::Belief b(cheng.getS()); b.fill(1.0 / cheng.getS());
+        solver(cheng, b);
+    });
+    run("MDP::LinearProgramming", repetitions, [&](ai::LP::Statistics &) {
+        ai::MDP::LinearProgramming solver;
+        solver(corner);
+    });
+
+    return 0;
+}
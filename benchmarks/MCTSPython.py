@@ -0,0 +1,93 @@
+# This benchmark measures how many MCTS simulations per second we can run from
+# Python, depending on how the model is provided.
+#
+# - MCTSModel uses a C++ MDP.Model, so it never calls back into Python.
+# - MCTSGenerativeModelPython wraps a pure Python environment, calling it
+#   once per sample.
+# - The batched variant asks the same environment for many samples per call.
+#
+# Usage: run from the directory containing the AIToolbox module.
+#
+#     python3 MCTSPython.py [iterations]
+
+import os
+import random
+import sys
+import time
+
+sys.path.append(os.getcwd())
+from AIToolbox import MDP
+
+SIDE = 8
+S = SIDE * SIDE
+A = 4
+DISCOUNT = 0.95
+HORIZON = 10
+START = S // 2 + SIDE // 2
+
+def step(s, a):
+    # Corner problem: the top-left and bottom-right corners are terminal, and
+    # each move fails with probability 0.2.
+    if random.random() < 0.2:
+        return s
+    x, y = s % SIDE, s // SIDE
+    if a == 0:   y = max(0, y - 1)
+    elif a == 1: x = min(SIDE - 1, x + 1)
+    elif a == 2: y = min(SIDE - 1, y + 1)
+    else:        x = max(0, x - 1)
+    return y * SIDE + x
+
+class Corner:
+    def getS(self): return S
+    def getA(self): return A
+    def getDiscount(self): return DISCOUNT
+    def isTerminal(self, s): return s == 0 or s == S - 1
+    def sampleSR(self, s, a): return (step(s, a), -1.0)
+
+class BatchedCorner(Corner):
+    def sampleSRBatch(self, states, actions):
+        return [step(s, a) for s, a in zip(states, actions)], [-1.0] * len(states)
+
+def makeModel():
+    model = MDP.Model(S, A, DISCOUNT)
+    t = [[[0.0] * S for _ in range(A)] for _ in range(S)]
+    r = [[[0.0] * S for _ in range(A)] for _ in range(S)]
+    for s in range(S):
+        for a in range(A):
+            if s == 0 or s == S - 1:
+                t[s][a][s] = 1.0
+                continue
+            x, y = s % SIDE, s // SIDE
+            if a == 0:   y = max(0, y - 1)
+            elif a == 1: x = min(SIDE - 1, x + 1)
+            elif a == 2: y = min(SIDE - 1, y + 1)
+            else:        x = max(0, x - 1)
+            t[s][a][y * SIDE + x] += 0.8
+            t[s][a][s] += 0.2
+            for s1 in range(S):
+                r[s][a][s1] = -1.0
+    model.setTransitionFunction(t)
+    model.setRewardFunction(r)
+    return model
+
+def bench(name, mcts, iterations, repetitions = 5):
+    start = time.perf_counter()
+    for _ in range(repetitions):
+        mcts.sampleAction(START, HORIZON)
+    elapsed = time.perf_counter() - start
+    print("{:<36}{:>14.0f} simulations/s".format(name, iterations * repetitions / elapsed))
+
+if __name__ == '__main__':
+    iterations = int(sys.argv[1]) if len(sys.argv) > 1 else 2000
+
+    # MCTS only keeps a reference to its model, so we must keep them alive.
+    model = makeModel()
+    bench("MCTSModel (C++ model)", MDP.MCTSModel(model, iterations, 5.0), iterations)
+
+    gm = MDP.GenerativeModelPython(Corner())
+    bench("GenerativeModelPython", MDP.MCTSGenerativeModelPython(gm, iterations, 5.0), iterations)
+
+    for batch in (16, 256):
+        gm = MDP.GenerativeModelPython(BatchedCorner(), batch)
+        bench("GenerativeModelPython (batch {})".format(batch),
+              MDP.MCTSGenerativeModelPython(gm, iterations, 5.0), iterations)
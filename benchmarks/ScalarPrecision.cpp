@@ -0,0 +1,279 @@
+/* This benchmark compares classes storing their data in double and single precision.
+ *
+ * It builds a random dense MDP and a random sparse one, converts both to
+ * float storage, and runs ValueIteration for a fixed number of steps on all
+ * of them. For each model we report the time per run, the memory used by
+ * the transition function, and the largest error of the resulting
+ * ValueFunction with respect to the double precision solution.
+ *
+ * It then feeds the same stream of random transitions to the tabular
+ * learners with double and float QFunctions, and reports the time for the
+ * whole stream, the memory of the QFunction and the largest error of the
+ * learned QFunction.
+ *
+ * Finally, it projects a random VList through a random POMDP with the
+ * Projecter, with double and float values and models. Here the memory is
+ * the one used by the projected values.
+ *
+ * Usage: scalar_precision [states] [actions] [horizon]
+ */
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/MDP/Algorithms/QLearning.hpp>
+#include <AIToolbox/MDP/Algorithms/SARSA.hpp>
+#include <AIToolbox/MDP/Algorithms/DoubleQLearning.hpp>
+#include <AIToolbox/POMDP/Model.hpp>
+#include <AIToolbox/POMDP/Algorithms/Utils/Projecter.hpp>
+
+namespace ai = AIToolbox;
+namespace mdp = AIToolbox::MDP;
+namespace pomdp = AIToolbox::POMDP;
+
+using Clock = std::chrono::steady_clock;
+
+mdp::Model makeDense(const size_t S, const size_t A, ai::RandomEngine & rnd) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    mdp::Model::TransitionMatrix t(A, ai::Matrix2D(S, S));
+    mdp::Model::RewardMatrix r(S, A);
+    for (auto & m : t) {
+        m = ai::Matrix2D::NullaryExpr(S, S, [&]{ return dist(rnd); });
+        m.array().colwise() /= m.array().rowwise().sum();
+    }
+    r = ai::Matrix2D::NullaryExpr(S, A, [&]{ return dist(rnd); });
+
+    return mdp::Model(ai::NO_CHECK, S, A, std::move(t), std::move(r), 0.95);
+}
+
+mdp::SparseModel makeSparse(const size_t S, const size_t A, const size_t successors, ai::RandomEngine & rnd) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::uniform_int_distribution<size_t> state(0, S - 1);
+
+    mdp::SparseModel::TransitionMatrix t(A, ai::SparseMatrix2D(S, S));
+    mdp::SparseModel::RewardMatrix r(S, A);
+    for (auto & m : t) {
+        std::vector<Eigen::Triplet<double>> triplets;
+        for (size_t s = 0; s < S; ++s) {
+            ai::Vector p(successors);
+            for (auto & v : p) v = dist(rnd);
+            p /= p.sum();
+            // Duplicates are summed, so the row still sums to one.
+            for (size_t i = 0; i < successors; ++i)
+                triplets.emplace_back(s, state(rnd), p[i]);
+        }
+        m.setFromTriplets(triplets.begin(), triplets.end());
+    }
+    for (size_t s = 0; s < S; ++s)
+        for (size_t a = 0; a < A; ++a)
+            r.insert(s, a) = dist(rnd);
+
+    return mdp::SparseModel(ai::NO_CHECK, S, A, std::move(t), std::move(r), 0.95);
+}
+
+template <typename T>
+size_t bytes(const ai::Matrix3DT<T> & t) {
+    size_t retval = 0;
+    for (const auto & m : t)
+        retval += m.size() * sizeof(T);
+    return retval;
+}
+
+template <typename T>
+size_t bytes(const ai::SparseMatrix3DT<T> & t) {
+    size_t retval = 0;
+    for (const auto & m : t)
+        retval += m.nonZeros() * (sizeof(T) + sizeof(typename ai::SparseMatrix2DT<T>::StorageIndex));
+    return retval;
+}
+
+// Copying through the IsModel constructor would be quadratic in S, even for
+// sparse models, so we cast the matrices directly.
+template <template <typename> class M>
+M<float> toFloat(const M<double> & model) {
+    typename M<float>::TransitionMatrix t;
+    for (const auto & m : model.getTransitionFunction())
+        t.emplace_back(m.template cast<float>());
+    typename M<float>::RewardMatrix r = model.getRewardFunction().template cast<float>();
+
+    return M<float>(ai::NO_CHECK, model.getS(), model.getA(), std::move(t), std::move(r), model.getDiscount());
+}
+
+void report(const std::string & name, const double ms, const size_t bytes, const double * error) {
+    std::cout << std::left  << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+              << std::setw(10) << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MB";
+    if (error)
+        std::cout << std::setw(14) << std::scientific << std::setprecision(2) << *error << " max error";
+    std::cout << '\n';
+}
+
+template <typename M>
+ai::Vector run(const std::string & name, const M & model, const unsigned horizon, const ai::Vector * reference) {
+    // Zero tolerance forces the solver to run for the full horizon.
+    mdp::ValueIteration solver(horizon, 0.0);
+
+    // One warm-up run, then we time a few more.
+    auto values = std::get<1>(solver(model)).values;
+
+    constexpr unsigned repetitions = 3;
+    const auto start = Clock::now();
+    for (unsigned i = 0; i < repetitions; ++i)
+        values = std::get<1>(solver(model)).values;
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    const double error = reference ? (values - *reference).cwiseAbs().maxCoeff() : 0.0;
+    report(name, elapsed.count() / repetitions, bytes(model.getTransitionFunction()), reference ? &error : nullptr);
+
+    return values;
+}
+
+struct Transition {
+    size_t s, a, s1, a1;
+    double rew;
+};
+
+std::vector<Transition> makeTransitions(const size_t S, const size_t A, const size_t n, ai::RandomEngine & rnd) {
+    std::uniform_int_distribution<size_t> state(0, S - 1), action(0, A - 1);
+    std::uniform_real_distribution<double> reward(-1.0, 1.0);
+
+    std::vector<Transition> retval(n);
+    for (auto & t : retval)
+        t = {state(rnd), action(rnd), state(rnd), action(rnd), reward(rnd)};
+    return retval;
+}
+
+// The learner is taken by value, so that each run starts from scratch.
+template <typename L>
+ai::Matrix2D learn(const std::string & name, L learner, const std::vector<Transition> & data, const ai::Matrix2D * reference) {
+    const auto start = Clock::now();
+    for (const auto & t : data) {
+        if constexpr (requires { learner.stepUpdateQ(t.s, t.a, t.s1, t.a1, t.rew); })
+            learner.stepUpdateQ(t.s, t.a, t.s1, t.a1, t.rew);
+        else
+            learner.stepUpdateQ(t.s, t.a, t.s1, t.rew);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    const auto & q = learner.getQFunction();
+    const ai::Matrix2D values = q.template cast<double>();
+
+    const double error = reference ? (values - *reference).cwiseAbs().maxCoeff() : 0.0;
+    report(name, elapsed.count(), q.size() * sizeof(typename std::remove_cvref_t<decltype(q)>::Scalar), reference ? &error : nullptr);
+
+    return values;
+}
+
+template <template <typename> class L>
+void learnBoth(const std::string & name, const size_t S, const size_t A, const std::vector<Transition> & data) {
+    const auto reference = learn(name + "<double>", L<double>(S, A, 0.95, 0.1), data, nullptr);
+    learn(name + "<float>", L<float>(S, A, 0.95, 0.1), data, &reference);
+}
+
+template <typename M>
+M makePOMDP(const size_t S, const size_t A, const size_t O, ai::RandomEngine & rnd) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    const auto mdpModel = makeDense(S, A, rnd);
+    typename M::TransitionMatrix t;
+    for (const auto & m : mdpModel.getTransitionFunction())
+        t.emplace_back(m.template cast<typename M::Scalar>());
+    typename M::RewardMatrix r = mdpModel.getRewardFunction().template cast<typename M::Scalar>();
+
+    ai::Matrix3D o(A, ai::Matrix2D(S, O));
+    for (auto & m : o) {
+        m = ai::Matrix2D::NullaryExpr(S, O, [&]{ return dist(rnd); });
+        m.array().colwise() /= m.array().rowwise().sum();
+    }
+
+    return M(ai::NO_CHECK, O, std::move(o), ai::NO_CHECK, S, A, std::move(t), std::move(r), 0.95);
+}
+
+template <typename T, typename M>
+std::vector<ai::Vector> project(const std::string & name, const M & model, const pomdp::VList & w, const std::vector<ai::Vector> * reference) {
+    pomdp::VListT<T> tw;
+    for (const auto & e : w)
+        tw.emplace_back(e.values.template cast<T>(), e.action, e.observations);
+
+    pomdp::Projecter<M, T> projecter(model);
+
+    const auto start = Clock::now();
+    const auto projections = projecter(tw);
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    std::vector<ai::Vector> values;
+    for (const auto & row : projections)
+        for (const auto & list : row)
+            for (const auto & e : list)
+                values.emplace_back(e.values.template cast<double>());
+
+    double error = 0.0;
+    if (reference)
+        for (size_t i = 0; i < values.size(); ++i)
+            error = std::max(error, (values[i] - (*reference)[i]).cwiseAbs().maxCoeff());
+    report(name, elapsed.count(), values.size() * model.getS() * sizeof(T), reference ? &error : nullptr);
+
+    return values;
+}
+
+int main(int argc, char ** argv) {
+    const size_t S = argc > 1 ? std::stoul(argv[1]) : 2000;
+    const size_t A = argc > 2 ? std::stoul(argv[2]) : 4;
+    const unsigned horizon = argc > 3 ? std::stoul(argv[3]) : 50;
+
+    ai::RandomEngine rnd(ai::Seeder::getSeed());
+
+    std::cout << "S = " << S << ", A = " << A << ", horizon = " << horizon << '\n';
+    {
+        const auto model = makeDense(S, A, rnd);
+        const auto fmodel = toFloat(model);
+
+        const auto reference = run("Model<double>", model, horizon, nullptr);
+        run("Model<float>", fmodel, horizon, &reference);
+    }
+    {
+        const auto model = makeSparse(S * 10, A, 20, rnd);
+        const auto fmodel = toFloat(model);
+
+        const auto reference = run("Sparse<double>", model, horizon, nullptr);
+        run("Sparse<float>", fmodel, horizon, &reference);
+    }
+    {
+        // Many states, so that the QFunction does not fit in cache.
+        const size_t LS = S * 500;
+        const auto data = makeTransitions(LS, A, 5'000'000, rnd);
+
+        learnBoth<mdp::QLearningT>("QLearning", LS, A, data);
+        learnBoth<mdp::SARSAT>("SARSA", LS, A, data);
+        learnBoth<mdp::DoubleQLearningT>("DoubleQLearning", LS, A, data);
+    }
+    {
+        const size_t PS = 200, O = 8, entries = 200;
+        using POMDP  = pomdp::Model<mdp::Model>;
+        using FPOMDP = pomdp::Model<mdp::ModelT<float>>;
+
+        // Both models are built from the same random draws.
+        auto prnd = rnd;
+        const auto model = makePOMDP<POMDP>(PS, A, O, rnd);
+        const auto fmodel = makePOMDP<FPOMDP>(PS, A, O, prnd);
+
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        pomdp::VList w;
+        for (size_t i = 0; i < entries; ++i)
+            w.emplace_back(ai::Vector::NullaryExpr(PS, [&]{ return dist(rnd); }), 0, pomdp::VObs(1, 0));
+
+        const auto reference = project<double>("Projecter<double>", model, w, nullptr);
+        project<float>("Projecter<float>", model, w, &reference);
+        project<float>("Projecter<float, float>", fmodel, w, &reference);
+    }
+}
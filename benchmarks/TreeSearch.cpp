@@ -0,0 +1,121 @@
+/* This benchmark measures the hash maps used by the tree search algorithms.
+ *
+ * First it compares FlatMap against std::unordered_map on the access
+ * pattern of tree nodes: many small maps, each looked up and grown one key
+ * at a time. Then it reports the throughput of MCTS, POMCP and rPOMCP, in
+ * tree nodes created per second.
+ *
+ * Usage: tree_search [repetitions]
+ */
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/FlatMap.hpp>
+
+#include <AIToolbox/MDP/Algorithms/MCTS.hpp>
+#include <AIToolbox/MDP/Environments/CornerProblem.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/POMCP.hpp>
+#include <AIToolbox/POMDP/Algorithms/rPOMCP.hpp>
+#include <AIToolbox/POMDP/Environments/TigerProblem.hpp>
+
+namespace ai = AIToolbox;
+
+using Clock = std::chrono::steady_clock;
+
+void report(const std::string & name, const double count, const std::string & unit, const std::chrono::duration<double> elapsed) {
+    std::cout << std::left  << std::setw(34) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << count / elapsed.count()
+              << ' ' << unit << "/s\n";
+}
+
+// Each "node" gets a handful of children keys drawn from a small range,
+// and most accesses hit an existing key, as with observations in POMCP.
+template <typename Map>
+void benchmarkMap(const std::string & name, const unsigned repetitions) {
+    constexpr size_t Nodes = 20000;
+    constexpr size_t Accesses = 200;
+
+    ai::RandomEngine rand(12345);
+    std::uniform_int_distribution<size_t> keyDist(0, 15);
+
+    std::vector<size_t> keys(Accesses * 64);
+    for (auto & k : keys) k = keyDist(rand);
+
+    unsigned long long checksum = 0;
+    const auto start = Clock::now();
+    for (unsigned r = 0; r < repetitions; ++r) {
+        std::vector<Map> nodes(Nodes);
+        for (size_t n = 0; n < Nodes; ++n) {
+            auto & map = nodes[n];
+            const size_t offset = (n * 37) % (keys.size() - Accesses);
+            for (size_t i = 0; i < Accesses; ++i) {
+                const auto k = keys[offset + i];
+                auto it = map.find(k);
+                if (it == map.end()) map[k] = 1;
+                else ++it->second;
+            }
+            checksum += map.size();
+        }
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    report(name, static_cast<double>(Nodes) * Accesses * repetitions, "accesses", elapsed);
+    if (checksum == 0) std::cout << "Unexpected checksum\n";
+}
+
+// Counts the belief nodes in a search tree.
+template <typename Node>
+size_t countNodes(const Node & node) {
+    size_t retval = 1;
+    for (const auto & a : node.children)
+        for (const auto & [key, child] : a.children)
+            retval += countNodes(child);
+    return retval;
+}
+
+template <typename F>
+void benchmarkSolver(const std::string & name, const unsigned repetitions, F f) {
+    size_t nodes = 0;
+    const auto start = Clock::now();
+    for (unsigned r = 0; r < repetitions; ++r)
+        nodes += f();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    report(name, static_cast<double>(nodes), "nodes", elapsed);
+}
+
+int main(int argc, char ** argv) {
+    const unsigned repetitions = argc > 1 ? std::stoul(argv[1]) : 5;
+
+    std::cout << "Average over " << repetitions << " repetitions.\n\n";
+
+    benchmarkMap<std::unordered_map<size_t, unsigned>>("std::unordered_map", repetitions);
+    benchmarkMap<ai::FlatMap<size_t, unsigned>>("FlatMap", repetitions);
+    std::cout << '\n';
+
+    const auto corner = ai::MDP::makeCornerProblem(ai::MDP::GridWorld(8, 8));
+    const auto tiger = ai::POMDP::makeTigerProblem();
+    ai::POMDP::Belief b(2); b.fill(0.5);
+
+    benchmarkSolver("MCTS (corner 8x8)", repetitions, [&]{
+        ai::MDP::MCTS solver(corner, 20000, 5.0);
+        solver.sampleAction(27, 20);
+        return countNodes(solver.getGraph());
+    });
+    benchmarkSolver("POMCP (tiger)", repetitions, [&]{
+        ai::POMDP::POMCP solver(tiger, 1000, 20000, 100.0);
+        solver.sampleAction(b, 20);
+        return countNodes(solver.getGraph());
+    });
+    benchmarkSolver("rPOMCP (tiger)", repetitions, [&]{
+        ai::POMDP::rPOMCP<decltype(tiger), true> solver(tiger, 1000, 20000, 100.0, 500);
+        solver.sampleAction(b, 20);
+        return countNodes(solver.getGraph());
+    });
+
+    return 0;
+}
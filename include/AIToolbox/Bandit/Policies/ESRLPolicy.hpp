@@ -83,6 +83,10 @@ namespace AIToolbox::Bandit {
             /**
              * @brief This function chooses an action, following the policy distribution.
              *
+             * Which actions can be sampled depends on the current phase
+             * of the policy, so sampleAction(RandomEngine &) is not
+             * supported and throws std::logic_error.
+             *
              * @return The chosen action.
              */
             virtual size_t sampleAction() const override;
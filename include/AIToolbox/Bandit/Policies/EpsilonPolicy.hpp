@@ -40,9 +40,11 @@ namespace AIToolbox::Bandit {
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual size_t sampleRandomAction() const override;
+            virtual size_t sampleRandomAction(RandomEngine & rnd) const override;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -50,9 +52,6 @@ namespace AIToolbox::Bandit {
              * @return The probability of picking an an action at random.
              */
             virtual double getRandomActionProbability() const override;
-
-            // Used to sampled random actions
-            mutable std::uniform_int_distribution<size_t> randomDistribution_;
     };
 }
 
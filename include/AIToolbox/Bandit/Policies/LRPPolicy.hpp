@@ -70,6 +70,10 @@ namespace AIToolbox::Bandit {
             /**
              * @brief This function chooses an action, following the policy distribution.
              *
+             * The distribution is updated in place by stepUpdateP(), so
+             * sampleAction(RandomEngine &) is not supported and throws
+             * std::logic_error.
+             *
              * @return The chosen action.
              */
             virtual size_t sampleAction() const override;
@@ -30,6 +30,28 @@ namespace AIToolbox::Bandit {
              */
             virtual size_t sampleAction() const override;
 
+            /**
+             * @brief This function chooses the greediest action, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator used to break ties.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses multiple independent actions.
+             *
+             * The set of greedy actions is computed only once, and each output
+             * is then a uniform pick among them.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<size_t> out) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -46,6 +46,30 @@ namespace AIToolbox::Bandit {
              */
             virtual size_t sampleAction() const override;
 
+            /**
+             * @brief This function chooses an action with probability dependent on value, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * \sa sampleAction();
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses multiple independent actions.
+             *
+             * The softmax is computed only once, and the outputs are then
+             * sampled in constant time each through a VoseAliasSampler.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<size_t> out) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
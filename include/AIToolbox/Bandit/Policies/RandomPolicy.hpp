@@ -25,6 +25,27 @@ namespace AIToolbox::Bandit {
              */
             virtual size_t sampleAction() const override;
 
+            /**
+             * @brief This function chooses a random action, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses multiple independent actions.
+             *
+             * This function simply fills the output with uniform samples.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<size_t> out) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
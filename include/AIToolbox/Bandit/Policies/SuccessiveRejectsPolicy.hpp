@@ -41,6 +41,10 @@ namespace AIToolbox::Bandit {
              * Given how SR works, it simply recommends each arm
              * (nKNew_ - nKOld_) times, before cycling to the next action.
              *
+             * The current arm is advanced by stepUpdateQ(), so
+             * sampleAction(RandomEngine &) is not supported and throws
+             * std::logic_error.
+             *
              * @return The chosen action.
              */
             virtual size_t sampleAction() const override;
@@ -6,6 +6,7 @@
 #include <AIToolbox/Bandit/Types.hpp>
 #include <AIToolbox/Bandit/Experience.hpp>
 #include <AIToolbox/Bandit/Policies/PolicyInterface.hpp>
+#include <AIToolbox/Utils/MaxProbability.hpp>
 
 namespace AIToolbox::Bandit {
     /**
@@ -32,37 +33,56 @@ namespace AIToolbox::Bandit {
              */
             virtual size_t sampleAction() const override;
 
+            /**
+             * @brief This function chooses an action using Thompson sampling and the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
-             * WARNING: In this class the only way to compute the true
-             * probability of selecting the input action is via numerical
-             * integration, since we're dealing with |A| Normal random
-             * variables. To avoid having to do this, we simply sample a lot
-             * and return an approximation of the times the input action was
-             * actually selected. This makes this function very very SLOW. Do
-             * not call at will!!
+             * The probability of an arm is the probability that its sampled
+             * mean is the highest. Since the posteriors of the arms are
+             * independent Student-t distributions, we compute it via
+             * numerical integration (see computeMaxProbability()).
+             *
+             * If some arm has been pulled less than twice, sampleAction()
+             * deterministically returns the first such arm.
              *
              * @param a The selected action.
              *
-             * @return This function returns an approximation of the probability of choosing the input action.
+             * @return This function returns the probability of choosing the input action.
              */
             virtual double getActionProbability(const size_t & a) const override;
 
             /**
              * @brief This function returns a vector containing all probabilities of the policy.
              *
-             * Ideally this function can be called only when there is a
-             * repeated need to access the same policy values in an
-             * efficient manner.
+             * The probabilities are computed via numerical integration, as
+             * in getActionProbability().
              *
-             * WARNING: This can be really expensive, as it does pretty much
-             * the same work as getActionProbability(). It shouldn't be slower
-             * than that call though, so if you do need the overall policy,
-             * do call this method.
+             * @return The probabilities of choosing each action.
              */
             virtual Vector getPolicy() const override;
 
+            /**
+             * @brief This function returns the posterior distributions over the means of all arms.
+             *
+             * These are the distributions sampled by sampleAction(). This
+             * function requires each arm to have been pulled at least
+             * twice.
+             *
+             * @return The posterior of each arm.
+             */
+            std::vector<ValueDistribution> getPosteriors() const;
+
             /**
              * @brief This function returns a reference to the underlying Experience we use.
              *
@@ -48,6 +48,18 @@ namespace AIToolbox::Bandit {
              */
             virtual size_t sampleAction() const override;
 
+            /**
+             * @brief This function chooses an action using top-two Thompson sampling and the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the most likely best action until this point.
              *
@@ -58,29 +70,24 @@ namespace AIToolbox::Bandit {
             /**
              * @brief This function returns the probability of taking the specified action.
              *
-             * WARNING: The only way to compute the true probability of
-             * selecting the input action is via empirical sampling.  we simply
-             * call sampleAction() a lot and return an approximation of the
-             * times the input action was actually selected. This makes this
-             * function very very SLOW. Do not call at will!!
+             * This function computes the probabilities of the leader from
+             * the underlying ThompsonSamplingPolicy. Since the challenger
+             * is sampled again until it differs from the leader, its
+             * probability given a leader l is p(a) / (1 - p(l)).
              *
              * @param a The selected action.
              *
-             * @return This function returns an approximation of the probability of choosing the input action.
+             * @return This function returns the probability of choosing the input action.
              */
             virtual double getActionProbability(const size_t & a) const override;
 
             /**
              * @brief This function returns a vector containing all probabilities of the policy.
              *
-             * Ideally this function can be called only when there is a
-             * repeated need to access the same policy values in an
-             * efficient manner.
+             * This function computes the probabilities of all actions at
+             * once, so it is as fast as a single getActionProbability().
              *
-             * WARNING: This can be really expensive, as it does pretty much
-             * the same work as getActionProbability(). It shouldn't be slower
-             * than that call though, so if you do need the overall policy,
-             * do call this method.
+             * @return The probabilities of choosing each action.
              */
             virtual Vector getPolicy() const override;
 
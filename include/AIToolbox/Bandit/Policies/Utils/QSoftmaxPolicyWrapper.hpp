@@ -101,23 +101,26 @@ namespace AIToolbox::Bandit {
             return wrap.sampleAction();
         }
 
-        valueBuffer_ = (q_ / temperature_).array().exp();
+        // We subtract the max so that the exponentials cannot overflow. If
+        // the max is itself infinite, we pick uniformly among the infinite
+        // values.
+        const double max = q_.maxCoeff();
+        if ( std::isinf(max) ) {
+            unsigned infinities = 0;
+            for ( size_t a = 0; a < buffer_.size(); ++a )
+                if ( q_[a] == max )
+                    buffer_[infinities++] = a;
 
-        unsigned infinities = 0;
-        for ( size_t a = 0; a < buffer_.size(); ++a )
-            if ( std::isinf(valueBuffer_(a)) )
-                buffer_[infinities++] = a;
-
-        if (infinities) {
             auto pickDistribution = std::uniform_int_distribution<unsigned>(0, infinities-1);
             unsigned selection = pickDistribution(rand_);
 
             return buffer_[selection];
-        } else {
-            valueBuffer_ /= valueBuffer_.sum();
-
-            return sampleProbability(buffer_.size(), valueBuffer_, rand_);
         }
+
+        valueBuffer_ = ((q_.array() - max) / temperature_).exp();
+        valueBuffer_ /= valueBuffer_.sum();
+
+        return sampleProbability(buffer_.size(), valueBuffer_, rand_);
     }
 
     template <typename V, typename Gen>
@@ -127,20 +130,19 @@ namespace AIToolbox::Bandit {
             return wrap.getActionProbability(a);
         }
 
-        valueBuffer_ = (q_ / temperature_).array().exp();
+        const double max = q_.maxCoeff();
+        if ( std::isinf(max) ) {
+            if ( q_[a] != max ) return 0.0;
 
-        bool isAInfinite = false;
-        unsigned infinities = 0;
-        for ( size_t aa = 0; aa < buffer_.size(); ++aa ) {
-            if ( std::isinf(valueBuffer_(aa)) ) {
-                infinities++;
-                isAInfinite |= (aa == a);
-            }
-        }
-        if ( infinities ) {
-            if ( isAInfinite ) return 1.0 / infinities;
-            return 0.0;
+            unsigned infinities = 0;
+            for ( size_t aa = 0; aa < buffer_.size(); ++aa )
+                if ( q_[aa] == max )
+                    infinities++;
+
+            return 1.0 / infinities;
         }
+
+        valueBuffer_ = ((q_.array() - max) / temperature_).exp();
         return valueBuffer_(a) / valueBuffer_.sum();
     }
 
@@ -152,22 +154,15 @@ namespace AIToolbox::Bandit {
             return wrap.getPolicy(p);
         }
 
-        p = (q_ / temperature_).array().exp();
-
-        unsigned infinities = 0;
-        double sum = 0.0;
-        for ( size_t a = 0; a < buffer_.size(); ++a ) {
-            sum += p[a];
-            if ( std::isinf(p[a]) )
-                infinities++;
+        const double max = q_.maxCoeff();
+        if ( std::isinf(max) ) {
+            p = (q_.array() == max).template cast<double>();
+            p /= p.sum();
+            return;
         }
 
-        if ( infinities )
-            p = p.array().isInf().template cast<double>() / infinities;
-        else if ( checkEqualSmall(sum, 0.0) )
-            p.fill(1.0 / buffer_.size());
-        else
-            p /= sum;
+        p = ((q_.array() - max) / temperature_).exp();
+        p /= p.sum();
     }
 }
 
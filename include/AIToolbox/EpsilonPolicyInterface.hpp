@@ -56,6 +56,32 @@ namespace AIToolbox {
              */
             virtual Action sampleAction(const Sampling & s) const override;
 
+            /**
+             * @brief This function chooses an action for state s, following the policy distribution and epsilon.
+             *
+             * This function uses the input generator both for the
+             * exploration and for sampling the wrapped policy, which thus
+             * also needs to support external generators.
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(const Sampling & s, RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses an action for each of the input states, following the policy distribution and epsilon.
+             *
+             * This function samples all actions from the wrapped policy in
+             * a single batch, and then replaces each of them with a random
+             * action with probability `epsilon`.
+             *
+             * @param s The sampled states of the policy.
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<const Sampling> s, std::span<Action> out) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -96,9 +122,11 @@ namespace AIToolbox {
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual Action sampleRandomAction() const = 0;
+            virtual Action sampleRandomAction(RandomEngine & rnd) const = 0;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -125,11 +153,28 @@ namespace AIToolbox {
     template <typename State, typename Sampling, typename Action>
     Action EpsilonPolicyInterface<State, Sampling, Action>::sampleAction(const Sampling & s) const {
         if ( probabilityDistribution(this->rand_) <= epsilon_ )
-            return sampleRandomAction();
+            return sampleRandomAction(this->rand_);
 
         return policy_.sampleAction(s);
     }
 
+    template <typename State, typename Sampling, typename Action>
+    Action EpsilonPolicyInterface<State, Sampling, Action>::sampleAction(const Sampling & s, RandomEngine & rnd) const {
+        if ( probabilityDistribution(rnd) <= epsilon_ )
+            return sampleRandomAction(rnd);
+
+        return policy_.sampleAction(s, rnd);
+    }
+
+    template <typename State, typename Sampling, typename Action>
+    void EpsilonPolicyInterface<State, Sampling, Action>::sampleActions(std::span<const Sampling> s, std::span<Action> out) const {
+        policy_.sampleActions(s, out);
+
+        for (auto & a : out)
+            if ( probabilityDistribution(this->rand_) <= epsilon_ )
+                a = sampleRandomAction(this->rand_);
+    }
+
     template <typename State, typename Sampling, typename Action>
     double EpsilonPolicyInterface<State, Sampling, Action>::getActionProbability(const Sampling & s, const Action & a) const {
         // Probability of taking old decision               Random action probability
@@ -185,6 +230,30 @@ namespace AIToolbox {
              */
             virtual Action sampleAction() const override;
 
+            /**
+             * @brief This function chooses an action, following the policy distribution and epsilon.
+             *
+             * This function uses the input generator both for the
+             * exploration and for sampling the wrapped policy, which thus
+             * also needs to support external generators.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses multiple actions, following the policy distribution and epsilon.
+             *
+             * This function samples all actions from the wrapped policy in
+             * a single batch, and then replaces each of them with a random
+             * action with probability `epsilon`.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<Action> out) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -224,9 +293,11 @@ namespace AIToolbox {
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual Action sampleRandomAction() const = 0;
+            virtual Action sampleRandomAction(RandomEngine & rnd) const = 0;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -253,11 +324,28 @@ namespace AIToolbox {
     template <typename Action>
     Action EpsilonPolicyInterface<void, void, Action>::sampleAction() const {
         if ( probabilityDistribution(this->rand_) <= epsilon_ )
-            return sampleRandomAction();
+            return sampleRandomAction(this->rand_);
 
         return policy_.sampleAction();
     }
 
+    template <typename Action>
+    Action EpsilonPolicyInterface<void, void, Action>::sampleAction(RandomEngine & rnd) const {
+        if ( probabilityDistribution(rnd) <= epsilon_ )
+            return sampleRandomAction(rnd);
+
+        return policy_.sampleAction(rnd);
+    }
+
+    template <typename Action>
+    void EpsilonPolicyInterface<void, void, Action>::sampleActions(std::span<Action> out) const {
+        policy_.sampleActions(out);
+
+        for (auto & a : out)
+            if ( probabilityDistribution(this->rand_) <= epsilon_ )
+                a = sampleRandomAction(this->rand_);
+    }
+
     template <typename Action>
     double EpsilonPolicyInterface<void, void, Action>::getActionProbability(const Action & a) const {
         // Probability of taking old decision               Random action probability
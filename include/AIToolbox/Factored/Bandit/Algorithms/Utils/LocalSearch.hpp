@@ -31,6 +31,16 @@ namespace AIToolbox::Factored::Bandit {
              */
             LocalSearch();
 
+            /**
+             * @brief This function sets the seed of the internal generator.
+             *
+             * This is used by QGreedyPolicy to draw the randomness of a
+             * copy of this class from an external generator.
+             *
+             * @param seed The new seed.
+             */
+            void seed(unsigned seed);
+
             /**
              * @brief This function performs the actual local search process.
              *
@@ -44,6 +44,17 @@ namespace AIToolbox::Factored::Bandit {
              */
             ReusingIterativeLocalSearch(double resetActionProbability = 0.3, double randomizeFactorProbability = 0.1, unsigned trialNum = 10, bool forceResetAction = true);
 
+            /**
+             * @brief This function sets the seed of the internal generators.
+             *
+             * This also reseeds the nested LocalSearch.
+             *
+             * \sa LocalSearch::seed(unsigned)
+             *
+             * @param seed The new seed.
+             */
+            void seed(unsigned seed);
+
             /**
              * @brief This function approximately finds the best Action-value pair for the provided Graph.
              *
@@ -27,9 +27,11 @@ namespace AIToolbox::Factored::Bandit {
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual Action sampleRandomAction() const override;
+            virtual Action sampleRandomAction(RandomEngine & rnd) const override;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -37,9 +39,6 @@ namespace AIToolbox::Factored::Bandit {
              * @return The probability of picking an an action at random.
              */
             virtual double getRandomActionProbability() const override;
-
-            // Used to sampled random actions
-            mutable std::vector<std::uniform_int_distribution<size_t>> randomDistribution_;
     };
 }
 
@@ -48,6 +48,23 @@ namespace AIToolbox::Factored::Bandit {
              */
             virtual Action sampleAction() const override;
 
+            /**
+             * @brief This function chooses the greediest action, using the input generator.
+             *
+             * This function works on copies of the internal graph and
+             * maximizer, so it can be called concurrently from multiple
+             * threads. Note that the copies are made at each call.
+             *
+             * The default VariableElimination maximizer is deterministic,
+             * so the generator is not used; maximizers with their own
+             * randomness (e.g. LocalSearch) are reseeded from it.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -108,6 +125,22 @@ namespace AIToolbox::Factored::Bandit {
         return std::get<0>(max_(A, graph_));
     }
 
+    template <typename Maximizer>
+    Action QGreedyPolicy<Maximizer>::sampleAction(RandomEngine & rnd) const {
+        Maximizer max(max_);
+        // Maximizers with their own randomness draw it from the input
+        // generator, so that each caller gets independent results.
+        if constexpr (requires { max.seed(rnd()); })
+            max.seed(rnd());
+        auto graph = graph_;
+        if (qc_) {
+            UpdateGraph<Maximizer>()(graph, *qc_, A);
+        } else {
+            UpdateGraph<Maximizer>()(graph, *qm_, A);
+        }
+        return std::get<0>(max(A, graph));
+    }
+
     template <typename Maximizer>
     double QGreedyPolicy<Maximizer>::getActionProbability(const Action & a) const {
         if (veccmp(a, sampleAction()) == 0) return 1.0;
@@ -25,6 +25,28 @@ namespace AIToolbox::Factored::Bandit {
              */
             virtual Action sampleAction() const override;
 
+            /**
+             * @brief This function chooses a random action, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function chooses multiple independent actions.
+             *
+             * Output actions that already have the right size are overwritten
+             * in place, without allocating.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<Action> out) const override;
+
             /**
              * @brief This function chooses a random action for state s, following the policy distribution.
              *
@@ -31,6 +31,18 @@ namespace AIToolbox::Factored::Bandit {
              */
             virtual Action sampleAction() const override;
 
+            /**
+             * @brief This function always return the current action.
+             *
+             * This policy is deterministic, so it can be sampled
+             * concurrently from multiple threads.
+             *
+             * @param rnd The generator, which is not used.
+             *
+             * @return The currently saved action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -48,19 +48,26 @@ namespace AIToolbox::Factored::Bandit {
             virtual Action sampleAction() const override;
 
             /**
-             * @brief This function returns the probability of taking the specified action.
+             * @brief This function chooses an action using Thompson sampling and the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param rnd The generator to use.
              *
-             * WARNING: In this class the only way to compute the true
-             * probability of selecting the input action is via numerical
-             * integration, since we're dealing with |A| Normal random
-             * variables. To avoid having to do this, we simply sample a lot
-             * and return an approximation of the times the input action was
-             * actually selected. This makes this function very very SLOW. Do
-             * not call at will!!
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const override;
+
+            /**
+             * @brief This function returns the probability of taking the specified action.
              *
-             * To keep things short, we call "sampleAction" 1000 times and
-             * count how many times the provided input was sampled. This
-             * requires performing 1000 VariableElimination runs.
+             * Since joint action values are sums of Student-t samples,
+             * and the candidate actions are correlated, there is no closed
+             * form for this probability. Instead we estimate it via Monte
+             * Carlo (see estimateFrequencies()), sampling until the standard
+             * error of the estimate is below getErrorBound(). Each sample
+             * requires a VariableElimination run, so this is still slow.
              *
              * @param a The selected action.
              *
@@ -86,6 +93,34 @@ namespace AIToolbox::Factored::Bandit {
              */
             static void setupGraph(const Experience & exp, VariableElimination::GVE::Graph & graph, RandomEngine & rnd);
 
+            /**
+             * @brief This function sets the maximum standard error of the estimates of getActionProbability().
+             *
+             * @param errorBound The new error bound, which must be positive.
+             */
+            void setErrorBound(double errorBound);
+
+            /**
+             * @brief This function returns the maximum standard error of the estimates of getActionProbability().
+             *
+             * @return The current error bound.
+             */
+            double getErrorBound() const;
+
+            /**
+             * @brief This function sets the number of threads used by getActionProbability().
+             *
+             * @param threads The number of threads; 0 uses all available cores.
+             */
+            void setThreads(unsigned threads);
+
+            /**
+             * @brief This function returns the number of threads used by getActionProbability().
+             *
+             * @return The number of threads.
+             */
+            unsigned getThreads() const;
+
             /**
              * @brief This function returns a reference to the underlying Experience we use.
              *
@@ -95,6 +130,8 @@ namespace AIToolbox::Factored::Bandit {
 
         private:
             const Experience & exp_;
+            double errorBound_;
+            unsigned threads_;
     };
 }
 
@@ -1,6 +1,11 @@
 #ifndef AI_TOOLBOX_FACTORED_MDP_COOPERATIVE_PRIORITIZED_SWEEPING_HEADER_FILE
 #define AI_TOOLBOX_FACTORED_MDP_COOPERATIVE_PRIORITIZED_SWEEPING_HEADER_FILE
 
+#include <algorithm>
+#include <barrier>
+#include <exception>
+#include <thread>
+
 #include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/Factored/Utils/Core.hpp>
 #include <AIToolbox/Factored/Utils/FactoredMatrix.hpp>
@@ -62,6 +67,44 @@ namespace AIToolbox::Factored::MDP {
              */
             void batchUpdateQ(const unsigned N = 50);
 
+            /**
+             * @brief This function performs a series of batch updates in parallel.
+             *
+             * This function is equivalent to batchUpdateQ(unsigned), but it
+             * spreads the work over multiple threads.
+             *
+             * The updates are done in rounds. In each round, up to
+             * `threads` state-action pairs are reconstructed from the queue
+             * and sampled from the model. Then each thread computes the
+             * update of a pair, which includes maximizing the QFunction over
+             * the next state. Finally, the updates are applied to the
+             * QFunction and their priorities are merged into the queue, in
+             * order and from a single thread.
+             *
+             * Pairs within a round never update the same entry of any
+             * Q-factor: a pair that would is postponed to the next round.
+             * However, all updates in a round are computed from the same
+             * QFunction, rather than each seeing the results of the
+             * previous ones, and the queue is only updated at the end of
+             * each round. Thus results will not match exactly the serial
+             * version.
+             *
+             * The model is never accessed concurrently: it is sampled
+             * between rounds, by whichever thread finishes the round last,
+             * so it does not need to be thread-safe, but it must not rely
+             * on being called from the calling thread. The Maximizer of the
+             * internal QGreedyPolicy is copied for each thread, so its
+             * parameters are respected.
+             *
+             * If the model or a Maximizer throw, all threads stop at the
+             * end of the current round, and the exception is rethrown from
+             * this function. The updates of that round are not applied.
+             *
+             * @param N The number of priority updates to perform.
+             * @param threads The number of threads to use; 0 or 1 runs the serial version.
+             */
+            void batchUpdateQ(unsigned N, unsigned threads);
+
             /**
              * @brief This function returns the QGreedyPolicy we use to determine a1* in the updates.
              *
@@ -101,6 +144,44 @@ namespace AIToolbox::Factored::MDP {
              */
             void updateQ(const State & s, const Action & a, const State & s1, const Rewards & r);
 
+            /**
+             * @brief This function computes the QFunction update for each Q-factor, without applying it.
+             *
+             * This function only reads the QFunction, so it can be called
+             * concurrently as long as each call uses its own policy and
+             * storage.
+             *
+             * @param gp The policy to use to determine a1*.
+             * @param s The initial state.
+             * @param a The action performed.
+             * @param s1 The final state.
+             * @param r The *normalized* rewards to use (one per state factor).
+             * @param rewardStorage Temporary storage, of the size of the state space.
+             * @param tds The output updates, one per Q-factor.
+             */
+            void computeUpdates(const QGreedyPolicy<Maximizer> & gp, const State & s, const Action & a, const State & s1, const Rewards & r, Vector & rewardStorage, Vector & tds) const;
+
+            /**
+             * @brief This function applies the updates computed by computeUpdates().
+             *
+             * @param s The initial state.
+             * @param a The action performed.
+             * @param tds The updates, one per Q-factor.
+             */
+            void applyUpdates(const State & s, const Action & a, const Vector & tds);
+
+            /**
+             * @brief This function reconstructs a state-action pair from the queue and samples the model with it.
+             *
+             * @param s The output state.
+             * @param a The output action.
+             * @param s1 The output sampled next state.
+             * @param rews The output sampled rewards.
+             *
+             * @return False if the queue was empty, true otherwise.
+             */
+            bool samplePair(State & s, Action & a, State & s1, Rewards & rews);
+
             /**
              * @brief This function updates the queue using the input state and the internal stored deltas.
              *
@@ -112,7 +193,7 @@ namespace AIToolbox::Factored::MDP {
             double alpha_, theta_;
 
             std::vector<std::vector<size_t>> qDomains_;
-            Vector rewardWeights_, deltaStorage_, rewardStorage_;
+            Vector rewardWeights_, deltaStorage_, rewardStorage_, tdStorage_;
 
             QFunction q_;
             QGreedyPolicy<Maximizer> gp_;
@@ -141,7 +222,8 @@ namespace AIToolbox::Factored::MDP {
         // anyway it's not a problem.
         rewardWeights_.setZero();
         deltaStorage_.setZero();
-        // We don't need to zero rewardStorage_
+        // We don't need to zero rewardStorage_ and tdStorage_
+        tdStorage_.resize(q_.bases.size());
 
         // We weight rewards based on the state features of each Q factor
         for (const auto & q : q_.bases)
@@ -164,39 +246,176 @@ namespace AIToolbox::Factored::MDP {
         Rewards rews(model_.getS().size());
 
         for (size_t n = 0; n < N; ++n) {
-            if (!queue_.getNonZeroPriorities()) return;
+            if (!samplePair(s, a, s1, rews)) return;
 
-            queue_.reconstruct(s, a);
+            // Use the sample to update Q.
+            updateQ(s, a, s1, rews);
+
+            // Update the queue
+            addToQueue(s);
+        }
+    }
 
-            // Filling randomly the missing elements.
-            for (size_t i = 0; i < s.size(); ++i) {
-                if (s[i] == model_.getS()[i]) {
-                    std::uniform_int_distribution<size_t> dist(0, model_.getS()[i]-1);
-                    s[i] = dist(rand_);
+    template <typename M, typename Maximizer>
+    void CooperativePrioritizedSweeping<M, Maximizer>::batchUpdateQ(const unsigned N, const unsigned threads) {
+        if (threads < 2) return batchUpdateQ(N);
+
+        const auto & S = model_.getS();
+        const auto & A = model_.getA();
+
+        // Everything a thread needs to compute an update.
+        struct Job {
+            State s, s1;
+            Action a;
+            Rewards rews;
+            Vector rewardStorage, tds;
+            // The entry each Q-factor would update.
+            std::vector<size_t> entries;
+        };
+        std::vector<Job> jobs(threads);
+        for (auto & j : jobs) {
+            j.s.resize(S.size());
+            j.s1.resize(S.size());
+            j.a.resize(A.size());
+            j.rews.resize(S.size());
+            j.rewardStorage.resize(S.size());
+            j.tds.resize(q_.bases.size());
+            j.entries.resize(q_.bases.size());
+        }
+        // Each thread needs its own Maximizer.
+        std::vector<QGreedyPolicy<Maximizer>> policies(threads, gp_);
+
+        unsigned popped = 0, roundSize = 0;
+        // Whether jobs[roundSize] holds a pair postponed from the last round.
+        bool postponed = false;
+
+        const auto prepareRound = [&]() {
+            if (postponed) {
+                std::swap(jobs[0], jobs[roundSize]);
+                postponed = false;
+                roundSize = 1;
+            } else {
+                roundSize = 0;
+            }
+            while (roundSize < threads && popped < N) {
+                auto & j = jobs[roundSize];
+                if (!samplePair(j.s, j.a, j.s1, j.rews)) break;
+                ++popped;
+
+                for (size_t i = 0; i < q_.bases.size(); ++i) {
+                    const auto & q = q_.bases[i];
+                    const auto sid = toIndexPartial(q.tag, S, j.s);
+                    const auto aid = toIndexPartial(q.actionTag, A, j.a);
+                    j.entries[i] = sid * q.values.cols() + aid;
                 }
+                // If this pair would update the same entry as a pair
+                // already in the round, we leave it for the next one.
+                for (unsigned k = 0; k < roundSize; ++k) {
+                    for (size_t i = 0; i < q_.bases.size(); ++i) {
+                        if (jobs[k].entries[i] == j.entries[i]) {
+                            postponed = true;
+                            break;
+                        }
+                    }
+                    if (postponed) break;
+                }
+                if (postponed) break;
+                ++roundSize;
+            }
+        };
+
+        prepareRound();
+        if (roundSize == 0) return;
+
+        // Exceptions cannot leave the threads, nor the barrier completion,
+        // so we store them and rethrow the first one once all have joined.
+        std::vector<std::exception_ptr> errors(threads + 1);
+
+        // Once all threads have computed their update, a single thread
+        // applies them in order and prepares the next round.
+        bool done = false;
+        const auto finishRound = [&]() noexcept {
+            done = std::any_of(std::begin(errors), std::end(errors), [](const auto & e) { return bool(e); });
+            if (done) return;
+            try {
+                for (unsigned k = 0; k < roundSize; ++k) {
+                    applyUpdates(jobs[k].s, jobs[k].a, jobs[k].tds);
+                    addToQueue(jobs[k].s);
+                }
+                prepareRound();
+                done = roundSize == 0;
+            } catch (...) {
+                errors[threads] = std::current_exception();
+                done = true;
             }
-            for (size_t i = 0; i < a.size(); ++i) {
-                if (a[i] == model_.getA()[i]) {
-                    std::uniform_int_distribution<size_t> dist(0, model_.getA()[i]-1);
-                    a[i] = dist(rand_);
+        };
+        std::barrier sync(threads, finishRound);
+
+        const auto work = [&](const unsigned id) {
+            while (true) {
+                if (id < roundSize) {
+                    auto & j = jobs[id];
+                    try {
+                        computeUpdates(policies[id], j.s, j.a, j.s1, j.rews, j.rewardStorage, j.tds);
+                    } catch (...) {
+                        errors[id] = std::current_exception();
+                    }
                 }
+                sync.arrive_and_wait();
+                if (done) return;
             }
+        };
 
-            // Finally, sample a new s1/rews from the model.
-            model_.sampleSRs(s, a, &s1, &rews);
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned id = 1; id < threads; ++id)
+            workers.emplace_back(work, id);
 
-            // And use them to update Q.
-            updateQ(s, a, s1, rews);
+        work(0);
 
-            // Update the queue
-            addToQueue(s);
+        for (auto & w : workers)
+            w.join();
+
+        for (const auto & e : errors)
+            if (e) std::rethrow_exception(e);
+    }
+
+    template <typename M, typename Maximizer>
+    bool CooperativePrioritizedSweeping<M, Maximizer>::samplePair(State & s, Action & a, State & s1, Rewards & rews) {
+        if (!queue_.getNonZeroPriorities()) return false;
+
+        queue_.reconstruct(s, a);
+
+        // Filling randomly the missing elements.
+        for (size_t i = 0; i < s.size(); ++i) {
+            if (s[i] == model_.getS()[i]) {
+                std::uniform_int_distribution<size_t> dist(0, model_.getS()[i]-1);
+                s[i] = dist(rand_);
+            }
         }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] == model_.getA()[i]) {
+                std::uniform_int_distribution<size_t> dist(0, model_.getA()[i]-1);
+                a[i] = dist(rand_);
+            }
+        }
+
+        // Finally, sample a new s1/rews from the model.
+        model_.sampleSRs(s, a, &s1, &rews);
+
+        return true;
     }
 
     template <typename M, typename Maximizer>
     void CooperativePrioritizedSweeping<M, Maximizer>::updateQ(const State & s, const Action & a, const State & s1, const Rewards & r) {
+        computeUpdates(gp_, s, a, s1, r, rewardStorage_, tdStorage_);
+        applyUpdates(s, a, tdStorage_);
+    }
+
+    template <typename M, typename Maximizer>
+    void CooperativePrioritizedSweeping<M, Maximizer>::computeUpdates(const QGreedyPolicy<Maximizer> & gp, const State & s, const Action & a, const State & s1, const Rewards & r, Vector & rewardStorage, Vector & tds) const {
         // Compute optimal action to do Q-Learning update.
-        const auto a1 = gp_.sampleAction(s1);
+        const auto a1 = gp.sampleAction(s1);
 
         // The standard Q-update is in the form:
         //
@@ -206,7 +425,7 @@ namespace AIToolbox::Factored::MDP {
         // state feature (similar to SparseCooperativeQLearning).
 
         // Start with R
-        rewardStorage_ = r.array();
+        rewardStorage = r.array();
         // Now go over the factored Q-function for the rest
         for (const auto & q : q_.bases) {
             const auto sid = toIndexPartial(q.tag, model_.getS(), s);
@@ -217,19 +436,32 @@ namespace AIToolbox::Factored::MDP {
 
             // gamma * Q(s', a') - Q(s, a)
             // We normalize it per state features, since we distribute the diff to all
-            // elements of rewardStorage_.
+            // elements of rewardStorage.
             const auto diff = (model_.getDiscount() * q.values(s1id, a1id) - q.values(sid, aid)) / q.tag.size();
 
             // Apply the values to each state feature that applies to this Q factor.
             // R(s,a) + ...
             for (const auto s : q.tag)
-                rewardStorage_[s] += diff;
+                rewardStorage[s] += diff;
         }
 
         // Normalize all values based on Q-factors
-        rewardStorage_.array() /= rewardWeights_.array();
-        rewardStorage_.array() *= alpha_;
+        rewardStorage.array() /= rewardWeights_.array();
+        rewardStorage.array() *= alpha_;
 
+        // Compute numerical reward from the components children of each Q
+        // factor.
+        for (size_t i = 0; i < q_.bases.size(); ++i) {
+            double td = 0.0;
+            for (const auto s : q_.bases[i].tag)
+                td += rewardStorage[s];
+
+            tds[i] = td;
+        }
+    }
+
+    template <typename M, typename Maximizer>
+    void CooperativePrioritizedSweeping<M, Maximizer>::applyUpdates(const State & s, const Action & a, const Vector & tds) {
         // We update each Q factor separately.
         for (size_t i = 0; i < q_.bases.size(); ++i) {
             auto & q = q_.bases[i];
@@ -237,19 +469,13 @@ namespace AIToolbox::Factored::MDP {
             const auto sid = toIndexPartial(q.tag, model_.getS(), s);
             const auto aid = toIndexPartial(q.actionTag, model_.getA(), a);
 
-            // Compute numerical reward from the components children of this Q
-            // factor.
-            double td = 0.0;
-            for (const auto s : q.tag)
-                td += rewardStorage_[s];
-
-            q.values(sid, aid) += td;
+            q.values(sid, aid) += tds[i];
 
             // Split the delta to each element referenced by this Q factor.
             // Note that we add to the storage, which is only cleared once we
             // call addToQueue; this means that multiple calls to this
             // functions cumulate their deltas.
-            const auto delta = std::fabs(td) / q.tag.size();
+            const auto delta = std::fabs(tds[i]) / q.tag.size();
             for (const auto s : q.tag)
                 deltaStorage_[s] += delta;
         }
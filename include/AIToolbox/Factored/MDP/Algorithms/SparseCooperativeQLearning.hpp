@@ -27,6 +27,13 @@ namespace AIToolbox::Factored::MDP {
      *
      * Aside from this, this algorithm is very similar to the single agent
      * MDP::QLearning (hence the name).
+     *
+     * To find the rules matching a state (and action) quickly even when
+     * there are very many of them, this class groups rules depending on the
+     * same state and action features into families. Within a family, rules
+     * are sorted by the joint index of their state and action, so that the
+     * rules matching a state are contiguous, and the one matching a
+     * state-action pair can be found with a binary search.
      */
     class SparseCooperativeQLearning {
         public:
@@ -146,12 +153,37 @@ namespace AIToolbox::Factored::MDP {
             const FilterMap<QFunctionRule> & getQFunctionRules() const;
 
         private:
+            /**
+             * @brief This function finds the ids of all rules matching the input state, and optionally action.
+             *
+             * The ids are sorted by family, and within each family by
+             * action, which makes building the VariableElimination graph
+             * from them cheaper.
+             *
+             * @param s The state to match.
+             * @param a The action to match, or nullptr to match all actions.
+             * @param ids The output ids.
+             */
+            void matchRules(const State & s, const Action * a, std::vector<size_t> & ids) const;
+
             State S;
             Action A;
             double discount_, alpha_;
 
             FilterMap<QFunctionRule> rules_;
-            QGreedyPolicy<> policy_;
+
+            // The rules depending on the same state and action features.
+            // Keys are (state id * action space + action id), sorted.
+            struct RuleFamily {
+                PartialKeys stateTag, actionTag;
+                size_t actionSpace;
+                std::vector<std::pair<size_t, size_t>> rules;
+            };
+            std::vector<RuleFamily> families_;
+
+            Bandit::VariableElimination ve_;
+            Bandit::VariableElimination::Graph graph_;
+            std::vector<size_t> beforeIds_, afterIds_;
     };
 }
 
@@ -3,6 +3,7 @@
 
 #include <optional>
 
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/Factored/MDP/Types.hpp>
 
 namespace AIToolbox::Factored::MDP {
@@ -75,8 +76,20 @@ namespace AIToolbox::Factored::MDP {
              */
             std::optional<Vector> operator()(const FactoredVector & C, const FactoredVector & b, bool addConstantBasis = false);
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of LP solves and the time
+             * spent, including building the LP.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             State S;
+            SolverStatistics stats_;
     };
 }
 
@@ -0,0 +1,178 @@
+#ifndef AI_TOOLBOX_FACTORED_MDP_VALUE_ITERATION_HEADER_FILE
+#define AI_TOOLBOX_FACTORED_MDP_VALUE_ITERATION_HEADER_FILE
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Factored/Utils/FactoredMatrix.hpp>
+#include <AIToolbox/Factored/MDP/Types.hpp>
+#include <AIToolbox/Factored/MDP/CooperativeModel.hpp>
+
+namespace AIToolbox::Factored::MDP {
+    /**
+     * @brief This class solves a factored MDP with approximate value or policy iteration.
+     *
+     * This class approximates the optimal ValueFunction of a factored MDP as
+     * a linear combination of the input basis functions, but differently
+     * from LinearProgramming it does not build a single LP containing the
+     * whole problem. Instead, it iterates on the weights of the basis
+     * functions, so that the memory used only grows linearly in the number
+     * of basis functions.
+     *
+     * The basis functions are first backprojected through the transition
+     * function of the model, using backProject(). At each iteration, the
+     * current weights are used to compute the QFunction
+     *
+     *     Q(s,a) = R(s,a) + discount * sum_k w_k * g_k(s,a)
+     *
+     * from which we compute the greedy value of a set of sample states, by
+     * maximizing over the joint actions with VariableElimination.
+     *
+     * In value iteration mode, the new weights are the projection of these
+     * values onto the basis functions. In policy iteration mode, the greedy
+     * actions at the sample states form a policy, which is then evaluated
+     * by finding the weights that minimize its Bellman residual:
+     *
+     *     sum_k w_k * (h_k(s) - discount * g_k(s,pi(s))) ~= R(s,pi(s))
+     *
+     * The projection can either be done in the least-squares sense, or in
+     * max-norm, by solving a small LP with one variable per basis function.
+     *
+     * Since it is not possible to enumerate the states of a large factored
+     * MDP, both the projection and the stopping criterion are computed
+     * over the input sample states. If all states are passed as samples,
+     * this class performs exact (projected) value or policy iteration.
+     *
+     * For each iteration, this class records its duration, the variation
+     * of the ValueFunction and the Bellman residual of the weights it
+     * started from, so that the convergence of the process can be
+     * inspected.
+     */
+    class ValueIteration {
+        public:
+            /**
+             * @brief The norm used to project values onto the basis functions.
+             */
+            enum class Projection { LeastSquares, MaxNorm };
+
+            /**
+             * @brief This struct contains the statistics of a single iteration.
+             */
+            struct IterationStats {
+                double residual;    ///< Max Bellman residual of the weights at the start of the iteration.
+                double variation;   ///< Max change in value of the samples during the iteration.
+                double seconds;     ///< Wall-clock time spent in the iteration.
+            };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * The horizon parameter is the maximum number of iterations
+             * performed. The tolerance parameter is the maximum variation
+             * between the values of the samples in two consecutive
+             * iterations under which the process stops. If the tolerance is
+             * zero, all iterations are always performed.
+             *
+             * @param horizon The maximum number of iterations to perform.
+             * @param tolerance The tolerance factor to stop the iterations.
+             * @param projection The norm used to project onto the basis functions.
+             * @param policyIteration Whether to perform policy iteration rather than value iteration.
+             */
+            ValueIteration(unsigned horizon, double tolerance = 0.001, Projection projection = Projection::LeastSquares, bool policyIteration = false);
+
+            /**
+             * @brief This function approximately solves the input MDP.
+             *
+             * @param m The MDP that needs to be solved.
+             * @param h The basis functions to use to approximate V*.
+             * @param samples The states over which to compute the projections.
+             *
+             * @return A tuple containing the maximum variation of the last iteration, the weights for the basis functions, and the equivalent QFunction.
+             */
+            std::tuple<double, Vector, QFunction> operator()(const CooperativeModel & m, const FactoredVector & h, const std::vector<State> & samples);
+
+            /**
+             * @brief This function sets the tolerance parameter.
+             *
+             * The tolerance parameter must be >= 0.0, otherwise the
+             * function will throw an std::invalid_argument.
+             *
+             * @param t The new tolerance parameter.
+             */
+            void setTolerance(double t);
+
+            /**
+             * @brief This function sets the horizon parameter.
+             *
+             * @param h The new horizon parameter.
+             */
+            void setHorizon(unsigned h);
+
+            /**
+             * @brief This function sets the norm used in the projections.
+             *
+             * @param p The new projection.
+             */
+            void setProjection(Projection p);
+
+            /**
+             * @brief This function sets whether to perform policy iteration rather than value iteration.
+             *
+             * @param p Whether to perform policy iteration.
+             */
+            void setPolicyIteration(bool p);
+
+            /**
+             * @brief This function returns the currently set tolerance parameter.
+             *
+             * @return The currently set tolerance parameter.
+             */
+            double getTolerance() const;
+
+            /**
+             * @brief This function returns the currently set horizon parameter.
+             *
+             * @return The currently set horizon parameter.
+             */
+            unsigned getHorizon() const;
+
+            /**
+             * @brief This function returns the currently set projection.
+             *
+             * @return The currently set projection.
+             */
+            Projection getProjection() const;
+
+            /**
+             * @brief This function returns whether policy iteration is performed.
+             *
+             * @return Whether policy iteration is performed.
+             */
+            bool getPolicyIteration() const;
+
+            /**
+             * @brief This function returns the statistics of the iterations of the last call.
+             *
+             * @return The statistics of each iteration, in order.
+             */
+            const std::vector<IterationStats> & getIterationStats() const;
+
+        private:
+            /**
+             * @brief This function projects the input values onto the columns of the input matrix.
+             *
+             * @param M A matrix with a row per sample and a column per basis function.
+             * @param b The values to approximate, one per sample.
+             *
+             * @return The weights of the projection.
+             */
+            Vector project(const Matrix2D & M, const Vector & b) const;
+
+            unsigned horizon_;
+            double tolerance_;
+            Projection projection_;
+            bool policyIteration_;
+
+            std::vector<IterationStats> stats_;
+    };
+}
+
+#endif
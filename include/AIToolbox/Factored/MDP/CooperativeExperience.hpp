@@ -69,6 +69,50 @@ namespace AIToolbox::Factored::MDP {
              */
             void reset();
 
+            /**
+             * @brief This function sets the internal visits table to the input.
+             *
+             * The input must have the same structure as the one returned by
+             * getVisitsTable(), including the last column of each table
+             * containing the sum of the visits of its row.
+             *
+             * This is important, as this function DOES NOT perform any size
+             * checks on the input.
+             *
+             * @param v The new visits table.
+             */
+            void setVisitsTable(const VisitsTable & v);
+
+            /**
+             * @brief This function sets the internal rewards matrix to the input.
+             *
+             * This is important, as this function DOES NOT perform any size
+             * checks on the input.
+             *
+             * @param r The new rewards matrix.
+             */
+            void setRewardMatrix(const RewardMatrix & r);
+
+            /**
+             * @brief This function sets the internal M2 matrix to the input.
+             *
+             * This is important, as this function DOES NOT perform any size
+             * checks on the input.
+             *
+             * @param mm The new M2 matrix.
+             */
+            void setM2Matrix(const RewardMatrix & mm);
+
+            /**
+             * @brief This function sets the number of recorded timesteps.
+             *
+             * This is useful when restoring a CooperativeExperience from its
+             * tables, as these do not contain the number of timesteps.
+             *
+             * @param t The number of timesteps.
+             */
+            void setTimesteps(unsigned long t);
+
             /**
              * @brief This function returns the number of times the record function has been called.
              *
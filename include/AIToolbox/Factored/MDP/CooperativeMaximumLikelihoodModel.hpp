@@ -3,6 +3,7 @@
 
 #include <AIToolbox/Factored/MDP/CooperativeExperience.hpp>
 #include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+#include <AIToolbox/Factored/Utils/DDNSampler.hpp>
 
 namespace AIToolbox::Factored::MDP {
     /**
@@ -123,6 +124,30 @@ namespace AIToolbox::Factored::MDP {
              */
             void sync(const CooperativeExperience::Indeces & indeces);
 
+            /**
+             * @brief This function incrementally syncs the last recorded transition.
+             *
+             * This function is equivalent to sync(const
+             * CooperativeExperience::Indeces &), but rather than recomputing
+             * each touched row from the visits table, it applies to it the
+             * single visit that CooperativeExperience::record() has just
+             * added. The row is scaled once and a single entry is
+             * incremented, without reading the counts back.
+             *
+             * This requires that all touched rows were in sync with the
+             * CooperativeExperience before the last record() call, and that
+             * only a single transition has been recorded since. This is the
+             * case when this function is called after every record().
+             *
+             * As the update is done in floating point, small rounding errors
+             * may accumulate over very long runs; a full sync() recomputes the
+             * exact values.
+             *
+             * @param indeces The indeces provided by the CooperativeExperience.
+             * @param s1 The new state passed to the last record() call.
+             */
+            void syncIncremental(const CooperativeExperience::Indeces & indeces, const State & s1);
+
             /**
              * @brief This function samples the MDP with the specified state action pair.
              *
@@ -196,6 +221,26 @@ namespace AIToolbox::Factored::MDP {
              */
             void sampleSRs(const State & s, const Action & a, State * s1, Rewards * rews) const;
 
+            /**
+             * @brief This function samples the MDP for a batch of independent state action pairs.
+             *
+             * This function is equivalent to calling sampleSR(const State &,
+             * const Action &, State *) for each input pair, but it is faster
+             * for large batches, as transitions are sampled via alias tables
+             * which are built once per row and then reused.
+             *
+             * Alias tables are rebuilt whenever a row is synced.
+             *
+             * The output vectors are resized to the batch size; reusing them
+             * between calls avoids allocations.
+             *
+             * @param s The states that need to be sampled.
+             * @param a The actions that need to be sampled, one per state.
+             * @param s1 The new states.
+             * @param rews The rewards for the sampled transitions.
+             */
+            void sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const;
+
             /**
              * @brief This function returns the stored transition probability for the specified transition.
              *
@@ -329,6 +374,7 @@ namespace AIToolbox::Factored::MDP {
             RewardMatrix rewards_;
 
             mutable RandomEngine rand_;
+            DDNSampler sampler_;
     };
 }
 
@@ -4,6 +4,7 @@
 #include <AIToolbox/Factored/MDP/Types.hpp>
 #include <AIToolbox/Factored/Utils/FactoredMatrix.hpp>
 #include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+#include <AIToolbox/Factored/Utils/DDNSampler.hpp>
 
 namespace AIToolbox::Factored::MDP {
     /**
@@ -125,6 +126,24 @@ namespace AIToolbox::Factored::MDP {
              */
             void sampleSRs(const State & s, const Action & a, State * s1, Rewards * rews) const;
 
+            /**
+             * @brief This function samples the MDP for a batch of independent state action pairs.
+             *
+             * This function is equivalent to calling sampleSR(const State &,
+             * const Action &, State *) for each input pair, but it is faster
+             * for large batches, as transitions are sampled via alias tables
+             * which are built once per row and then reused.
+             *
+             * The output vectors are resized to the batch size; reusing them
+             * between calls avoids allocations.
+             *
+             * @param s The states that need to be sampled.
+             * @param a The actions that need to be sampled, one per state.
+             * @param s1 The new states.
+             * @param rews The rewards for the sampled transitions.
+             */
+            void sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const;
+
             /**
              * @brief This function sets a new discount factor for the Model.
              *
@@ -204,6 +223,7 @@ namespace AIToolbox::Factored::MDP {
             FactoredMatrix2D rewards_;
 
             mutable RandomEngine rand_;
+            DDNSampler sampler_;
     };
 }
 
@@ -3,6 +3,7 @@
 
 #include <AIToolbox/Factored/MDP/CooperativeExperience.hpp>
 #include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+#include <AIToolbox/Factored/Utils/DDNSampler.hpp>
 
 namespace AIToolbox::Factored::MDP {
     /**
@@ -94,12 +95,19 @@ namespace AIToolbox::Factored::MDP {
              * After this function is run the transition and reward functions
              * will accurately reflect the state of the underlying
              * CooperativeExperience.
+             *
+             * This function always resamples all rows, regardless of the
+             * resampling schedule (see setResampleVisits()).
              */
             void sync();
 
             /**
              * @brief This function syncs a state-action pair to the underlying CooperativeExperience.
              *
+             * Each row touched by the pair is resampled only if the
+             * resampling schedule allows it (see setResampleVisits() and
+             * setResampleStaleness()).
+             *
              * @param s The state that needs to be synced.
              * @param a The action that needs to be synced.
              */
@@ -122,6 +130,55 @@ namespace AIToolbox::Factored::MDP {
              */
             void sync(const CooperativeExperience::Indeces & indeces);
 
+            /**
+             * @brief This function sets the number of new visits after which a row is resampled.
+             *
+             * Resampling a row requires sampling a Dirichlet distribution
+             * with as many parameters as the values of its feature, which
+             * is expensive when syncing after every step. Setting this
+             * parameter makes sync(const State &, const Action &) and
+             * sync(const CooperativeExperience::Indeces &) resample a row
+             * only once it has received at least this many visits since it
+             * was last sampled, or when it becomes too stale (see
+             * setResampleStaleness()). Rows which are not resampled keep
+             * their previous sample.
+             *
+             * A value of 0 (the default) resamples every touched row at
+             * every sync.
+             *
+             * @param visits The number of new visits needed to resample a row.
+             */
+            void setResampleVisits(unsigned long visits);
+
+            /**
+             * @brief This function returns the number of new visits after which a row is resampled.
+             *
+             * @return The number of new visits needed to resample a row.
+             */
+            unsigned long getResampleVisits() const;
+
+            /**
+             * @brief This function sets the number of timesteps after which a row is resampled.
+             *
+             * When lazy resampling is enabled via setResampleVisits(), a
+             * touched row is also resampled if at least this many timesteps
+             * of the underlying CooperativeExperience have passed since it
+             * was last sampled. This makes sure that rows which are rarely
+             * visited still see their new data eventually.
+             *
+             * A value of 0 (the default) disables this check.
+             *
+             * @param timesteps The number of timesteps after which a row is stale.
+             */
+            void setResampleStaleness(unsigned long timesteps);
+
+            /**
+             * @brief This function returns the number of timesteps after which a row is resampled.
+             *
+             * @return The number of timesteps after which a row is stale.
+             */
+            unsigned long getResampleStaleness() const;
+
             /**
              * @brief This function samples the MDP with the specified state action pair.
              *
@@ -195,6 +252,26 @@ namespace AIToolbox::Factored::MDP {
              */
             void sampleSRs(const State & s, const Action & a, State * s1, Rewards * rews) const;
 
+            /**
+             * @brief This function samples the MDP for a batch of independent state action pairs.
+             *
+             * This function is equivalent to calling sampleSR(const State &,
+             * const Action &, State *) for each input pair, but it is faster
+             * for large batches, as transitions are sampled via alias tables
+             * which are built once per row and then reused.
+             *
+             * Alias tables are rebuilt whenever a row is synced.
+             *
+             * The output vectors are resized to the batch size; reusing them
+             * between calls avoids allocations.
+             *
+             * @param s The states that need to be sampled.
+             * @param a The actions that need to be sampled, one per state.
+             * @param s1 The new states.
+             * @param rews The rewards for the sampled transitions.
+             */
+            void sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const;
+
             /**
              * @brief This function returns the stored transition probability for the specified transition.
              *
@@ -319,13 +396,26 @@ namespace AIToolbox::Factored::MDP {
              */
             void syncRow(size_t i, size_t j);
 
+            /**
+             * @brief This function syncs a single row of T and R if the resampling schedule allows it.
+             *
+             * @param i The feature to sync.
+             * @param j The row to sync.
+             */
+            void lazySyncRow(size_t i, size_t j);
+
             const CooperativeExperience & experience_;
             double discount_;
+            unsigned long resampleVisits_, resampleStaleness_;
 
             TransitionMatrix transitions_;
             RewardMatrix rewards_;
 
+            // Visits and timestep at the last sample of each row.
+            std::vector<std::vector<unsigned long>> sampledVisits_, sampledTimesteps_;
+
             mutable RandomEngine rand_;
+            DDNSampler sampler_;
     };
 }
 
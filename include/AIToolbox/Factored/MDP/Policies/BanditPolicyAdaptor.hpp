@@ -35,6 +35,16 @@ namespace AIToolbox::Factored::MDP {
              */
             virtual Action sampleAction(const State & s) const override;
 
+            /**
+             * @brief This function chooses a random action using the underlying bandit policy and the input generator.
+             *
+             * @param s The unused sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(const State & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -74,6 +84,11 @@ namespace AIToolbox::Factored::MDP {
         return policy_.sampleAction();
     }
 
+    template <typename BP>
+    Action BanditPolicyAdaptor<BP>::sampleAction(const State &, RandomEngine & rnd) const {
+        return policy_.sampleAction(rnd);
+    }
+
     template <typename BP>
     double BanditPolicyAdaptor<BP>::getActionProbability(const State &, const Action & a) const {
         return policy_.getActionProbability(a);
@@ -30,9 +30,11 @@ namespace AIToolbox::Factored::MDP {
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual Action sampleRandomAction() const;
+            virtual Action sampleRandomAction(RandomEngine & rnd) const;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -40,9 +42,6 @@ namespace AIToolbox::Factored::MDP {
              * @return The probability of picking an an action at random.
              */
             virtual double getRandomActionProbability() const;
-
-            // Used to sampled random actions
-            mutable std::vector<std::uniform_int_distribution<size_t>> randomDistribution_;
     };
 }
 
@@ -55,6 +55,24 @@ namespace AIToolbox::Factored::MDP {
              */
             virtual Action sampleAction(const State & s) const override;
 
+            /**
+             * @brief This function chooses the greediest action for state s, using the input generator.
+             *
+             * This function works on copies of the internal graph and
+             * maximizer, so it can be called concurrently from multiple
+             * threads. Note that the copies are made at each call.
+             *
+             * The default VariableElimination maximizer is deterministic,
+             * so the generator is not used; maximizers with their own
+             * randomness (e.g. LocalSearch) are reseeded from it.
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(const State & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -116,6 +134,22 @@ namespace AIToolbox::Factored::MDP {
         return std::get<0>(max_(A, graph_));
     }
 
+    template <typename Maximizer>
+    Action QGreedyPolicy<Maximizer>::sampleAction(const State & s, RandomEngine & rnd) const {
+        Maximizer max(max_);
+        // Maximizers with their own randomness draw it from the input
+        // generator, so that each caller gets independent results.
+        if constexpr (requires { max.seed(rnd()); })
+            max.seed(rnd());
+        auto graph = graph_;
+        if (qc_) {
+            UpdateGraph<Maximizer>()(graph, qc_->filter(s), S, A, s);
+        } else {
+            UpdateGraph<Maximizer>()(graph, *qm_, S, A, s);
+        }
+        return std::get<0>(max(A, graph));
+    }
+
     template <typename Maximizer>
     double QGreedyPolicy<Maximizer>::getActionProbability(const State & s, const Action & a) const {
         if (veccmp(a, sampleAction(s)) == 0) return 1.0;
@@ -0,0 +1,245 @@
+#ifndef AI_TOOLBOX_FACTORED_MDP_STREAMING_COOPERATIVE_EXPERIENCE_HEADER_FILE
+#define AI_TOOLBOX_FACTORED_MDP_STREAMING_COOPERATIVE_EXPERIENCE_HEADER_FILE
+
+#include <AIToolbox/Factored/MDP/Types.hpp>
+#include <AIToolbox/Factored/MDP/CooperativeExperience.hpp>
+#include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+
+namespace AIToolbox::Factored::MDP {
+    /**
+     * @brief This class keeps recency-weighted statistics of registered events and rewards.
+     *
+     * This class records the same statistics as CooperativeExperience (visits,
+     * average rewards and M2 of the rewards), but is meant for non-stationary
+     * streams of data, where old experience should progressively stop
+     * counting. Two forms of forgetting are supported:
+     *
+     * - Exponential decay: every time a new event is recorded, the weight of
+     *   all previous events is multiplied by the decay factor. Thus the
+     *   visits are not integers anymore, but represent the effective number
+     *   of samples seen.
+     * - Windowed decay: the statistics are kept in two blocks of `window`
+     *   timesteps each. When the newest block is full, the oldest is
+     *   discarded. Thus the statistics always contain between the last
+     *   `window` and `2 * window` events.
+     *
+     * In both cases the work done per event and the memory used do not
+     * depend on how many events have been recorded. Exponential decay is
+     * implemented by increasing the weight of new events rather than
+     * decreasing the old ones, and rescaling all tables only when weights
+     * grow too large.
+     *
+     * Rewards and M2 statistics are updated with the weighted version of
+     * Welford's algorithm, so that they can be merged in constant time
+     * using the parallel algorithm by Chan et al. This allows to record
+     * experience from multiple threads, by giving each thread its own
+     * instance (a shard), and merging them all into one with merge() when
+     * the data is needed.
+     *
+     * Models cannot read from this class directly. Instead, the statistics
+     * are copied into a CooperativeExperience with exportTo(), after which
+     * the models using it can be synced normally. See exportTo() for how
+     * the fractional effective visits are converted to integers.
+     *
+     * MDP::StreamingExperience is the tabular counterpart of this class.
+     */
+    class StreamingCooperativeExperience {
+        public:
+            using Indeces = CooperativeExperience::Indeces;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * The decay must be in (0, 1]. A decay of 1 does not forget
+             * anything. A window of 0 means no window.
+             *
+             * Exponential and windowed decay cannot be used together: if the
+             * window is not zero, the decay must be 1, otherwise the function
+             * will throw an std::invalid_argument.
+             *
+             * @param graph The coordination graph of the cooperative problem.
+             * @param decay The exponential decay to apply to old events.
+             * @param window The number of timesteps in each block of the window.
+             */
+            StreamingCooperativeExperience(const DDNGraph & graph, double decay = 1.0, unsigned long window = 0);
+
+            /**
+             * @brief This function adds a new event to the recordings.
+             *
+             * @param s     Old state.
+             * @param a     Performed action.
+             * @param s1    New state.
+             * @param rew   Obtained rewards.
+             *
+             * @return The indeces of s and a updated in the DDN.
+             */
+            const Indeces & record(const State & s, const Action & a, const State & s1, const Rewards & rew);
+
+            /**
+             * @brief This function merges the statistics of another instance into this one.
+             *
+             * The two instances must use the same DDNGraph, decay and window,
+             * otherwise this function will throw an std::invalid_argument.
+             *
+             * With exponential decay, both instances are assumed to have
+             * been recording during the same period, so that their last
+             * events have the same weight. With windowed decay, blocks are
+             * merged with the corresponding blocks of the other instance.
+             *
+             * @param other The instance to merge into this one.
+             */
+            void merge(const StreamingCooperativeExperience & other);
+
+            /**
+             * @brief This function copies the current statistics into a CooperativeExperience.
+             *
+             * The effective visits are rounded to the nearest integer; the
+             * sum of each row is the sum of its rounded visits. With
+             * exponential decay the effective visits of a row can drop
+             * below 0.5: so that such a row is not exported as never
+             * visited, its most visited transition is exported with one
+             * visit. Single transitions with effective visits below 0.5 are
+             * still exported as unvisited.
+             *
+             * The M2 statistics are scaled by the same factor as the visits
+             * of their row, so that the variance of the rewards is
+             * preserved.
+             *
+             * The CooperativeExperience must have been built with the same
+             * DDNGraph as this instance.
+             *
+             * @param exp The CooperativeExperience to overwrite.
+             */
+            void exportTo(CooperativeExperience * exp) const;
+
+            /**
+             * @brief This function resets all experienced rewards and transitions.
+             */
+            void reset();
+
+            /**
+             * @brief This function returns the effective number of visits of a transition.
+             *
+             * If s1 is equal to the number of values of feature i, this
+             * function returns the effective number of visits of the whole
+             * row.
+             *
+             * @param i The feature.
+             * @param j The row of the feature (as given by DDNGraph::getId).
+             * @param s1 The new value of the feature.
+             *
+             * @return The effective number of visits.
+             */
+            double getVisits(size_t i, size_t j, size_t s1) const;
+
+            /**
+             * @brief This function returns the weighted average reward of a row.
+             *
+             * @param i The feature.
+             * @param j The row of the feature (as given by DDNGraph::getId).
+             *
+             * @return The weighted average reward.
+             */
+            double getReward(size_t i, size_t j) const;
+
+            /**
+             * @brief This function returns the weighted M2 statistic of the rewards of a row.
+             *
+             * @param i The feature.
+             * @param j The row of the feature (as given by DDNGraph::getId).
+             *
+             * @return The weighted M2 statistic.
+             */
+            double getM2(size_t i, size_t j) const;
+
+            /**
+             * @brief This function returns the number of times the record function has been called.
+             *
+             * This includes the timesteps recorded by merged instances.
+             *
+             * @return The number of recorded timesteps.
+             */
+            unsigned long getTimesteps() const;
+
+            /**
+             * @brief This function returns the exponential decay.
+             *
+             * @return The exponential decay.
+             */
+            double getDecay() const;
+
+            /**
+             * @brief This function returns the number of timesteps in each block of the window.
+             *
+             * @return The window size, or 0 if there is no window.
+             */
+            unsigned long getWindow() const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            const State & getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            const Action & getA() const;
+
+            /**
+             * @brief This function returns the underlying DDNGraph of the StreamingCooperativeExperience.
+             *
+             * @return The underlying DDNGraph.
+             */
+            const DDNGraph & getGraph() const;
+
+        private:
+            // The statistics of a block of timesteps. The visits tables have
+            // the same layout as the CooperativeExperience ones. With
+            // exponential decay all visits and M2 values are scaled by the
+            // same factor, which is the weight of the last recorded event.
+            struct Block {
+                std::vector<Matrix2D> visits;
+                CooperativeExperience::RewardMatrix rewards;
+                CooperativeExperience::RewardMatrix M2s;
+            };
+
+            /**
+             * @brief This function computes the combined statistics of a row across blocks.
+             */
+            void getRow(size_t i, size_t j, double * n, double * mean, double * m2) const;
+
+            /**
+             * @brief This function merges the statistics of a block into another.
+             *
+             * The visits and M2 values of the input block are multiplied by
+             * the input scale before being merged.
+             */
+            static void mergeBlock(Block & lhs, const Block & rhs, double scale);
+
+            /**
+             * @brief This function divides all weights by the current increment.
+             */
+            void rescale();
+
+            /**
+             * @brief This function zeroes all statistics of a block.
+             */
+            void zero(Block & b) const;
+
+            const DDNGraph & graph_;
+            double decay_;
+            unsigned long window_;
+
+            Block current_, previous_;
+            double increment_;
+
+            unsigned long timesteps_, blockTimesteps_;
+            Indeces indeces_;
+    };
+}
+
+#endif
@@ -82,7 +82,8 @@ namespace AIToolbox::Factored {
              *
              * This method will sanity check all sets of parents, both agents
              * and state features. Additionally, it will pre-compute the size
-             * of each set to speed up the computation of ids.
+             * of each set and the strides of each parent to speed up the
+             * computation of ids.
              *
              * @param parents The ParentSet to insert.
              */
@@ -259,6 +260,13 @@ namespace AIToolbox::Factored {
             Action A;
             std::vector<ParentSet> parents_;
             std::vector<std::vector<size_t>> startIds_;
+
+            // For each feature, the (agent, multiplier) pairs to compute the
+            // action id, and for each action id the (feature, multiplier)
+            // pairs to compute the parent id from full states and actions.
+            using Strides = std::vector<std::pair<size_t, size_t>>;
+            std::vector<Strides> agentStrides_;
+            std::vector<std::vector<Strides>> featureStrides_;
     };
 
     using DDNGraph = DynamicDecisionNetworkGraph;
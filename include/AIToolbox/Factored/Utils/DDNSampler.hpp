@@ -0,0 +1,121 @@
+#ifndef AI_TOOLBOX_FACTORED_UTILS_DDN_SAMPLER_HEADER_FILE
+#define AI_TOOLBOX_FACTORED_UTILS_DDN_SAMPLER_HEADER_FILE
+
+#include <AIToolbox/Factored/Types.hpp>
+#include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+
+namespace AIToolbox::Factored {
+    /**
+     * @brief This class samples next states from a DDN in constant time per feature.
+     *
+     * Sampling a feature with sampleProbability is linear in the size of
+     * the feature. This class instead builds an alias table (see
+     * buildAliasTable()) for each row of the DDN, so that samples from it
+     * are constant time.
+     *
+     * The tables of each feature are stored contiguously, with the weight
+     * and alias of each entry next to each other, and each sample uses a
+     * single draw from the random engine.
+     *
+     * This is useful when the same model is sampled many times, for example
+     * to advance many independent rollouts at once.
+     *
+     * The class does not store the DDN itself, so that it can be freely
+     * copied together with the model that owns it. It must always be used
+     * with the same DDN, and whenever a row of the DDN changes the
+     * update(const DDN &, size_t, size_t) method must be called.
+     *
+     * The tables are only modified by the update methods, so that sampling
+     * can be done concurrently from multiple threads (as long as each uses
+     * its own generator).
+     */
+    class DDNSampler {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor only allocates the tables; they must be
+             * built with update(const DDN &) before sampling.
+             *
+             * @param graph The graph of the DDN to sample from.
+             */
+            DDNSampler(const DDNGraph & graph);
+
+            /**
+             * @brief This constructor builds the alias tables of all rows of the input DDN.
+             *
+             * @param ddn The DDN to sample from.
+             */
+            DDNSampler(const DDN & ddn);
+
+            /**
+             * @brief This function samples a single feature from a row of the DDN.
+             *
+             * @param ddn The DDN to sample from.
+             * @param i The feature to sample.
+             * @param j The row of the feature (as given by DDNGraph::getId).
+             * @param rnd The random engine to sample with.
+             *
+             * @return The sampled value of the feature.
+             */
+            size_t sample(const DDN & ddn, size_t i, size_t j, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function samples a new state for each input state-action pair.
+             *
+             * The output vector is resized to the batch size; reusing it
+             * between calls avoids allocations.
+             *
+             * @param ddn The DDN to sample from.
+             * @param s The states to sample from.
+             * @param a The actions to sample from, one per state.
+             * @param s1 The output new states.
+             * @param rnd The random engine to sample with.
+             */
+            void sample(const DDN & ddn, const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function rebuilds the alias table of a row.
+             *
+             * @param ddn The DDN to sample from.
+             * @param i The feature of the row.
+             * @param j The row.
+             */
+            void update(const DDN & ddn, size_t i, size_t j);
+
+            /**
+             * @brief This function rebuilds all alias tables.
+             *
+             * @param ddn The DDN to sample from.
+             */
+            void update(const DDN & ddn);
+
+        private:
+            struct Coin {
+                double prob;
+                size_t alias;
+            };
+            struct Tables {
+                size_t size;
+                double scale;
+                std::vector<Coin> coins;
+            };
+
+            std::vector<Tables> tables_;
+    };
+
+    inline size_t DDNSampler::sample(const DDN &, const size_t i, const size_t j, RandomEngine & rnd) const {
+        const auto & t = tables_[i];
+        const auto row = t.coins.data() + j * t.size;
+
+        // A single 32 bit draw is enough precision for both the coin to
+        // pick and its weight.
+        const double x = rnd() * t.scale;
+        const size_t c = x;
+
+        if (x - c < row[c].prob) return c;
+        return row[c].alias;
+    }
+}
+
+#endif
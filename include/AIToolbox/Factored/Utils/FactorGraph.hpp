@@ -255,7 +255,9 @@ namespace AIToolbox::Factored {
 
         private:
             FactorList factorAdjacencies_;
-            static FactorList factorAdjacenciesPool_;
+            // Pool of unused nodes, shared between the graphs of a thread
+            // so that graphs can be used concurrently from different ones.
+            static thread_local FactorList factorAdjacenciesPool_;
 
             auto findFactorByVariables(const FactorItList & list, const Variables & variables) const {
                 return std::find_if(
@@ -276,7 +278,7 @@ namespace AIToolbox::Factored {
     };
 
     template <typename FD>
-    typename FactorGraph<FD>::FactorList FactorGraph<FD>::factorAdjacenciesPool_;
+    thread_local typename FactorGraph<FD>::FactorList FactorGraph<FD>::factorAdjacenciesPool_;
 
     template <typename FD>
     FactorGraph<FD>::FactorGraph(const size_t variables) : variableAdjacencies_(variables), activeVariables_(variables) {}
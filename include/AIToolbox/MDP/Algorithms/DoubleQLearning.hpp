@@ -42,8 +42,11 @@ namespace AIToolbox::MDP {
      * If you are interested in the actual values stored in the two "main"
      * QFunctions, please use getQFunctionA() and getQFunctionB(). Note that
      * getQFunctionB() will not return a reference!
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class DoubleQLearning {
+    template <typename T>
+    class DoubleQLearningT {
         public:
             /**
              * @brief Basic constructor.
@@ -56,7 +59,7 @@ namespace AIToolbox::MDP {
              * @param discount The discount to use when learning.
              * @param alpha The learning rate of the DoubleQLearning method.
              */
-            DoubleQLearning(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
+            DoubleQLearningT(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
 
             /**
              * @brief Basic constructor.
@@ -73,7 +76,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate of the DoubleQLearning method.
              */
             template <IsGenerativeModel M>
-            DoubleQLearning(const M& model, double alpha = 0.1);
+            DoubleQLearningT(const M& model, double alpha = 0.1);
 
             /**
              * @brief This function sets the learning rate parameter.
@@ -169,7 +172,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal "sum" QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
             /**
              * @brief This function returns a reference to the first internal QFunction.
@@ -180,7 +183,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal first QFunction.
              */
-            const QFunction & getQFunctionA() const;
+            const QFunctionT<T> & getQFunctionA() const;
 
             /**
              * @brief This function returns a copy to the second QFunction.
@@ -189,7 +192,7 @@ namespace AIToolbox::MDP {
              *
              * @return What the second QFunction should be.
              */
-            QFunction getQFunctionB() const;
+            QFunctionT<T> getQFunctionB() const;
 
             /**
              * @brief This function allows to directly set the internal QFunctions.
@@ -205,7 +208,7 @@ namespace AIToolbox::MDP {
              *
              * @param qfun The new QFunction to set.
              */
-            void setQFunction(const QFunction & qfun);
+            void setQFunction(const QFunctionT<T> & qfun);
 
         private:
             size_t S, A;
@@ -216,12 +219,18 @@ namespace AIToolbox::MDP {
             std::bernoulli_distribution dist_;
 
             // First QFunction and "sum" QFunction
-            QFunction qa_, qc_;
+            QFunctionT<T> qa_, qc_;
     };
 
+    /**
+     * @brief This is the double precision DoubleQLearning.
+     */
+    using DoubleQLearning = DoubleQLearningT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    DoubleQLearning::DoubleQLearning(const M& model, const double alpha) :
-            DoubleQLearning(model.getS(), model.getA(), model.getDiscount(), alpha) {}
+    DoubleQLearningT<T>::DoubleQLearningT(const M& model, const double alpha) :
+            DoubleQLearningT(model.getS(), model.getA(), model.getDiscount(), alpha) {}
 }
 
 #endif
@@ -33,8 +33,11 @@ namespace AIToolbox::MDP {
      * in turn allows to somewhat increase the learning rate for the method,
      * which allows Expected SARSA to learn faster than simple SARSA. All
      * guarantees of normal SARSA are maintained.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class ExpectedSARSA {
+    template <typename T>
+    class ExpectedSARSAT {
         public:
             /**
              * @brief Basic constructor.
@@ -58,7 +61,7 @@ namespace AIToolbox::MDP {
              * @param discount The discount of the underlying MDP model.
              * @param alpha The learning rate of the ExpectedSARSA method.
              */
-            ExpectedSARSA(QFunction & qfun, const PolicyInterface & policy, double discount = 0.0, double alpha = 0.1);
+            ExpectedSARSAT(QFunctionT<T> & qfun, const PolicyInterface & policy, double discount = 0.0, double alpha = 0.1);
 
             /**
              * @brief Basic constructor.
@@ -87,7 +90,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate of the ExpectedSARSA method.
              */
             template <IsGenerativeModel M>
-            ExpectedSARSA(QFunction & qfun, const PolicyInterface & policy, const M& model, double alpha = 0.1);
+            ExpectedSARSAT(QFunctionT<T> & qfun, const PolicyInterface & policy, const M& model, double alpha = 0.1);
 
             /**
              * @brief This function sets the learning rate parameter.
@@ -183,7 +186,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
             /**
              * @brief This function returns a reference to the policy used by ExpectedSARSA.
@@ -198,11 +201,17 @@ namespace AIToolbox::MDP {
             double alpha_;
             double discount_;
 
-            QFunction & q_;
+            QFunctionT<T> & q_;
     };
 
+    /**
+     * @brief This is the double precision ExpectedSARSA.
+     */
+    using ExpectedSARSA = ExpectedSARSAT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    ExpectedSARSA::ExpectedSARSA(QFunction & qfun, const PolicyInterface & policy, const M& model, const double alpha) :
-            ExpectedSARSA(qfun, policy, model.getDiscount(), alpha) {}
+    ExpectedSARSAT<T>::ExpectedSARSAT(QFunctionT<T> & qfun, const PolicyInterface & policy, const M& model, const double alpha) :
+            ExpectedSARSAT(qfun, policy, model.getDiscount(), alpha) {}
 }
 #endif
@@ -44,8 +44,11 @@ namespace AIToolbox::MDP {
      * If the beta parameter is equal to the alpha, this becomes standard
      * QLearning. When the beta parameter is zero, the algorithm becomes
      * equivalent to Distributed QLearning.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class HystereticQLearning {
+    template <typename T>
+    class HystereticQLearningT {
         public:
             /**
              * @brief Basic constructor.
@@ -65,7 +68,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate for positive updates.
              * @param beta The learning rate for negative updates.
              */
-            HystereticQLearning(size_t S, size_t A, double discount = 1.0, double alpha = 0.1, double beta = 0.01);
+            HystereticQLearningT(size_t S, size_t A, double discount = 1.0, double alpha = 0.1, double beta = 0.01);
 
             /**
              * @brief Basic constructor.
@@ -89,7 +92,7 @@ namespace AIToolbox::MDP {
              * @param beta The learning rate for negative updates.
              */
             template <IsGenerativeModel M>
-            HystereticQLearning(const M& model, double alpha = 0.1, double beta = 0.01);
+            HystereticQLearningT(const M& model, double alpha = 0.1, double beta = 0.01);
 
             /**
              * @brief This function sets the learning rate parameter for positive updates.
@@ -192,19 +195,25 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
         private:
             size_t S, A;
             double alpha_, beta_;
             double discount_;
 
-            QFunction q_;
+            QFunctionT<T> q_;
     };
 
+    /**
+     * @brief This is the double precision HystereticQLearning.
+     */
+    using HystereticQLearning = HystereticQLearningT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    HystereticQLearning::HystereticQLearning(const M& model, const double alpha, const double beta) :
-            HystereticQLearning(model.getS(), model.getA(), model.getDiscount(), alpha, beta) {}
+    HystereticQLearningT<T>::HystereticQLearningT(const M& model, const double alpha, const double beta) :
+            HystereticQLearningT(model.getS(), model.getA(), model.getDiscount(), alpha, beta) {}
 
 }
 #endif
@@ -98,10 +98,7 @@ namespace AIToolbox::MDP {
 
         // We have the values, but we also want the optimal actions. So while
         // we're at it, we also build Q.
-        const auto & ir = [&]{
-            if constexpr (IsModelEigen<M>) return model.getRewardFunction();
-            else return computeImmediateRewards(model);
-        }();
+        const auto ir = computeImmediateRewards(model);
 
         auto q = computeQFunction(model, model.getDiscount() * (*values), ir);
 
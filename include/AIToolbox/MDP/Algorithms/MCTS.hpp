@@ -4,10 +4,11 @@
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/Utils/FlatMap.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/MDP/Algorithms/Utils/Rollout.hpp>
 
-#include <unordered_map>
 
 namespace AIToolbox::MDP {
     /**
@@ -52,7 +53,7 @@ namespace AIToolbox::MDP {
 
         public:
             struct StateNode;
-            using StateNodes = std::unordered_map<size_t, StateNode>;
+            using StateNodes = FlatMap<size_t, StateNode>;
 
             struct ActionNode {
                 StateNodes children;
@@ -153,12 +154,26 @@ namespace AIToolbox::MDP {
              */
             double getExploration() const;
 
+            /**
+             * @brief This function returns the statistics of the last call to sampleAction().
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of simulations run, the
+             * number of tree nodes created, and the time spent, from which
+             * the simulations per second can be computed.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             const M& model_;
             unsigned iterations_, maxDepth_;
             double exploration_;
 
             StateNode graph_;
+            SolverStatistics stats_;
+            bool recording_;
 
             mutable RandomEngine rand_;
 
@@ -178,7 +193,7 @@ namespace AIToolbox::MDP {
     requires AIToolbox::IsGenerativeModel<M> && HasIntegralActionSpace<M>
     MCTS<M, StateHash>::MCTS(const M& m, const unsigned iter, const double exp) :
             model_(m), iterations_(iter),
-            exploration_(exp), graph_(), rand_(Seeder::getSeed()) {}
+            exploration_(exp), graph_(), recording_(false), rand_(Seeder::getSeed()) {}
 
     template <typename M, template <typename> class StateHash>
     requires AIToolbox::IsGenerativeModel<M> && HasIntegralActionSpace<M>
@@ -222,12 +237,16 @@ namespace AIToolbox::MDP {
     template <typename M, template <typename> class StateHash>
     requires AIToolbox::IsGenerativeModel<M> && HasIntegralActionSpace<M>
     size_t MCTS<M, StateHash>::runSimulation(const State & s, const unsigned horizon) {
+        SolverStatisticsRecorder record(stats_);
+        recording_ = static_cast<bool>(record);
+
         if ( !horizon ) return 0;
 
         maxDepth_ = horizon;
 
         for (unsigned i = 0; i < iterations_; ++i )
             simulate(graph_, s, 0);
+        if ( recording_ ) stats_.simulations = iterations_;
 
         auto begin = std::begin(graph_.children);
         return std::distance(begin, findBestA(begin, std::end(graph_.children)));
@@ -268,6 +287,7 @@ namespace AIToolbox::MDP {
             if ( it == std::end(aNode.children) ) {
                 // Touch node to create it
                 aNode.children[s1Key];
+                if ( recording_ ) ++stats_.treeNodes;
                 futureRew = rollout(model_, s1, maxDepth_ - depth + 1, rand_);
             }
             else {
@@ -368,6 +388,12 @@ namespace AIToolbox::MDP {
     double MCTS<M, StateHash>::getExploration() const {
         return exploration_;
     }
+
+    template <typename M, template <typename> class StateHash>
+    requires AIToolbox::IsGenerativeModel<M> && HasIntegralActionSpace<M>
+    const SolverStatistics & MCTS<M, StateHash>::getStatistics() const {
+        return stats_;
+    }
 }
 
 #endif
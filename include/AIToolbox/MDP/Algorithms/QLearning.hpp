@@ -40,8 +40,11 @@ namespace AIToolbox::MDP {
      * behavior aside from actually trying out actions. However it is
      * needed to know the size of the state space, the size of the action
      * space and the discount factor of the problem.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class QLearning {
+    template <typename T>
+    class QLearningT {
         public:
             /**
              * @brief Basic constructor.
@@ -54,7 +57,7 @@ namespace AIToolbox::MDP {
              * @param discount The discount to use when learning.
              * @param alpha The learning rate of the QLearning method.
              */
-            QLearning(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
+            QLearningT(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
 
             /**
              * @brief Basic constructor.
@@ -71,7 +74,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate of the QLearning method.
              */
             template <IsGenerativeModel M>
-            QLearning(const M& model, double alpha = 0.1);
+            QLearningT(const M& model, double alpha = 0.1);
 
             /**
              * @brief This function sets the learning rate parameter.
@@ -160,7 +163,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
             /**
              * @brief This function allows to directly set the internal QFunction.
@@ -173,18 +176,24 @@ namespace AIToolbox::MDP {
              *
              * @param qfun The new QFunction to set.
              */
-            void setQFunction(const QFunction & qfun);
+            void setQFunction(const QFunctionT<T> & qfun);
 
         private:
             size_t S, A;
             double alpha_;
             double discount_;
 
-            QFunction q_;
+            QFunctionT<T> q_;
     };
 
+    /**
+     * @brief This is the double precision QLearning.
+     */
+    using QLearning = QLearningT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    QLearning::QLearning(const M& model, const double alpha) :
-            QLearning(model.getS(), model.getA(), model.getDiscount(), alpha) {}
+    QLearningT<T>::QLearningT(const M& model, const double alpha) :
+            QLearningT(model.getS(), model.getA(), model.getDiscount(), alpha) {}
 }
 #endif
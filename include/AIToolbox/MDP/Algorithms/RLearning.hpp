@@ -44,8 +44,11 @@ namespace AIToolbox::MDP {
      * behavior aside from actually trying out actions. However it is
      * needed to know the size of the state space, the size of the action
      * space and the discount factor of the problem.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class RLearning {
+    template <typename T>
+    class RLearningT {
         public:
             /**
              * @brief Basic constructor.
@@ -58,7 +61,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate for the QFunction.
              * @param rho The learning rate for the average reward.
              */
-            RLearning(size_t S, size_t A, double alpha = 0.1, double rho = 0.1);
+            RLearningT(size_t S, size_t A, double alpha = 0.1, double rho = 0.1);
 
             /**
              * @brief Basic constructor.
@@ -76,7 +79,7 @@ namespace AIToolbox::MDP {
              * @param rho The learning rate for the average reward.
              */
             template <IsGenerativeModel M>
-            RLearning(const M& model, double alpha = 0.1, double rho = 0.1);
+            RLearningT(const M& model, double alpha = 0.1, double rho = 0.1);
 
             /**
              * @brief This function sets the learning rate parameter for the QFunction.
@@ -166,7 +169,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
             /**
              * @brief This function returns the learned average reward.
@@ -186,18 +189,24 @@ namespace AIToolbox::MDP {
              *
              * @param qfun The new QFunction to set.
              */
-            void setQFunction(const QFunction & qfun);
+            void setQFunction(const QFunctionT<T> & qfun);
 
         private:
             size_t S, A;
             double alpha_, rho_;
             double rAvg_;
 
-            QFunction q_;
+            QFunctionT<T> q_;
     };
 
+    /**
+     * @brief This is the double precision RLearning.
+     */
+    using RLearning = RLearningT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    RLearning::RLearning(const M& model, const double alpha, const double rho) :
-            RLearning(model.getS(), model.getA(), alpha, rho) {}
+    RLearningT<T>::RLearningT(const M& model, const double alpha, const double rho) :
+            RLearningT(model.getS(), model.getA(), alpha, rho) {}
 }
 #endif
@@ -44,8 +44,11 @@ namespace AIToolbox::MDP {
      * behavior aside from actually trying out actions. However it is
      * needed to know the size of the state space, the size of the action
      * space and the discount factor of the problem.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class SARSA {
+    template <typename T>
+    class SARSAT {
         public:
             /**
              * @brief Basic constructor.
@@ -58,7 +61,7 @@ namespace AIToolbox::MDP {
              * @param discount The discount of the underlying model.
              * @param alpha The learning rate of the SARSA method.
              */
-            SARSA(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
+            SARSAT(size_t S, size_t A, double discount = 1.0, double alpha = 0.1);
 
             /**
              * @brief Basic constructor.
@@ -75,7 +78,7 @@ namespace AIToolbox::MDP {
              * @param alpha The learning rate of the SARSA method.
              */
             template <IsGenerativeModel M>
-            SARSA(const M& model, double alpha = 0.1);
+            SARSAT(const M& model, double alpha = 0.1);
 
             /**
              * @brief This function sets the learning rate parameter.
@@ -170,18 +173,24 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
         private:
             size_t S, A;
             double alpha_;
             double discount_;
 
-            QFunction q_;
+            QFunctionT<T> q_;
     };
 
+    /**
+     * @brief This is the double precision SARSA.
+     */
+    using SARSA = SARSAT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    SARSA::SARSA(const M& model, const double alpha) :
-            SARSA(model.getS(), model.getA(), model.getDiscount(), alpha) {}
+    SARSAT<T>::SARSAT(const M& model, const double alpha) :
+            SARSAT(model.getS(), model.getA(), model.getDiscount(), alpha) {}
 }
 #endif
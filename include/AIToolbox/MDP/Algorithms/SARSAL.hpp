@@ -33,8 +33,11 @@ namespace AIToolbox::MDP {
      * time an action/state pair is witnessed, its eligibility trace is reset
      * to 1.0. This avoids potentially diverging values which can happen with
      * the normal eligibility traces.
+     *
+     * @tparam T The scalar type used to store the QFunction.
      */
-    class SARSAL {
+    template <typename T>
+    class SARSALT {
         public:
             using Trace = std::tuple<size_t, size_t, double>;
             using Traces = std::vector<Trace>;
@@ -51,7 +54,7 @@ namespace AIToolbox::MDP {
              * @param lambda The lambda parameter for the eligibility traces.
              * @param tolerance The cutoff point for eligibility traces.
              */
-            SARSAL(size_t S, size_t A, double discount = 1.0, double alpha = 0.1, double lambda = 0.9, double tolerance = 0.001);
+            SARSALT(size_t S, size_t A, double discount = 1.0, double alpha = 0.1, double lambda = 0.9, double tolerance = 0.001);
 
             /**
              * @brief Basic constructor.
@@ -70,7 +73,7 @@ namespace AIToolbox::MDP {
              * @param tolerance The cutoff point for eligibility traces.
              */
             template <IsGenerativeModel M>
-            SARSAL(const M& model, double alpha = 0.1, double lambda = 0.9, double tolerance = 0.001);
+            SARSALT(const M& model, double alpha = 0.1, double lambda = 0.9, double tolerance = 0.001);
 
             /**
              * @brief This function updates the internal QFunction using the discount set during construction.
@@ -234,7 +237,7 @@ namespace AIToolbox::MDP {
              *
              * @return The internal QFunction.
              */
-            const QFunction & getQFunction() const;
+            const QFunctionT<T> & getQFunction() const;
 
             /**
              * @brief This function allows to directly set the internal QFunction.
@@ -247,7 +250,7 @@ namespace AIToolbox::MDP {
              *
              * @param qfun The new QFunction to set.
              */
-            void setQFunction(const QFunction & qfun);
+            void setQFunction(const QFunctionT<T> & qfun);
 
         private:
             size_t S, A;
@@ -257,12 +260,18 @@ namespace AIToolbox::MDP {
             // This is used to avoid multiplying the discount and lambda all the time.
             double gammaL_;
 
-            QFunction q_;
+            QFunctionT<T> q_;
             Traces traces_;
     };
 
+    /**
+     * @brief This is the double precision SARSAL.
+     */
+    using SARSAL = SARSALT<double>;
+
+    template <typename T>
     template <IsGenerativeModel M>
-    SARSAL::SARSAL(const M& model, const double alpha, const double lambda, const double tolerance) :
-            SARSAL(model.getS(), model.getA(), model.getDiscount(), alpha, lambda, tolerance) {}
+    SARSALT<T>::SARSALT(const M& model, const double alpha, const double lambda, const double tolerance) :
+            SARSALT(model.getS(), model.getA(), model.getDiscount(), alpha, lambda, tolerance) {}
 }
 #endif
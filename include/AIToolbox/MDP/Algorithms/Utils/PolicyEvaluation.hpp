@@ -181,7 +181,7 @@ namespace AIToolbox::MDP {
             // We use the implicit reward function if it is available,
             // otherwise we use the one we computed beforehand.
             if constexpr(IsModelEigen<M>)
-                q = computeQFunction(model_, v1_, model_.getRewardFunction());
+                q = computeQFunction(model_, v1_, computeImmediateRewards(model_));
             else
                 q = computeQFunction(model_, v1_, immediateRewards_);
 
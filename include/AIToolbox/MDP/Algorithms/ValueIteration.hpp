@@ -6,6 +6,7 @@
 #include <AIToolbox/MDP/TypeTraits.hpp>
 #include <AIToolbox/MDP/Utils.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 
 namespace AIToolbox::MDP {
     /**
@@ -118,6 +119,18 @@ namespace AIToolbox::MDP {
              */
             const ValueFunction & getValueFunction() const;
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of iterations, the time
+             * spent, and the maximum variation of the ValueFunction after
+             * each iteration.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             // Parameters
             double tolerance_;
@@ -126,6 +139,7 @@ namespace AIToolbox::MDP {
 
             // Internals
             ValueFunction v1_;
+            SolverStatistics stats_;
     };
 
     template <IsModel M>
@@ -134,6 +148,8 @@ namespace AIToolbox::MDP {
         const size_t S = model.getS();
         const size_t A = model.getA();
 
+        SolverStatisticsRecorder record(stats_);
+
         {
             // Verify that parameter value function is compatible.
             const size_t size = vParameter_.values.size();
@@ -148,10 +164,7 @@ namespace AIToolbox::MDP {
                 v1_ = vParameter_;
         }
 
-        const auto & ir = [&]{
-            if constexpr (IsModelEigen<M>) return model.getRewardFunction();
-            else return computeImmediateRewards(model);
-        }();
+        const auto ir = computeImmediateRewards(model);
 
         unsigned timestep = 0;
         double variation = tolerance_ * 2; // Make it bigger
@@ -174,11 +187,14 @@ namespace AIToolbox::MDP {
             // Compute the new value function (note that also val1 is overwritten)
             bellmanOperatorInplace(q, &v1_);
 
-            // We do this only if the tolerance specified is positive, otherwise we
-            // continue for all the timesteps.
-            if ( useTolerance )
+            // We do this only if the tolerance specified is positive (or we
+            // are recording it), otherwise we continue for all the timesteps.
+            if ( useTolerance || record )
                 variation = (val1 - val0).cwiseAbs().maxCoeff();
+            if ( record )
+                stats_.residuals.push_back(variation);
         }
+        if ( record ) stats_.iterations = timestep;
 
         // We do not guarantee that the Value/QFunctions are the perfect ones,
         // as we stop as within the given tolerance.
@@ -0,0 +1,259 @@
+#ifndef AI_TOOLBOX_MDP_CONCURRENT_EXPERIENCE_HEADER_FILE
+#define AI_TOOLBOX_MDP_CONCURRENT_EXPERIENCE_HEADER_FILE
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/Experience.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class keeps track of registered events and rewards from multiple threads.
+     *
+     * This class records the same data as Experience, but its record()
+     * function can be called concurrently by any number of threads. All
+     * visit counts are stored as atomic counters, while the average reward
+     * and M2 of each state-action pair are updated with Welford's algorithm
+     * under a small per-pair lock, so that they match what Experience
+     * computes. Writers only ever wait for each other when they record the
+     * same state-action pair at the same time.
+     *
+     * To wait and touch shared data even less, each writing thread can
+     * record into its own Buffer. When full, a Buffer combines its events
+     * per state-action pair, and merges them into the shared statistics
+     * with the parallel algorithm by Chan et al., so that each pair is
+     * updated once per batch.
+     *
+     * As the data is constantly changing, models should not read from this
+     * class directly. Instead, the snapshot() function copies a consistent
+     * view of the data into an Experience, which can then be used normally
+     * (for example, by a MaximumLikelihoodModel). While a snapshot is being
+     * taken, new calls to record() and Buffer flushes wait until the copy is
+     * done, and the snapshot waits for the ones in progress to finish.
+     * Events which are still in Buffers are not part of snapshots; call
+     * Buffer::flush() to make them visible.
+     */
+    class ConcurrentExperience {
+        public:
+            /**
+             * @brief This class buffers the events recorded by a single thread.
+             *
+             * A Buffer must only be used by a single thread at a time, and
+             * must not outlive the ConcurrentExperience it was created
+             * from. Any remaining events are flushed on destruction.
+             */
+            class Buffer {
+                public:
+                    /**
+                     * @brief This function adds a new event to the buffer.
+                     *
+                     * If the buffer is full, all its events are flushed.
+                     *
+                     * @param s     Old state.
+                     * @param a     Performed action.
+                     * @param s1    New state.
+                     * @param rew   Obtained reward.
+                     */
+                    void record(size_t s, size_t a, size_t s1, double rew);
+
+                    /**
+                     * @brief This function applies all buffered events to the underlying experience.
+                     */
+                    void flush();
+
+                    /**
+                     * @brief This function returns the number of events currently buffered.
+                     *
+                     * @return The number of buffered events.
+                     */
+                    size_t size() const;
+
+                    Buffer(Buffer &&) = default;
+                    ~Buffer();
+
+                private:
+                    friend class ConcurrentExperience;
+
+                    struct Event {
+                        size_t s, a, s1;
+                        double rew;
+                    };
+
+                    Buffer(ConcurrentExperience & exp, size_t batchSize);
+
+                    ConcurrentExperience * exp_;
+                    size_t batchSize_;
+                    std::vector<Event> events_;
+            };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * @param S The number of states of the world.
+             * @param A The number of actions available to the agent.
+             */
+            ConcurrentExperience(size_t S, size_t A);
+
+            /**
+             * @brief This function adds a new event to the recordings.
+             *
+             * This function is thread-safe.
+             *
+             * @param s     Old state.
+             * @param a     Performed action.
+             * @param s1    New state.
+             * @param rew   Obtained reward.
+             */
+            void record(size_t s, size_t a, size_t s1, double rew);
+
+            /**
+             * @brief This function creates a new Buffer to record events from a thread.
+             *
+             * This function is thread-safe.
+             *
+             * @param batchSize The number of events after which the Buffer is automatically flushed.
+             *
+             * @return A new Buffer.
+             */
+            Buffer makeBuffer(size_t batchSize = 256);
+
+            /**
+             * @brief This function copies a consistent view of the recorded data into an Experience.
+             *
+             * The output contains all record() calls which completed
+             * before this function was called, and none of the ones that
+             * started after it returned.
+             *
+             * This function is thread-safe.
+             *
+             * @param exp The Experience to overwrite, which must have the same S and A.
+             */
+            void snapshot(Experience * exp);
+
+            /**
+             * @brief This function resets all experienced rewards and transitions.
+             *
+             * This function must not be called concurrently with other
+             * functions of this class.
+             */
+            void reset();
+
+            /**
+             * @brief This function returns the number of times the record function has been called.
+             *
+             * @return The number of recorded timesteps.
+             */
+            unsigned long getTimesteps() const;
+
+            /**
+             * @brief This function returns the current recorded visits for a transitions.
+             *
+             * @param s     Old state.
+             * @param a     Performed action.
+             * @param s1    New state.
+             *
+             * @return The number of visits.
+             */
+            unsigned long getVisits(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the number of transitions recorded that start with the specified state and action.
+             *
+             * @param s     The initial state.
+             * @param a     The action performed.
+             *
+             * @return The total number of transitions that start with the specified state-action pair.
+             */
+            unsigned long getVisitsSum(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the average reward obtained for a state-action pair.
+             *
+             * While other threads are recording, the returned value may
+             * be outdated as soon as it is returned.
+             *
+             * @param s     The initial state.
+             * @param a     The action performed.
+             *
+             * @return The average reward.
+             */
+            double getReward(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the M2 statistic for a state-action pair.
+             *
+             * While other threads are recording, the returned value may
+             * be outdated as soon as it is returned.
+             *
+             * @param s     The initial state.
+             * @param a     The action performed.
+             *
+             * @return The M2 statistic.
+             */
+            double getM2(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            size_t getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            size_t getA() const;
+
+        private:
+            struct Rewards {
+                double mean, m2;
+            };
+
+            /**
+             * @brief This function registers the calling thread as a writer, waiting for any snapshot to finish.
+             */
+            void beginWrite();
+
+            /**
+             * @brief This function unregisters the calling thread as a writer.
+             */
+            void endWrite();
+
+            /**
+             * @brief This function waits until the input state-action pair can be updated.
+             */
+            void lockPair(size_t id) const;
+
+            /**
+             * @brief This function allows other threads to update the input state-action pair.
+             */
+            void unlockPair(size_t id) const;
+
+            size_t S, A;
+
+            // Indexed as (a * S + s) * S + s1, as in the Table3D of Experience.
+            std::vector<std::atomic<unsigned long>> visits_;
+            // These are indexed as s * A + a. The visit sums are only
+            // modified together with the rewards, under the pair's lock.
+            std::vector<std::atomic<unsigned long>> visitsSum_;
+            std::vector<Rewards> rewards_;
+            mutable std::vector<std::atomic_flag> locks_;
+            std::atomic<unsigned long> timesteps_;
+
+            // Snapshot synchronization.
+            std::atomic<bool> pausing_;
+            std::atomic<unsigned> writers_;
+            std::mutex snapshotMutex_;
+
+            // Buffers reused between snapshots.
+            Table3D visitsBuffer_;
+            Matrix2D rewardsBuffer_, M2sBuffer_;
+    };
+}
+
+#endif
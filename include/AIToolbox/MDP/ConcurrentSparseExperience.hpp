@@ -0,0 +1,163 @@
+#ifndef AI_TOOLBOX_MDP_CONCURRENT_SPARSE_EXPERIENCE_HEADER_FILE
+#define AI_TOOLBOX_MDP_CONCURRENT_SPARSE_EXPERIENCE_HEADER_FILE
+
+#include <mutex>
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/SparseExperience.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class keeps track of registered events and rewards from multiple threads, using sparse tables.
+     *
+     * Inserting into the sparse tables of SparseExperience may move large
+     * parts of them, so it cannot be done concurrently. Instead, each
+     * writing thread gets its own Buffer, where it records its events. When
+     * a Buffer is full, it combines its events per state-action pair
+     * (merging the rewards with the parallel algorithm by Chan et al.), and
+     * then applies them to the shared SparseExperience at once, so that the
+     * lock protecting it is only taken once per batch, and each pair is
+     * only updated once.
+     *
+     * Since whole batches are applied under the lock, the snapshot()
+     * function can copy a consistent view of the data into a
+     * SparseExperience, which can then be used normally (for example, by a
+     * SparseMaximumLikelihoodModel) while writers continue. Events which
+     * are still in the Buffers are not part of snapshots; call
+     * Buffer::flush() to make them visible.
+     */
+    class ConcurrentSparseExperience {
+        public:
+            /**
+             * @brief This class buffers the events recorded by a single thread.
+             *
+             * A Buffer must only be used by a single thread at a time, and
+             * must not outlive the ConcurrentSparseExperience it was created
+             * from. Any remaining events are flushed on destruction.
+             */
+            class Buffer {
+                public:
+                    /**
+                     * @brief This function adds a new event to the buffer.
+                     *
+                     * If the buffer is full, all its events are flushed.
+                     *
+                     * @param s     Old state.
+                     * @param a     Performed action.
+                     * @param s1    New state.
+                     * @param rew   Obtained reward.
+                     */
+                    void record(size_t s, size_t a, size_t s1, double rew);
+
+                    /**
+                     * @brief This function applies all buffered events to the underlying experience.
+                     */
+                    void flush();
+
+                    /**
+                     * @brief This function returns the number of events currently buffered.
+                     *
+                     * @return The number of buffered events.
+                     */
+                    size_t size() const;
+
+                    Buffer(Buffer &&) = default;
+                    ~Buffer();
+
+                private:
+                    friend class ConcurrentSparseExperience;
+
+                    struct Event {
+                        size_t s, a, s1;
+                        double rew;
+                    };
+
+                    Buffer(ConcurrentSparseExperience & exp, size_t batchSize);
+
+                    ConcurrentSparseExperience * exp_;
+                    size_t batchSize_;
+                    std::vector<Event> events_;
+            };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * @param S The number of states of the world.
+             * @param A The number of actions available to the agent.
+             */
+            ConcurrentSparseExperience(size_t S, size_t A);
+
+            /**
+             * @brief This function creates a new Buffer to record events from a thread.
+             *
+             * This function is thread-safe.
+             *
+             * @param batchSize The number of events after which the Buffer is automatically flushed.
+             *
+             * @return A new Buffer.
+             */
+            Buffer makeBuffer(size_t batchSize = 256);
+
+            /**
+             * @brief This function adds a single event directly to the recordings.
+             *
+             * This function is thread-safe, but takes a lock for each call;
+             * Buffers should be preferred when recording from many threads.
+             *
+             * @param s     Old state.
+             * @param a     Performed action.
+             * @param s1    New state.
+             * @param rew   Obtained reward.
+             */
+            void record(size_t s, size_t a, size_t s1, double rew);
+
+            /**
+             * @brief This function copies a consistent view of the recorded data into a SparseExperience.
+             *
+             * This function is thread-safe.
+             *
+             * @param exp The SparseExperience to overwrite, which must have the same S and A.
+             */
+            void snapshot(SparseExperience * exp) const;
+
+            /**
+             * @brief This function resets all experienced rewards and transitions.
+             *
+             * Events still in Buffers are not discarded.
+             *
+             * This function is thread-safe.
+             */
+            void reset();
+
+            /**
+             * @brief This function returns the number of flushed events.
+             *
+             * This function is thread-safe.
+             *
+             * @return The number of recorded timesteps.
+             */
+            unsigned long getTimesteps() const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            size_t getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            size_t getA() const;
+
+        private:
+            SparseExperience exp_;
+            mutable std::mutex mutex_;
+    };
+}
+
+#endif
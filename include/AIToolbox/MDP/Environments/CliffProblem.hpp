@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_MDP_CLIFF_PROBLEM_HEADER_FILE
 
 #include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/MDP/ImplicitModel.hpp>
 #include <AIToolbox/MDP/Environments/Utils/GridWorld.hpp>
 
 namespace AIToolbox::MDP {
@@ -121,6 +122,79 @@ namespace AIToolbox::MDP {
 
         return model;
     }
+
+    /**
+     * @brief This class is the transition kernel of the cliff problem.
+     *
+     * It computes the same transitions and rewards as makeCliffProblem(),
+     * without storing them.
+     *
+     * \sa makeCliffProblem(const GridWorld &)
+     */
+    class CliffProblemKernel {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * @param grid The grid to use for the problem.
+             */
+            CliffProblemKernel(const GridWorld & grid) : grid_(grid) {}
+
+            /**
+             * @brief This function calls the input function for every successor of the input state-action pair.
+             *
+             * @param s The initial state.
+             * @param a The action performed.
+             * @param f The function to call with each successor, its probability and its reward.
+             */
+            template <typename F>
+            void forEachTransition(const size_t s, const size_t a, F f) const {
+                using namespace GridWorldUtils;
+                constexpr double failReward = -100.0, stepReward = -1.0, winReward = 0.0;
+
+                const size_t start = getS() - 2, goal = getS() - 1;
+                const size_t upStart = (grid_.getHeight() - 1) * grid_.getWidth();
+                const size_t upGoal  = getS() - 3;
+
+                if ( s == goal ) {
+                    // Self absorbing
+                    f(goal, 1.0, 0.0);
+                } else if ( s == start ) {
+                    if ( a == UP ) f(upStart, 1.0, stepReward);
+                    // Going right from the start goes into the cliff
+                    else f(start, 1.0, a == RIGHT ? failReward : stepReward);
+                } else if ( a == DOWN && s == upStart ) {
+                    f(start, 1.0, stepReward);
+                } else if ( a == DOWN && s == upGoal ) {
+                    f(goal, 1.0, winReward); // Won!
+                } else if ( a == DOWN && s > upStart && s < upGoal ) {
+                    f(start, 1.0, failReward); // This goes into the cliff
+                } else {
+                    f(grid_.getAdjacent(a, grid_(s)), 1.0, stepReward);
+                }
+            }
+
+            size_t getS() const { return grid_.getS() + 2; }
+            size_t getA() const { return 4; }
+
+        private:
+            GridWorld grid_;
+    };
+
+    /**
+     * @brief This function sets up the cliff problem in an ImplicitModel.
+     *
+     * The problem is the same as the one returned by makeCliffProblem(),
+     * but its transitions are never stored. This allows solving it on
+     * very large grids.
+     *
+     * @param grid The grid to use for the problem.
+     *
+     * @return The ImplicitModel representing the problem.
+     */
+    inline ImplicitModel<CliffProblemKernel> makeImplicitCliffProblem(const GridWorld & grid) {
+        return ImplicitModel<CliffProblemKernel>(CliffProblemKernel(grid), 1.0);
+    }
 }
 
 #endif
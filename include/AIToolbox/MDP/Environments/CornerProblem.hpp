@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_MDP_CORNER_PROBLEM_HEADER_FILE
 
 #include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/ImplicitModel.hpp>
 #include <AIToolbox/MDP/Environments/Utils/GridWorld.hpp>
 
 namespace AIToolbox::MDP {
@@ -83,6 +84,74 @@ namespace AIToolbox::MDP {
         }
         return Model(S, A, transitions, rewards, 0.95);
     }
+
+    /**
+     * @brief This class is the transition kernel of the corner problem.
+     *
+     * It computes the same transitions and rewards as makeCornerProblem(),
+     * without storing them.
+     *
+     * \sa makeCornerProblem(const GridWorld &, double)
+     */
+    class CornerProblemKernel {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * @param grid The grid to use for the problem.
+             * @param stepUncertainty The probability that a movement action succeeds.
+             */
+            CornerProblemKernel(const GridWorld & grid, double stepUncertainty = 0.8) :
+                    grid_(grid), stepUncertainty_(stepUncertainty) {}
+
+            /**
+             * @brief This function calls the input function for every successor of the input state-action pair.
+             *
+             * @param s The initial state.
+             * @param a The action performed.
+             * @param f The function to call with each successor, its probability and its reward.
+             */
+            template <typename F>
+            void forEachTransition(const size_t s, const size_t a, F f) const {
+                // Self absorbing states
+                if ( s == 0 || s == grid_.getS() - 1 ) {
+                    f(s, 1.0, 0.0);
+                    return;
+                }
+                const size_t s1 = grid_.getAdjacent(a, grid_(s));
+                // If the move takes you outside the map, it doesn't do
+                // anything
+                if ( s == s1 ) {
+                    f(s, 1.0, -1.0);
+                } else {
+                    f(s1, stepUncertainty_, -1.0);
+                    f(s, 1.0 - stepUncertainty_, 0.0);
+                }
+            }
+
+            size_t getS() const { return grid_.getS(); }
+            size_t getA() const { return 4; }
+
+        private:
+            GridWorld grid_;
+            double stepUncertainty_;
+    };
+
+    /**
+     * @brief This function sets up the corner problem in an ImplicitModel.
+     *
+     * The problem is the same as the one returned by makeCornerProblem(),
+     * but its transitions are never stored. This allows solving it on
+     * very large grids.
+     *
+     * @param grid The grid to use for the problem.
+     * @param stepUncertainty The probability that a movement action succeeds.
+     *
+     * @return The ImplicitModel representing the problem.
+     */
+    inline ImplicitModel<CornerProblemKernel> makeImplicitCornerProblem(const GridWorld & grid, double stepUncertainty = 0.8) {
+        return ImplicitModel<CornerProblemKernel>(CornerProblemKernel(grid, stepUncertainty), 0.95);
+    }
 }
 
 #endif
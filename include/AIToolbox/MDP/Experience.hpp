@@ -143,6 +143,16 @@ namespace AIToolbox::MDP {
              */
             void setM2Matrix(const Matrix2D & mm);
 
+            /**
+             * @brief This function sets the number of recorded timesteps.
+             *
+             * This is useful when restoring an Experience from its tables,
+             * as these do not contain the number of timesteps.
+             *
+             * @param t The number of timesteps.
+             */
+            void setTimesteps(unsigned long t);
+
             /**
              * @brief This function adds a new event to the recordings.
              *
@@ -0,0 +1,78 @@
+#ifndef AI_TOOLBOX_MDP_EXPERIMENTS_HEADER_FILE
+#define AI_TOOLBOX_MDP_EXPERIMENTS_HEADER_FILE
+
+#include <tuple>
+
+#include <AIToolbox/Tools/Experiments.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/Policies/PolicyInterface.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This function runs episodes of a policy on a model in parallel, and collects their rewards.
+     *
+     * Each episode starts from the input state, and runs for the input
+     * horizon, or until a terminal state is reached. The reward obtained
+     * at each timestep is recorded in the returned Statistics; after a
+     * terminal state we record zeros, so that every timestep accounts
+     * for all episodes.
+     *
+     * All randomness comes from the per-episode engines of
+     * AIToolbox::runEpisodes(), so the result does not depend on the
+     * number of threads. The policy is sampled through
+     * PolicyInterface::sampleAction(const size_t &, RandomEngine &), so it
+     * must implement it. The model is sampled through its
+     * sampleSR(s, a, RandomEngine &) method if it has one; otherwise we
+     * sample its transition probabilities directly, which takes O(S) per
+     * step.
+     *
+     * @param model The model to run the episodes on.
+     * @param policy The policy to follow.
+     * @param s0 The initial state of each episode.
+     * @param episodes The number of episodes to run.
+     * @param horizon The maximum length of each episode.
+     * @param threads The number of threads to use; 0 uses all available cores.
+     * @param firstStream The Seeder stream of the first episode.
+     *
+     * @return The Statistics of the rewards obtained in each timestep.
+     */
+    template <IsModel M>
+    Statistics runEpisodes(const M & model, const PolicyInterface & policy, const size_t s0, const size_t episodes, const size_t horizon, const unsigned threads = 1, const std::uint64_t firstStream = 0) {
+        auto sampleSR = [&model](const size_t s, const size_t a, RandomEngine & rnd) -> std::tuple<size_t, double> {
+            if constexpr (requires { model.sampleSR(s, a, rnd); }) {
+                return model.sampleSR(s, a, rnd);
+            } else {
+                const size_t S = model.getS();
+                double p = probabilityDistribution(rnd);
+                for (size_t s1 = 0; s1 < S; ++s1) {
+                    const double t = model.getTransitionProbability(s, a, s1);
+                    if (t > p) return {s1, model.getExpectedReward(s, a, s1)};
+                    p -= t;
+                }
+                return {S - 1, model.getExpectedReward(s, a, S - 1)};
+            }
+        };
+
+        auto episode = [&](size_t, RandomEngine & rnd, Statistics & stats) {
+            size_t s = s0;
+            bool terminal = false;
+            for (size_t t = 0; t < horizon; ++t) {
+                if (terminal) {
+                    stats.record(0.0, t);
+                    continue;
+                }
+                const auto a = policy.sampleAction(s, rnd);
+                const auto [s1, r] = sampleSR(s, a, rnd);
+                stats.record(r, t);
+
+                terminal = model.isTerminal(s1);
+                s = s1;
+            }
+        };
+
+        return AIToolbox::runEpisodes(episodes, horizon, episode, threads, firstStream);
+    }
+}
+
+#endif
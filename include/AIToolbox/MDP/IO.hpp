@@ -2,13 +2,16 @@
 #define AI_TOOLBOX_MDP_IO_HEADER_FILE
 
 #include <iosfwd>
+#include <string>
 
 namespace AIToolbox::MDP {
     // Forward references to avoid including tons of headers
     class Experience;
     class SparseExperience;
-    class Model;
-    class SparseModel;
+    template <typename T> class ModelT;
+    template <typename T> class SparseModelT;
+    using Model = ModelT<double>;
+    using SparseModel = SparseModelT<double>;
     class PolicyInterface;
     class Policy;
 
@@ -24,6 +27,25 @@ namespace AIToolbox::MDP {
      */
     Model parseCassandra(std::istream & input);
 
+    /**
+     * @brief This function parses a sparse MDP from a Cassandra formatted file.
+     *
+     * This function is meant for large models, which would not fit in
+     * memory as dense matrices. The file is memory-mapped, and parsed
+     * directly into sparse matrices, optionally in parallel. See
+     * CassandraParser::parseSparseMDP() for details.
+     *
+     * This function may throw std::runtime_errors depending on whether the
+     * input is correctly formed or not, and std::invalid_argument if it
+     * does not describe a valid MDP.
+     *
+     * @param filename The name of the file to parse.
+     * @param threads The number of threads to use; 0 uses all available cores.
+     *
+     * @return The parsed model.
+     */
+    SparseModel parseCassandraSparse(const std::string & filename, unsigned threads = 1);
+
     /**
      * @name MDP output stream operators.
      *
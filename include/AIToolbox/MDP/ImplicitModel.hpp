@@ -0,0 +1,299 @@
+#ifndef AI_TOOLBOX_MDP_IMPLICIT_MODEL_HEADER_FILE
+#define AI_TOOLBOX_MDP_IMPLICIT_MODEL_HEADER_FILE
+
+#include <tuple>
+#include <random>
+#include <stdexcept>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class represents an MDP whose transitions are computed on demand.
+     *
+     * Both Model and SparseModel store the transition function explicitly,
+     * which costs S*S*A memory for the first, and memory proportional to
+     * the number of non-zero transitions for the second. For many
+     * structured problems, like grid worlds, the transitions follow from a
+     * simple local rule, and storing them is wasteful.
+     *
+     * This class wraps a transition kernel, which computes the successors
+     * of each state-action pair when asked, and exposes it as a full MDP
+     * model. The only thing stored is the S*A immediate reward function,
+     * which is computed once on construction.
+     *
+     * Individual probabilities are found by enumerating the successors of
+     * the requested state-action pair, so they are cheap only when these
+     * are few. Planning algorithms that use computeQFunction() (like
+     * ValueIteration and PolicyIteration) use instead the
+     * applyTransitionFunction() method, which applies the transition
+     * function to a ValueFunction as a matrix-free operator. This allows
+     * them to solve problems with millions of states.
+     *
+     * Note that this class does not satisfy IsModelEigen, as it has no
+     * transition matrices to return; it satisfies IsModelMatrixFree.
+     *
+     * @tparam K The type of the transition kernel.
+     */
+    template <IsTransitionKernel K>
+    class ImplicitModel {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor verifies that the kernel reports valid
+             * probabilities for every state-action pair, and throws
+             * std::invalid_argument otherwise.
+             *
+             * The discount parameter must be between 0 and 1 included,
+             * otherwise the constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param kernel The transition kernel of the MDP.
+             * @param discount The discount factor for the MDP.
+             */
+            ImplicitModel(K kernel, double discount = 1.0);
+
+            /**
+             * @brief This function sets a new discount factor for the Model.
+             *
+             * @param d The new discount factor for the Model.
+             */
+            void setDiscount(double d);
+
+            /**
+             * @brief This function samples the MDP for the specified state action pair.
+             *
+             * This function samples the model for simulate experience. The
+             * transition and reward functions are used to produce, from the
+             * state action pair inserted as arguments, a possible new state
+             * with respective reward. The new state is picked from all
+             * possible states that the MDP allows transitioning to, each
+             * with probability equal to the same probability of the
+             * transition in the model. After a new state is picked, the
+             * reward is the reward the kernel reports for that transition.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
+
+            /**
+             * @brief This function samples the MDP with the specified state action pair, using the input generator.
+             *
+             * This function is equivalent to sampleSR(size_t, size_t),
+             * but it does not touch the internal generator of the model.
+             * This allows sampling the model concurrently from multiple
+             * threads, each with its own generator.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The generator to use.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            size_t getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            size_t getA() const;
+
+            /**
+             * @brief This function returns the currently set discount factor.
+             *
+             * @return The currently set discount factor.
+             */
+            double getDiscount() const;
+
+            /**
+             * @brief This function returns the stored transition probability for the specified transition.
+             *
+             * @param s The initial state of the transition.
+             * @param a The action performed in the transition.
+             * @param s1 The final state of the transition.
+             *
+             * @return The probability of the specified transition.
+             */
+            double getTransitionProbability(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the stored expected reward for the specified transition.
+             *
+             * @param s The initial state of the transition.
+             * @param a The action performed in the transition.
+             * @param s1 The final state of the transition.
+             *
+             * @return The expected reward of the specified transition.
+             */
+            double getExpectedReward(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function applies the transition function to the input values.
+             *
+             * For each state-action pair, this function adds to the
+             * corresponding entry of the input QFunction the expected
+             * value of the input values over its successors. In matrix
+             * form, for each action this computes q.col(a) += T(a) * v,
+             * without ever building T(a).
+             *
+             * @param v The values to apply the transition function to.
+             * @param q The QFunction to add the results to.
+             */
+            void applyTransitionFunction(const Values & v, QFunction & q) const;
+
+            /**
+             * @brief This function returns the rewards matrix for inspection.
+             *
+             * @return The rewards matrix.
+             */
+            const Matrix2D & getRewardFunction() const;
+
+            /**
+             * @brief This function returns the transition kernel of the Model.
+             *
+             * @return The transition kernel.
+             */
+            const K & getKernel() const;
+
+            /**
+             * @brief This function returns whether a given state is a terminal.
+             *
+             * @param s The state examined.
+             *
+             * @return True if the input state is a terminal, false otherwise.
+             */
+            bool isTerminal(size_t s) const;
+
+        private:
+            K kernel_;
+            size_t S, A;
+            double discount_;
+
+            Matrix2D rewards_;
+
+            mutable RandomEngine rand_;
+    };
+
+    template <IsTransitionKernel K>
+    ImplicitModel<K>::ImplicitModel(K kernel, const double discount) :
+            kernel_(std::move(kernel)), S(kernel_.getS()), A(kernel_.getA()),
+            rewards_(S, A), rand_(Seeder::getSeed())
+    {
+        setDiscount(discount);
+
+        for ( size_t s = 0; s < S; ++s ) {
+            for ( size_t a = 0; a < A; ++a ) {
+                double p = 0.0, r = 0.0;
+                kernel_.forEachTransition(s, a, [&](const size_t s1, const double pp, const double rr) {
+                    if ( s1 >= S || pp < 0.0 )
+                        throw std::invalid_argument("Input kernel contains an invalid transition.");
+                    p += pp;
+                    r += pp * rr;
+                });
+                if ( checkDifferentSmall(p, 1.0) )
+                    throw std::invalid_argument("Input kernel does not contain valid probabilities.");
+                rewards_(s, a) = r;
+            }
+        }
+    }
+
+    template <IsTransitionKernel K>
+    void ImplicitModel<K>::setDiscount(const double d) {
+        if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
+        discount_ = d;
+    }
+
+    template <IsTransitionKernel K>
+    std::tuple<size_t, double> ImplicitModel<K>::sampleSR(const size_t s, const size_t a) const {
+        return sampleSR(s, a, rand_);
+    }
+
+    template <IsTransitionKernel K>
+    std::tuple<size_t, double> ImplicitModel<K>::sampleSR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        double p = probabilityDistribution(rnd);
+
+        // If numerical errors leave some probability, we keep the last successor.
+        size_t s1 = s;
+        double r = 0.0;
+        bool found = false;
+        kernel_.forEachTransition(s, a, [&](const size_t ss, const double pp, const double rr) {
+            if ( found ) return;
+            s1 = ss; r = rr;
+            if ( pp > p ) found = true;
+            else p -= pp;
+        });
+
+        return std::make_tuple(s1, r);
+    }
+
+    template <IsTransitionKernel K>
+    double ImplicitModel<K>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+        double p = 0.0;
+        kernel_.forEachTransition(s, a, [&](const size_t ss, const double pp, double) {
+            if ( ss == s1 ) p += pp;
+        });
+        return p;
+    }
+
+    template <IsTransitionKernel K>
+    double ImplicitModel<K>::getExpectedReward(const size_t s, const size_t a, const size_t s1) const {
+        double p = 0.0, r = 0.0;
+        kernel_.forEachTransition(s, a, [&](const size_t ss, const double pp, const double rr) {
+            if ( ss == s1 ) { p += pp; r += pp * rr; }
+        });
+        if ( p == 0.0 ) return 0.0;
+        return r / p;
+    }
+
+    template <IsTransitionKernel K>
+    void ImplicitModel<K>::applyTransitionFunction(const Values & v, QFunction & q) const {
+        for ( size_t s = 0; s < S; ++s ) {
+            for ( size_t a = 0; a < A; ++a ) {
+                double e = 0.0;
+                kernel_.forEachTransition(s, a, [&](const size_t s1, const double p, double) {
+                    e += p * v[s1];
+                });
+                q(s, a) += e;
+            }
+        }
+    }
+
+    template <IsTransitionKernel K>
+    bool ImplicitModel<K>::isTerminal(const size_t s) const {
+        for ( size_t a = 0; a < A; ++a )
+            if ( !checkEqualSmall(1.0, getTransitionProbability(s, a, s)) )
+                return false;
+        return true;
+    }
+
+    template <IsTransitionKernel K>
+    size_t ImplicitModel<K>::getS() const { return S; }
+    template <IsTransitionKernel K>
+    size_t ImplicitModel<K>::getA() const { return A; }
+    template <IsTransitionKernel K>
+    double ImplicitModel<K>::getDiscount() const { return discount_; }
+
+    template <IsTransitionKernel K>
+    const Matrix2D & ImplicitModel<K>::getRewardFunction() const { return rewards_; }
+    template <IsTransitionKernel K>
+    const K & ImplicitModel<K>::getKernel() const { return kernel_; }
+}
+
+#endif
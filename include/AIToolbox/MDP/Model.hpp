@@ -66,11 +66,25 @@ namespace AIToolbox::MDP {
      *
      * Since so much information can be extracted from the QFunction, lots
      * of methods (mostly in Reinforcement Learning) try to learn it.
+     *
+     * The scalar parameter selects the type used to store the transition
+     * and reward functions. Storing them as float halves the memory used
+     * by the model, which for large models also speeds up planning, as the
+     * matrix-vector products of the Bellman backups are limited by memory
+     * bandwidth. All values returned by the interface remain doubles, and
+     * the planning algorithms still accumulate values in double precision.
+     *
+     * This class is instantiated for double and float; Model is the double
+     * version.
+     *
+     * @tparam T The scalar type used to store the model.
      */
-    class Model {
+    template <typename T>
+    class ModelT {
         public:
-            using TransitionMatrix   = Matrix3D;
-            using RewardMatrix       = Matrix2D;
+            using Scalar             = T;
+            using TransitionMatrix   = Matrix3DT<T>;
+            using RewardMatrix       = Matrix2DT<T>;
 
             /**
              * @brief Basic constructor.
@@ -86,7 +100,7 @@ namespace AIToolbox::MDP {
              * @param a The number of actions available to the agent.
              * @param discount The discount factor for the MDP.
              */
-            Model(size_t s, size_t a, double discount = 1.0);
+            ModelT(size_t s, size_t a, double discount = 1.0);
 
             /**
              * @brief Basic constructor.
@@ -113,7 +127,7 @@ namespace AIToolbox::MDP {
              * otherwise the constructor will throw an
              * std::invalid_argument.
              *
-             * @tparam T The external transition container type.
+             * @tparam TM The external transition container type.
              * @tparam R The external rewards container type.
              * @param s The number of states of the world.
              * @param a The number of actions available to the agent.
@@ -121,8 +135,8 @@ namespace AIToolbox::MDP {
              * @param r The external rewards container.
              * @param d The discount factor for the MDP.
              */
-            template <IsNaive3DMatrix T, IsNaive3DMatrix R>
-            Model(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
+            template <IsNaive3DMatrix TM, IsNaive3DMatrix R>
+            ModelT(size_t s, size_t a, const TM & t, const R & r, double d = 1.0);
 
             /**
              * @brief Copy constructor from any valid MDP model.
@@ -137,7 +151,7 @@ namespace AIToolbox::MDP {
              * @param model The model that needs to be copied.
              */
             template <IsModel M>
-            Model(const M& model);
+            ModelT(const M& model);
 
             /**
              * @brief Unchecked constructor.
@@ -156,7 +170,7 @@ namespace AIToolbox::MDP {
              * @param r The reward function to be used in the Model.
              * @param d The discount factor for the Model.
              */
-            Model(NoCheck, size_t s, size_t a, TransitionMatrix && t, RewardMatrix && r, double d);
+            ModelT(NoCheck, size_t s, size_t a, TransitionMatrix && t, RewardMatrix && r, double d);
 
             /**
              * @brief This function replaces the Model transition function with the one provided.
@@ -175,11 +189,11 @@ namespace AIToolbox::MDP {
              * Internal values of the container will be converted to
              * double, so these conversions must be possible.
              *
-             * @tparam T The external transition container type.
+             * @tparam TM The external transition container type.
              * @param t The external transitions container.
              */
-            template <IsNaive3DMatrix T>
-            void setTransitionFunction(const T & t);
+            template <IsNaive3DMatrix TM>
+            void setTransitionFunction(const TM & t);
 
             /**
              * @brief This function sets the transition function using a Eigen dense matrix.
@@ -260,6 +274,22 @@ namespace AIToolbox::MDP {
              */
             std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
 
+            /**
+             * @brief This function samples the MDP with the specified state action pair, using the input generator.
+             *
+             * This function is equivalent to sampleSR(size_t, size_t),
+             * but it does not touch the internal generator of the model.
+             * This allows sampling the model concurrently from multiple
+             * threads, each with its own generator.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The generator to use.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a, RandomEngine & rnd) const;
+
             /**
              * @brief This function returns the number of states of the world.
              *
@@ -317,7 +347,7 @@ namespace AIToolbox::MDP {
              *
              * @return The transition function for the input action.
              */
-            const Matrix2D & getTransitionFunction(size_t a) const;
+            const Matrix2DT<T> & getTransitionFunction(size_t a) const;
 
             /**
              * @brief This function returns the rewards matrix for inspection.
@@ -345,9 +375,15 @@ namespace AIToolbox::MDP {
             mutable RandomEngine rand_;
     };
 
-    template <IsNaive3DMatrix T, IsNaive3DMatrix R>
-    Model::Model(const size_t s, const size_t a, const T & t, const R & r, const double d) :
-            S(s), A(a), transitions_(A, Matrix2D(S, S)),
+    /**
+     * @brief This is the double precision MDP model.
+     */
+    using Model = ModelT<double>;
+
+    template <typename T>
+    template <IsNaive3DMatrix TM, IsNaive3DMatrix R>
+    ModelT<T>::ModelT(const size_t s, const size_t a, const TM & t, const R & r, const double d) :
+            S(s), A(a), transitions_(A, Matrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         setDiscount(d);
@@ -355,9 +391,10 @@ namespace AIToolbox::MDP {
         setRewardFunction(r);
     }
 
+    template <typename T>
     template <IsModel M>
-    Model::Model(const M& model) :
-            S(model.getS()), A(model.getA()), transitions_(A, Matrix2D(S, S)),
+    ModelT<T>::ModelT(const M& model) :
+            S(model.getS()), A(model.getA()), transitions_(A, Matrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         setDiscount(model.getDiscount());
@@ -373,8 +410,9 @@ namespace AIToolbox::MDP {
             }
     }
 
-    template <IsNaive3DMatrix T>
-    void Model::setTransitionFunction(const T & t) {
+    template <typename T>
+    template <IsNaive3DMatrix TM>
+    void ModelT<T>::setTransitionFunction(const TM & t) {
         if (!isProbability(S, A, S, t))
             throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
 
@@ -384,8 +422,9 @@ namespace AIToolbox::MDP {
                     transitions_[a](s, s1) = t[s][a][s1];
     }
 
+    template <typename T>
     template <IsNaive3DMatrix R>
-    void Model::setRewardFunction(const R & r) {
+    void ModelT<T>::setRewardFunction(const R & r) {
         rewards_.setZero();
         for ( size_t s = 0; s < S; ++s )
             for ( size_t a = 0; a < A; ++a )
@@ -34,6 +34,16 @@ namespace AIToolbox::MDP {
              */
             virtual size_t sampleAction(const size_t & s) const override;
 
+            /**
+             * @brief This function chooses a random action using the underlying bandit policy and the input generator.
+             *
+             * @param s The unused sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const size_t & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -81,6 +91,11 @@ namespace AIToolbox::MDP {
         return policy_.sampleAction();
     }
 
+    template <typename BP>
+    size_t BanditPolicyAdaptor<BP>::sampleAction(const size_t &, RandomEngine & rnd) const {
+        return policy_.sampleAction(rnd);
+    }
+
     template <typename BP>
     double BanditPolicyAdaptor<BP>::getActionProbability(const size_t &, const size_t & a) const {
         return policy_.getActionProbability(a);
@@ -36,13 +36,27 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the action probabilities for each of the input states.
+             *
+             * This function mixes the probabilities of the wrapped policy,
+             * computed in a single batch, with the uniform random policy.
+             *
+             * @param states The states to compute the probabilities for.
+             *
+             * @return A states.size() x A matrix of action probabilities.
+             */
+            virtual Matrix2D getActionProbabilities(std::span<const size_t> states) const override;
+
         protected:
             /**
              * @brief This function returns a random action in the Action space.
              *
+             * @param rnd The generator to use.
+             *
              * @return A valid random action.
              */
-            virtual size_t sampleRandomAction() const override;
+            virtual size_t sampleRandomAction(RandomEngine & rnd) const override;
 
             /**
              * @brief This function returns the probability of picking a random action.
@@ -50,9 +64,6 @@ namespace AIToolbox::MDP {
              * @return The probability of picking an an action at random.
              */
             virtual double getRandomActionProbability() const override;
-
-            // Used to sampled random actions
-            mutable std::uniform_int_distribution<size_t> randomDistribution_;
     };
 }
 
@@ -1,6 +1,8 @@
 #ifndef AI_TOOLBOX_MDP_POLICY_INTERFACE_HEADER_FILE
 #define AI_TOOLBOX_MDP_POLICY_INTERFACE_HEADER_FILE
 
+#include <span>
+
 #include <AIToolbox/Types.hpp>
 #include <AIToolbox/PolicyInterface.hpp>
 
@@ -24,7 +26,31 @@ namespace AIToolbox::MDP {
              * efficient manner.
              */
             virtual Matrix2D getPolicy() const = 0;
+
+            /**
+             * @brief This function returns the action probabilities for each of the input states.
+             *
+             * Row i of the returned matrix contains the probabilities of
+             * taking each action in states[i]. This is useful to score
+             * batches of states without calling getActionProbability() for
+             * every state-action pair; policies can override it with
+             * vectorized implementations.
+             *
+             * @param states The states to compute the probabilities for.
+             *
+             * @return A states.size() x A matrix of action probabilities.
+             */
+            virtual Matrix2D getActionProbabilities(std::span<const size_t> states) const;
     };
+
+    inline Matrix2D PolicyInterface::getActionProbabilities(std::span<const size_t> states) const {
+        Matrix2D retval(states.size(), A);
+        for (size_t i = 0; i < states.size(); ++i)
+            for (size_t a = 0; a < A; ++a)
+                retval(i, a) = getActionProbability(states[i], a);
+
+        return retval;
+    }
 }
 
 #endif
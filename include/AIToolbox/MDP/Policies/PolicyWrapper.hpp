@@ -48,6 +48,19 @@ namespace AIToolbox::MDP {
              */
             virtual size_t sampleAction(const size_t & s) const override;
 
+            /**
+             * @brief This function chooses a random action for state s, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const size_t & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -58,6 +71,28 @@ namespace AIToolbox::MDP {
              */
             virtual double getActionProbability(const size_t & s, const size_t & a) const override;
 
+            /**
+             * @brief This function chooses an action for each of the input states.
+             *
+             * This function samples each row of the policy matrix in turn.
+             *
+             * @param states The sampled states of the policy.
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<const size_t> states, std::span<size_t> out) const override;
+
+            /**
+             * @brief This function returns the action probabilities for each of the input states.
+             *
+             * This function simply gathers the rows of the input states from
+             * the policy matrix.
+             *
+             * @param states The states to compute the probabilities for.
+             *
+             * @return A states.size() x A matrix of action probabilities.
+             */
+            virtual Matrix2D getActionProbabilities(std::span<const size_t> states) const override;
+
             /**
              * @brief This function enables inspection of the internal policy.
              *
@@ -31,6 +31,19 @@ namespace AIToolbox::MDP {
              */
             virtual size_t sampleAction(const size_t & s) const override;
 
+            /**
+             * @brief This function chooses the greediest action for state s, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator used to break ties.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const size_t & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -59,6 +72,28 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function chooses an action for each of the input states.
+             *
+             * This function reuses the same internal buffer for all states.
+             *
+             * @param states The sampled states of the policy.
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<const size_t> states, std::span<size_t> out) const override;
+
+            /**
+             * @brief This function returns the action probabilities for each of the input states.
+             *
+             * Each row is computed in a single pass over the QFunction row,
+             * instead of one pass per action as getActionProbability() does.
+             *
+             * @param states The states to compute the probabilities for.
+             *
+             * @return A states.size() x A matrix of action probabilities.
+             */
+            virtual Matrix2D getActionProbabilities(std::span<const size_t> states) const override;
+
         private:
             // To avoid reallocating a vector every time for sampling.
             mutable std::vector<size_t> bestActions_;
@@ -51,6 +51,21 @@ namespace AIToolbox::MDP {
              */
             virtual size_t sampleAction(const size_t & s) const override;
 
+            /**
+             * @brief This function chooses an action for state s with probability dependent on value, using the input generator.
+             *
+             * This function can be called concurrently from multiple
+             * threads, as long as each uses its own generator.
+             *
+             * \sa sampleAction(const size_t & s);
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const size_t & s, RandomEngine & rnd) const override;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -76,6 +91,37 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function chooses an action for each of the input states.
+             *
+             * This function computes the softmax for all input states at once
+             * (see getActionProbabilities()), and then samples each row.
+             *
+             * As with sampleAction(const size_t &), this uses the internal
+             * generator, so it must not be called concurrently.
+             *
+             * @param states The sampled states of the policy.
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<const size_t> states, std::span<size_t> out) const override;
+
+            /**
+             * @brief This function returns the action probabilities for each of the input states.
+             *
+             * This function computes a row-wise softmax over the QFunction rows
+             * of all input states at once. The maximum of each row is subtracted
+             * before exponentiation, so that large values do not overflow.
+             *
+             * If the temperature is zero, this returns the greedy probabilities.
+             *
+             * This function can be called concurrently from multiple threads.
+             *
+             * @param states The states to compute the probabilities for.
+             *
+             * @return A states.size() x A matrix of action probabilities.
+             */
+            virtual Matrix2D getActionProbabilities(std::span<const size_t> states) const override;
+
             /**
              * @brief This function sets the temperature parameter.
              *
@@ -103,7 +149,10 @@ namespace AIToolbox::MDP {
 
         private:
             double temperature_;
-            // To avoid reallocating a vector every time for sampling.
+            // To avoid reallocating a vector every time for sampling. These
+            // are only used by sampleAction(const size_t &); the other const
+            // methods use local buffers. Note that sampleActions() still
+            // samples from the shared generator.
             mutable std::vector<size_t> bestActions_;
             mutable Vector vbuffer_;
     };
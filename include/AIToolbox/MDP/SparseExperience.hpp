@@ -167,6 +167,30 @@ namespace AIToolbox::MDP {
              */
             void reset();
 
+            /**
+             * @brief This function reserves slack capacity in each row of the internal tables.
+             *
+             * The sparse tables start in compressed form, but Eigen switches
+             * a table to uncompressed form as soon as a transition never
+             * seen before is recorded, and a full row is then grown by
+             * moving all following data in the table. After this call each
+             * row can hold at least the specified number of non-zeros, so
+             * new transitions are inserted in place.
+             * Note that reset() compresses the tables again.
+             *
+             * @param rowCapacity The minimum number of non-zero elements each row can hold.
+             */
+            void reserveRows(size_t rowCapacity);
+
+            /**
+             * @brief This function packs the internal tables into compressed form.
+             *
+             * This removes any explicitly stored zeros (e.g. the M2 of
+             * pairs visited once) and any slack left in the rows by
+             * reserveRows().
+             */
+            void compress();
+
             /**
              * @brief This function returns the number of times the record function has been called.
              *
@@ -270,6 +294,7 @@ namespace AIToolbox::MDP {
             unsigned long timesteps_;
 
             friend std::istream& operator>>(std::istream &is, SparseExperience &);
+            friend class ConcurrentSparseExperience;
     };
 
     template <IsNaive3DTable V>
@@ -3,9 +3,11 @@
 
 #include <tuple>
 #include <random>
+#include <type_traits>
 
 #include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/Types.hpp>
+#include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
@@ -62,6 +64,20 @@ namespace AIToolbox::MDP {
      * action space of SxAxS. It also of course incredibly reduces memory
      * consumption in such cases, which may also improve speed by effect of
      * improved caching.
+     *
+     * The sparse matrices start in compressed form, but Eigen switches a
+     * matrix to uncompressed form as soon as a sync inserts a transition
+     * never seen before. From then on, each row grows on its own, and a
+     * full row is grown by moving all following data in the matrix. When
+     * learning online, reserveRows() can be used to give each row some
+     * slack capacity up front: syncing a state-action pair then only costs
+     * time proportional to the non-zeros in its row.
+     *
+     * Syncs also leave explicitly stored zeros in the matrices, for
+     * example for the initial self-transition of a state-action pair that
+     * has been visited. Once learning is done (or before handing the model
+     * to a planner), compress() removes them and packs the matrices back
+     * into compressed form.
      */
     template <IsExperience E>
     class SparseMaximumLikelihoodModel {
@@ -157,6 +173,40 @@ namespace AIToolbox::MDP {
              */
             void sync(size_t s, size_t a, size_t s1);
 
+            /**
+             * @brief This function reserves slack capacity in each row of the model.
+             *
+             * After this call, the transition and reward matrices are kept
+             * uncompressed, and each of their rows has space for at least
+             * the specified number of non-zero elements. Syncs which add new
+             * transitions to a row then insert them in place, without moving
+             * the data of the other rows. If a row runs out of space, only
+             * then the matrix is reallocated, doubling the space for that row.
+             *
+             * Uncompressed matrices can be used normally, but planners may
+             * be faster with compressed ones; see compress().
+             *
+             * @param rowCapacity The minimum number of non-zero elements each row can hold.
+             */
+            void reserveRows(size_t rowCapacity);
+
+            /**
+             * @brief This function packs the transition and reward matrices into compressed form.
+             *
+             * This removes any explicitly stored zeros left by syncs, and
+             * any slack left in the rows by reserveRows(). New syncs will
+             * still work, but inserting new transitions will again need to
+             * move the data of the matrices.
+             */
+            void compress();
+
+            /**
+             * @brief This function returns whether the transition and reward matrices are in compressed form.
+             *
+             * @return True if all matrices are compressed, false otherwise.
+             */
+            bool isCompressed() const;
+
             /**
              * @brief This function samples the MDP for the specified state action pair.
              *
@@ -319,19 +369,31 @@ namespace AIToolbox::MDP {
         // we check different from rewards_, rather than zero, because it's
         // possible that by averaging some rewards go BACK to zero, rather than
         // away from it. In those case we still have to set the new rewards to zero.
-        if (checkDifferentSmall(rewards_.coeffRef(s, a), experience_.getReward(s, a)))
+        if (checkDifferentSmall(rewards_.coeff(s, a), experience_.getReward(s, a)))
             rewards_.coeffRef(s, a) = experience_.getReward(s, a);
 
-        // Clear beginning's identity matrix
-        if ( visitSum == 1ul )
-            transitions_[a].coeffRef(s, s) = 0.0;
-
         // Create reciprocal for fast division
         const double visitSumReciprocal = 1.0 / visitSum;
 
         if constexpr (IsExperienceEigen<E>) {
-            transitions_[a].row(s) = experience_.getVisitsTable(a).row(s).template cast<double>() * visitSumReciprocal;
+            using VisitsTable = std::remove_cvref_t<decltype(experience_.getVisitsTable(a))>;
+            if constexpr (std::is_base_of_v<Eigen::SparseMatrixBase<VisitsTable>, VisitsTable>) {
+                // Here we only touch the non-zeros of the row. Since visits
+                // never go down, the only element we may have to clear is
+                // the initial self-transition.
+                for (SparseMatrix2D::InnerIterator it(transitions_[a], s); it; ++it)
+                    it.valueRef() = 0.0;
+
+                for (typename VisitsTable::InnerIterator it(experience_.getVisitsTable(a), s); it; ++it)
+                    transitions_[a].coeffRef(s, it.col()) = static_cast<double>(it.value()) * visitSumReciprocal;
+            } else {
+                transitions_[a].row(s) = experience_.getVisitsTable(a).row(s).template cast<double>() * visitSumReciprocal;
+            }
         } else {
+            // Clear beginning's identity matrix
+            if ( visitSum == 1ul )
+                transitions_[a].coeffRef(s, s) = 0.0;
+
             // Normalize
             for ( size_t s1 = 0; s1 < S; ++s1 ) {
                 const auto visits = experience_.getVisits(s, a, s1);
@@ -352,7 +414,7 @@ namespace AIToolbox::MDP {
         // we check different from rewards_, rather than zero, because it's
         // possible that by averaging some rewards go BACK to zero, rather than
         // away from it. In those case we still have to set the new rewards to zero.
-        if (checkDifferentSmall(rewards_.coeffRef(s, a), experience_.getReward(s, a)))
+        if (checkDifferentSmall(rewards_.coeff(s, a), experience_.getReward(s, a)))
             rewards_.coeffRef(s, a) = experience_.getReward(s, a);
 
         if ( visitSum == 1ul ) {
@@ -368,10 +430,33 @@ namespace AIToolbox::MDP {
             // In the end of the process the new values will be the same as if we updated directly using
             // an increased denominator, and thus we will be able to call this function again correctly.
             transitions_[a].coeffRef(s, s1) = newTransitionValue;
-            transitions_[a].row(s) /= newVectorSum;
+            for (SparseMatrix2D::InnerIterator it(transitions_[a], s); it; ++it)
+                it.valueRef() /= newVectorSum;
         }
     }
 
+    template <IsExperience E>
+    void SparseMaximumLikelihoodModel<E>::reserveRows(const size_t rowCapacity) {
+        for (auto & t : transitions_)
+            reserveSparseRows(t, rowCapacity);
+        reserveSparseRows(rewards_, rowCapacity);
+    }
+
+    template <IsExperience E>
+    void SparseMaximumLikelihoodModel<E>::compress() {
+        // Pruning also compresses the matrices.
+        for (auto & t : transitions_)
+            t.prune(0.0);
+        rewards_.prune(0.0);
+    }
+
+    template <IsExperience E>
+    bool SparseMaximumLikelihoodModel<E>::isCompressed() const {
+        for (const auto & t : transitions_)
+            if (!t.isCompressed()) return false;
+        return rewards_.isCompressed();
+    }
+
     template <IsExperience E>
     std::tuple<size_t, double> SparseMaximumLikelihoodModel<E>::sampleSR(const size_t s, const size_t a) const {
         const size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
@@ -73,11 +73,19 @@ namespace AIToolbox::MDP {
      * SxAxS. It also of course incredibly reduces memory consumption in
      * such cases, which may also improve speed by effect of improved
      * caching.
+     *
+     * As with ModelT, the scalar parameter selects the type used to store
+     * the transition and reward functions. This class is instantiated for
+     * double and float; SparseModel is the double version.
+     *
+     * @tparam T The scalar type used to store the model.
      */
-    class SparseModel {
+    template <typename T>
+    class SparseModelT {
         public:
-            using TransitionMatrix   = SparseMatrix3D;
-            using RewardMatrix       = SparseMatrix2D;
+            using Scalar             = T;
+            using TransitionMatrix   = SparseMatrix3DT<T>;
+            using RewardMatrix       = SparseMatrix2DT<T>;
 
             /**
              * @brief Basic constructor.
@@ -93,7 +101,7 @@ namespace AIToolbox::MDP {
              * @param a The number of actions available to the agent.
              * @param discount The discount factor for the MDP.
              */
-            SparseModel(size_t s, size_t a, double discount = 1.0);
+            SparseModelT(size_t s, size_t a, double discount = 1.0);
 
             /**
              * @brief Basic constructor.
@@ -128,7 +136,7 @@ namespace AIToolbox::MDP {
              * otherwise the constructor will throw an
              * std::invalid_argument.
              *
-             * @tparam T The external transition container type.
+             * @tparam TM The external transition container type.
              * @tparam R The external rewards container type.
              * @param s The number of states of the world.
              * @param a The number of actions available to the agent.
@@ -136,8 +144,8 @@ namespace AIToolbox::MDP {
              * @param r The external rewards container.
              * @param d The discount factor for the MDP.
              */
-            template <IsNaive3DMatrix T, IsNaive3DMatrix R>
-            SparseModel(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
+            template <IsNaive3DMatrix TM, IsNaive3DMatrix R>
+            SparseModelT(size_t s, size_t a, const TM & t, const R & r, double d = 1.0);
 
             /**
              * @brief Copy constructor from any valid MDP model.
@@ -152,7 +160,7 @@ namespace AIToolbox::MDP {
              * @param model The model that needs to be copied.
              */
             template <IsModel M>
-            SparseModel(const M& model);
+            SparseModelT(const M& model);
 
             /**
              * @brief Unchecked constructor.
@@ -171,7 +179,7 @@ namespace AIToolbox::MDP {
              * @param r The reward function to be used in the SparseModel.
              * @param d The discount factor for the SparseModel.
              */
-            SparseModel(NoCheck, size_t s, size_t a, TransitionMatrix && t, RewardMatrix && r, double d);
+            SparseModelT(NoCheck, size_t s, size_t a, TransitionMatrix && t, RewardMatrix && r, double d);
 
             /**
              * @brief This function replaces the transition function with the one provided.
@@ -198,11 +206,11 @@ namespace AIToolbox::MDP {
              * it into an Eigen Sparse container and feeding that
              * to this class.
              *
-             * @tparam T The external transition container type.
+             * @tparam TM The external transition container type.
              * @param t The external transitions container.
              */
-            template <IsNaive3DMatrix T>
-            void setTransitionFunction(const T & t);
+            template <IsNaive3DMatrix TM>
+            void setTransitionFunction(const TM & t);
 
             /**
              * @brief This function sets the transition function using a SparseMatrix3D.
@@ -291,6 +299,22 @@ namespace AIToolbox::MDP {
              */
             std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
 
+            /**
+             * @brief This function samples the MDP with the specified state action pair, using the input generator.
+             *
+             * This function is equivalent to sampleSR(size_t, size_t),
+             * but it does not touch the internal generator of the model.
+             * This allows sampling the model concurrently from multiple
+             * threads, each with its own generator.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The generator to use.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a, RandomEngine & rnd) const;
+
             /**
              * @brief This function returns the number of states of the world.
              *
@@ -348,7 +372,7 @@ namespace AIToolbox::MDP {
              *
              * @return The transition function for the input action.
              */
-            const SparseMatrix2D & getTransitionFunction(size_t a) const;
+            const SparseMatrix2DT<T> & getTransitionFunction(size_t a) const;
 
             /**
              * @brief This function returns the rewards matrix for inspection.
@@ -376,9 +400,15 @@ namespace AIToolbox::MDP {
             mutable RandomEngine rand_;
     };
 
-    template <IsNaive3DMatrix T, IsNaive3DMatrix R>
-    SparseModel::SparseModel(const size_t s, const size_t a, const T & t, const R & r, const double d) :
-            S(s), A(a), transitions_(A, SparseMatrix2D(S, S)),
+    /**
+     * @brief This is the double precision sparse MDP model.
+     */
+    using SparseModel = SparseModelT<double>;
+
+    template <typename T>
+    template <IsNaive3DMatrix TM, IsNaive3DMatrix R>
+    SparseModelT<T>::SparseModelT(const size_t s, const size_t a, const TM & t, const R & r, const double d) :
+            S(s), A(a), transitions_(A, SparseMatrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         setDiscount(d);
@@ -386,9 +416,10 @@ namespace AIToolbox::MDP {
         setRewardFunction(r);
     }
 
+    template <typename T>
     template <IsModel M>
-    SparseModel::SparseModel(const M& model) :
-            S(model.getS()), A(model.getA()), transitions_(A, SparseMatrix2D(S, S)),
+    SparseModelT<T>::SparseModelT(const M& model) :
+            S(model.getS()), A(model.getA()), transitions_(A, SparseMatrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         setDiscount(model.getDiscount());
@@ -403,7 +434,7 @@ namespace AIToolbox::MDP {
                 const double r = model.getExpectedReward(s, a, s1);
                 if ( checkDifferentSmall(0.0, r) ) rewards_.coeffRef(s, a) += r * p;
             }
-            if ( checkDifferentSmall(1.0, transitions_[a].row(s).sum()) )
+            if ( checkDifferentSmall(1.0, transitions_[a].row(s).template cast<double>().sum()) )
                 throw std::invalid_argument("Input transition matrix contains an invalid row.");
         }
 
@@ -412,8 +443,9 @@ namespace AIToolbox::MDP {
         rewards_.makeCompressed();
     }
 
-    template <IsNaive3DMatrix T>
-    void SparseModel::setTransitionFunction(const T & t) {
+    template <typename T>
+    template <IsNaive3DMatrix TM>
+    void SparseModelT<T>::setTransitionFunction(const TM & t) {
         if (!isProbability(S, A, S, t))
             throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
 
@@ -430,8 +462,9 @@ namespace AIToolbox::MDP {
         }
     }
 
+    template <typename T>
     template <IsNaive3DMatrix R>
-    void SparseModel::setRewardFunction(const R & r) {
+    void SparseModelT<T>::setRewardFunction(const R & r) {
         rewards_.setZero();
         for ( size_t a = 0; a < A; ++a ) {
             for ( size_t s = 0; s < S; ++s ) {
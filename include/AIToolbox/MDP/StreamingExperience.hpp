@@ -0,0 +1,198 @@
+#ifndef AI_TOOLBOX_MDP_STREAMING_EXPERIENCE_HEADER_FILE
+#define AI_TOOLBOX_MDP_STREAMING_EXPERIENCE_HEADER_FILE
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/Experience.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class keeps recency-weighted statistics of registered events and rewards.
+     *
+     * This is the tabular counterpart of
+     * Factored::MDP::StreamingCooperativeExperience: see that class for how
+     * exponential and windowed decay work, and for how shards recorded on
+     * different threads are merged.
+     *
+     * Here the statistics are kept per state-action pair, and are exported
+     * into an Experience, after which the models using it can be synced
+     * normally.
+     */
+    class StreamingExperience {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * The decay and window follow the same rules as in
+             * Factored::MDP::StreamingCooperativeExperience, and invalid
+             * values throw an std::invalid_argument.
+             *
+             * @param S The number of states of the world.
+             * @param A The number of actions available to the agent.
+             * @param decay The exponential decay to apply to old events.
+             * @param window The number of timesteps in each block of the window.
+             */
+            StreamingExperience(size_t S, size_t A, double decay = 1.0, unsigned long window = 0);
+
+            /**
+             * @brief This function adds a new event to the recordings.
+             *
+             * @param s     Old state.
+             * @param a     Performed action.
+             * @param s1    New state.
+             * @param rew   Obtained reward.
+             */
+            void record(size_t s, size_t a, size_t s1, double rew);
+
+            /**
+             * @brief This function merges the statistics of another instance into this one.
+             *
+             * The two instances must have the same S, A, decay and window,
+             * otherwise this function will throw an std::invalid_argument.
+             *
+             * @param other The instance to merge into this one.
+             */
+            void merge(const StreamingExperience & other);
+
+            /**
+             * @brief This function copies the current statistics into an Experience.
+             *
+             * The effective visits are converted as in
+             * Factored::MDP::StreamingCooperativeExperience::exportTo(), with
+             * each state-action pair taking the role of a row.
+             *
+             * The Experience must have the same S and A as this instance.
+             *
+             * @param exp The Experience to overwrite.
+             */
+            void exportTo(Experience * exp) const;
+
+            /**
+             * @brief This function resets all experienced rewards and transitions.
+             */
+            void reset();
+
+            /**
+             * @brief This function returns the effective number of visits of a transition.
+             *
+             * @param s Old state.
+             * @param a Performed action.
+             * @param s1 New state.
+             *
+             * @return The effective number of visits.
+             */
+            double getVisits(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the effective number of visits of a state-action pair.
+             *
+             * @param s Old state.
+             * @param a Performed action.
+             *
+             * @return The effective number of visits.
+             */
+            double getVisitsSum(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the weighted average reward of a state-action pair.
+             *
+             * @param s Old state.
+             * @param a Performed action.
+             *
+             * @return The weighted average reward.
+             */
+            double getReward(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the weighted M2 statistic of the rewards of a state-action pair.
+             *
+             * @param s Old state.
+             * @param a Performed action.
+             *
+             * @return The weighted M2 statistic.
+             */
+            double getM2(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the number of times the record function has been called.
+             *
+             * This includes the timesteps recorded by merged instances.
+             *
+             * @return The number of recorded timesteps.
+             */
+            unsigned long getTimesteps() const;
+
+            /**
+             * @brief This function returns the exponential decay.
+             *
+             * @return The exponential decay.
+             */
+            double getDecay() const;
+
+            /**
+             * @brief This function returns the number of timesteps in each block of the window.
+             *
+             * @return The window size, or 0 if there is no window.
+             */
+            unsigned long getWindow() const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            size_t getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            size_t getA() const;
+
+        private:
+            // The statistics of a block of timesteps. With exponential
+            // decay all visits and M2 values are scaled by the same factor,
+            // which is the weight of the last recorded event.
+            struct Block {
+                Matrix3D visits;
+                Matrix2D visitsSum;
+                Matrix2D rewards;
+                Matrix2D M2s;
+            };
+
+            /**
+             * @brief This function computes the combined statistics of a state-action pair across blocks.
+             */
+            void getPair(size_t s, size_t a, double * n, double * mean, double * m2) const;
+
+            /**
+             * @brief This function merges the statistics of a block into another.
+             *
+             * The visits and M2 values of the input block are multiplied by
+             * the input scale before being merged.
+             */
+            static void mergeBlock(Block & lhs, const Block & rhs, double scale);
+
+            /**
+             * @brief This function divides all weights by the current increment.
+             */
+            void rescale();
+
+            /**
+             * @brief This function zeroes all statistics of a block.
+             */
+            static void zero(Block & b);
+
+            size_t S, A;
+            double decay_;
+            unsigned long window_;
+
+            Block current_, previous_;
+            double increment_;
+
+            unsigned long timesteps_, blockTimesteps_;
+    };
+}
+
+#endif
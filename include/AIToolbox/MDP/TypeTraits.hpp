@@ -74,6 +74,57 @@ namespace AIToolbox::MDP {
         requires IsDerivedFromEigen<std::remove_cvref_t<decltype((m.getRewardFunction()))>>;
     };
 
+    /**
+     * @brief This concept represents the required interface for a transition kernel.
+     *
+     * A transition kernel describes the transitions of an MDP by listing,
+     * on demand, the successors of each state-action pair. This is useful
+     * for MDPs where the transitions follow from a simple local rule (like
+     * in grid worlds), so that they never need to be stored.
+     *
+     * The interface must be implemented and be public in the parameter
+     * class. The interface is the following:
+     *
+     * - size_t getS() const : Returns the number of states of the kernel.
+     * - size_t getA() const : Returns the number of actions of the kernel.
+     * - void forEachTransition(size_t s, size_t a, F f) const : Calls f(s1, p, r) for every successor s1 of (s,a), with its probability p and reward r.
+     *
+     * The probabilities reported for each state-action pair must sum to
+     * one. The same successor may be reported more than once, in which
+     * case its probabilities are summed.
+     */
+    template <typename K>
+    concept IsTransitionKernel = requires (const K k, size_t s, size_t a) {
+        { k.getS() } -> std::convertible_to<size_t>;
+        { k.getA() } -> std::convertible_to<size_t>;
+        k.forEachTransition(s, a, [](size_t, double, double) {});
+    };
+
+    /**
+     * @brief This concept represents the required interface that allows MDP algorithms to work on models without a stored transition function.
+     *
+     * This concept tests for the interface of an MDP model which can apply
+     * its transition function to a vector without materializing it, like
+     * a matrix-free operator.
+     *
+     * The interface must be implemented and be public in the parameter
+     * class. The interface is the following:
+     *
+     * - void applyTransitionFunction(const Values & v, QFunction & q) const : Adds to each q(s,a) the expectation of v over the successors of (s,a).
+     * - R getRewardFunction() const : Returns the reward function as a matrix SxA', where R is some Eigen matrix type.
+     *
+     * In addition the MDP needs to respect the interface for the MDP model.
+     *
+     * \sa IsModel
+     */
+    template <typename M>
+    concept IsModelMatrixFree = IsModel<M> && requires (const M m, const Values & v, QFunction & q) {
+        m.applyTransitionFunction(v, q);
+
+        m.getRewardFunction();
+        requires IsDerivedFromEigen<std::remove_cvref_t<decltype((m.getRewardFunction()))>>;
+    };
+
     /**
      * @brief This concept represents the required interface for an experience recorder.
      *
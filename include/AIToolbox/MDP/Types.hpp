@@ -51,6 +51,18 @@ namespace AIToolbox::MDP {
 
     using QFunction = Matrix2D;
 
+    /**
+     * @brief A QFunction stored with the specified scalar type.
+     *
+     * The tabular learners (e.g. QLearningT) can store their QFunction in
+     * single precision, which halves their memory and bandwidth; all
+     * learning parameters and rewards are still passed as double. Policies
+     * work on double QFunctions, so a float QFunction must be cast (e.g.
+     * `q.cast<double>()`) before a policy can be built on it.
+     */
+    template <typename T>
+    using QFunctionT = Matrix2DT<T>;
+
     /** @}  */
 }
 
@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_MDP_UTILS_HEADER_FILE
 
 #include <stddef.h>
+#include <type_traits>
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
 
@@ -69,6 +70,9 @@ namespace AIToolbox::MDP {
      *
      * Note that this function is more efficient with eigen models.
      *
+     * The rewards are always returned in double precision, even if the
+     * model stores them as float.
+     *
      * @param model The MDP that needs to be solved.
      *
      * @return The Models's immediate rewards.
@@ -76,6 +80,12 @@ namespace AIToolbox::MDP {
     template <IsModel M>
     Matrix2D computeImmediateRewards(const M & model) {
         if constexpr(IsModelEigen<M>) {
+            using Scalar = typename std::remove_cvref_t<decltype(model.getRewardFunction())>::Scalar;
+            if constexpr (std::is_same_v<Scalar, double>)
+                return model.getRewardFunction();
+            else
+                return model.getRewardFunction().template cast<double>();
+        } else if constexpr(IsModelMatrixFree<M>) {
             return model.getRewardFunction();
         } else {
             const auto S = model.getS();
@@ -94,7 +104,13 @@ namespace AIToolbox::MDP {
     /**
      * @brief This function computes the Model's QFunction from the values of a ValueFunction.
      *
-     * Note that this function is more efficient with eigen models.
+     * Note that this function is more efficient with eigen models, and with
+     * models that can apply their transition function without storing it.
+     *
+     * If the model stores its transitions in a scalar other than double,
+     * the input values are converted once to that scalar, so that the
+     * products with the transition matrices run at that precision. Their
+     * results are still accumulated in double into the QFunction.
      *
      * @param model The MDP that needs to be solved.
      * @param v The values of the ValueFunction for the future of the QFunction.
@@ -107,8 +123,20 @@ namespace AIToolbox::MDP {
         const auto A = model.getA();
 
         if constexpr(IsModelEigen<M>) {
-            for ( size_t a = 0; a < A; ++a )
-                ir.col(a).noalias() += model.getTransitionFunction(a) * v;
+            using Scalar = typename std::remove_cvref_t<decltype(model.getTransitionFunction(0))>::Scalar;
+            if constexpr (std::is_same_v<Scalar, double>) {
+                for ( size_t a = 0; a < A; ++a )
+                    ir.col(a).noalias() += model.getTransitionFunction(a) * v;
+            } else {
+                const VectorT<Scalar> vs = v.template cast<Scalar>();
+                VectorT<Scalar> tmp;
+                for ( size_t a = 0; a < A; ++a ) {
+                    tmp.noalias() = model.getTransitionFunction(a) * vs;
+                    ir.col(a) += tmp.template cast<double>();
+                }
+            }
+        } else if constexpr(IsModelMatrixFree<M>) {
+            model.applyTransitionFunction(v, ir);
         } else {
             const auto S = model.getS();
             for ( size_t s = 0; s < S; ++s )
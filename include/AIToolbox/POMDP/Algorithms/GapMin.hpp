@@ -8,6 +8,7 @@
 #include <AIToolbox/Logging.hpp>
 
 #include <AIToolbox/Utils/Polytope.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
@@ -134,6 +135,20 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, double, VList, MDP::QFunction> operator()(const M & model, const Belief & initialBelief);
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of iterations, the LP solves
+             * performed for the upper bound interpolations, the number of
+             * lower bound vectors pruned, the time spent, and the gap
+             * between the bounds of the initial belief after each
+             * iteration.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             using IntermediatePOMDP = Model<MDP::Model>;
 
@@ -174,7 +189,7 @@ namespace AIToolbox::POMDP {
                 const Belief & belief,
                 const VList & lbV,
                 const std::vector<Belief> & lbBeliefs,
-                const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV
+                const MDP::QFunction & ubQ, const IndexedPointSurface & ubV
             );
 
             /**
@@ -197,7 +212,7 @@ namespace AIToolbox::POMDP {
              * @return A pair with a reward-function only POMDP, and its associated SOSA matrix.
              */
             template <IsModel M>
-            std::tuple<IntermediatePOMDP, SparseMatrix4D> makeNewPomdp(const M& model, const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV);
+            std::tuple<IntermediatePOMDP, SparseMatrix4D> makeNewPomdp(const M& model, const MDP::QFunction & ubQ, const IndexedPointSurface & ubV);
 
             /**
              * @brief This function skims useless beliefs from the ubV.
@@ -215,12 +230,14 @@ namespace AIToolbox::POMDP {
              * @param ubV The current belief-value pairs.
              * @param fibQ The alphavectors associated with the ubV.
              */
-            void cleanUp(const MDP::QFunction & ubQ, UpperBoundValueFunction * ubV, Matrix2D * fibQ);
+            void cleanUp(const MDP::QFunction & ubQ, IndexedPointSurface * ubV, Matrix2D * fibQ);
 
             Matrix2D immediateRewards_;
             double tolerance_;
             double initialTolerance_;
             unsigned precisionDigits_;
+
+            SolverStatistics stats_;
     };
 
     template <IsModel M>
@@ -234,6 +251,8 @@ namespace AIToolbox::POMDP {
         // Reset tolerance to set parameter;
         tolerance_ = initialTolerance_;
 
+        SolverStatisticsRecorder record(stats_);
+
         // Helper methods
         BlindStrategies bs(infiniteHorizon, tolerance_);
         FastInformedBound fib(infiniteHorizon, tolerance_);
@@ -242,7 +261,11 @@ namespace AIToolbox::POMDP {
         // Here we use the BlindStrategies in order to obtain a very simple
         // initial lower bound.
         VList lbVList = std::get<1>(bs(pomdp, true));
-        lbVList.erase(extractDominated(std::begin(lbVList), std::end(lbVList), unwrap), std::end(lbVList));
+        {
+            const auto bound = extractDominated(std::begin(lbVList), std::end(lbVList), unwrap);
+            if (record) stats_.prunedVectors += std::distance(bound, std::end(lbVList));
+            lbVList.erase(bound, std::end(lbVList));
+        }
 
         auto lbBeliefs = std::vector<Belief>{initialBelief};
 
@@ -266,9 +289,11 @@ namespace AIToolbox::POMDP {
         // FastInformedBound), and a series of belief-value pairs, which we'll
         // use with the later-constructed new POMDP in order to improve our
         // bounds.
-        UpperBoundValueFunction ubV = {
-            {initialBelief}, {fibQ.row(pomdp.getS()).maxCoeff()}
-        };
+        //
+        // Since we query the upper bound for every successor of every belief
+        // we examine, we keep the belief-value pairs indexed.
+        IndexedPointSurface ubV(ubQ);
+        ubV.add(initialBelief, fibQ.row(pomdp.getS()).maxCoeff());
 
         // We also store two numbers for the overall lowerBound/upperBound
         // differences. They are the values of the lowerBound and the
@@ -276,7 +301,7 @@ namespace AIToolbox::POMDP {
         double lb;
         findBestAtPoint(initialBelief, std::begin(lbVList), std::end(lbVList), &lb, unwrap);
 
-        double ub = ubV.second[0];
+        double ub = ubV.getValues()[0];
 
         AI_LOGGER(AI_SEVERITY_INFO, "Initial bounds: " << lb << ", " << ub);
 
@@ -287,6 +312,8 @@ namespace AIToolbox::POMDP {
             if (checkEqualSmall(var, 0.0) || var < threshold)
                 break;
 
+            if (record) ++stats_.iterations;
+
             tolerance_ = threshold * (1.0 - pomdp.getDiscount()) / 2.0;
             // Now we find beliefs for both lower and upper bound where we
             // think we can improve. For the ub beliefs we also return their
@@ -307,6 +334,7 @@ namespace AIToolbox::POMDP {
                     // Then we remove all beliefs which don't actively support any
                     // alphaVectors.
                     auto sol = pbvi(pomdp, lbBeliefs, ValueFunction{std::move(lbVList)});
+                    if (record) stats_.prunedVectors += pbvi.getStatistics().prunedVectors;
 
                     lbVList = std::move(std::get<1>(sol).back());
 
@@ -328,7 +356,7 @@ namespace AIToolbox::POMDP {
 
             if (newUbBeliefsSize > 0) {
                 // Here we do the same for the upper bound.
-                const auto prevRows = pomdp.getS() + ubV.first.size();
+                const auto prevRows = pomdp.getS() + ubV.size();
                 fibQ.conservativeResize(prevRows + newUbBeliefsSize, Eigen::NoChange);
 
                 AI_LOGGER(AI_SEVERITY_DEBUG, "UB: Adding " << newUbBeliefsSize << " new beliefs...");
@@ -341,8 +369,7 @@ namespace AIToolbox::POMDP {
                 // in the fibQ which will come useful on the next round of
                 // FastInformedBound.
                 for (size_t i = 0; i < newUbBeliefs.size(); ++i) {
-                    ubV.first.emplace_back(std::move(newUbBeliefs[i]));
-                    ubV.second.emplace_back(newUbVals[i]);
+                    ubV.add(std::move(newUbBeliefs[i]), newUbVals[i]);
                     fibQ.row(prevRows + i).fill(newUbVals[i]);
                 }
 
@@ -355,8 +382,9 @@ namespace AIToolbox::POMDP {
                 // upperBound alphavectors. We additionally update the values
                 // for all ub beliefs.
                 ubQ.noalias() = fibQ.topRows(pomdp.getS());
-                for (size_t i = 0; i < ubV.second.size(); ++i)
-                    ubV.second[i] = fibQ.row(pomdp.getS() + i).maxCoeff();
+                ubV.setCorners(ubQ);
+                for (size_t i = 0; i < ubV.size(); ++i)
+                    ubV.setValue(i, fibQ.row(pomdp.getS() + i).maxCoeff());
 
                 // Finally, we remove some unused stuff, and we recompute the upperbound.
                 cleanUp(ubQ, &ubV, &fibQ);
@@ -368,7 +396,8 @@ namespace AIToolbox::POMDP {
             // return it/use it to stop the loop.
             auto oldVar = var;
             var = ub - lb;
-            AI_LOGGER(AI_SEVERITY_INFO, "Updated bounds to " << lb << ", " << ub << " -- size LB: " << lbVList.size() << ", size UB " << ubV.first.size());
+            if (record) stats_.residuals.push_back(var);
+            AI_LOGGER(AI_SEVERITY_INFO, "Updated bounds to " << lb << ", " << ub << " -- size LB: " << lbVList.size() << ", size UB " << ubV.size());
 
             // Stop if we didn't find anything new, or if we have converged the bounds.
             if (newLbBeliefsSize + newUbBeliefsSize == 0 || std::fabs(var - oldVar) < tolerance_ * 5)
@@ -378,8 +407,8 @@ namespace AIToolbox::POMDP {
     }
 
     template <IsModel M>
-    std::tuple<GapMin::IntermediatePOMDP, SparseMatrix4D> GapMin::makeNewPomdp(const M& model, const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV) {
-        size_t S = model.getS() + ubV.first.size();
+    std::tuple<GapMin::IntermediatePOMDP, SparseMatrix4D> GapMin::makeNewPomdp(const M& model, const MDP::QFunction & ubQ, const IndexedPointSurface & ubV) {
+        size_t S = model.getS() + ubV.size();
 
         // First we build the new reward function. For normal states, this is
         // the same as the old one. For all additional states (beliefs), we
@@ -392,8 +421,8 @@ namespace AIToolbox::POMDP {
         }();
 
         R.topRows(model.getS()) = ir;
-        for (size_t b = 0; b < ubV.first.size(); ++b)
-            R.row(model.getS()+b) = ubV.first[b].transpose() * ir;
+        for (size_t b = 0; b < ubV.size(); ++b)
+            R.row(model.getS()+b) = ubV.getPoints()[b].transpose() * ir;
 
         // Now we create the SOSA matrix for this new POMDP. For each pair of
         // action/observation, and for each belief we have (thus state), we
@@ -428,8 +457,8 @@ namespace AIToolbox::POMDP {
                     corner[s] = 0.0;
                 }
 
-                for (size_t b = 0; b < ubV.first.size(); ++b)
-                    updateMatrix(m, ubV.first[b], a, o, model.getS() + b);
+                for (size_t b = 0; b < ubV.size(); ++b)
+                    updateMatrix(m, ubV.getPoints()[b], a, o, model.getS() + b);
 
                 // After updating all rows of the matrix, we put it inside the
                 // SOSA matrix.
@@ -455,7 +484,7 @@ namespace AIToolbox::POMDP {
     template <IsModel M>
     std::tuple<std::vector<Belief>, std::vector<Belief>, std::vector<double>> GapMin::selectReachableBeliefs(
             const M & pomdp, const Belief & initialBelief, const VList & lbVList,
-            const std::vector<Belief> & lbBeliefs, const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV
+            const std::vector<Belief> & lbBeliefs, const MDP::QFunction & ubQ, const IndexedPointSurface & ubV
         )
     {
         std::vector<Belief> newLbBeliefs, newUbBeliefs, visitedBeliefs;
@@ -469,7 +498,7 @@ namespace AIToolbox::POMDP {
         unsigned newBeliefs = 0;
 
         // From the original code, a limitation on how many new beliefs we find.
-        const auto maxNewBeliefs = std::max(20lu, (ubV.first.size() + lbVList.size()) / 5lu);
+        const auto maxNewBeliefs = std::max(20lu, (ubV.size() + lbVList.size()) / 5lu);
 
         // We initialize the queue with the initial belief.
         {
@@ -525,7 +554,7 @@ namespace AIToolbox::POMDP {
                 const auto check = [&b](const Belief & bb){ return checkEqualProbability(b, bb); };
                 if (std::any_of(std::begin(newUbBeliefs), std::end(newUbBeliefs), check))
                     return false;
-                if (std::any_of(std::begin(ubV.first), std::end(ubV.first), check))
+                if (std::any_of(std::begin(ubV.getPoints()), std::end(ubV.getPoints()), check))
                     return false;
                 return true;
             };
@@ -5,6 +5,7 @@
 
 #include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/Utils/Prune.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/POMDP/Utils.hpp>
@@ -115,6 +116,31 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, ValueFunction> operator()(const M & model);
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of iterations, the number of
+             * pruned vectors, the time spent, and the variation between the
+             * last two ValueFunctions after each iteration.
+             *
+             * The LP solves are not counted here, as they are reported by
+             * getLPStatistics().
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
+            /**
+             * @brief This function returns the statistics of the LP solves of the last call.
+             *
+             * These are the solves performed while pruning, and are always
+             * recorded, regardless of instrumentation.
+             *
+             * @return The LP statistics of the last call.
+             */
+            const LP::Statistics & getLPStatistics() const;
+
         private:
             /**
              * @brief This function computes a VList composed of all possible combinations of sums of the VLists provided.
@@ -140,6 +166,9 @@ namespace AIToolbox::POMDP {
             size_t S, A, O;
             unsigned horizon_;
             double tolerance_;
+
+            SolverStatistics stats_;
+            LP::Statistics lpStats_;
     };
 
     template <IsModel M>
@@ -151,6 +180,9 @@ namespace AIToolbox::POMDP {
 
         auto v = makeValueFunction(S); // TODO: May take user input
 
+        SolverStatisticsRecorder record(stats_, false);
+        const auto lpStart = LP::getThreadStatistics();
+
         unsigned timestep = 0;
 
         Pruner prune(S);
@@ -179,7 +211,9 @@ namespace AIToolbox::POMDP {
                 for ( size_t o = 0; o < O; ++o ) {
                     const auto begin = std::begin(projs[a][o]);
                     const auto end   = std::end  (projs[a][o]);
-                    projs[a][o].erase(prune(begin, end, unwrap), end);
+                    const auto bound = prune(begin, end, unwrap);
+                    if ( record ) stats_.prunedVectors += std::distance(bound, end);
+                    projs[a][o].erase(bound, end);
                 }
 
                 // TODO: A better strategy for the code below might be to
@@ -216,7 +250,9 @@ namespace AIToolbox::POMDP {
                         projs[a][i] = crossSum(projs[a][i], projs[a][i + diff], a, stepsize > 0);
                         const auto begin = std::begin(projs[a][i]);
                         const auto end   = std::end  (projs[a][i]);
-                        projs[a][i].erase(prune(begin, end, unwrap), end);
+                        const auto bound = prune(begin, end, unwrap);
+                        if ( record ) stats_.prunedVectors += std::distance(bound, end);
+                        projs[a][i].erase(bound, end);
                         --elements;
                     }
 
@@ -246,14 +282,22 @@ namespace AIToolbox::POMDP {
             // computed the parsimonious set of value functions.
             const auto begin = std::begin(w);
             const auto end   = std::end  (w);
-            w.erase(prune(begin, end, unwrap), end);
+            const auto bound = prune(begin, end, unwrap);
+            if ( record ) stats_.prunedVectors += std::distance(bound, end);
+            w.erase(bound, end);
 
             v.emplace_back(std::move(w));
 
             // Check convergence
-            if ( useTolerance )
+            if ( useTolerance || record )
                 variation = weakBoundDistance(v[timestep-1], v[timestep]);
+            if ( record )
+                stats_.residuals.push_back(variation);
         }
+        if ( record ) stats_.iterations = timestep;
+
+        lpStats_ = LP::getThreadStatistics();
+        lpStats_ -= lpStart;
 
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
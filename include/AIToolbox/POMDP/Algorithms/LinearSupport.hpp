@@ -122,6 +122,18 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, ValueFunction> operator()(const M & model);
 
+            /**
+             * @brief This function returns the statistics of the LP solves of the last call.
+             *
+             * Note that the vertices of the ValueFunction surface are
+             * currently found by solving linear systems rather than LPs
+             * (see findVerticesNaive()), so these are zero unless the
+             * vertex enumeration is changed to use LPs.
+             *
+             * @return The LP statistics of the last call.
+             */
+            const LP::Statistics & getLPStatistics() const;
+
         private:
             unsigned horizon_;
             double tolerance_;
@@ -146,11 +158,13 @@ namespace AIToolbox::POMDP {
             using Agenda = boost::heap::fibonacci_heap<Vertex, boost::heap::compare<VertexComparator>>;
 
             Agenda agenda_;
+            LP::Statistics lpStats_;
     };
 
     template <IsModel M>
     std::tuple<double, ValueFunction> LinearSupport::operator()(const M& model) {
         const auto S = model.getS();
+        const auto lpStart = LP::getThreadStatistics();
 
         Projecter project(model);
         auto v = makeValueFunction(S); // TODO: May take user input
@@ -282,6 +296,10 @@ namespace AIToolbox::POMDP {
                 variation = weakBoundDistance(v[timestep-1], v[timestep]);
             }
         }
+
+        lpStats_ = LP::getThreadStatistics();
+        lpStats_ -= lpStart;
+
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
 }
@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_POMDP_PBVI_HEADER_FILE
 
 #include <AIToolbox/Utils/Prune.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/POMDP/Utils.hpp>
@@ -159,6 +160,18 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, ValueFunction> operator()(const M & model, const std::vector<Belief> & beliefs, ValueFunction v = {});
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of iterations, the number
+             * of pruned vectors, the time spent, and the variation between
+             * the last two ValueFunctions after each iteration.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             /**
              * @brief This function computes a VList composed the maximized cross-sums with respect to the provided beliefs.
@@ -186,6 +199,7 @@ namespace AIToolbox::POMDP {
             unsigned horizon_;
             double tolerance_;
 
+            SolverStatistics stats_;
             mutable RandomEngine rand_;
     };
 
@@ -211,6 +225,8 @@ namespace AIToolbox::POMDP {
         if (v.size() == 0)
             v = makeValueFunction(S);
 
+        SolverStatisticsRecorder record(stats_);
+
         unsigned timestep = 0;
 
         Projecter projecter(model);
@@ -235,6 +251,8 @@ namespace AIToolbox::POMDP {
             for ( size_t a = 0; a < A; ++a ) {
                 projs[a][0] = crossSum( projs[a], a, beliefs );
                 finalWSize += projs[a][0].size();
+                // crossSum creates a vector per belief before pruning.
+                if ( record ) stats_.prunedVectors += beliefs.size() - projs[a][0].size();
             }
             VList w;
             w.reserve(finalWSize);
@@ -248,6 +266,7 @@ namespace AIToolbox::POMDP {
             for ( const auto & belief : beliefs )
                 bound = extractBestAtPoint(belief, begin, bound, end, unwrap);
 
+            if ( record ) stats_.prunedVectors += std::distance(bound, end);
             w.erase(bound, std::end(w));
 
             // If you want to save as much memory as possible, do this.
@@ -258,9 +277,12 @@ namespace AIToolbox::POMDP {
             v.emplace_back(std::move(w));
 
             // Check convergence
-            if ( useTolerance )
+            if ( useTolerance || record )
                 variation = weakBoundDistance(v[v.size()-2], v.back());
+            if ( record )
+                stats_.residuals.push_back(variation);
         }
+        if ( record ) stats_.iterations = timestep;
 
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
@@ -1,13 +1,14 @@
 #ifndef AI_TOOLBOX_POMDP_POMCP_HEADER_FILE
 #define AI_TOOLBOX_POMDP_POMCP_HEADER_FILE
 
-#include <unordered_map>
-
 #include <AIToolbox/Logging.hpp>
 #include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/FlatMap.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
+#include <AIToolbox/POMDP/Algorithms/Utils/ParticleBelief.hpp>
 #include <AIToolbox/MDP/Algorithms/Utils/Rollout.hpp>
 
 namespace AIToolbox::POMDP {
@@ -49,22 +50,25 @@ namespace AIToolbox::POMDP {
      * In order to avoid performing belief updates between each
      * action/observation pair, which can be expensive, POMCP uses particle
      * beliefs. These approximate the beliefs at every step, and are used
-     * to select states in the rollouts.
+     * to select states in the rollouts. Particles are stored as weighted
+     * state counts (see ParticleBelief), so that the memory used by each
+     * node is bounded by the number of states it has seen.
      *
-     * A weakness of this implementation is that, as every particle
-     * approximation of continuous values, it will lose particles in time.
-     * To fight this a possibility is to implement a particle
-     * reinvigoration method, which would introduce noise in the particle
-     * beliefs in order to keep them "fresh" (possibly using domain
-     * knowledge).
+     * As every particle approximation, the beliefs lose particles in time,
+     * since nodes deep in the tree are visited less often. To fight this,
+     * when moving the root POMCP reinvigorates the new belief: it samples
+     * states from the old root belief, simulates the action taken with the
+     * generative model, and keeps the resulting states whose observation
+     * matches the one received. The new belief is then brought back to
+     * the initial belief size with systematic resampling.
      */
     template <IsGenerativeModel M>
     class POMCP {
         public:
-            using SampleBelief = std::vector<size_t>;
+            using SampleBelief = ParticleBelief;
 
             struct BeliefNode;
-            using BeliefNodes = std::unordered_map<size_t, BeliefNode>;
+            using BeliefNodes = FlatMap<size_t, BeliefNode>;
 
             struct ActionNode {
                 BeliefNodes children;
@@ -75,7 +79,7 @@ namespace AIToolbox::POMDP {
 
             struct BeliefNode {
                 BeliefNode() : N(0) {}
-                BeliefNode(size_t s) : belief(1, s), N(0) {}
+                BeliefNode(size_t s) : N(0) { belief.addParticle(s); }
                 ActionNodes children;
                 SampleBelief belief;
                 unsigned N;
@@ -118,9 +122,13 @@ namespace AIToolbox::POMDP {
              * using the existing graph: this should make search faster,
              * and also not require any belief updates.
              *
-             * NOTE: Currently there is no particle reinvigoration
-             * implemented, so for long horizons you can expect
-             * progressively degrading performances.
+             * If the new root has less particles than the belief size,
+             * new particles are generated from the previous root belief
+             * (see setReinvigorationAttempts()). The new root belief is
+             * then resampled to the belief size.
+             *
+             * If no particles can be obtained at all, this function falls
+             * back to a uniform belief.
              *
              * @param a The action taken in the last timestep.
              * @param o The observation received in the last timestep.
@@ -141,6 +149,24 @@ namespace AIToolbox::POMDP {
              */
             void setBeliefSize(size_t beliefSize);
 
+            /**
+             * @brief This function sets the number of reinvigoration attempts per missing particle.
+             *
+             * When the root is moved to a new belief with less than
+             * getBeliefSize() particles, POMCP tries to generate the
+             * missing ones by sampling the previous belief and simulating
+             * the action taken, keeping the states which produce the
+             * observation received.
+             *
+             * As observations can be unlikely, this number bounds the
+             * number of simulations to the number of missing particles
+             * times the number of attempts. Setting it to zero disables
+             * reinvigoration.
+             *
+             * @param attempts The number of attempts per missing particle.
+             */
+            void setReinvigorationAttempts(unsigned attempts);
+
             /**
              * @brief This function sets the number of performed rollouts in POMCP.
              *
@@ -182,6 +208,13 @@ namespace AIToolbox::POMDP {
              */
             size_t getBeliefSize() const;
 
+            /**
+             * @brief This function returns the number of reinvigoration attempts per missing particle.
+             *
+             * @return The number of reinvigoration attempts.
+             */
+            unsigned getReinvigorationAttempts() const;
+
             /**
              * @brief This function returns the number of iterations performed to plan for an action.
              *
@@ -196,14 +229,27 @@ namespace AIToolbox::POMDP {
              */
             double getExploration() const;
 
+            /**
+             * @brief This function returns the statistics of the last call to sampleAction().
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of simulations run, the
+             * number of tree nodes created, and the time spent, from which
+             * the simulations per second can be computed.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             const M& model_;
             size_t S, A, beliefSize_;
-            unsigned iterations_, maxDepth_;
+            unsigned iterations_, maxDepth_, reinvigorationAttempts_;
             double exploration_;
 
-            SampleBelief sampleBelief_;
             BeliefNode graph_;
+            SolverStatistics stats_;
+            bool recording_;
 
             mutable RandomEngine rand_;
 
@@ -283,17 +329,27 @@ namespace AIToolbox::POMDP {
              * @return A particle belief approximating the input belief.
              */
             SampleBelief makeSampledBelief(const Belief & b);
+
+            /**
+             * @brief This function adds particles to the root belief, and resamples it.
+             *
+             * @param previous The belief before the action was taken.
+             * @param a The action taken.
+             * @param o The observation received.
+             */
+            void reinvigorate(const SampleBelief & previous, size_t a, size_t o);
     };
 
     template <IsGenerativeModel M>
     POMCP<M>::POMCP(const M& m, const size_t beliefSize, const unsigned iter, const double exp) :
             model_(m), S(model_.getS()), A(model_.getA()), beliefSize_(beliefSize),
-            iterations_(iter), exploration_(exp), graph_(), rand_(Seeder::getSeed()) {}
+            iterations_(iter), reinvigorationAttempts_(10), exploration_(exp), graph_(),
+            recording_(false), rand_(Seeder::getSeed()) {}
 
     template <IsGenerativeModel M>
     size_t POMCP<M>::sampleAction(const Belief& b, const unsigned horizon) {
         // Reset graph
-        graph_ = BeliefNode(A);
+        graph_ = BeliefNode();
         graph_.children.resize(A);
         graph_.belief = makeSampledBelief(b);
 
@@ -302,23 +358,27 @@ namespace AIToolbox::POMDP {
 
     template <IsGenerativeModel M>
     size_t POMCP<M>::sampleAction(const size_t a, const size_t o, const unsigned horizon) {
-        const auto & obs = graph_.children[a].children;
+        // We keep the old root belief to reinvigorate the new one.
+        auto previous = std::move(graph_.belief);
+
+        auto & obs = graph_.children[a].children;
 
         auto it = obs.find(o);
         if ( it == obs.end() ) {
-            AI_LOGGER(AI_SEVERITY_WARNING, "Observation " << o << " never experienced in simulation, restarting with uniform belief..");
-            auto b = Belief(S); b.fill(1.0/S);
-            return sampleAction(b, horizon);
+            AI_LOGGER(AI_SEVERITY_WARNING, "Observation " << o << " never experienced in simulation, reinvigorating..");
+            graph_ = BeliefNode();
+        } else {
+            // Here we need an additional step, because *it is contained by graph_.
+            // If we just move assign, graph_ is first going to delete everything it
+            // contains (included *it), and then we are going to move unallocated memory
+            // into graph_! So we move *it outside of the graph_ hierarchy, so that
+            // we can then assign safely.
+            auto tmp = std::move(it->second); graph_ = std::move(tmp);
         }
 
-        // Here we need an additional step, because *it is contained by graph_.
-        // If we just move assign, graph_ is first going to delete everything it
-        // contains (included *it), and then we are going to move unallocated memory
-        // into graph_! So we move *it outside of the graph_ hierarchy, so that
-        // we can then assign safely.
-        { auto tmp = std::move(it->second); graph_ = std::move(tmp); }
+        reinvigorate(previous, a, o);
 
-        if ( ! graph_.belief.size() ) {
+        if ( graph_.belief.empty() ) {
             AI_LOGGER(AI_SEVERITY_WARNING, "POMCP lost track of the belief, restarting with uniform..");
             auto b = Belief(S); b.fill(1.0/S);
             return sampleAction(b, horizon);
@@ -334,13 +394,16 @@ namespace AIToolbox::POMDP {
 
     template <IsGenerativeModel M>
     size_t POMCP<M>::runSimulation(const unsigned horizon) {
+        SolverStatisticsRecorder record(stats_);
+        recording_ = static_cast<bool>(record);
+
         if ( !horizon ) return 0;
 
         maxDepth_ = horizon;
-        std::uniform_int_distribution<size_t> generator(0, graph_.belief.size()-1);
 
         for (unsigned i = 0; i < iterations_; ++i )
-            simulate(graph_, graph_.belief.at(generator(rand_)), 0);
+            simulate(graph_, graph_.belief.sample(rand_), 0);
+        if ( recording_ ) stats_.simulations = iterations_;
 
         auto begin = std::begin(graph_.children);
         return std::distance(begin, findBestA(begin, std::end(graph_.children)));
@@ -363,14 +426,13 @@ namespace AIToolbox::POMDP {
             // update for the next timestep.
             auto ot = aNode.children.find(o);
             if ( ot == std::end(aNode.children) ) {
-                aNode.children.emplace(std::piecewise_construct,
-                                       std::forward_as_tuple(o),
-                                       std::forward_as_tuple(s1));
+                aNode.children.try_emplace(o, s1);
+                if ( recording_ ) ++stats_.treeNodes;
                 // This stops automatically if we go out of depth
                 futureRew = rollout(model_, s1, maxDepth_ - depth + 1, rand_);
             }
             else {
-                ot->second.belief.push_back(s1);
+                ot->second.belief.addParticle(s1);
                 // We only go deeper if needed (maxDepth_ is always at least 1).
                 if ( depth + 1 < maxDepth_ && !model_.isTerminal(s1) ) {
                     // Since most memory is allocated on the leaves,
@@ -427,13 +489,30 @@ namespace AIToolbox::POMDP {
 
     template <IsGenerativeModel M>
     typename POMCP<M>::SampleBelief POMCP<M>::makeSampledBelief(const Belief & b) {
-        SampleBelief belief;
-        belief.reserve(beliefSize_);
-
-        for ( size_t i = 0; i < beliefSize_; ++i )
-            belief.push_back(sampleProbability(S, b, rand_));
+        return SampleBelief(b, beliefSize_, rand_);
+    }
 
-        return belief;
+    template <IsGenerativeModel M>
+    void POMCP<M>::reinvigorate(const SampleBelief & previous, const size_t a, const size_t o) {
+        auto & belief = graph_.belief;
+        const auto particles = static_cast<size_t>(belief.getTotalWeight());
+
+        if ( particles < beliefSize_ && !previous.empty() ) {
+            const size_t missing = beliefSize_ - particles;
+            const size_t maxAttempts = missing * reinvigorationAttempts_;
+
+            size_t added = 0;
+            for ( size_t i = 0; i < maxAttempts && added < missing; ++i ) {
+                const auto sor = model_.sampleSOR(previous.sample(rand_), a);
+                if ( std::get<1>(sor) == o ) {
+                    belief.addParticle(std::get<0>(sor));
+                    ++added;
+                }
+            }
+        }
+        // This keeps the root belief of fixed size, no matter how many
+        // particles the simulations have added to it.
+        belief.resample(beliefSize_, rand_);
     }
 
     template <IsGenerativeModel M>
@@ -441,6 +520,11 @@ namespace AIToolbox::POMDP {
         beliefSize_ = beliefSize;
     }
 
+    template <IsGenerativeModel M>
+    void POMCP<M>::setReinvigorationAttempts(const unsigned attempts) {
+        reinvigorationAttempts_ = attempts;
+    }
+
     template <IsGenerativeModel M>
     void POMCP<M>::setIterations(const unsigned iter) {
         iterations_ = iter;
@@ -466,6 +550,11 @@ namespace AIToolbox::POMDP {
         return beliefSize_;
     }
 
+    template <IsGenerativeModel M>
+    unsigned POMCP<M>::getReinvigorationAttempts() const {
+        return reinvigorationAttempts_;
+    }
+
     template <IsGenerativeModel M>
     unsigned POMCP<M>::getIterations() const {
         return iterations_;
@@ -475,6 +564,11 @@ namespace AIToolbox::POMDP {
     double POMCP<M>::getExploration() const {
         return exploration_;
     }
+
+    template <IsGenerativeModel M>
+    const SolverStatistics & POMCP<M>::getStatistics() const {
+        return stats_;
+    }
 }
 
 #endif
@@ -3,6 +3,9 @@
 
 #include <AIToolbox/Logging.hpp>
 
+#include <AIToolbox/Utils/FlatMap.hpp>
+#include <AIToolbox/Utils/Polytope.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 
@@ -86,6 +89,19 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, double, VList, MDP::QFunction> operator()(const M & model, const Belief & initialBelief);
 
+            /**
+             * @brief This function returns the statistics of the last call.
+             *
+             * The statistics are only recorded when instrumentation is
+             * enabled. They contain the number of iterations, the number
+             * of alphavectors removed by delta pruning, the number of
+             * belief tree nodes, the time spent, and the gap between the
+             * bounds of the initial belief after each iteration.
+             *
+             * @return The statistics of the last call.
+             */
+            const SolverStatistics & getStatistics() const;
+
         private:
             /**
              * @brief This struct represents a node in our Belief graph.
@@ -145,7 +161,7 @@ namespace AIToolbox::POMDP {
             void samplePoints(
                 const M & pomdp,
                 const VList & lbV,
-                const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV
+                const MDP::QFunction & ubQ, const IndexedPointSurface & ubV
             );
 
             /**
@@ -168,7 +184,7 @@ namespace AIToolbox::POMDP {
             void expandLeaf(
                 size_t id, const M & model,
                 const VList & lbV,
-                const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV
+                const MDP::QFunction & ubQ, const IndexedPointSurface & ubV
             );
 
             /**
@@ -200,7 +216,7 @@ namespace AIToolbox::POMDP {
             void updateNode(
                 TreeNode & node, const M & model,
                 const VList & lbV,
-                const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV,
+                const MDP::QFunction & ubQ, const IndexedPointSurface & ubV,
                 bool expand
             );
 
@@ -224,7 +240,7 @@ namespace AIToolbox::POMDP {
             void backupNode(
                 size_t id, const M & model,
                 VList & lbV,
-                MDP::QFunction & ubQ, UpperBoundValueFunction & ubV
+                MDP::QFunction & ubQ, IndexedPointSurface & ubV
             );
 
             double predictValue(size_t id, const TreeNode & node);
@@ -293,7 +309,7 @@ namespace AIToolbox::POMDP {
                     double entropyStep_, UBMin_, UBStep_;
 
                     //                 id          is_initialized, ei,     ubi,    lb,    err
-                    std::unordered_map<size_t, std::tuple<bool,    size_t, size_t, double, double>> nodes_;
+                    FlatMap<size_t,            std::tuple<bool,    size_t, size_t, double, double>> nodes_;
                     //              entropy x ub
                     boost::multi_array<Bin, 2> bins_;
             };
@@ -314,6 +330,8 @@ namespace AIToolbox::POMDP {
             std::unordered_map<Belief, size_t, boost::hash<Belief>> beliefToNode_;
             std::vector<LBPredictor> predictors_;
 
+            SolverStatistics stats_;
+
             // Storage to avoid reallocations
             std::vector<size_t> sampledNodes_;
             std::vector<char> backuppedActions_;
@@ -327,6 +345,8 @@ namespace AIToolbox::POMDP {
         AI_LOGGER(AI_SEVERITY_DEBUG, "Running SARSOP; POMDP S: " << pomdp.getS() << "; A: " << pomdp.getA() << "; O: " << pomdp.getO());
         AI_LOGGER(AI_SEVERITY_DEBUG, "Initial Belief: " << initialBelief.transpose());
 
+        SolverStatisticsRecorder record(stats_);
+
         // ##############################
         // ### Resetting general data ###
         // ##############################
@@ -443,9 +463,12 @@ namespace AIToolbox::POMDP {
         // FastInformedBound), and a series of belief-value pairs, which we'll
         // use with the later-constructed new POMDP in order to improve our
         // bounds.
-        UpperBoundValueFunction ubV = {
-            {initialBelief}, {(initialBelief.transpose() * ubQ).maxCoeff()}
-        };
+        //
+        // Since we query the upper bound for every successor of every belief
+        // we touch, we keep the belief-value pairs indexed to make the
+        // sawtooth interpolation cheap.
+        IndexedPointSurface ubV(ubQ);
+        ubV.add(initialBelief, (initialBelief.transpose() * ubQ).maxCoeff());
 
         // ###########################
         // ### Setup UB predictors ###
@@ -485,6 +508,8 @@ namespace AIToolbox::POMDP {
         // ##################
 
         while (true) {
+            if (record) ++stats_.iterations;
+
             // Deep sample a branch of the action/observation trees. The
             // sampled nodes (except the last one where we stop) are added to
             // sampledNodes_.
@@ -513,7 +538,9 @@ namespace AIToolbox::POMDP {
             // dominated within a given neighborhood of all their witness
             // beliefs.
             AI_LOGGER(AI_SEVERITY_DEBUG, "Delta pruning...");
+            const auto unprunedSize = lbVList.size();
             deltaPrune(lbVList);
+            if (record) stats_.prunedVectors += unprunedSize - lbVList.size();
 
             // # Upper Bound Pruning #
 
@@ -521,40 +548,38 @@ namespace AIToolbox::POMDP {
             // This means that their value is *higher* than what we can
             // approximate using the other beliefs.
             AI_LOGGER(AI_SEVERITY_DEBUG, "UB pruning...");
-            size_t i = ubV.first.size();
+            size_t i = ubV.size();
             do {
                 --i;
 
-                // We swap the current belief to check at the end, and we
-                // temporarily remove it so we can test the interpolation
-                // without it.
-                std::swap(ubV.first[i], ubV.first.back());
-                std::swap(ubV.second[i], ubV.second.back());
+                // We temporarily remove the current belief so we can test the
+                // interpolation without it. Removing it moves the last belief
+                // in its place.
+                auto belief = ubV.getPoints()[i];
+                auto value = ubV.getValues()[i];
 
-                auto belief = std::move(ubV.first.back());
-                auto value = ubV.second.back();
-
-                ubV.first.pop_back();
-                ubV.second.pop_back();
+                ubV.erase(i);
 
                 // If its original value is lower than the interpolation, we
                 // still need it to improve our upper bound.
                 if (value < std::get<0>(sawtoothInterpolation(belief, ubQ, ubV))) {
                     // Thus, we put it back inside.
-                    ubV.first.emplace_back(std::move(belief));
-                    ubV.second.emplace_back(value);
+                    ubV.add(std::move(belief), value);
                 }
-            } while (i != 0 && ubV.first.size() > 1);
+            } while (i != 0 && ubV.size() > 1);
 
             AI_LOGGER(AI_SEVERITY_INFO,
                 "Root lower bound: " << treeStorage_[0].LB <<
                 "; upper bound: " << treeStorage_[0].UB <<
                 "; alpha vectors: " << lbVList.size() <<
-                "; belief points: " << ubV.first.size());
+                "; belief points: " << ubV.size());
+
+            if (record) stats_.residuals.push_back(treeStorage_[0].UB - treeStorage_[0].LB);
 
             if (treeStorage_[0].UB - treeStorage_[0].LB <= tolerance_)
                 break;
         }
+        if (record) stats_.treeNodes = treeStorage_.size();
 
         // Remove witness data from lbVList since we don't need to pass it
         // outside.
@@ -565,7 +590,7 @@ namespace AIToolbox::POMDP {
     }
 
     template <IsModel M>
-    void SARSOP::samplePoints(const M & pomdp, const VList & lbVList, const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV) {
+    void SARSOP::samplePoints(const M & pomdp, const VList & lbVList, const MDP::QFunction & ubQ, const IndexedPointSurface & ubV) {
         sampledNodes_.clear();
         // Always begin sampling from the root. We are going to go down a path
         // until we hit our stopping conditions. If we end up outside the tree,
@@ -657,7 +682,7 @@ namespace AIToolbox::POMDP {
     void SARSOP::expandLeaf(
             const size_t id, const M & pomdp,
             const VList & lbVList,
-            const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV
+            const MDP::QFunction & ubQ, const IndexedPointSurface & ubV
         )
     {
         // Note that we create a pointer as this function will add nodes to
@@ -745,7 +770,7 @@ namespace AIToolbox::POMDP {
     void SARSOP::updateNode(
             TreeNode & node, const M & pomdp,
             const VList & lbVList,
-            const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV,
+            const MDP::QFunction & ubQ, const IndexedPointSurface & ubV,
             bool expand
         )
     {
@@ -777,7 +802,7 @@ namespace AIToolbox::POMDP {
     }
 
     template <IsModel M>
-    void SARSOP::backupNode(size_t id, const M & pomdp, VList & lbVList, MDP::QFunction & ubQ, UpperBoundValueFunction & ubV) {
+    void SARSOP::backupNode(size_t id, const M & pomdp, VList & lbVList, MDP::QFunction & ubQ, IndexedPointSurface & ubV) {
         const auto & ir = [&]{
             if constexpr (MDP::IsModelEigen<M>) return pomdp.getRewardFunction();
             else return immediateRewards_;
@@ -827,11 +852,12 @@ namespace AIToolbox::POMDP {
         for (size_t s = 0; s < pomdp.getS(); ++s) {
             if (checkEqualSmall(node.belief[s], 1.0)) {
                 ubQ(s, maxAction) = node.UB;
+                // The cached corner values of ubV depend on ubQ.
+                ubV.setCorners(ubQ);
                 return;
             }
         }
-        ubV.first.push_back(node.belief);
-        ubV.second.push_back(node.UB);
+        ubV.add(node.belief, node.UB);
     }
 }
 
@@ -0,0 +1,293 @@
+#ifndef AI_TOOLBOX_POMDP_PARTICLE_BELIEF_HEADER_FILE
+#define AI_TOOLBOX_POMDP_PARTICLE_BELIEF_HEADER_FILE
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Utils/FlatMap.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/POMDP/Types.hpp>
+
+namespace AIToolbox::POMDP {
+    /**
+     * @brief This class represents a weighted particle belief.
+     *
+     * Rather than storing each particle separately, this class stores a
+     * single weight for each state (like a state->count map). This keeps
+     * the memory used bounded by the number of states that have been
+     * seen, no matter how many particles are added.
+     *
+     * Particles can be added with arbitrary weights. The belief can be
+     * sampled, and it can be resampled (via systematic resampling) to
+     * obtain an unweighted belief with a fixed number of particles.
+     *
+     * Sampling uses an internal cumulative table which is built on the
+     * first sample after a modification, so that repeated sampling from
+     * the same belief (as done at the root of the POMCP tree) is fast.
+     */
+    class ParticleBelief {
+        public:
+            using Particle = std::pair<size_t, double>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor creates an empty belief.
+             */
+            ParticleBelief();
+
+            /**
+             * @brief This constructor approximates a Belief with particles.
+             *
+             * The particles are generated by sampling the input Belief,
+             * and have weight 1 each.
+             *
+             * @param b The Belief to approximate.
+             * @param particles The number of particles to sample.
+             * @param rnd The random engine to sample with.
+             */
+            ParticleBelief(const Belief & b, size_t particles, RandomEngine & rnd);
+
+            /**
+             * @brief This function adds a particle to the belief.
+             *
+             * If the state already has a particle, the weight is simply
+             * added to it.
+             *
+             * @param s The state of the particle.
+             * @param weight The weight of the particle.
+             */
+            void addParticle(size_t s, double weight = 1.0);
+
+            /**
+             * @brief This function samples a state from the belief.
+             *
+             * The belief must not be empty.
+             *
+             * @param rnd The random engine to sample with.
+             *
+             * @return A state, sampled proportionally to its weight.
+             */
+            size_t sample(RandomEngine & rnd) const;
+
+            /**
+             * @brief This function resamples the belief to the specified number of particles.
+             *
+             * This function uses systematic resampling, which has lower
+             * variance than multinomial resampling and runs in linear
+             * time. After this call every weight is an integer count, and
+             * the counts sum to the input number of particles.
+             *
+             * Resampling an empty belief does nothing.
+             *
+             * This function will throw a std::invalid_argument if the
+             * input number of particles is zero.
+             *
+             * @param particles The number of particles to resample.
+             * @param rnd The random engine to sample with.
+             */
+            void resample(size_t particles, RandomEngine & rnd);
+
+            /**
+             * @brief This function removes all particles from the belief.
+             */
+            void clear();
+
+            /**
+             * @brief This function returns whether the belief contains no particles.
+             *
+             * @return Whether the belief is empty.
+             */
+            bool empty() const;
+
+            /**
+             * @brief This function returns the number of distinct states in the belief.
+             *
+             * @return The number of distinct states.
+             */
+            size_t size() const;
+
+            /**
+             * @brief This function returns the sum of the weights of all particles.
+             *
+             * For unweighted beliefs, this is the number of particles.
+             *
+             * @return The total weight.
+             */
+            double getTotalWeight() const;
+
+            /**
+             * @brief This function returns the weight associated with the input state.
+             *
+             * @param s The state to check.
+             *
+             * @return The weight of the state, or zero if it is not present.
+             */
+            double getWeight(size_t s) const;
+
+            /**
+             * @brief This function returns the effective sample size of the belief.
+             *
+             * This is computed as (sum w)^2 / sum w^2 over the weights of
+             * the individual particles added to the belief (not the merged
+             * weights of each state), and is a measure of how degenerate
+             * the weights are. For unweighted beliefs it is equal to the
+             * number of particles.
+             *
+             * @return The effective sample size.
+             */
+            double getEffectiveSampleSize() const;
+
+            /**
+             * @brief This function returns the Belief approximated by the particles.
+             *
+             * @param S The number of states of the Belief.
+             *
+             * @return The normalized Belief.
+             */
+            Belief getBelief(size_t S) const;
+
+            /**
+             * @brief This function returns the most likely state in the belief.
+             *
+             * The belief must not be empty.
+             *
+             * @return The state with the highest weight.
+             */
+            size_t getMostLikelyState() const;
+
+            /**
+             * @brief This function returns the stored particles.
+             *
+             * @return The state->weight map of particles.
+             */
+            const FlatMap<size_t, double> & getParticles() const;
+
+        private:
+            FlatMap<size_t, double> weights_;
+            double totalWeight_;
+            // Sum of the squared weights of the added particles.
+            double squaredWeight_;
+
+            // Cumulative weights for sampling, built lazily.
+            mutable std::vector<Particle> cumulative_;
+    };
+
+    inline ParticleBelief::ParticleBelief() : totalWeight_(0.0), squaredWeight_(0.0) {}
+
+    inline ParticleBelief::ParticleBelief(const Belief & b, const size_t particles, RandomEngine & rnd) : totalWeight_(0.0), squaredWeight_(0.0) {
+        const size_t S = b.size();
+        for (size_t i = 0; i < particles; ++i)
+            addParticle(sampleProbability(S, b, rnd));
+    }
+
+    inline void ParticleBelief::addParticle(const size_t s, const double weight) {
+        weights_[s] += weight;
+        totalWeight_ += weight;
+        squaredWeight_ += weight * weight;
+        cumulative_.clear();
+    }
+
+    inline size_t ParticleBelief::sample(RandomEngine & rnd) const {
+        if (cumulative_.empty()) {
+            cumulative_.reserve(weights_.size());
+            double sum = 0.0;
+            for (const auto & [s, w] : weights_) {
+                sum += w;
+                cumulative_.emplace_back(s, sum);
+            }
+        }
+        std::uniform_real_distribution<double> dist(0.0, cumulative_.back().second);
+        const double p = dist(rnd);
+
+        const auto it = std::upper_bound(std::begin(cumulative_), std::end(cumulative_), p,
+                [](const double v, const Particle & c) { return v < c.second; });
+
+        // Guard against p being exactly the total.
+        return it == std::end(cumulative_) ? cumulative_.back().first : it->first;
+    }
+
+    inline void ParticleBelief::resample(const size_t particles, RandomEngine & rnd) {
+        if (particles == 0) throw std::invalid_argument("Cannot resample a belief to zero particles");
+        if (weights_.empty()) return;
+
+        const double step = totalWeight_ / particles;
+        std::uniform_real_distribution<double> dist(0.0, step);
+
+        FlatMap<size_t, double> newWeights;
+        newWeights.reserve(std::min(particles, weights_.size()));
+
+        // We place the particles on a regular grid shifted by a single
+        // random offset, and count how many fall within each weight.
+        double point = dist(rnd), sum = 0.0;
+        size_t placed = 0, last = 0;
+        for (const auto & [s, w] : weights_) {
+            sum += w;
+            last = s;
+            unsigned count = 0;
+            while (placed < particles && point < sum) {
+                ++count, ++placed;
+                point += step;
+            }
+            if (count) newWeights[s] = count;
+        }
+        // Numerical errors can leave the last few points out of the grid.
+        if (placed < particles)
+            newWeights[last] += particles - placed;
+
+        weights_ = std::move(newWeights);
+        totalWeight_ = static_cast<double>(particles);
+        squaredWeight_ = static_cast<double>(particles);
+        cumulative_.clear();
+    }
+
+    inline void ParticleBelief::clear() {
+        weights_.clear();
+        totalWeight_ = 0.0;
+        squaredWeight_ = 0.0;
+        cumulative_.clear();
+    }
+
+    inline bool ParticleBelief::empty() const {
+        return weights_.empty();
+    }
+
+    inline size_t ParticleBelief::size() const {
+        return weights_.size();
+    }
+
+    inline double ParticleBelief::getTotalWeight() const {
+        return totalWeight_;
+    }
+
+    inline double ParticleBelief::getWeight(const size_t s) const {
+        const auto it = weights_.find(s);
+        return it == std::end(weights_) ? 0.0 : it->second;
+    }
+
+    inline double ParticleBelief::getEffectiveSampleSize() const {
+        return squaredWeight_ > 0.0 ? totalWeight_ * totalWeight_ / squaredWeight_ : 0.0;
+    }
+
+    inline Belief ParticleBelief::getBelief(const size_t S) const {
+        Belief b = Belief::Zero(S);
+        for (const auto & [s, w] : weights_)
+            b[s] = w;
+        if (totalWeight_ > 0.0)
+            b /= totalWeight_;
+        return b;
+    }
+
+    inline size_t ParticleBelief::getMostLikelyState() const {
+        return std::max_element(std::begin(weights_), std::end(weights_),
+                [](const auto & lhs, const auto & rhs) { return lhs.second < rhs.second; })->first;
+    }
+
+    inline const FlatMap<size_t, double> & ParticleBelief::getParticles() const {
+        return weights_;
+    }
+}
+
+#endif
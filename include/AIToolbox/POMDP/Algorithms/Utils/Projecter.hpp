@@ -1,6 +1,8 @@
 #ifndef AI_TOOLBOX_POMDP_PROJECTER_HEADER_FILE
 #define AI_TOOLBOX_POMDP_PROJECTER_HEADER_FILE
 
+#include <type_traits>
+
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/MDP/Utils.hpp>
@@ -8,12 +10,22 @@
 namespace AIToolbox::POMDP {
     /**
      * @brief This class offers projecting facilities for Models.
+     *
+     * The scalar parameter selects the type of the projected values. With
+     * float the projections, which can be very many, take half the memory.
+     * The products with the transition and observation functions are done
+     * in the scalar of the transition function of the model, so they are
+     * also faster if the model itself is stored in float (e.g. a
+     * POMDP::Model<MDP::ModelT<float>>).
+     *
+     * @tparam M The type of the model.
+     * @tparam T The scalar type of the projected values.
      */
-    template <IsModel M>
+    template <IsModel M, typename T = double>
     class Projecter {
         public:
-            using ProjectionsTable          = boost::multi_array<VList, 2>;
-            using ProjectionsRow            = boost::multi_array<VList, 1>;
+            using ProjectionsTable          = boost::multi_array<VListT<T>, 2>;
+            using ProjectionsRow            = boost::multi_array<VListT<T>, 1>;
 
             /**
              * @brief Basic constructor.
@@ -33,7 +45,7 @@ namespace AIToolbox::POMDP {
              *
              * @return A 2d array of projection lists.
              */
-            ProjectionsTable operator()(const VList & w);
+            ProjectionsTable operator()(const VListT<T> & w);
 
             /**
              * @brief This function returns all possible projections for the provided VList and action.
@@ -43,7 +55,7 @@ namespace AIToolbox::POMDP {
              *
              * @return A 1d array of projection lists.
              */
-            ProjectionsRow operator()(const VList & w, size_t a);
+            ProjectionsRow operator()(const VListT<T> & w, size_t a);
 
         private:
             using PossibleObservationsTable = boost::multi_array<bool,  2>;
@@ -60,14 +72,14 @@ namespace AIToolbox::POMDP {
 
             const M & model_;
             size_t S, A, O;
-            double discount_;
+            T discount_;
 
-            Matrix2D immediateRewards_;
+            Matrix2DT<T> immediateRewards_;
             PossibleObservationsTable possibleObservations_;
     };
 
-    template <IsModel M>
-    Projecter<M>::Projecter(const M& model) :
+    template <IsModel M, typename T>
+    Projecter<M, T>::Projecter(const M& model) :
             model_(model), S(model_.getS()), A(model_.getA()), O(model_.getO()),
             discount_(model_.getDiscount()), possibleObservations_(boost::extents[A][O])
     {
@@ -75,8 +87,8 @@ namespace AIToolbox::POMDP {
         computeImmediateRewards();
     }
 
-    template <IsModel M>
-    typename Projecter<M>::ProjectionsTable Projecter<M>::operator()(const VList & w) {
+    template <IsModel M, typename T>
+    typename Projecter<M, T>::ProjectionsTable Projecter<M, T>::operator()(const VListT<T> & w) {
         ProjectionsTable projections( boost::extents[A][O] );
 
         for ( size_t a = 0; a < A; ++a )
@@ -85,8 +97,8 @@ namespace AIToolbox::POMDP {
         return projections;
     }
 
-    template <IsModel M>
-    typename Projecter<M>::ProjectionsRow Projecter<M>::operator()(const VList & w, const size_t a) {
+    template <IsModel M, typename T>
+    typename Projecter<M, T>::ProjectionsRow Projecter<M, T>::operator()(const VListT<T> & w, const size_t a) {
         ProjectionsRow projections( boost::extents[O] );
 
         for ( size_t o = 0; o < O; ++o ) {
@@ -103,14 +115,17 @@ namespace AIToolbox::POMDP {
             }
 
             // Otherwise we compute a projection for each ValueFunction supplied to us.
-            MDP::Values vproj(S);
+            VectorT<T> vproj(S);
             for ( size_t i = 0; i < w.size(); ++i ) {
                 const auto & v = w[i].values;
                 // For each value function in the previous timestep, we compute the new value
                 // if we performed action a and obtained observation o.
                 // vproj_{a,o}[s] = R(s,a) / |O| + discount * sum_{s'} ( T(s,a,s') * O(s',a,o) * v_{t-1}(s') )
                 if constexpr(IsModelEigen<M>) {
-                    vproj = model_.getTransitionFunction(a) * (v.cwiseProduct(model_.getObservationFunction(a).col(o)));
+                    // Casts to the same scalar are no-ops.
+                    const auto & t = model_.getTransitionFunction(a);
+                    using TS = typename std::remove_cvref_t<decltype(t)>::Scalar;
+                    vproj = (t * v.template cast<TS>().cwiseProduct(model_.getObservationFunction(a).col(o).template cast<TS>())).template cast<T>();
                 } else {
                     vproj.setZero();
                     for ( size_t s = 0; s < S; ++s )
@@ -125,21 +140,21 @@ namespace AIToolbox::POMDP {
         return projections;
     }
 
-    template <IsModel M>
-    void Projecter<M>::computeImmediateRewards() {
+    template <IsModel M, typename T>
+    void Projecter<M, T>::computeImmediateRewards() {
         immediateRewards_ = [&]{
             if constexpr(MDP::IsModelEigen<M>)
-                return model_.getRewardFunction().transpose();
+                return model_.getRewardFunction().transpose().template cast<T>();
             else
-                return MDP::computeImmediateRewards(model_).transpose();
+                return MDP::computeImmediateRewards(model_).transpose().template cast<T>();
         }();
         // You can find out why this is divided in the incremental pruning paper =)
         // The idea is that at the end of all the cross sums it's going to add up to the correct value.
-        immediateRewards_ /= static_cast<double>(O);
+        immediateRewards_ /= static_cast<T>(O);
     }
 
-    template <IsModel M>
-    void Projecter<M>::computePossibleObservations() {
+    template <IsModel M, typename T>
+    void Projecter<M, T>::computePossibleObservations() {
         for ( size_t a = 0; a < A; ++a )
             for ( size_t o = 0; o < O; ++o )
                 for ( size_t s = 0; s < S; ++s ) // This NEEDS to be last!
@@ -2,8 +2,8 @@
 #define AI_TOOLBOX_POMDP_rPOMCP_GRAPH_HEADER_FILE
 
 #include <vector>
-#include <unordered_map>
 
+#include <AIToolbox/Utils/FlatMap.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 
@@ -16,6 +16,7 @@ namespace AIToolbox::Impl::POMDP {
 
     struct BeliefNodeNoEntropyAddon {
         size_t maxS_ = 0;           ///< This keeps track of the belief peak state for max of belief
+        unsigned maxN_ = 0;         ///< This is the number of particles of the peak state
     };
 }
 
@@ -35,12 +36,7 @@ namespace AIToolbox::POMDP {
     // we do not need to sample from here, just to access fast and recompute the
     // entropy values.
     template <bool UseEntropy>
-    using TrackBelief = std::unordered_map<
-                            size_t,
-                            BeliefParticle<UseEntropy>,
-                            std::hash<size_t>,
-                            std::equal_to<size_t>
-                        >;
+    using TrackBelief = FlatMap<size_t, BeliefParticle<UseEntropy>>;
 
     /**
      * @brief This is a belief node of the rPOMCP tree.
@@ -71,7 +67,7 @@ namespace AIToolbox::POMDP {
     };
 
     template <bool UseEntropy>
-    using BeliefNodes = std::unordered_map<size_t, BeliefNode<UseEntropy>>;
+    using BeliefNodes = FlatMap<size_t, BeliefNode<UseEntropy>>;
 
     template <bool UseEntropy>
     struct ActionNode {
@@ -146,27 +142,31 @@ namespace AIToolbox::POMDP {
     // entropy term. Minor errors are ok since this is still an estimation.
     template <>
     void BeliefNode<true>::updateBeliefAndKnowledge(const size_t s) {
+        auto & particle = trackBelief_[s];
         // Remove entropy term for this state from summatory
-        knowledgeMeasure_ -= trackBelief_[s].negativeEntropy;
+        knowledgeMeasure_ -= particle.negativeEntropy;
         // Updating belief
-        trackBelief_[s].N += 1;
+        particle.N += 1;
         // Computing new entropy term for this state
-        double p = static_cast<double>(trackBelief_[s].N) / static_cast<double>(N+1);
+        double p = static_cast<double>(particle.N) / static_cast<double>(N+1);
         double newEntropy = p * std::log(p);
         // Update values
-        trackBelief_[s].negativeEntropy = newEntropy;
+        particle.negativeEntropy = newEntropy;
         knowledgeMeasure_ += newEntropy;
     }
 
     // This is the Max-Belief implementation
     template <>
     void BeliefNode<false>::updateBeliefAndKnowledge(const size_t s) {
-        trackBelief_[s].N += 1;
+        const auto count = ++trackBelief_[s].N;
 
-        if ( trackBelief_[s].N > trackBelief_[maxS_].N )
+        // We cache the peak count, so we only need a single lookup.
+        if ( count > maxN_ ) {
             maxS_ = s;
+            maxN_ = count;
+        }
 
-        knowledgeMeasure_ = static_cast<double>(trackBelief_[maxS_].N) / static_cast<double>(N+1);
+        knowledgeMeasure_ = static_cast<double>(maxN_) / static_cast<double>(N+1);
     }
 
     template <bool UseEntropy>
@@ -184,7 +184,7 @@ namespace AIToolbox::POMDP {
             BeliefNode<UseEntropy>(), rand_(&rand), beliefSize_(beliefSize)
     {
         this->children.resize(A);
-        std::unordered_map<size_t, unsigned> generatedSamples;
+        FlatMap<size_t, unsigned> generatedSamples;
 
         size_t S = b.size();
         for ( size_t i = 0; i < beliefSize_; ++i )
@@ -114,6 +114,16 @@ namespace AIToolbox::POMDP {
             template <IsModel M>
             std::tuple<double, ValueFunction> operator()(const M & model);
 
+            /**
+             * @brief This function returns the statistics of the LP solves of the last call.
+             *
+             * These include both the solves done to find witness points and
+             * the ones done while pruning.
+             *
+             * @return The LP statistics of the last call.
+             */
+            const LP::Statistics & getLPStatistics() const;
+
         private:
             /**
              * @brief This function adds a default cross-sum to the agenda, to start off the algorithm.
@@ -138,6 +148,8 @@ namespace AIToolbox::POMDP {
 
             std::vector<MDP::Values> agenda_;
             std::unordered_set<VObs, boost::hash<VObs>> triedVectors_;
+
+            LP::Statistics lpStats_;
     };
 
     template <IsModel M>
@@ -163,6 +175,8 @@ namespace AIToolbox::POMDP {
         Pruner prune(S);
         WitnessLP lp(S);
 
+        const auto lpStart = LP::getThreadStatistics();
+
         const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
         double variation = tolerance_ * 2; // Make it bigger
         while ( timestep < horizon_ && ( !useTolerance || variation > tolerance_ ) ) {
@@ -233,6 +247,9 @@ namespace AIToolbox::POMDP {
             }
         }
 
+        lpStats_ = LP::getThreadStatistics();
+        lpStats_ -= lpStart;
+
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
 
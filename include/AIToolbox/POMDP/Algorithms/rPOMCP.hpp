@@ -1,7 +1,6 @@
 #ifndef AI_TOOLBOX_POMDP_rPOMCP_HEADER_FILE
 #define AI_TOOLBOX_POMDP_rPOMCP_HEADER_FILE
 
-#include <unordered_map>
 
 #include <AIToolbox/Logging.hpp>
 #include <AIToolbox/Seeder.hpp>
@@ -278,7 +277,7 @@ namespace AIToolbox::POMDP {
             ot = aNode.children.find(o);
             if ( ot == aNode.children.end() ) {
                 newNode = true;
-                std::tie(ot, std::ignore) = aNode.children.insert(std::make_pair(o, BNode()));
+                std::tie(ot, std::ignore) = aNode.children.try_emplace(o);
             }
 
             // Compute knowledge for new observation node (entropy/max belief)
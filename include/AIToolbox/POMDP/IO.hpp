@@ -8,6 +8,7 @@
 #include <AIToolbox/MDP/IO.hpp>
 
 #include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/POMDP/Model.hpp>
@@ -29,6 +30,25 @@ namespace AIToolbox::POMDP {
      */
     Model<MDP::Model> parseCassandra(std::istream & input);
 
+    /**
+     * @brief This function parses a sparse POMDP from a Cassandra formatted file.
+     *
+     * This function is meant for large models, which would not fit in
+     * memory as dense matrices. The file is memory-mapped, and parsed
+     * directly into sparse matrices, optionally in parallel. See
+     * CassandraParser::parseSparsePOMDP() for details.
+     *
+     * This function may throw std::runtime_errors depending on whether the
+     * input is correctly formed or not, and std::invalid_argument if it
+     * does not describe a valid POMDP.
+     *
+     * @param filename The name of the file to parse.
+     * @param threads The number of threads to use; 0 uses all available cores.
+     *
+     * @return The parsed model.
+     */
+    SparseModel<MDP::SparseModel> parseCassandraSparse(const std::string & filename, unsigned threads = 1);
+
     /**
      * @brief This function outputs a POMDP model to a stream.
      *
@@ -45,6 +45,11 @@ namespace AIToolbox::POMDP {
      * arbitrary number of VEntries inside - with an upper bound. Each VList
      * can have at most A * size(VList_{t-1})^O.
      *
+     * VEntryT and VListT allow to store the values with a different scalar
+     * type, for example to halve the memory used by the projections and
+     * cross-sums of the pruning algorithms (see Projecter). VEntry and VList
+     * are their double versions, which are used everywhere else.
+     *
      * A ValueFunction is the final tree keeping all VLists together. A
      * ValueFunction has always at least one element.
      *
@@ -69,12 +74,17 @@ namespace AIToolbox::POMDP {
      */
 
     using VObs          = std::vector<size_t>;
-    struct VEntry {
-        MDP::Values values;
+    template <typename T>
+    struct VEntryT {
+        VectorT<T> values;
         size_t action;
         VObs observations;
     };
-    using VList         = std::vector<VEntry>;
+    template <typename T>
+    using VListT        = std::vector<VEntryT<T>>;
+
+    using VEntry        = VEntryT<double>;
+    using VList         = VListT<double>;
     using ValueFunction = std::vector<VList>;
 
     using UpperBoundValueFunction = std::pair<std::vector<Belief>, std::vector<double>>;
@@ -655,13 +655,13 @@ namespace AIToolbox::POMDP {
      * @param immediateRewards The immediate rewards of the model.
      * @param belief The belief to find the best action in.
      * @param ubQ The current QFunction for this model.
-     * @param ubV The current list of belief/values for this model.
+     * @param ubV The current list of belief/values for this model (either an UpperBoundValueFunction or an IndexedPointSurface in sync with ubQ).
      * @param vals Optionally, an output vector containing the per-action upper-bound values. Does not need preallocation, and passing it does not result in more work.
      *
      * @return The best action-value pair.
      */
-    template <bool useLP = true, IsModel M>
-    std::tuple<size_t, double> bestPromisingAction(const M & pomdp, const MDP::QFunction & immediateRewards, const Belief & belief, const MDP::QFunction & ubQ, const UpperBoundValueFunction & ubV, Vector * vals = nullptr) {
+    template <bool useLP = true, IsModel M, typename UBV>
+    std::tuple<size_t, double> bestPromisingAction(const M & pomdp, const MDP::QFunction & immediateRewards, const Belief & belief, const MDP::QFunction & ubQ, const UBV & ubV, Vector * vals = nullptr) {
         Vector storage;
         Vector & qvals = vals ? *vals : storage;
 
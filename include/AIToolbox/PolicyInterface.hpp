@@ -1,6 +1,9 @@
 #ifndef AI_TOOLBOX_POLICYINTERFACE_HEADER_FILE
 #define AI_TOOLBOX_POLICYINTERFACE_HEADER_FILE
 
+#include <span>
+#include <stdexcept>
+
 #include <AIToolbox/Types.hpp>
 #include <AIToolbox/Seeder.hpp>
 
@@ -52,6 +55,43 @@ namespace AIToolbox {
              */
             virtual Action sampleAction(const Sampling & s) const = 0;
 
+            /**
+             * @brief This function chooses a random action for state s, using the input generator.
+             *
+             * This function does not touch the internal generator of the
+             * policy. Policies that implement it can then be shared between
+             * threads and sampled concurrently, as long as each thread
+             * provides its own generator (see Seeder::getThreadEngine()).
+             *
+             * Not all policies support this: policies whose sampling
+             * depends on internal state updated by learning (e.g. the
+             * Bandit ESRLPolicy, LRPPolicy and SuccessiveRejectsPolicy) do
+             * not override it, and the default implementation throws
+             * std::logic_error. Wrappers such as EpsilonPolicy
+             * support it only if their wrapped policy does.
+             *
+             * @param s The sampled state of the policy.
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(const Sampling & s, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function chooses a random action for each of the input states.
+             *
+             * This function is equivalent to calling sampleAction() for each
+             * state, but it is a single virtual call, and policies can
+             * override it to share work between the samples.
+             *
+             * The input spans must have the same size, otherwise this
+             * function throws std::invalid_argument.
+             *
+             * @param s The sampled states of the policy.
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<const Sampling> s, std::span<Action> out) const;
+
             /**
              * @brief This function returns the probability of taking the specified action in the specified state.
              *
@@ -91,6 +131,19 @@ namespace AIToolbox {
     template <typename State, typename Sampling, typename Action>
     PolicyInterface<State, Sampling, Action>::~PolicyInterface() {}
 
+    template <typename State, typename Sampling, typename Action>
+    Action PolicyInterface<State, Sampling, Action>::sampleAction(const Sampling &, RandomEngine &) const {
+        throw std::logic_error("This policy does not support sampling with an external generator");
+    }
+
+    template <typename State, typename Sampling, typename Action>
+    void PolicyInterface<State, Sampling, Action>::sampleActions(std::span<const Sampling> s, std::span<Action> out) const {
+        if (s.size() != out.size()) throw std::invalid_argument("Input and output sizes of sampleActions differ");
+
+        for (size_t i = 0; i < s.size(); ++i)
+            out[i] = sampleAction(s[i]);
+    }
+
     template <typename State, typename Sampling, typename Action>
     const State & PolicyInterface<State, Sampling, Action>::getS() const { return S; }
 
@@ -128,6 +181,39 @@ namespace AIToolbox {
              */
             virtual Action sampleAction() const = 0;
 
+            /**
+             * @brief This function chooses a random action, using the input generator.
+             *
+             * This function does not touch the internal generator of the
+             * policy. Policies that implement it can then be shared between
+             * threads and sampled concurrently, as long as each thread
+             * provides its own generator (see Seeder::getThreadEngine()).
+             *
+             * Not all policies support this: policies whose sampling
+             * depends on internal state updated by learning (e.g. the
+             * Bandit ESRLPolicy, LRPPolicy and SuccessiveRejectsPolicy) do
+             * not override it, and the default implementation throws
+             * std::logic_error. Wrappers such as EpsilonPolicy
+             * support it only if their wrapped policy does.
+             *
+             * @param rnd The generator to use.
+             *
+             * @return The chosen action.
+             */
+            virtual Action sampleAction(RandomEngine & rnd) const;
+
+            /**
+             * @brief This function chooses multiple independent random actions.
+             *
+             * This function is equivalent to calling sampleAction() once for
+             * each element of the output, but it is a single virtual call,
+             * and policies can override it to share work between the
+             * samples.
+             *
+             * @param out The output span where to write the chosen actions.
+             */
+            virtual void sampleActions(std::span<Action> out) const;
+
             /**
              * @brief This function returns the probability of taking the specified action.
              *
@@ -158,6 +244,17 @@ namespace AIToolbox {
     template <typename Action>
     PolicyInterface<void, void, Action>::~PolicyInterface() {}
 
+    template <typename Action>
+    Action PolicyInterface<void, void, Action>::sampleAction(RandomEngine &) const {
+        throw std::logic_error("This policy does not support sampling with an external generator");
+    }
+
+    template <typename Action>
+    void PolicyInterface<void, void, Action>::sampleActions(std::span<Action> out) const {
+        for (auto & a : out)
+            a = sampleAction();
+    }
+
     template <typename Action>
     const Action & PolicyInterface<void, void, Action>::getA() const { return A; }
 }
@@ -2,7 +2,12 @@
 #define AI_TOOLBOX_SEEDER_HEADER_FILE
 
 #include <random>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
 #include <AIToolbox/Types.hpp>
+#include <AIToolbox/Utils/Philox.hpp>
 
 namespace AIToolbox {
     /**
@@ -11,12 +16,71 @@ namespace AIToolbox {
      * To avoid seeding all generators with a single seed equal to the current time, only
      * this class is setup with the time seed, while all others are seeded with numbers
      * generated from this class to obtain maximum randomness.
+     *
+     * Note that getSeed() draws from a single shared generator. While it
+     * is safe to call it concurrently, the seeds each caller gets then
+     * depend on the order of the calls, which is not reproducible. When
+     * random numbers are needed from multiple threads, use the stream
+     * functions instead: they derive independent generators from the root
+     * seed and a stream id through the counter-based Philox engine,
+     * without touching any shared state. Objects that seed themselves via
+     * getSeed() can be made reproducible by constructing them within a
+     * StreamScope.
      */
     class Seeder {
         public:
+            /**
+             * @brief This class redirects getSeed() to a stream for the duration of its scope.
+             *
+             * While an instance of this class is alive, all calls to
+             * getSeed() made from the same thread draw from a generator
+             * that depends only on the root seed and the ids of the
+             * scope, rather than from the shared generator. Thus objects
+             * constructed within the scope are seeded the same way
+             * regardless of how many other threads are constructing
+             * objects at the same time.
+             *
+             * Scopes can be nested: an inner scope uses a child stream of
+             * the outer one (see Philox::split()), so hierarchical ids like
+             * experiment/episode/agent can be given without coordinating
+             * them globally.
+             *
+             * Scopes must be destroyed in the reverse order of their
+             * construction, and only affect the thread that created them.
+             */
+            class StreamScope {
+                public:
+                    /**
+                     * @brief Basic constructor.
+                     *
+                     * @param stream The id of the stream, relative to the enclosing scope if any.
+                     */
+                    explicit StreamScope(std::uint64_t stream);
+
+                    /**
+                     * @brief Destructor; this restores the enclosing scope, if any.
+                     */
+                    ~StreamScope();
+
+                    StreamScope(const StreamScope &) = delete;
+                    StreamScope & operator=(const StreamScope &) = delete;
+
+                private:
+                    friend class Seeder;
+
+                    Philox engine_;
+                    StreamScope * parent_;
+            };
+
             /**
              * @brief This function gets a random number to seed generators.
              *
+             * If the calling thread is within a StreamScope, the number is
+             * drawn from the stream of the innermost scope. Otherwise it is
+             * drawn from the shared generator.
+             *
+             * This function is thread-safe.
+             *
              * @return A random unsigned number.
              */
             static unsigned getSeed();
@@ -29,6 +93,10 @@ namespace AIToolbox {
              * reproducible experiments, this function can be called in order
              * to seed the underlying generator.
              *
+             * This function should be called before spawning any thread
+             * that uses streams, as they read the root seed without
+             * synchronization.
+             *
              * @param seed The seed for the underlying generator.
              */
             static void setRootSeed(unsigned seed);
@@ -43,6 +111,66 @@ namespace AIToolbox {
              */
             static unsigned getRootSeed();
 
+            /**
+             * @brief This function returns a counter-based engine for the input stream.
+             *
+             * The returned engine depends only on the root seed and the
+             * stream id, so this function is thread-safe, and runs are
+             * reproducible regardless of the order in which streams are
+             * requested.
+             *
+             * Stream ids with the highest bit set are reserved for
+             * getThreadEngine(). Further independent streams can be
+             * obtained from the returned engine with Philox::split().
+             *
+             * @param stream The id of the stream.
+             *
+             * @return A Philox engine for the input stream.
+             */
+            static Philox getStream(std::uint64_t stream);
+
+            /**
+             * @brief This function returns a RandomEngine seeded from the input stream.
+             *
+             * When RandomEngine is Philox (see AI_RANDOM_ENGINE_PHILOX)
+             * this simply returns a copy of the input. Otherwise, the
+             * whole state of the RandomEngine is filled with the output of
+             * the stream.
+             *
+             * @param stream The stream to seed the engine with.
+             *
+             * @return A RandomEngine for the input stream.
+             */
+            static RandomEngine getStreamEngine(const Philox & stream);
+
+            /**
+             * @brief This function returns a RandomEngine seeded from the input stream.
+             *
+             * This is equivalent to seeding a RandomEngine with the output of
+             * getStream(stream), so it is also thread-safe and reproducible.
+             *
+             * @param stream The id of the stream.
+             *
+             * @return A RandomEngine for the input stream.
+             */
+            static RandomEngine getStreamEngine(std::uint64_t stream);
+
+            /**
+             * @brief This function returns a RandomEngine local to the calling thread.
+             *
+             * Each thread is assigned a separate stream the first time it
+             * calls this function, so that the returned engine can be
+             * passed to the const sampling functions of shared objects (like
+             * policies) without synchronization.
+             *
+             * Note that the stream of each thread depends on the order in
+             * which threads first call this function; for reproducible
+             * multithreaded runs, use getStreamEngine() with explicit ids.
+             *
+             * @return A reference to the engine of the calling thread.
+             */
+            static RandomEngine & getThreadEngine();
+
         private:
             Seeder();
 
@@ -50,6 +178,8 @@ namespace AIToolbox {
 
             unsigned rootSeed_;
             RandomEngine generator_;
+            std::mutex generatorMutex_;
+            std::atomic<std::uint64_t> threadStreams_;
     };
 }
 
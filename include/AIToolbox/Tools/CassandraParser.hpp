@@ -3,6 +3,7 @@
 
 #include <AIToolbox/Types.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <functional>
@@ -15,6 +16,8 @@ namespace AIToolbox {
         public:
             using MDPVals = std::tuple<size_t, size_t, DumbMatrix3D, DumbMatrix3D, double>;
             using POMDPVals = std::tuple<size_t, size_t, size_t, DumbMatrix3D, DumbMatrix3D, DumbMatrix3D, double>;
+            using SparseMDPVals = std::tuple<size_t, size_t, SparseMatrix3D, SparseMatrix2D, double>;
+            using SparsePOMDPVals = std::tuple<size_t, size_t, size_t, SparseMatrix3D, SparseMatrix2D, SparseMatrix3D, double>;
 
             /**
              * @brief Basic constructor.
@@ -63,8 +66,61 @@ namespace AIToolbox {
              */
             POMDPVals parsePOMDP(std::istream & input);
 
+            /**
+             * @brief This function parses the input following Cassandra's rules into sparse matrices.
+             *
+             * This function accepts the same syntax as parseMDP(std::istream &),
+             * and in addition it understands '#' comments and the
+             * `identity` and `uniform` matrix keywords.
+             *
+             * Rather than filling dense S*A*S matrices, the parser
+             * collects the entries of each statement as triplets, and
+             * builds the sparse transition matrices from them. The
+             * rewards are directly returned as the SxA matrix of expected
+             * rewards, as used by MDP::SparseModel. Thus, memory is
+             * proportional to the size of the input rather than to the
+             * size of the state space. Note that wildcards in statements
+             * are still expanded, so for example a `T: a : *` row
+             * statement produces S*S entries.
+             *
+             * The input is a view of the whole file, which avoids copying
+             * its lines (see MappedFile). Statements can optionally be
+             * parsed by multiple threads; the result does not depend on
+             * the number of threads used.
+             *
+             * Any problems during parsing result in an std::runtime_error.
+             *
+             * No checks are done here regarding the consistency of the read
+             * data (transition probabilities, etc).
+             *
+             * @param input The contents of the file to parse.
+             * @param threads The number of threads to use; 0 uses all available cores.
+             *
+             * @return A tuple containing S, A, T, R, and discount of the parsed MDP.
+             */
+            SparseMDPVals parseSparseMDP(std::string_view input, unsigned threads = 1);
+
+            /**
+             * @brief This function parses the input following Cassandra's rules into sparse matrices.
+             *
+             * This function is equivalent to parseSparseMDP(std::string_view, unsigned),
+             * but it also parses the number of observations and the
+             * observation function, as parsePOMDP(std::istream &) does.
+             *
+             * @param input The contents of the file to parse.
+             * @param threads The number of threads to use; 0 uses all available cores.
+             *
+             * @return A tuple containing S, A, O, T, R, W, and discount of the parsed POMDP.
+             */
+            SparsePOMDPVals parseSparsePOMDP(std::string_view input, unsigned threads = 1);
+
         private:
-            using IDMap = std::unordered_map<std::string, size_t>;
+            // The transparent hash allows lookups from std::string_view without copies.
+            struct IDHash {
+                using is_transparent = void;
+                size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+            };
+            using IDMap = std::unordered_map<std::string, size_t, IDHash, std::equal_to<>>;
             using ActionMap = std::unordered_map<std::string, std::function<void(const std::string &)>>;
             using Tokens = std::vector<std::string>;
 
@@ -77,6 +133,34 @@ namespace AIToolbox {
              */
             void parseModelInfo(std::istream & input);
 
+            /**
+             * @brief This function parses the preamble from an in-memory input.
+             *
+             * Comments and empty lines are discarded, and all other lines
+             * are returned as views into the input.
+             *
+             * @param input The contents of the file to parse.
+             *
+             * @return The lines of the input which are not part of the preamble.
+             */
+            std::vector<std::string_view> parseModelInfo(std::string_view input);
+
+            /**
+             * @brief This function parses the T, O and R statements into sparse matrices.
+             *
+             * The lines are split in chunks, each starting with a
+             * statement, which are parsed in parallel. The triplets of
+             * each chunk are then merged in order, so that later
+             * statements override earlier ones as in the dense parser.
+             *
+             * @param lines The lines of the input which are not part of the preamble.
+             * @param threads The number of threads to use; 0 uses all available cores.
+             * @param T The transition matrix to build.
+             * @param R The expected rewards matrix to build.
+             * @param W The observation matrix to build, or nullptr to ignore O statements.
+             */
+            void parseSparseBody(const std::vector<std::string_view> & lines, unsigned threads, SparseMatrix3D & T, SparseMatrix2D & R, SparseMatrix3D * W);
+
             /**
              * @brief This function extracts ids from numbers or string tokens.
              *
@@ -0,0 +1,101 @@
+#ifndef AI_TOOLBOX_EXPERIMENTS_HEADER_FILE
+#define AI_TOOLBOX_EXPERIMENTS_HEADER_FILE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Tools/Statistics.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This function runs independent episodes in parallel, and collects their statistics.
+     *
+     * Each episode is run by calling the input function as
+     * `episode(i, rnd, stats)`, where `i` is the index of the episode, `rnd`
+     * is a RandomEngine reserved for it, and `stats` is the Statistics where
+     * the episode must record its values (in timestep order).
+     *
+     * Each episode `i` gets the engine returned by
+     * Seeder::getStreamEngine(firstStream + i), so its randomness does not
+     * depend on which thread runs it. Episodes are split in fixed chunks,
+     * each recorded sequentially in its own Statistics; the chunks are
+     * then merged in order. Thus, as long as each episode only uses its
+     * engine for randomness, the result is identical for any number of
+     * threads. Each episode also runs within a Seeder::StreamScope on the
+     * same stream id, so objects that the episode constructs, and that
+     * seed themselves through Seeder::getSeed(), are reproducible as well.
+     *
+     * Different experiments should use non-overlapping stream ranges, to
+     * avoid correlations between them.
+     *
+     * The episode function is called concurrently from multiple threads.
+     * If any episode throws, the exception of the failing episode with the
+     * lowest index is rethrown here after all threads have stopped, so
+     * that, like the result, it does not depend on the number of threads.
+     * Episodes after the first failure may not be run.
+     *
+     * @param episodes The number of episodes to run.
+     * @param timesteps The number of timesteps of the returned Statistics.
+     * @param episode The function running a single episode.
+     * @param threads The number of threads to use; 0 uses all available cores.
+     * @param firstStream The Seeder stream of the first episode.
+     *
+     * @return The merged Statistics of all episodes.
+     */
+    template <typename F>
+    Statistics runEpisodes(const size_t episodes, const size_t timesteps, F && episode, unsigned threads = 1, const std::uint64_t firstStream = 0) {
+        // This must not depend on the number of threads, or the order of the
+        // floating point sums would change the result.
+        constexpr size_t chunkSize = 16;
+        const size_t chunks = (episodes + chunkSize - 1) / chunkSize;
+
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::max(1u, static_cast<unsigned>(std::min<size_t>(threads, chunks)));
+
+        std::vector<Statistics> results(chunks, Statistics(timesteps));
+        std::vector<std::exception_ptr> errors(chunks);
+        std::atomic<size_t> nextChunk = 0;
+
+        auto worker = [&]() {
+            for (size_t c = nextChunk++; c < chunks; c = nextChunk++) {
+                try {
+                    const size_t end = std::min(episodes, (c + 1) * chunkSize);
+                    for (size_t i = c * chunkSize; i < end; ++i) {
+                        Seeder::StreamScope scope(firstStream + i);
+                        auto rnd = Seeder::getStreamEngine(firstStream + i);
+                        episode(i, rnd, results[c]);
+                    }
+                } catch (...) {
+                    errors[c] = std::current_exception();
+                    // Stop the other workers as soon as possible. Chunks
+                    // are claimed in order, so all the ones before this
+                    // have already been claimed and still run to the end.
+                    nextChunk = chunks;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (auto & w : workers) w.join();
+
+        for (const auto & e : errors)
+            if (e) std::rethrow_exception(e);
+
+        Statistics retval(timesteps);
+        for (const auto & r : results)
+            retval.merge(r);
+
+        return retval;
+    }
+}
+
+#endif
@@ -55,6 +55,22 @@ namespace AIToolbox {
              */
             void record(double value, size_t timestep);
 
+            /**
+             * @brief This function adds all data recorded in another Statistics to this one.
+             *
+             * This allows recording separate sets of runs (for example
+             * from different threads) in separate Statistics, and to
+             * combine them afterwards. The result is the same as if all
+             * runs had been recorded here, up to floating point rounding,
+             * which depends on the order of the merges.
+             *
+             * Both Statistics must have the same number of timesteps,
+             * otherwise this function throws std::invalid_argument.
+             *
+             * @param other The Statistics to add to this one.
+             */
+            void merge(const Statistics & other);
+
             /**
              * @brief This function computes mean and standard deviation for all timesteps.
              *
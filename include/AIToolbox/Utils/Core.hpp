@@ -353,6 +353,74 @@ namespace AIToolbox {
                 for ( size_t x = 0; x < d3; ++x )
                     out[i][j][x] = in[i][j][x];
     }
+
+    /**
+     * @brief This function makes sure each row of a row-major sparse matrix has space for a number of non-zeros.
+     *
+     * The matrix is left uncompressed, so that elements can be inserted in
+     * a row without moving the data of the other rows as long as the row
+     * has space left. Rows which already hold more non-zeros than requested
+     * are left as they are.
+     *
+     * @param m The sparse matrix to reserve space into.
+     * @param rowCapacity The minimum number of non-zeros each row should be able to hold.
+     */
+    template <typename M>
+    void reserveSparseRows(M & m, const size_t rowCapacity) {
+        static_assert(M::IsRowMajor);
+
+        // Eigen reserves space on top of the current non-zeros of each row.
+        Eigen::VectorXi extra(m.rows());
+        for ( Eigen::Index r = 0; r < m.rows(); ++r ) {
+            const auto nnz = static_cast<size_t>(m.isCompressed() ?
+                m.outerIndexPtr()[r + 1] - m.outerIndexPtr()[r] :
+                m.innerNonZeroPtr()[r]);
+            extra[r] = static_cast<int>(rowCapacity > nnz ? rowCapacity - nnz : 0);
+        }
+        m.reserve(extra);
+    }
+
+    /**
+     * @brief This function adds a weighted sample to running mean and M2 statistics.
+     *
+     * This is the weighted version of Welford's algorithm.
+     *
+     * @param n The total weight of the samples, including the new one.
+     * @param mean The weighted mean of the samples, to update.
+     * @param m2 The weighted M2 statistic of the samples, to update.
+     * @param w The weight of the new sample.
+     * @param x The new sample.
+     */
+    inline void updateWelford(const double n, double & mean, double & m2, const double w, const double x) {
+        const double delta = x - mean;
+        mean += delta * w / n;
+        m2 += w * delta * (x - mean);
+    }
+
+    /**
+     * @brief This function merges the mean and M2 statistics of a set of weighted samples into another.
+     *
+     * This is the parallel algorithm by Chan et al., which is exact as
+     * long as both sets were computed with Welford's algorithm (see
+     * updateWelford()).
+     *
+     * @param n1 The total weight of the first set, to update.
+     * @param mean1 The weighted mean of the first set, to update.
+     * @param m21 The weighted M2 statistic of the first set, to update.
+     * @param n2 The total weight of the second set.
+     * @param mean2 The weighted mean of the second set.
+     * @param m22 The weighted M2 statistic of the second set.
+     */
+    inline void mergeWelford(double & n1, double & mean1, double & m21, const double n2, const double mean2, const double m22) {
+        if (n2 == 0.0) return;
+
+        const double n = n1 + n2;
+        const double delta = mean2 - mean1;
+
+        mean1 += delta * n2 / n;
+        m21 += m22 + delta * delta * n1 * n2 / n;
+        n1 = n;
+    }
 }
 
 namespace Eigen {
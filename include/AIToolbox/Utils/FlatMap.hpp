@@ -0,0 +1,537 @@
+#ifndef AI_TOOLBOX_UTILS_FLAT_MAP_HEADER_FILE
+#define AI_TOOLBOX_UTILS_FLAT_MAP_HEADER_FILE
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <tuple>
+#include <functional>
+
+namespace AIToolbox {
+    /**
+     * @brief This class is a hash map using open addressing with Robin Hood hashing.
+     *
+     * All elements are stored in a single flat array, together with a
+     * byte for each slot holding the distance of its element from its
+     * ideal position (zero meaning the slot is empty). On insertion,
+     * elements that are closer to their ideal slot give way to the ones
+     * further away, which keeps probe sequences short; removals shift
+     * the following elements back, so no tombstones are needed.
+     *
+     * Compared to std::unordered_map this avoids one allocation per
+     * element and the pointer chasing that comes with it, which makes a
+     * big difference for the small maps stored in the nodes of tree
+     * search algorithms (MCTS, POMCP, rPOMCP).
+     *
+     * The interface follows the one of std::unordered_map, with some
+     * differences:
+     *
+     * - Insertions and removals invalidate all iterators, pointers and
+     *   references to the elements of the map (since elements may be
+     *   moved). References obtained before an insertion in a *different*
+     *   map are of course not affected.
+     * - The value_type is std::pair<K, V>, rather than
+     *   std::pair<const K, V>. Keys must not be modified.
+     * - Both keys and values must be nothrow move constructible.
+     *
+     * The hash of each key is scrambled before use, so identity hashes
+     * (as std::hash<size_t>) work fine. The mapped type can be incomplete
+     * when the map is declared, so recursive structures (like trees) can
+     * be built with it.
+     *
+     * @tparam K The key type.
+     * @tparam V The mapped type.
+     * @tparam Hash The hash function for the keys.
+     * @tparam KeyEqual The equality function for the keys.
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    class FlatMap {
+        public:
+            using key_type = K;
+            using mapped_type = V;
+            using value_type = std::pair<K, V>;
+            using size_type = size_t;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+
+            template <bool Const>
+            class Iterator {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = typename FlatMap::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+                    using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+                    Iterator() : slots_(nullptr), dist_(nullptr), id_(0), capacity_(0) {}
+                    Iterator(pointer slots, const uint8_t * dist, size_t id, size_t capacity) :
+                            slots_(slots), dist_(dist), id_(id), capacity_(capacity) { skipEmpty(); }
+
+                    // Allows conversion from iterator to const_iterator.
+                    template <bool C = Const, typename = std::enable_if_t<C>>
+                    Iterator(const Iterator<false> & other) :
+                            slots_(other.slots_), dist_(other.dist_), id_(other.id_), capacity_(other.capacity_) {}
+
+                    reference operator*() const { return slots_[id_]; }
+                    pointer operator->() const { return slots_ + id_; }
+
+                    Iterator & operator++() { ++id_; skipEmpty(); return *this; }
+                    Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+
+                    bool operator==(const Iterator & other) const { return id_ == other.id_; }
+                    bool operator!=(const Iterator & other) const { return id_ != other.id_; }
+
+                private:
+                    friend class FlatMap;
+                    friend class Iterator<!Const>;
+
+                    void skipEmpty() { while (id_ < capacity_ && !dist_[id_]) ++id_; }
+
+                    pointer slots_;
+                    const uint8_t * dist_;
+                    size_t id_, capacity_;
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor does not allocate any memory.
+             */
+            FlatMap();
+
+            /**
+             * @brief Copy constructor.
+             */
+            FlatMap(const FlatMap & other);
+
+            /**
+             * @brief Move constructor.
+             */
+            FlatMap(FlatMap && other) noexcept;
+
+            /**
+             * @brief Assignment operator.
+             */
+            FlatMap & operator=(FlatMap other) noexcept;
+
+            /**
+             * @brief Destructor.
+             */
+            ~FlatMap();
+
+            /**
+             * @brief This function returns the element with the input key, if present.
+             *
+             * @param key The key to look for.
+             *
+             * @return An iterator to the element, or end() if not found.
+             */
+            iterator find(const K & key);
+            const_iterator find(const K & key) const;
+
+            /**
+             * @brief This function returns whether the map contains the input key.
+             *
+             * @param key The key to look for.
+             *
+             * @return 1 if the key is present, 0 otherwise.
+             */
+            size_t count(const K & key) const;
+
+            /**
+             * @brief This function returns the value for the input key, inserting a default one if not present.
+             *
+             * @param key The key to look for.
+             *
+             * @return A reference to the value.
+             */
+            V & operator[](const K & key);
+
+            /**
+             * @brief This function inserts a new element constructed from the input arguments, if the key is not present.
+             *
+             * @param key The key of the element.
+             * @param args The arguments to construct the value with.
+             *
+             * @return An iterator to the element with the key, and whether the insertion took place.
+             */
+            template <typename... Args>
+            std::pair<iterator, bool> try_emplace(const K & key, Args&&... args);
+
+            /**
+             * @brief This function inserts the input element, if its key is not present.
+             *
+             * @param value The element to insert.
+             *
+             * @return An iterator to the element with the key, and whether the insertion took place.
+             */
+            std::pair<iterator, bool> insert(value_type && value);
+
+            /**
+             * @brief This function removes the element with the input key, if present.
+             *
+             * @param key The key to remove.
+             *
+             * @return The number of removed elements.
+             */
+            size_t erase(const K & key);
+
+            /**
+             * @brief This function removes all elements, while keeping the allocated memory.
+             */
+            void clear();
+
+            /**
+             * @brief This function makes sure the map can contain the input number of elements without reallocating.
+             *
+             * @param size The number of elements.
+             */
+            void reserve(size_t size);
+
+            /**
+             * @brief This function swaps the contents of two maps.
+             */
+            void swap(FlatMap & other) noexcept;
+
+            /**
+             * @brief This function returns the number of elements in the map.
+             */
+            size_t size() const;
+
+            /**
+             * @brief This function returns whether the map is empty.
+             */
+            bool empty() const;
+
+            /**
+             * @brief This function returns the number of slots allocated for the map.
+             */
+            size_t capacity() const;
+
+            iterator begin();
+            const_iterator begin() const;
+            const_iterator cbegin() const;
+
+            iterator end();
+            const_iterator end() const;
+            const_iterator cend() const;
+
+        private:
+            // The distance of each element from its ideal slot is stored in a
+            // byte; going over this limit forces the map to grow.
+            static constexpr uint8_t MaxDistance = 255;
+            // Maximum load factor, as a fraction over 8.
+            static constexpr size_t MaxLoadNum = 7;
+            // Most maps in search trees only have a couple of elements, so we
+            // start small.
+            static constexpr size_t MinCapacity = 4;
+
+            /**
+             * @brief This function returns the ideal slot for the input key.
+             *
+             * We use Fibonacci hashing, which maps the hash to the top bits
+             * of its product with 2^64 / phi; this works well even with
+             * poor hashes.
+             */
+            size_t home(const K & key) const;
+
+            /**
+             * @brief This function looks for the input key.
+             *
+             * @return The slot of the key, or capacity_ if not present.
+             */
+            size_t findSlot(const K & key) const;
+
+            /**
+             * @brief This function inserts a value known not to be in the map.
+             *
+             * The value is moved in only if it could be inserted.
+             *
+             * @param start The ideal slot of the value.
+             * @param value The value to insert.
+             *
+             * @return The slot of the inserted value, or capacity_ if the maximum probe distance would be exceeded.
+             */
+            size_t insertUnique(size_t start, value_type & value);
+
+            /**
+             * @brief This function inserts a value constructed from the input arguments.
+             */
+            template <typename... Args>
+            std::pair<iterator, bool> emplaceImpl(const K & key, Args&&... args);
+
+            /**
+             * @brief This function moves all elements to a table of the input capacity.
+             */
+            void rehash(size_t capacity);
+
+            void destroy();
+
+            value_type * slots_;
+            std::unique_ptr<uint8_t[]> dist_;
+            size_t size_, capacity_, shift_;
+    };
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    FlatMap<K, V, Hash, KeyEqual>::FlatMap() : slots_(nullptr), size_(0), capacity_(0), shift_(0) {}
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    FlatMap<K, V, Hash, KeyEqual>::FlatMap(const FlatMap & other) : FlatMap() {
+        if (!other.size_) return;
+
+        slots_ = std::allocator<value_type>().allocate(other.capacity_);
+        dist_.reset(new uint8_t[other.capacity_]());
+        capacity_ = other.capacity_;
+        shift_ = other.shift_;
+
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (!other.dist_[i]) continue;
+            new (slots_ + i) value_type(other.slots_[i]);
+            dist_[i] = other.dist_[i];
+            ++size_;
+        }
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    FlatMap<K, V, Hash, KeyEqual>::FlatMap(FlatMap && other) noexcept : FlatMap() {
+        swap(other);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    FlatMap<K, V, Hash, KeyEqual> & FlatMap<K, V, Hash, KeyEqual>::operator=(FlatMap other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    FlatMap<K, V, Hash, KeyEqual>::~FlatMap() {
+        destroy();
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void FlatMap<K, V, Hash, KeyEqual>::destroy() {
+        if (!slots_) return;
+
+        clear();
+        std::allocator<value_type>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+        dist_.reset();
+        capacity_ = 0;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::home(const K & key) const {
+        return (static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> shift_;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::findSlot(const K & key) const {
+        if (!size_) return capacity_;
+
+        const size_t mask = capacity_ - 1;
+        size_t i = home(key);
+        // If we find an element closer to its home than we are to ours, the
+        // key cannot be further on.
+        for (unsigned d = 1; dist_[i] >= d; ++d, i = (i + 1) & mask)
+            if (dist_[i] == d && KeyEqual()(slots_[i].first, key))
+                return i;
+
+        return capacity_;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::insertUnique(const size_t start, value_type & value) {
+        const size_t mask = capacity_ - 1;
+
+        // Find where the value goes, which is the first slot whose element
+        // is closer to its home than we would be.
+        size_t i = start;
+        unsigned d = 1;
+        for (; dist_[i] >= d; ++d, i = (i + 1) & mask)
+            if (d == MaxDistance) return capacity_;
+
+        // Find the empty slot at the end of this run, making sure that
+        // shifting the elements in between would not overflow their
+        // distances.
+        size_t e = i;
+        for (; dist_[e]; e = (e + 1) & mask)
+            if (dist_[e] == MaxDistance) return capacity_;
+
+        // Shift everything in [i, e) one slot forward.
+        while (e != i) {
+            const size_t prev = (e - 1) & mask;
+            new (slots_ + e) value_type(std::move(slots_[prev]));
+            slots_[prev].~value_type();
+            dist_[e] = dist_[prev] + 1;
+            e = prev;
+        }
+        new (slots_ + i) value_type(std::move(value));
+        dist_[i] = d;
+        ++size_;
+
+        return i;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    template <typename... Args>
+    std::pair<typename FlatMap<K, V, Hash, KeyEqual>::iterator, bool> FlatMap<K, V, Hash, KeyEqual>::emplaceImpl(const K & key, Args&&... args) {
+        if (const auto i = findSlot(key); i != capacity_)
+            return {iterator(slots_, dist_.get(), i, capacity_), false};
+
+        // We construct the value before touching the table, so that if
+        // this throws the map is left as it was.
+        value_type value(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+
+        if ((size_ + 1) * 8 > capacity_ * MaxLoadNum)
+            rehash(capacity_ ? capacity_ * 2 : MinCapacity);
+
+        size_t i;
+        while ((i = insertUnique(home(key), value)) == capacity_)
+            rehash(capacity_ * 2);
+
+        return {iterator(slots_, dist_.get(), i, capacity_), true};
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void FlatMap<K, V, Hash, KeyEqual>::rehash(const size_t capacity) {
+        FlatMap other;
+        other.slots_ = std::allocator<value_type>().allocate(capacity);
+        other.dist_.reset(new uint8_t[capacity]());
+        other.capacity_ = capacity;
+        other.shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) --other.shift_;
+
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (!dist_[i]) continue;
+            while (other.insertUnique(other.home(slots_[i].first), slots_[i]) == other.capacity_)
+                other.rehash(other.capacity_ * 2);
+        }
+        swap(other);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::iterator FlatMap<K, V, Hash, KeyEqual>::find(const K & key) {
+        return iterator(slots_, dist_.get(), findSlot(key), capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::const_iterator FlatMap<K, V, Hash, KeyEqual>::find(const K & key) const {
+        return const_iterator(slots_, dist_.get(), findSlot(key), capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::count(const K & key) const {
+        return findSlot(key) != capacity_;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    V & FlatMap<K, V, Hash, KeyEqual>::operator[](const K & key) {
+        return emplaceImpl(key).first->second;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    template <typename... Args>
+    std::pair<typename FlatMap<K, V, Hash, KeyEqual>::iterator, bool> FlatMap<K, V, Hash, KeyEqual>::try_emplace(const K & key, Args&&... args) {
+        return emplaceImpl(key, std::forward<Args>(args)...);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    std::pair<typename FlatMap<K, V, Hash, KeyEqual>::iterator, bool> FlatMap<K, V, Hash, KeyEqual>::insert(value_type && value) {
+        return emplaceImpl(value.first, std::move(value.second));
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::erase(const K & key) {
+        size_t i = findSlot(key);
+        if (i == capacity_) return 0;
+
+        // Backward shift: all following elements which are not in their
+        // ideal slot move back by one.
+        const size_t mask = capacity_ - 1;
+        slots_[i].~value_type();
+        for (size_t next = (i + 1) & mask; dist_[next] > 1; i = next, next = (next + 1) & mask) {
+            new (slots_ + i) value_type(std::move(slots_[next]));
+            slots_[next].~value_type();
+            dist_[i] = dist_[next] - 1;
+        }
+        dist_[i] = 0;
+        --size_;
+
+        return 1;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void FlatMap<K, V, Hash, KeyEqual>::clear() {
+        for (size_t i = 0; size_ && i < capacity_; ++i) {
+            if (!dist_[i]) continue;
+            slots_[i].~value_type();
+            dist_[i] = 0;
+            --size_;
+        }
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void FlatMap<K, V, Hash, KeyEqual>::reserve(const size_t size) {
+        size_t capacity = capacity_ ? capacity_ : MinCapacity;
+        while (size * 8 > capacity * MaxLoadNum) capacity *= 2;
+
+        if (capacity > capacity_)
+            rehash(capacity);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void FlatMap<K, V, Hash, KeyEqual>::swap(FlatMap & other) noexcept {
+        using std::swap;
+        swap(slots_, other.slots_);
+        swap(dist_, other.dist_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+        swap(shift_, other.shift_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::size() const { return size_; }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    bool FlatMap<K, V, Hash, KeyEqual>::empty() const { return size_ == 0; }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    size_t FlatMap<K, V, Hash, KeyEqual>::capacity() const { return capacity_; }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::iterator FlatMap<K, V, Hash, KeyEqual>::begin() {
+        return iterator(slots_, dist_.get(), 0, capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::const_iterator FlatMap<K, V, Hash, KeyEqual>::begin() const {
+        return const_iterator(slots_, dist_.get(), 0, capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::const_iterator FlatMap<K, V, Hash, KeyEqual>::cbegin() const {
+        return begin();
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::iterator FlatMap<K, V, Hash, KeyEqual>::end() {
+        return iterator(slots_, dist_.get(), capacity_, capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::const_iterator FlatMap<K, V, Hash, KeyEqual>::end() const {
+        return const_iterator(slots_, dist_.get(), capacity_, capacity_);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename FlatMap<K, V, Hash, KeyEqual>::const_iterator FlatMap<K, V, Hash, KeyEqual>::cend() const {
+        return end();
+    }
+}
+
+#endif
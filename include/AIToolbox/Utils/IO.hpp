@@ -4,6 +4,8 @@
 #include <AIToolbox/Types.hpp>
 
 #include <iostream>
+#include <string>
+#include <string_view>
 
 namespace AIToolbox {
     /**
@@ -66,6 +68,50 @@ namespace AIToolbox {
     std::istream & read(std::istream & is, SparseTable3D & t);
 
     /** @}  */
+
+    /**
+     * @brief This class provides read-only access to the whole contents of a file.
+     *
+     * Where possible (POSIX systems), the file is memory-mapped, so that
+     * its contents are read lazily by the OS, and are never copied. On
+     * other systems the file is read into memory on construction.
+     *
+     * The returned data is valid as long as this class is alive.
+     */
+    class MappedFile {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor throws an std::runtime_error if the file
+             * cannot be opened or read.
+             *
+             * @param filename The name of the file to open.
+             */
+            explicit MappedFile(const std::string & filename);
+
+            /**
+             * @brief Basic destructor.
+             */
+            ~MappedFile();
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator=(const MappedFile &) = delete;
+
+            /**
+             * @brief This function returns the contents of the file.
+             *
+             * @return A view over the whole file.
+             */
+            std::string_view getData() const;
+
+        private:
+            const char * data_;
+            size_t size_;
+            bool mapped_;
+            // Used when we cannot map the file.
+            std::string buffer_;
+    };
 }
 
 #endif
@@ -0,0 +1,104 @@
+#ifndef AI_TOOLBOX_UTILS_INSTRUMENTATION_HEADER_FILE
+#define AI_TOOLBOX_UTILS_INSTRUMENTATION_HEADER_FILE
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace AIToolbox {
+    /**
+     * @brief This struct contains the counters recorded during a single call to a solver.
+     *
+     * Solvers that support instrumentation keep one of these, which is
+     * reset at the start of each call and can be read through their
+     * getStatistics() method.
+     *
+     * Counters are only recorded while instrumentation is enabled (see
+     * setInstrumentationEnabled()); otherwise they are left at zero. Not
+     * every solver uses every counter: the ones that do not apply to a
+     * solver also stay at zero.
+     *
+     * LP solves are counted per thread (see LP::getThreadSolves()), so
+     * lpCalls only includes the solves made by the thread which called
+     * the solver, and not the ones made by any worker threads it spawns.
+     */
+    struct SolverStatistics {
+        unsigned iterations = 0;        ///< Number of iterations of the main loop.
+        size_t lpCalls = 0;             ///< Number of LP solves performed by the calling thread.
+        size_t prunedVectors = 0;       ///< Number of vectors removed by pruning.
+        size_t treeNodes = 0;           ///< Number of search tree nodes created.
+        size_t simulations = 0;         ///< Number of simulations run from the root.
+        double seconds = 0.0;           ///< Wall-clock time spent in the call.
+        std::vector<double> residuals;  ///< The residual (or bound gap) after each iteration.
+
+        /**
+         * @brief This function returns the number of simulations run per second.
+         *
+         * @return The simulations per second, or zero if no time was recorded.
+         */
+        double getSimulationsPerSecond() const;
+    };
+
+    /**
+     * @brief This function enables or disables the recording of SolverStatistics.
+     *
+     * Instrumentation is disabled by default. The setting is global, and
+     * is read by each solver once at the start of each call, so changing
+     * it while a solver is running does not affect that call.
+     *
+     * @param enabled Whether solvers should record their statistics.
+     */
+    void setInstrumentationEnabled(bool enabled);
+
+    /**
+     * @brief This function returns whether solvers record their statistics.
+     *
+     * @return Whether instrumentation is enabled.
+     */
+    bool isInstrumentationEnabled();
+
+    /**
+     * @brief This class records a single solver call into a SolverStatistics.
+     *
+     * On construction the input statistics are reset. If instrumentation
+     * is enabled, the recorder also times the call and counts the LP
+     * solves made by the calling thread, and stores both on destruction.
+     * Solvers which expose their own LP::Statistics can disable the LP
+     * count, so that the solves are reported only once.
+     *
+     * Solvers test the recorder before updating any other counter, so
+     * that when instrumentation is disabled recording costs a single
+     * branch, and no allocations or clock reads.
+     */
+    class SolverStatisticsRecorder {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * @param stats The statistics to record into.
+             * @param countLPCalls Whether to record the LP solves into SolverStatistics::lpCalls.
+             */
+            explicit SolverStatisticsRecorder(SolverStatistics & stats, bool countLPCalls = true);
+
+            /**
+             * @brief Destructor; this stores the elapsed time and LP solves.
+             */
+            ~SolverStatisticsRecorder();
+
+            SolverStatisticsRecorder(const SolverStatisticsRecorder &) = delete;
+            SolverStatisticsRecorder & operator=(const SolverStatisticsRecorder &) = delete;
+
+            /**
+             * @brief This function returns whether this call is being recorded.
+             */
+            explicit operator bool() const { return stats_ != nullptr; }
+
+        private:
+            SolverStatistics * stats_;
+            bool countLPCalls_;
+            size_t lpSolves_;
+            std::chrono::steady_clock::time_point start_;
+    };
+}
+
+#endif
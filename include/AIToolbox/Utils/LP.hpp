@@ -15,10 +15,24 @@ namespace AIToolbox {
      * different libraries as needed, in order to avoid changing the rest of
      * the library.
      *
+     * Two backends are currently available: lp_solve, which is best suited
+     * for large problems, and DenseSimplex, an in-tree dense simplex which is
+     * much faster for small problems (a few tens of variables) where the
+     * setup costs of lp_solve dominate. By default the backend is picked
+     * automatically depending on the number of variables; this can be
+     * changed at build time through the AI_LP_BACKEND CMake option, and at
+     * runtime through setDefaultBackend().
+     *
      * Constraints are added through editing the `row` public Vector. This
      * vector has a number of elements equal to the number of variables
      * specified to the LP class during construction. Each element in the
      * Vector corresponds to the coefficient of the associated variable.
+     *
+     * Optionally, the LP can warm start each solve from the basis found by
+     * the previous one. The basis is kept in sync as rows and columns are
+     * pushed and popped, so that sequences of nearly identical problems
+     * (which differ by a single row, as in WitnessLP) do not need to restart
+     * the simplex from scratch every time.
      */
     class LP {
         private:
@@ -28,6 +42,53 @@ namespace AIToolbox {
 
         public:
             enum class Constraint { LessEqual, Equal, GreaterEqual };
+            enum class Backend { Automatic, LpSolve, DenseSimplex };
+
+            /**
+             * @brief The maximum number of variables for which Backend::Automatic selects the DenseSimplex.
+             */
+            static constexpr size_t DenseSimplexMaxVariables = 64;
+
+            /**
+             * @brief This struct contains statistics about the solves performed by an LP.
+             */
+            struct Statistics {
+                size_t solves = 0;              ///< Number of calls to solve().
+                size_t warmStarts = 0;          ///< Number of solves started from a previous basis.
+                size_t fallbacks = 0;           ///< Number of warm starts which failed and were redone from scratch.
+                unsigned long long pivots = 0;  ///< Total number of simplex iterations.
+                double seconds = 0.0;           ///< Total wall-clock time spent solving.
+
+                /**
+                 * @brief This function adds the input statistics to these ones.
+                 *
+                 * @param rhs The statistics to add.
+                 *
+                 * @return A reference to these statistics.
+                 */
+                Statistics & operator+=(const Statistics & rhs) {
+                    solves += rhs.solves; warmStarts += rhs.warmStarts; fallbacks += rhs.fallbacks;
+                    pivots += rhs.pivots; seconds += rhs.seconds;
+                    return *this;
+                }
+
+                /**
+                 * @brief This function subtracts the input statistics from these ones.
+                 *
+                 * This is useful to compute the statistics of the solves
+                 * done between two reads of getThreadStatistics().
+                 *
+                 * @param rhs The statistics to subtract.
+                 *
+                 * @return A reference to these statistics.
+                 */
+                Statistics & operator-=(const Statistics & rhs) {
+                    solves -= rhs.solves; warmStarts -= rhs.warmStarts; fallbacks -= rhs.fallbacks;
+                    pivots -= rhs.pivots; seconds -= rhs.seconds;
+                    return *this;
+                }
+            };
+
             /**
              * @brief Basic constructor.
              *
@@ -36,9 +97,19 @@ namespace AIToolbox {
              *
              * By default all variables are assumed positive (>=0).
              *
+             * If the backend is Backend::Automatic, the default backend is
+             * used (see setDefaultBackend()). If that is also
+             * Backend::Automatic, the DenseSimplex is used for problems with
+             * at most DenseSimplexMaxVariables variables, and lp_solve for
+             * the others.
+             *
+             * Users which know their LP is going to grow large (for example
+             * by adding many columns) should select a backend explicitly.
+             *
              * @param varNumber The number of variables.
+             * @param backend The backend to use to solve the LP.
              */
-            LP(size_t varNumber);
+            LP(size_t varNumber, Backend backend = Backend::Automatic);
 
             /**
              * @brief Basic destructor to avoid problems with std::unique_ptr
@@ -96,6 +167,21 @@ namespace AIToolbox {
              */
             void pushRow(Constraint c, double value);
 
+            /**
+             * @brief This function adds multiple constraints to the LP at once.
+             *
+             * This function is equivalent to calling pushRow() once per row of
+             * the input matrix, but reserves memory for all new rows at once,
+             * and updates the stored basis (if any) a single time.
+             *
+             * The `row` public field is not used nor modified.
+             *
+             * @param rows A matrix where each row contains the coefficients of a constraint.
+             * @param c The type of constraint that should be enforced for all rows.
+             * @param values The values on the other side of each constraint equation.
+             */
+            void pushRows(const Matrix2D & rows, Constraint c, const Vector & values);
+
             /**
              * @brief This function removes the last pushed constraint.
              */
@@ -121,6 +207,9 @@ namespace AIToolbox {
              * the return Vector will contain the values of the first N
              * variables of the solution, where N is the input.
              *
+             * If the problem is infeasible or its objective is unbounded,
+             * nothing is returned, whatever the backend.
+             *
              * This function may also return the final result of the objective.
              * The pointer may be written independently from whether the
              * solution was successful or not.
@@ -176,9 +265,95 @@ namespace AIToolbox {
              */
             static double getPrecision();
 
+            /**
+             * @brief This function sets whether solve() should warm start from the previous basis.
+             *
+             * When enabled, the basis found by each successful solve is stored
+             * and carried over through subsequent pushRow(), popRow() and
+             * addColumn() calls. The next solve then starts from it rather
+             * than from the default basis.
+             *
+             * If a warm-started solve fails, it is automatically redone from
+             * the default basis, so the results do not change.
+             *
+             * By default warm starting is disabled.
+             *
+             * @param warmStart Whether to warm start solves.
+             */
+            void setWarmStart(bool warmStart);
+
+            /**
+             * @brief This function returns whether solve() warm starts from the previous basis.
+             *
+             * @return Whether warm starting is enabled.
+             */
+            bool getWarmStart() const;
+
+            /**
+             * @brief This function returns the backend used by this LP.
+             *
+             * @return The backend used; never Backend::Automatic.
+             */
+            Backend getBackend() const;
+
+            /**
+             * @brief This function sets the backend used by LPs that do not explicitly select one.
+             *
+             * The initial value of the default backend is set at build time,
+             * and is Backend::Automatic unless otherwise specified. This
+             * function does not affect already constructed LPs, and can be
+             * called while other threads are constructing LPs.
+             *
+             * @param backend The new default backend.
+             */
+            static void setDefaultBackend(Backend backend);
+
+            /**
+             * @brief This function returns the backend used by LPs that do not explicitly select one.
+             *
+             * @return The current default backend.
+             */
+            static Backend getDefaultBackend();
+
+            /**
+             * @brief This function returns the statistics of all solves performed so far.
+             *
+             * @return The statistics of this LP.
+             */
+            const Statistics & getStatistics() const;
+
+            /**
+             * @brief This function resets the statistics of this LP.
+             */
+            void resetStatistics();
+
+            /**
+             * @brief This function returns the number of solves performed by all LPs in the calling thread.
+             *
+             * This allows counting the LP solves done by an algorithm
+             * without access to the LPs it creates, by comparing the value
+             * before and after running it.
+             *
+             * @return The number of calls to solve() made so far in this thread.
+             */
+            static size_t getThreadSolves();
+
+            /**
+             * @brief This function returns the statistics of the solves performed by all LPs in the calling thread.
+             *
+             * This allows algorithms which create their own LPs to report
+             * the statistics of all their solves, by comparing the value
+             * before and after running.
+             *
+             * @return The statistics of all solves made so far in this thread.
+             */
+            static const Statistics & getThreadStatistics();
+
         private:
             size_t varNumber_;
             bool maximize_;
+            bool warmStart_;
+            Statistics stats_;
     };
 }
 
@@ -0,0 +1,703 @@
+#ifndef AI_TOOLBOX_UTILS_LP_DENSE_SIMPLEX_HEADER_FILE
+#define AI_TOOLBOX_UTILS_LP_DENSE_SIMPLEX_HEADER_FILE
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Eigen/LU>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Utils/LP.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This class implements a dense bounded simplex for small linear programs.
+     *
+     * This class is meant for LPs with few variables and at most a few
+     * hundred constraints, like the ones solved by WitnessLP or
+     * LPInterpolation. For these problems the setup costs of a general
+     * purpose sparse solver dominate the actual solve time, while a dense
+     * tableau is both simple and fast.
+     *
+     * Each constraint `a * x {<=,=,>=} b` gets its own slack variable `s`,
+     * so that it can be written as `a * x + s = b` where `s` is bounded
+     * depending on the type of constraint. Thus, the all-slack basis is
+     * always available as a starting point.
+     *
+     * The solver keeps the basis of the last solve, and updates it as rows
+     * and columns are added or removed. When warm starting, if the kept
+     * basis is dual feasible (as is the case when a row is pushed after an
+     * optimal solve) the problem is solved with the dual simplex; otherwise
+     * with a primal simplex, minimizing the sum of infeasibilities first if
+     * needed.
+     *
+     * By default, all variables are assumed to be non-negative.
+     */
+    class DenseSimplex {
+        public:
+            enum class Result { Optimal, Infeasible, Unbounded, Failed };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * @param vars The number of variables (columns) of the LP.
+             */
+            DenseSimplex(size_t vars);
+
+            /**
+             * @brief This function sets a single variable as the objective.
+             *
+             * As in lp_solve, the coefficients of the other variables are
+             * left untouched.
+             *
+             * @param n The variable to use as objective.
+             * @param maximize Whether the objective should be maximized (or minimized).
+             */
+            void setObjective(size_t n, bool maximize);
+
+            /**
+             * @brief This function sets the objective coefficients.
+             *
+             * @param c The coefficients of the objective, one per variable.
+             * @param maximize Whether the objective should be maximized (or minimized).
+             */
+            void setObjective(const Eigen::Ref<const Vector> & c, bool maximize);
+
+            /**
+             * @brief This function adds a constraint on top of the constraint stack.
+             *
+             * @param a The coefficients of the constraint, one per variable.
+             * @param c The type of the constraint.
+             * @param value The right hand side of the constraint.
+             */
+            void pushRow(const Eigen::Ref<const Vector> & a, LP::Constraint c, double value);
+
+            /**
+             * @brief This function removes the last added constraint.
+             */
+            void popRow();
+
+            /**
+             * @brief This function adds a new variable which does not appear in any constraint.
+             */
+            void addColumn();
+
+            /**
+             * @brief This function makes the specified variable unbounded.
+             *
+             * @param n The variable to make unbounded.
+             */
+            void setUnbounded(size_t n);
+
+            /**
+             * @brief This function reserves memory for the specified number of constraints.
+             *
+             * @param rows The number of constraints to reserve memory for.
+             */
+            void reserve(size_t rows);
+
+            /**
+             * @brief This function sets whether solve() should start from the basis of the previous solve.
+             *
+             * @param warmStart Whether to warm start.
+             */
+            void setWarmStart(bool warmStart);
+
+            /**
+             * @brief This function returns whether the next solve() will be able to warm start.
+             */
+            bool canWarmStart() const;
+
+            /**
+             * @brief This function solves the LP.
+             *
+             * @return The outcome of the solve.
+             */
+            Result solve();
+
+            /**
+             * @brief This function returns the values of the variables found by the last solve.
+             *
+             * If the LP was unbounded, this is the last feasible vertex
+             * found before the unbounded direction.
+             */
+            const Vector & getSolution() const;
+
+            /**
+             * @brief This function returns the value of the objective found by the last solve.
+             *
+             * If the LP was unbounded, this is an infinity with the sign of
+             * the optimization direction.
+             */
+            double getObjective() const;
+
+            /**
+             * @brief This function returns the number of pivots performed by the last solve.
+             */
+            size_t getIterations() const;
+
+            /**
+             * @brief This function returns the number of variables of the LP.
+             */
+            size_t getVariables() const;
+
+            /**
+             * @brief This function returns the number of constraints of the LP.
+             */
+            size_t getRows() const;
+
+        private:
+            enum class Status : char { Basic, Lower, Upper, Zero };
+
+            static constexpr double inf_ = std::numeric_limits<double>::infinity();
+            static constexpr double primalTolerance_ = 1e-9;
+            static constexpr double dualTolerance_   = 1e-9;
+            static constexpr double pivotTolerance_  = 1e-9;
+            static constexpr double roundTolerance_  = 1e-11;
+            static constexpr size_t refactorInterval_ = 100;
+            static constexpr size_t blandThreshold_   = 50;
+
+            double lower(size_t j) const;
+            double upper(size_t j) const;
+            bool isFixed(size_t j) const;
+            Status defaultStatus(size_t j) const;
+
+            static double roundToPrecision(double v);
+
+            void slackBasis();
+            bool factorize();
+            void computeValues();
+            double residual() const;
+            void computeReducedCosts(const Vector & cost);
+            bool isPrimalFeasible() const;
+            bool isDualFeasible() const;
+            void pivot(size_t r, size_t q);
+            void addLastRowToTableau();
+            void removeLastRowFromTableau(size_t p);
+
+            enum class Step { Done, Progress, Unbounded };
+            Step primalStep(bool phase1, bool bland, bool * degenerate);
+            Step dualStep(bool bland, bool * degenerate);
+
+            size_t n_, m_;
+            Matrix2D A_;
+            Vector b_, c_;
+            std::vector<LP::Constraint> types_;
+            std::vector<char> free_;
+            bool maximize_;
+
+            // Basis: basic_[k] is the variable basic in the k-th tableau row.
+            // Variables [0, n_) are the columns, [n_, n_ + m_) the slacks.
+            std::vector<size_t> basic_;
+            std::vector<Status> status_;
+            bool warmStart_, basisValid_, tableauValid_;
+
+            // Working data; the tableau is B^-1 * [A I], so its last m_
+            // columns contain B^-1. It is kept updated across pushes and
+            // pops, and refactorized every refactorInterval_ pivots.
+            Matrix2D T_;
+            Vector x_, d_;
+            size_t sinceRefactor_;
+
+            Vector solution_;
+            double objective_;
+            size_t iterations_;
+    };
+
+    inline DenseSimplex::DenseSimplex(const size_t vars) :
+            n_(vars), m_(0), A_(0, vars), b_(0), c_(Vector::Zero(vars)),
+            free_(vars, false), maximize_(false), status_(vars, Status::Lower),
+            warmStart_(false), basisValid_(false), tableauValid_(false), sinceRefactor_(0),
+            solution_(Vector::Zero(vars)), objective_(0.0), iterations_(0) {}
+
+    inline void DenseSimplex::setObjective(const size_t n, const bool maximize) {
+        c_[n] = 1.0;
+        maximize_ = maximize;
+    }
+
+    inline void DenseSimplex::setObjective(const Eigen::Ref<const Vector> & c, const bool maximize) {
+        c_ = c;
+        maximize_ = maximize;
+    }
+
+    inline void DenseSimplex::pushRow(const Eigen::Ref<const Vector> & a, const LP::Constraint c, const double value) {
+        if (m_ == static_cast<size_t>(A_.rows()))
+            reserve(std::max<size_t>(8, 2 * m_));
+
+        A_.row(m_) = a.transpose();
+        b_[m_] = value;
+        types_.push_back(c);
+
+        // The new slack enters the basis, which keeps it non-singular.
+        status_.push_back(Status::Basic);
+        if (basisValid_) {
+            basic_.push_back(n_ + m_);
+            if (tableauValid_) addLastRowToTableau();
+        } else {
+            tableauValid_ = false;
+        }
+
+        ++m_;
+    }
+
+    inline void DenseSimplex::popRow() {
+        const auto slack = n_ + m_ - 1;
+
+        if (basisValid_) {
+            size_t p = 0;
+            if (status_[slack] == Status::Basic) {
+                while (basic_[p] != slack) ++p;
+            } else if (tableauValid_) {
+                // We bring the slack into the basis, so that it can leave it
+                // together with its row. The pivot row with the largest
+                // coefficient is the most stable.
+                for (size_t k = 1; k < m_; ++k)
+                    if (std::fabs(T_(k, slack)) > std::fabs(T_(p, slack)))
+                        p = k;
+
+                if (std::fabs(T_(p, slack)) > pivotTolerance_) {
+                    status_[basic_[p]] = defaultStatus(basic_[p]);
+                    pivot(p, slack);
+                    ++sinceRefactor_;
+                } else {
+                    basisValid_ = tableauValid_ = false;
+                }
+            } else {
+                basisValid_ = false;
+            }
+
+            if (basisValid_) {
+                if (tableauValid_) removeLastRowFromTableau(p);
+                basic_.erase(std::begin(basic_) + p);
+            }
+        }
+
+        status_.pop_back();
+        types_.pop_back();
+        --m_;
+    }
+
+    inline void DenseSimplex::addColumn() {
+        if (A_.rows() > 0) {
+            A_.conservativeResize(Eigen::NoChange, n_ + 1);
+            A_.col(n_).setZero();
+        } else {
+            A_.resize(0, n_ + 1);
+        }
+        c_.conservativeResize(n_ + 1);
+        c_[n_] = 0.0;
+        free_.push_back(false);
+        solution_.conservativeResize(n_ + 1);
+        solution_[n_] = 0.0;
+
+        // Slacks come after the columns, so they are shifted by one.
+        for (auto & j : basic_)
+            if (j >= n_) ++j;
+        status_.insert(std::begin(status_) + n_, Status::Lower);
+
+        ++n_;
+        tableauValid_ = false;
+    }
+
+    inline void DenseSimplex::setUnbounded(const size_t n) {
+        free_[n] = true;
+        if (status_[n] != Status::Basic)
+            status_[n] = Status::Zero;
+    }
+
+    inline void DenseSimplex::reserve(const size_t rows) {
+        if (rows <= static_cast<size_t>(A_.rows())) return;
+        A_.conservativeResize(rows, n_);
+        b_.conservativeResize(rows);
+    }
+
+    inline void DenseSimplex::setWarmStart(const bool warmStart) {
+        warmStart_ = warmStart;
+    }
+
+    inline bool DenseSimplex::canWarmStart() const { return warmStart_ && basisValid_; }
+    inline const Vector & DenseSimplex::getSolution() const { return solution_; }
+    inline double DenseSimplex::getObjective() const { return objective_; }
+    inline size_t DenseSimplex::getIterations() const { return iterations_; }
+    inline size_t DenseSimplex::getVariables() const { return n_; }
+    inline size_t DenseSimplex::getRows() const { return m_; }
+
+    inline double DenseSimplex::lower(const size_t j) const {
+        if (j < n_) return free_[j] ? -inf_ : 0.0;
+        return types_[j - n_] == LP::Constraint::GreaterEqual ? -inf_ : 0.0;
+    }
+
+    inline double DenseSimplex::upper(const size_t j) const {
+        if (j < n_) return inf_;
+        return types_[j - n_] == LP::Constraint::LessEqual ? inf_ : 0.0;
+    }
+
+    inline bool DenseSimplex::isFixed(const size_t j) const {
+        return j >= n_ && types_[j - n_] == LP::Constraint::Equal;
+    }
+
+    inline DenseSimplex::Status DenseSimplex::defaultStatus(const size_t j) const {
+        if (std::isfinite(lower(j))) return Status::Lower;
+        if (std::isfinite(upper(j))) return Status::Upper;
+        return Status::Zero;
+    }
+
+    inline double DenseSimplex::roundToPrecision(const double v) {
+        if (std::fabs(v) < roundTolerance_) return 0.0;
+        // We round the mantissa, so that the precision is relative.
+        int exp;
+        const double mantissa = std::frexp(v, &exp);
+        return std::ldexp(std::round(mantissa / roundTolerance_) * roundTolerance_, exp);
+    }
+
+    inline void DenseSimplex::slackBasis() {
+        basic_.resize(m_);
+        for (size_t j = 0; j < n_; ++j)
+            status_[j] = defaultStatus(j);
+        for (size_t i = 0; i < m_; ++i) {
+            basic_[i] = n_ + i;
+            status_[n_ + i] = Status::Basic;
+        }
+        basisValid_ = true;
+    }
+
+    inline bool DenseSimplex::factorize() {
+        const size_t N = n_ + m_;
+
+        sinceRefactor_ = 0;
+        if (m_ == 0) {
+            T_.resize(0, N);
+            tableauValid_ = true;
+            computeValues();
+            return true;
+        }
+
+        Matrix2D full(m_, N);
+        full.leftCols(n_) = A_.topRows(m_);
+        full.rightCols(m_).setIdentity();
+
+        Matrix2D B(m_, m_);
+        for (size_t k = 0; k < m_; ++k)
+            B.col(k) = full.col(basic_[k]);
+
+        const Eigen::PartialPivLU<Matrix2D> lu(B);
+        if (!(lu.rcond() > 1e-12)) {
+            tableauValid_ = false;
+            return false;
+        }
+
+        T_ = lu.solve(full);
+        tableauValid_ = true;
+        computeValues();
+        return true;
+    }
+
+    inline void DenseSimplex::computeValues() {
+        const size_t N = n_ + m_;
+
+        // Nonbasic variables sit on one of their bounds (or zero if free).
+        x_.resize(N);
+        for (size_t j = 0; j < N; ++j) {
+            switch (status_[j]) {
+                case Status::Lower: x_[j] = lower(j); break;
+                case Status::Upper: x_[j] = upper(j); break;
+                default:            x_[j] = 0.0;
+            }
+        }
+
+        // Basic variables are then B^-1 * (b - N * x_N).
+        const Vector rhs = b_.head(m_) - A_.topRows(m_) * x_.head(n_) - x_.tail(m_);
+        const Vector xB = T_.rightCols(m_) * rhs;
+        for (size_t k = 0; k < m_; ++k)
+            x_[basic_[k]] = xB[k];
+    }
+
+    inline void DenseSimplex::computeReducedCosts(const Vector & cost) {
+        Vector cB(m_);
+        for (size_t k = 0; k < m_; ++k)
+            cB[k] = cost[basic_[k]];
+        d_ = cost - T_.transpose() * cB;
+    }
+
+    inline bool DenseSimplex::isPrimalFeasible() const {
+        for (const auto j : basic_)
+            if (x_[j] < lower(j) - primalTolerance_ || x_[j] > upper(j) + primalTolerance_)
+                return false;
+        return true;
+    }
+
+    inline bool DenseSimplex::isDualFeasible() const {
+        for (size_t j = 0; j < n_ + m_; ++j) {
+            if (isFixed(j)) continue;
+            switch (status_[j]) {
+                case Status::Lower: if (d_[j] < -dualTolerance_) return false; break;
+                case Status::Upper: if (d_[j] >  dualTolerance_) return false; break;
+                case Status::Zero:  if (std::fabs(d_[j]) > dualTolerance_) return false; break;
+                default:;
+            }
+        }
+        return true;
+    }
+
+    inline void DenseSimplex::pivot(const size_t r, const size_t q) {
+        T_.row(r) /= T_(r, q);
+        for (size_t k = 0; k < m_; ++k) {
+            if (k == r) continue;
+            const double f = T_(k, q);
+            if (f != 0.0) T_.row(k) -= f * T_.row(r);
+        }
+        status_[q] = Status::Basic;
+        basic_[r] = q;
+    }
+
+    inline double DenseSimplex::residual() const {
+        if (m_ == 0) return 0.0;
+        return (A_.topRows(m_) * x_.head(n_) + x_.tail(m_) - b_.head(m_)).lpNorm<Eigen::Infinity>();
+    }
+
+    inline void DenseSimplex::addLastRowToTableau() {
+        // The new row has its slack basic, so the basis matrix becomes
+        // [B 0; a_B 1], and the new tableau row is [a 0 1] - a_B * T.
+        const size_t N = n_ + m_;
+        T_.conservativeResize(m_ + 1, N + 1);
+        T_.col(N).setZero();
+
+        auto newRow = T_.row(m_);
+        newRow.head(n_) = A_.row(m_);
+        newRow.tail(m_ + 1).setZero();
+        newRow[N] = 1.0;
+        for (size_t k = 0; k < m_; ++k) {
+            if (basic_[k] >= n_) continue;
+            const double coeff = A_(m_, basic_[k]);
+            if (coeff != 0.0)
+                newRow.head(N) -= coeff * T_.row(k).head(N);
+        }
+    }
+
+    inline void DenseSimplex::removeLastRowFromTableau(const size_t p) {
+        // The slack of the last row is basic in row p, so its column in the
+        // tableau is a unit vector, and removing both leaves the tableau of
+        // the reduced problem.
+        const auto after = m_ - 1 - p;
+        if (after > 0)
+            T_.middleRows(p, after) = T_.bottomRows(after).eval();
+        T_.conservativeResize(m_ - 1, n_ + m_ - 1);
+    }
+
+    inline DenseSimplex::Step DenseSimplex::primalStep(const bool phase1, const bool bland, bool * degenerate) {
+        const size_t N = n_ + m_;
+
+        // Pricing: Dantzig's rule, or Bland's when stalling.
+        size_t q = N;
+        int dir = 0;
+        double best = 0.0;
+        for (size_t j = 0; j < N; ++j) {
+            if (status_[j] == Status::Basic || isFixed(j)) continue;
+            int jdir = 0;
+            if (status_[j] == Status::Lower && d_[j] < -dualTolerance_) jdir = 1;
+            else if (status_[j] == Status::Upper && d_[j] > dualTolerance_) jdir = -1;
+            else if (status_[j] == Status::Zero && std::fabs(d_[j]) > dualTolerance_) jdir = d_[j] < 0.0 ? 1 : -1;
+            if (!jdir) continue;
+
+            if (std::fabs(d_[j]) > best) {
+                q = j, dir = jdir, best = std::fabs(d_[j]);
+                if (bland) break;
+            }
+        }
+        if (q == N) return Step::Done;
+
+        // Ratio test; r == m_ means the entering variable reaches its other bound.
+        size_t r = m_;
+        double t = upper(q) - lower(q), bestRate = 0.0;
+        bool toUpper = false;
+        for (size_t k = 0; k < m_; ++k) {
+            const double rate = -dir * T_(k, q);
+            if (std::fabs(rate) <= pivotTolerance_) continue;
+
+            const auto j = basic_[k];
+            const double l = lower(j), u = upper(j);
+            double tk;
+            bool kUpper;
+            if (rate > 0.0) {
+                if (phase1 && x_[j] < l - primalTolerance_) tk = (l - x_[j]) / rate, kUpper = false;
+                else if (phase1 && x_[j] > u + primalTolerance_) continue;
+                else if (std::isfinite(u)) tk = (u - x_[j]) / rate, kUpper = true;
+                else continue;
+            } else {
+                if (phase1 && x_[j] > u + primalTolerance_) tk = (u - x_[j]) / rate, kUpper = true;
+                else if (phase1 && x_[j] < l - primalTolerance_) continue;
+                else if (std::isfinite(l)) tk = (l - x_[j]) / rate, kUpper = false;
+                else continue;
+            }
+            tk = std::max(tk, 0.0);
+
+            const bool better = bland ? (tk < t - 1e-12 || (tk <= t + 1e-12 && (r == m_ || j < basic_[r])))
+                                      : (tk < t - 1e-12 || (tk <= t + 1e-12 && std::fabs(rate) > bestRate));
+            if (better)
+                r = k, t = tk, toUpper = kUpper, bestRate = std::fabs(rate);
+        }
+        if (!std::isfinite(t)) return Step::Unbounded;
+
+        *degenerate = t <= primalTolerance_;
+
+        const double step = dir * t;
+        x_[q] += step;
+        for (size_t k = 0; k < m_; ++k)
+            x_[basic_[k]] -= T_(k, q) * step;
+
+        if (r == m_) {
+            status_[q] = dir > 0 ? Status::Upper : Status::Lower;
+            x_[q] = dir > 0 ? upper(q) : lower(q);
+        } else {
+            const auto j = basic_[r];
+            status_[j] = toUpper ? Status::Upper : Status::Lower;
+            x_[j] = toUpper ? upper(j) : lower(j);
+            pivot(r, q);
+        }
+        return Step::Progress;
+    }
+
+    inline DenseSimplex::Step DenseSimplex::dualStep(const bool bland, bool * degenerate) {
+        const size_t N = n_ + m_;
+
+        // Leaving variable: the most infeasible basic one.
+        size_t r = m_;
+        double worst = primalTolerance_;
+        bool below = false;
+        for (size_t k = 0; k < m_; ++k) {
+            const auto j = basic_[k];
+            const double under = lower(j) - x_[j], over = x_[j] - upper(j);
+            if (under > worst) r = k, worst = under, below = true;
+            if (over  > worst) r = k, worst = over,  below = false;
+        }
+        if (r == m_) return Step::Done;
+
+        // Entering variable: the one that keeps the reduced costs feasible.
+        size_t q = N;
+        double ratio = inf_, bestAlpha = 0.0;
+        for (size_t j = 0; j < N; ++j) {
+            if (status_[j] == Status::Basic || isFixed(j)) continue;
+            const double alpha = T_(r, j);
+            if (std::fabs(alpha) <= pivotTolerance_) continue;
+
+            // The leaving variable changes by -alpha * dx_j.
+            const bool increase = below ? alpha < 0.0 : alpha > 0.0;
+            if (status_[j] == Status::Lower && !increase) continue;
+            if (status_[j] == Status::Upper &&  increase) continue;
+
+            const double rj = std::fabs(d_[j]) / std::fabs(alpha);
+            const bool better = bland ? rj < ratio - 1e-12
+                                      : (rj < ratio - 1e-12 || (rj <= ratio + 1e-12 && std::fabs(alpha) > bestAlpha));
+            if (better)
+                q = j, ratio = rj, bestAlpha = std::fabs(alpha);
+        }
+        // The dual is unbounded, so the primal is infeasible.
+        if (q == N) return Step::Unbounded;
+
+        *degenerate = ratio <= dualTolerance_;
+
+        const auto leaving = basic_[r];
+        const double target = below ? lower(leaving) : upper(leaving);
+        const double step = (x_[leaving] - target) / T_(r, q);
+        x_[q] += step;
+        for (size_t k = 0; k < m_; ++k)
+            x_[basic_[k]] -= T_(k, q) * step;
+
+        status_[leaving] = below ? Status::Lower : Status::Upper;
+        x_[leaving] = target;
+        pivot(r, q);
+
+        return Step::Progress;
+    }
+
+    inline DenseSimplex::Result DenseSimplex::solve() {
+        const size_t N = n_ + m_;
+        iterations_ = 0;
+
+        // Nonbasic statuses may be stale if bounds changed.
+        for (size_t j = 0; j < N; ++j) {
+            if (status_[j] == Status::Basic) continue;
+            if ((status_[j] == Status::Lower && !std::isfinite(lower(j))) ||
+                (status_[j] == Status::Upper && !std::isfinite(upper(j))) ||
+                (status_[j] == Status::Zero  && (std::isfinite(lower(j)) || std::isfinite(upper(j)))))
+                status_[j] = defaultStatus(j);
+        }
+
+        // If we can, we reuse the tableau we have kept updated; otherwise we
+        // rebuild it from the kept basis, or from the all-slack basis.
+        if (warmStart_ && basisValid_ && tableauValid_ && sinceRefactor_ < refactorInterval_) {
+            computeValues();
+        } else if (!(warmStart_ && basisValid_ && factorize())) {
+            slackBasis();
+            factorize();
+        }
+
+        Vector cost = Vector::Zero(N);
+        cost.head(n_) = maximize_ ? -c_ : c_;
+        Vector phase1Cost(N);
+
+        const size_t maxIterations = 50 * (N + 10);
+        size_t stalling = 0;
+        bool usePrimal = false;
+        Result result = Result::Failed;
+
+        while (iterations_ < maxIterations) {
+            if (sinceRefactor_ >= refactorInterval_ && !factorize()) break;
+            const bool bland = stalling > blandThreshold_;
+            bool degenerate = false;
+            Step step;
+
+            computeReducedCosts(cost);
+            if (isPrimalFeasible()) {
+                usePrimal = false;
+                step = primalStep(false, bland, &degenerate);
+                if (step == Step::Done) result = Result::Optimal;
+                if (step == Step::Unbounded) result = Result::Unbounded;
+            } else if (!usePrimal && isDualFeasible()) {
+                step = dualStep(bland, &degenerate);
+                // If the dual is unbounded, the primal is infeasible.
+                if (step == Step::Unbounded) result = Result::Infeasible;
+            } else {
+                // Phase 1: minimize the sum of infeasibilities.
+                usePrimal = true;
+                phase1Cost.setZero();
+                for (const auto j : basic_) {
+                    if (x_[j] < lower(j) - primalTolerance_) phase1Cost[j] = -1.0;
+                    else if (x_[j] > upper(j) + primalTolerance_) phase1Cost[j] = 1.0;
+                }
+                computeReducedCosts(phase1Cost);
+                step = primalStep(true, bland, &degenerate);
+                if (step == Step::Done) result = Result::Infeasible;
+            }
+
+            if (step != Step::Progress) {
+                // Before trusting the result we check that numerical errors
+                // have not accumulated; otherwise we refactorize and resume.
+                if (sinceRefactor_ == 0 || residual() <= primalTolerance_) break;
+                result = Result::Failed;
+                if (!factorize()) break;
+                continue;
+            }
+            ++iterations_;
+            ++sinceRefactor_;
+            stalling = degenerate ? stalling + 1 : 0;
+        }
+
+        if (result == Result::Failed)
+            basisValid_ = tableauValid_ = false;
+
+        if (result == Result::Optimal || result == Result::Unbounded) {
+            // As lp_solve does, we round the solution to remove numerical
+            // noise, so that equivalent variables get equal values.
+            for (size_t j = 0; j < n_; ++j)
+                solution_[j] = roundToPrecision(x_[j]);
+            objective_ = c_.dot(solution_);
+            if (result == Result::Unbounded)
+                objective_ = maximize_ ? inf_ : -inf_;
+        }
+        return result;
+    }
+}
+
+#endif
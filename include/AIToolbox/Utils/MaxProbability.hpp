@@ -0,0 +1,214 @@
+#ifndef AI_TOOLBOX_UTILS_MAX_PROBABILITY_HEADER_FILE
+#define AI_TOOLBOX_UTILS_MAX_PROBABILITY_HEADER_FILE
+
+#include <vector>
+#include <thread>
+#include <barrier>
+#include <exception>
+#include <cmath>
+#include <algorithm>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Seeder.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This class represents a one-dimensional distribution over the value of an arm.
+     *
+     * This class is used to describe the independent posteriors over the
+     * means of a set of arms, so that we can compute the probability of each
+     * arm being the best one (i.e. the probability of it being picked by
+     * Thompson sampling).
+     *
+     * Use the static factory functions to construct instances.
+     */
+    struct ValueDistribution {
+        enum class Kind { Point, Gaussian, StudentT, Beta };
+
+        /**
+         * @brief This function creates a distribution which always returns the same value.
+         *
+         * @param value The value of the distribution.
+         */
+        static ValueDistribution point(double value);
+
+        /**
+         * @brief This function creates a Gaussian distribution.
+         *
+         * If the standard deviation is zero, a point distribution is returned.
+         *
+         * @param mean The mean of the distribution.
+         * @param stddev The standard deviation of the distribution.
+         */
+        static ValueDistribution gaussian(double mean, double stddev);
+
+        /**
+         * @brief This function creates a location-scale Student-t distribution.
+         *
+         * If the scale is zero, a point distribution is returned.
+         *
+         * @param dof The degrees of freedom of the distribution.
+         * @param location The location (median) of the distribution.
+         * @param scale The scale of the distribution.
+         */
+        static ValueDistribution studentT(double dof, double location, double scale);
+
+        /**
+         * @brief This function creates a Beta distribution.
+         *
+         * Both parameters must be at least 0.5.
+         *
+         * @param alpha The alpha parameter of the distribution.
+         * @param beta The beta parameter of the distribution.
+         */
+        static ValueDistribution beta(double alpha, double beta);
+
+        /**
+         * @brief This function returns the cumulative distribution function at the input point.
+         *
+         * @param x The point to evaluate.
+         *
+         * @return The probability of sampling a value lower or equal to x.
+         */
+        double cdf(double x) const;
+
+        Kind kind;
+        // Point: value; Gaussian: mean, stddev; StudentT: dof, location,
+        // scale; Beta: alpha, beta.
+        double p0, p1, p2;
+    };
+
+    /**
+     * @brief This function computes the probability of each distribution producing the highest sample.
+     *
+     * For each continuous distribution a, this function integrates
+     *
+     *     f_a(x) * prod_{b != a} F_b(x)
+     *
+     * with adaptive Gauss-Kronrod quadrature. The integration is done in a
+     * transformed space where each distribution has bounded support and
+     * density, and is split at the locations of all other distributions
+     * so that narrow steps in the integrand are not missed.
+     *
+     * Ties between point distributions are broken in favor of the lowest
+     * index, as done by Thompson sampling when it keeps the first best arm.
+     *
+     * @param dists The independent distributions to compare.
+     * @param tolerance The target absolute error of each probability.
+     *
+     * @return A vector containing the probability of each distribution being the max.
+     */
+    Vector computeMaxProbabilities(const std::vector<ValueDistribution> & dists, double tolerance = 1e-8);
+
+    /**
+     * @brief This function computes the probability of a single distribution producing the highest sample.
+     *
+     * This function is equivalent to computeMaxProbabilities(dists)[a],
+     * but only integrates for the requested distribution.
+     *
+     * @param dists The independent distributions to compare.
+     * @param a The distribution whose probability to compute.
+     * @param tolerance The target absolute error of the probability.
+     *
+     * @return The probability of distribution a being the max.
+     */
+    double computeMaxProbability(const std::vector<ValueDistribution> & dists, size_t a, double tolerance = 1e-8);
+
+    /**
+     * @brief This function estimates the frequencies of the outputs of a sampler via Monte Carlo.
+     *
+     * This function is a fallback for when the probabilities of a sampler
+     * cannot be computed in closed form. Samples are drawn in batches, each
+     * thread using its own RandomEngine, until the standard error of every
+     * estimated frequency is below the requested bound, or the maximum
+     * number of samples is reached.
+     *
+     * The sampler must be callable concurrently from multiple threads as
+     * `size_t sampler(RandomEngine &)`, and return values in [0, N). The
+     * threads are spawned once per call. If the sampler throws, all
+     * threads stop after their current batch, and the exception is
+     * rethrown.
+     *
+     * @param N The number of possible outputs of the sampler.
+     * @param sampler The sampler to estimate.
+     * @param errorBound The maximum standard error allowed on each frequency.
+     * @param threads The number of threads to use; 0 uses all available cores.
+     * @param maxSamples The maximum number of samples to draw.
+     *
+     * @return A vector containing the estimated frequency of each output.
+     */
+    template <typename Sampler>
+    Vector estimateFrequencies(const size_t N, Sampler && sampler, const double errorBound, unsigned threads = 1, const unsigned long maxSamples = 10000000) {
+        constexpr unsigned long batch = 256;
+
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::vector<RandomEngine> engines;
+        std::vector<std::vector<unsigned long>> counts(threads, std::vector<unsigned long>(N, 0));
+        for (unsigned t = 0; t < threads; ++t)
+            engines.emplace_back(Seeder::getSeed());
+
+        auto runBatch = [&](const unsigned t) {
+            for (unsigned long i = 0; i < batch; ++i)
+                ++counts[t][sampler(engines[t])];
+        };
+
+        Vector retval(N);
+        unsigned long samples = 0;
+        bool stop = false;
+        std::vector<std::exception_ptr> errors(threads);
+
+        // This is called once all threads have completed a batch.
+        auto check = [&]() noexcept {
+            samples += batch * threads;
+
+            // The 1/n term avoids stopping early on outputs we have not
+            // seen yet, whose empirical variance would be zero.
+            double maxError = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                unsigned long c = 0;
+                for (unsigned t = 0; t < threads; ++t)
+                    c += counts[t][i];
+                retval[i] = static_cast<double>(c) / samples;
+                maxError = std::max(maxError, std::sqrt((retval[i] * (1.0 - retval[i]) + 1.0 / samples) / samples));
+            }
+            stop = maxError <= errorBound || samples >= maxSamples ||
+                   std::any_of(std::begin(errors), std::end(errors), [](const auto & e) { return bool(e); });
+        };
+
+        if (threads == 1) {
+            do {
+                runBatch(0);
+                check();
+            } while (!stop);
+            return retval;
+        }
+
+        // The workers are spawned once, and synchronize after each batch.
+        std::barrier sync(threads, check);
+        auto work = [&](const unsigned t) {
+            do {
+                try {
+                    runBatch(t);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+                sync.arrive_and_wait();
+            } while (!stop);
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back(work, t);
+        work(0);
+        for (auto & w : workers) w.join();
+
+        for (const auto & e : errors)
+            if (e) std::rethrow_exception(e);
+
+        return retval;
+    }
+}
+
+#endif
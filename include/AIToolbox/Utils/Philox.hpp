@@ -0,0 +1,189 @@
+#ifndef AI_TOOLBOX_UTILS_PHILOX_HEADER_FILE
+#define AI_TOOLBOX_UTILS_PHILOX_HEADER_FILE
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace AIToolbox {
+    /**
+     * @brief This class implements the Philox4x32-10 counter-based random engine.
+     *
+     * A counter-based engine computes each output block as a bijection of
+     * its counter, keyed by the seed. This means that any number of
+     * independent streams can be obtained from the same seed simply by
+     * reserving part of the counter for a stream id, without any shared
+     * state between them, and that the engine state is tiny compared to
+     * std::mt19937.
+     *
+     * Here the counter is split in two 64 bit halves: the high one holds
+     * the stream id, and the low one the position within the stream.
+     * Streams can be further split hierarchically with split(), so that
+     * for example each experiment, each episode in it and each object in
+     * the episode can have its own stream without coordinating ids.
+     *
+     * This class satisfies the UniformRandomBitGenerator requirements, so
+     * it can be used with all standard distributions.
+     *
+     * See "Parallel Random Numbers: As Easy as 1, 2, 3", Salmon et al.
+     */
+    class Philox {
+        public:
+            using result_type = std::uint32_t;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * @param key The seed of the engine.
+             * @param stream The id of the stream to generate.
+             */
+            explicit Philox(std::uint64_t key = 0, std::uint64_t stream = 0);
+
+            /**
+             * @brief This function resets the engine to the start of the input stream.
+             *
+             * @param key The seed of the engine.
+             * @param stream The id of the stream to generate.
+             */
+            void seed(std::uint64_t key, std::uint64_t stream = 0);
+
+            /**
+             * @brief This function returns the next number in the stream.
+             */
+            result_type operator()();
+
+            /**
+             * @brief This function advances the stream by the input number of outputs.
+             *
+             * This is done in constant time.
+             *
+             * @param z The number of outputs to skip.
+             */
+            void discard(unsigned long long z);
+
+            /**
+             * @brief This function returns an engine on a child stream of this one.
+             *
+             * The id of the child stream is obtained by hashing the id of
+             * this stream together with the input child id, so the result
+             * depends only on the key, this stream and the child id, and
+             * not on the current position of this engine. Different
+             * children (and children of children) thus get distinct
+             * streams, up to collisions of their 64 bit ids, which are
+             * negligible in practice.
+             *
+             * @param child The id of the child stream.
+             *
+             * @return A Philox engine at the start of the child stream.
+             */
+            Philox split(std::uint64_t child) const;
+
+            /**
+             * @brief This function returns the seed of the engine.
+             */
+            std::uint64_t getKey() const;
+
+            /**
+             * @brief This function returns the stream id of the engine.
+             */
+            std::uint64_t getStream() const;
+
+            /**
+             * @brief This function computes a single Philox4x32-10 block.
+             *
+             * @param counter The counter to encrypt.
+             * @param key The key to use.
+             *
+             * @return The random block for the input counter.
+             */
+            static std::array<std::uint32_t, 4> block(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+            bool operator==(const Philox &) const = default;
+
+        private:
+            std::array<std::uint32_t, 4> counter_;
+            std::array<std::uint32_t, 2> key_;
+            std::array<std::uint32_t, 4> buffer_;
+            unsigned index_;
+    };
+
+    inline Philox::Philox(const std::uint64_t key, const std::uint64_t stream) {
+        seed(key, stream);
+    }
+
+    inline void Philox::seed(const std::uint64_t key, const std::uint64_t stream) {
+        counter_ = {0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)};
+        key_ = {static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)};
+        buffer_ = {};
+        // The buffer is computed lazily, so that seeding is cheap.
+        index_ = 4;
+    }
+
+    inline Philox::result_type Philox::operator()() {
+        if (index_ == 4) {
+            buffer_ = block(counter_, key_);
+            if (++counter_[0] == 0) ++counter_[1];
+            index_ = 0;
+        }
+        return buffer_[index_++];
+    }
+
+    inline void Philox::discard(unsigned long long z) {
+        // Consume what remains of the current buffer first.
+        while (z && index_ < 4) { ++index_; --z; }
+        if (!z) return;
+
+        std::uint64_t position = (static_cast<std::uint64_t>(counter_[1]) << 32) | counter_[0];
+        position += (z - 1) / 4;
+        counter_[0] = static_cast<std::uint32_t>(position);
+        counter_[1] = static_cast<std::uint32_t>(position >> 32);
+
+        index_ = 4;
+        // Generate the block containing the next output, and skip into it.
+        (*this)();
+        index_ = 1 + (z - 1) % 4;
+    }
+
+    inline Philox Philox::split(const std::uint64_t child) const {
+        // We hash with a different key than the one used for generation, so
+        // that child ids do not correlate with the outputs of the streams.
+        constexpr std::uint32_t K0 = 0x243F6A88, K1 = 0x85A308D3;
+
+        const auto h = block(
+            {static_cast<std::uint32_t>(child), static_cast<std::uint32_t>(child >> 32), counter_[2], counter_[3]},
+            {key_[0] ^ K0, key_[1] ^ K1}
+        );
+        return Philox(getKey(), (static_cast<std::uint64_t>(h[1]) << 32) | h[0]);
+    }
+
+    inline std::uint64_t Philox::getKey() const {
+        return (static_cast<std::uint64_t>(key_[1]) << 32) | key_[0];
+    }
+
+    inline std::uint64_t Philox::getStream() const {
+        return (static_cast<std::uint64_t>(counter_[3]) << 32) | counter_[2];
+    }
+
+    inline std::array<std::uint32_t, 4> Philox::block(std::array<std::uint32_t, 4> c, std::array<std::uint32_t, 2> k) {
+        constexpr std::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+        for (unsigned round = 0; round < 10; ++round) {
+            const std::uint64_t p0 = M0 * c[0];
+            const std::uint64_t p1 = M1 * c[2];
+            c = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+                static_cast<std::uint32_t>(p0),
+            };
+            k[0] += W0; k[1] += W1;
+        }
+        return c;
+    }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <optional>
+#include <unordered_map>
 
 #include <Eigen/Dense>
 
@@ -533,6 +534,209 @@ namespace AIToolbox {
      */
     std::tuple<double, Vector> sawtoothInterpolation(const Point & p, const CompactHyperplanes & ubQ, const PointSurface & ubV);
 
+    /**
+     * @brief This class indexes a PointSurface to speed up repeated interpolation queries.
+     *
+     * Both sawtoothInterpolation() and LPInterpolation() need to scan every
+     * Point in the surface for each query, checking its zero entries against
+     * the input and computing its distance from the surface spanned by the
+     * simplex corners. Algorithms like SARSOP and GapMin perform these
+     * queries for every successor of every belief they examine, while the
+     * surface itself changes only a little between queries.
+     *
+     * This class stores the surface together with a series of per-Point
+     * precomputed data:
+     *
+     * - The reciprocals of the non-zero coordinates of each Point, so that
+     *   the sawtooth ratios become simple products.
+     * - The height of each Point relative to the corner surface (which is
+     *   independent from the query, but depends on the corners).
+     * - The coordinate where each Point has its highest value.
+     *
+     * Points are additionally grouped into buckets by their support (the set
+     * of their non-zero coordinates). Since a Point can only help to
+     * interpolate an input if its support is contained in the input's, whole
+     * buckets can be discarded with a single check. Within each bucket,
+     * Points are kept sorted by their height, so that sawtoothInterpolation()
+     * can stop as soon as no remaining Point can possibly improve the bound.
+     *
+     * The corner values used to compute the heights are cached; whenever the
+     * CompactHyperplanes used in the queries change, setCorners() must be
+     * called again.
+     *
+     * Point ids are the same as the indeces in the equivalent PointSurface,
+     * so that the coefficient vectors returned by the interpolation functions
+     * have the same meaning for both.
+     */
+    class IndexedPointSurface {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * @param ubQ The CompactHyperplanes that will be used as a baseline surface in the queries.
+             */
+            IndexedPointSurface(const CompactHyperplanes & ubQ);
+
+            /**
+             * @brief This constructor indexes an already existing PointSurface.
+             *
+             * @param ubQ The CompactHyperplanes that will be used as a baseline surface in the queries.
+             * @param ubV The PointSurface to index.
+             */
+            IndexedPointSurface(const CompactHyperplanes & ubQ, const PointSurface & ubV);
+
+            /**
+             * @brief This function updates the cached corner values.
+             *
+             * This function must be called every time the CompactHyperplanes
+             * passed to the interpolation functions change. It recomputes the
+             * heights of all Points, and thus costs O(|points| * S).
+             *
+             * If the maximum values of the corners did not change, this
+             * function does nothing.
+             *
+             * @param ubQ The new CompactHyperplanes to use as a baseline.
+             */
+            void setCorners(const CompactHyperplanes & ubQ);
+
+            /**
+             * @brief This function adds a new Point to the surface.
+             *
+             * The new Point is assigned the id size() - 1.
+             *
+             * @param p The Point to add.
+             * @param value The value of the surface at the Point.
+             */
+            void add(Point p, double value);
+
+            /**
+             * @brief This function removes a Point from the surface.
+             *
+             * In order to keep the operation cheap, the last Point in the
+             * surface is moved in place of the removed one, thus taking its
+             * id (as with a swap and pop_back in a std::vector).
+             *
+             * @param id The id of the Point to remove.
+             */
+            void erase(size_t id);
+
+            /**
+             * @brief This function swaps the ids of two Points.
+             *
+             * @param lhs The id of the first Point.
+             * @param rhs The id of the second Point.
+             */
+            void swap(size_t lhs, size_t rhs);
+
+            /**
+             * @brief This function modifies the value of the surface at an already existing Point.
+             *
+             * @param id The id of the Point to modify.
+             * @param value The new value.
+             */
+            void setValue(size_t id, double value);
+
+            /**
+             * @brief This function returns the number of Points in the surface.
+             */
+            size_t size() const;
+
+            /**
+             * @brief This function returns the Points in the surface, ordered by id.
+             */
+            const std::vector<Point> & getPoints() const;
+
+            /**
+             * @brief This function returns the values of the Points in the surface, ordered by id.
+             */
+            const std::vector<double> & getValues() const;
+
+            /**
+             * @brief This function returns the currently cached maximum values at the corners of the simplex.
+             */
+            const Vector & getCornerValues() const;
+
+            /**
+             * @brief This function returns the difference between the value of a Point and the corner surface at that Point.
+             *
+             * This is the amount by which the Point would lower the corner
+             * surface if used for interpolation (for useful Points, this is
+             * negative).
+             *
+             * @param id The id of the Point.
+             */
+            double getHeight(size_t id) const;
+
+            /**
+             * @brief This function returns the ids of all Points that can be used to interpolate the input.
+             *
+             * A Point can be used only if it is zero in all coordinates where
+             * the input is zero. The ids are returned in ascending order.
+             *
+             * @param zeroStates A vector marking the coordinates where the input is zero.
+             *
+             * @return The ids of all compatible Points.
+             */
+            std::vector<size_t> getCompatiblePoints(const std::vector<char> & zeroStates) const;
+
+        private:
+            friend std::tuple<double, Vector> sawtoothInterpolation(const Point &, const CompactHyperplanes &, const IndexedPointSurface &);
+
+            struct PointData {
+                size_t bucket;
+                // Reciprocals of the non-zero coordinates, in bucket support order.
+                Vector inverse;
+                // Index in the bucket support of the highest coordinate.
+                size_t dominant;
+                // Dot product of the Point with the corner values.
+                double cornerValue;
+            };
+
+            struct Bucket {
+                std::vector<size_t> support;
+                // Point ids, sorted by ascending height.
+                std::vector<size_t> ids;
+            };
+
+            void insertInBucket(size_t id);
+            void removeFromBucket(size_t id);
+            void renameInBucket(size_t bucket, size_t oldId, size_t newId);
+
+            Vector cornerVals_;
+            PointSurface surface_;
+            std::vector<PointData> data_;
+            std::vector<Bucket> buckets_;
+            std::unordered_map<std::vector<size_t>, size_t, boost::hash<std::vector<size_t>>> supportToBucket_;
+    };
+
+    /**
+     * @brief This function computes the same upper bound as the PointSurface overload, using an IndexedPointSurface.
+     *
+     * The IndexedPointSurface must have been kept in sync with the input
+     * CompactHyperplanes through IndexedPointSurface::setCorners().
+     *
+     * @param p The point to compute the value of.
+     * @param ubQ A set of Hyperplanes to use as a baseline surface.
+     * @param ubV An indexed set of Points (not on the corners of the simplex) to use as main interpolation.
+     *
+     * @return The value of the Point, and a vector containing the proportion in which each Point in the surface contributes to the upper bound.
+     */
+    std::tuple<double, Vector> sawtoothInterpolation(const Point & p, const CompactHyperplanes & ubQ, const IndexedPointSurface & ubV);
+
+    /**
+     * @brief This function computes the same upper bound as the PointSurface overload, using an IndexedPointSurface.
+     *
+     * The IndexedPointSurface must have been kept in sync with the input
+     * CompactHyperplanes through IndexedPointSurface::setCorners().
+     *
+     * @param p The point to compute the value of.
+     * @param ubQ A set of Hyperplanes to use as a baseline surface.
+     * @param ubV An indexed set of Points (not on the corners of the simplex) to use as main interpolation.
+     *
+     * @return The value of the Point, and a vector containing the proportion in which each Point in the surface contributes to the upper bound.
+     */
+    std::tuple<double, Vector> LPInterpolation(const Point & p, const CompactHyperplanes & ubQ, const IndexedPointSurface & ubV);
+
     /**
      * @brief This class implements an easy interface to do Witness discovery through linear programming.
      *
@@ -547,6 +751,10 @@ namespace AIToolbox {
      * Optimal constraints can be progressively added as soon as found. When a
      * new constraint needs to be tested to see if a witness is available, the
      * findWitness() function can be called.
+     *
+     * Since consecutive calls to findWitness() solve LPs which differ by a
+     * single row, the underlying LP is warm started from the basis of the
+     * previous solve.
      */
     class WitnessLP {
         public:
@@ -568,6 +776,20 @@ namespace AIToolbox {
              */
             void addOptimalRow(const Hyperplane & v);
 
+            /**
+             * @brief This function adds multiple optimal constraints to the LP at once.
+             *
+             * This function is equivalent to calling addOptimalRow() for
+             * each element in the range, but adds all rows to the LP in a
+             * single batch.
+             *
+             * @param begin The beginning of the range of optimal Hyperplanes to add.
+             * @param end The end of the range of optimal Hyperplanes to add.
+             * @param p A projection to access the Hyperplanes from more complex structures.
+             */
+            template <typename It, typename P = std::identity>
+            void addOptimalRows(It begin, It end, P p = P{});
+
             /**
              * @brief This function solves the currently set LP.
              *
@@ -575,6 +797,10 @@ namespace AIToolbox {
              * successful returns the witness point which satisfies
              * the solution.
              *
+             * If no optimal constraints have been added yet, any Point is a
+             * witness, and the simplex corner where the input is highest is
+             * returned without solving the LP.
+             *
              * @param v The Hyperplane to test against the optimal ones already added.
              *
              * @return If found, the Point witness to the set problem.
@@ -595,10 +821,33 @@ namespace AIToolbox {
              */
             void allocate(size_t rows);
 
+            /**
+             * @brief This function returns the statistics of all LP solves performed so far.
+             *
+             * @return The statistics of the underlying LP.
+             */
+            const LP::Statistics & getStatistics() const;
+
         private:
-            size_t S;
+            size_t S, optimalRows_;
             LP lp_;
     };
+
+    template <typename It, typename P>
+    void WitnessLP::addOptimalRows(It begin, It end, P p) {
+        const auto size = std::distance(begin, end);
+        if (size == 0) return;
+
+        // See addOptimalRow() for the layout of these rows.
+        Matrix2D rows(size, S + 2);
+        for (auto i = 0; begin != end; ++begin, ++i) {
+            rows.row(i).head(S) = std::invoke(p, *begin).transpose();
+            rows(i, S)     = -1.0;
+            rows(i, S + 1) = +1.0;
+        }
+        lp_.pushRows(rows, LP::Constraint::LessEqual, Vector::Zero(size));
+        optimalRows_ += size;
+    }
 }
 
 #endif
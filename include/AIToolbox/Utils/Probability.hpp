@@ -118,48 +118,64 @@ namespace AIToolbox {
      *
      * \sa isProbability(const size_t size, const T & in);
      *
+     * This function is available for double and float matrices. The row
+     * sums are always computed in double precision.
+     *
      * @param in The input matrix.
      *
      * @return True if the matrix satisfies probability constraints,
      *         and false otherwise.
      */
-    bool isProbability(const Matrix2D & in);
+    template <typename T>
+    bool isProbability(const Matrix2DT<T> & in);
 
     /**
      * @brief This function checks whether the rows of the input matrix contain valid discrete distributions.
      *
      * \sa isProbability(const size_t size, const T & in);
      *
+     * This function is available for double and float matrices. The row
+     * sums are always computed in double precision.
+     *
      * @param in The input matrix.
      *
      * @return True if the matrix satisfies probability constraints,
      *         and false otherwise.
      */
-    bool isProbability(const Matrix3D & in);
+    template <typename T>
+    bool isProbability(const Matrix3DT<T> & in);
 
     /**
      * @brief This function checks whether the rows of the input matrix contain valid discrete distributions.
      *
      * \sa isProbability(const size_t size, const T & in);
      *
+     * This function is available for double and float matrices. The row
+     * sums are always computed in double precision.
+     *
      * @param in The input matrix.
      *
      * @return True if the matrix satisfies probability constraints,
      *         and false otherwise.
      */
-    bool isProbability(const SparseMatrix2D & in);
+    template <typename T>
+    bool isProbability(const SparseMatrix2DT<T> & in);
 
     /**
      * @brief This function checks whether the rows of the input matrix contain valid discrete distributions.
      *
      * \sa isProbability(const size_t size, const T & in);
      *
+     * This function is available for double and float matrices. The row
+     * sums are always computed in double precision.
+     *
      * @param in The input matrix.
      *
      * @return True if the matrix satisfies probability constraints,
      *         and false otherwise.
      */
-    bool isProbability(const SparseMatrix3D & in);
+    template <typename T>
+    bool isProbability(const SparseMatrix3DT<T> & in);
 
     /**
      * @brief This function samples an index from a probability vector.
@@ -210,6 +226,7 @@ namespace AIToolbox {
      * std::uniform_real_distribution<double>, since that is what is used
      * to obtain the random sample.
      *
+     * @tparam T The scalar type of the sparse matrix.
      * @tparam G The type of the generator used.
      * @param in The external probability container.
      * @param d The size of the supplied container.
@@ -217,11 +234,11 @@ namespace AIToolbox {
      *
      * @return An index in range [0,d-1].
      */
-    template <typename G>
-    size_t sampleProbability(const size_t d, const SparseMatrix2D::ConstRowXpr& in, G& generator) {
+    template <typename T, typename G>
+    size_t sampleProbability(const size_t d, const Eigen::Block<const SparseMatrix2DT<T>, 1, Eigen::Dynamic, true> & in, G& generator) {
         double p = probabilityDistribution(generator);
 
-        for ( SparseMatrix2D::ConstRowXpr::InnerIterator i(in, 0); ; ++i ) {
+        for ( typename SparseMatrix2DT<T>::ConstRowXpr::InnerIterator i(in, 0); ; ++i ) {
             if ( i.value() > p ) return i.col();
             p -= i.value();
         }
@@ -415,6 +432,22 @@ namespace AIToolbox {
      */
     ProbabilityVector projectToProbability(const Vector & v);
 
+    /**
+     * @brief This function builds the tables of the Alias sampling method.
+     *
+     * This is the setup used by VoseAliasSampler, exposed so that classes
+     * which need many alias tables can store them contiguously.
+     *
+     * To sample, draw x uniformly in [0, N), and let i be its integer
+     * part; then the result is i if (x - i) < prob[i], and alias[i]
+     * otherwise.
+     *
+     * @param p The probability distribution to build the tables for.
+     * @param prob The output weighted coins, of size p.size().
+     * @param alias The output aliases, of size p.size().
+     */
+    void buildAliasTable(const ProbabilityVector & p, double * prob, size_t * alias);
+
     /**
      * @brief This class represents the Alias sampling method.
      *
@@ -196,6 +196,13 @@ next:;
             template <typename It, typename P = std::identity>
             It operator()(It begin, It end, P p = P{});
 
+            /**
+             * @brief This function returns the statistics of all LP solves performed so far.
+             *
+             * @return The statistics of the underlying WitnessLP.
+             */
+            const LP::Statistics & getStatistics() const { return lp_.getStatistics(); }
+
         private:
             size_t S;
 
@@ -228,8 +235,7 @@ next:;
 
             // Setup initial LP rows. Note that best can't be empty, since we have
             // at least one best for the simplex corners.
-            for ( auto it = begin; it != bound; ++it )
-                lp_.addOptimalRow(std::invoke(p, *it));
+            lp_.addOptimalRows(begin, bound, p);
         }
 
         // For each of the remaining points now we try to find a witness
@@ -2,11 +2,11 @@
 
 namespace AIToolbox::Bandit {
     EpsilonPolicy::EpsilonPolicy(const PolicyInterface & p, double epsilon) :
-            PolicyInterface::Base(p.getA()), EpsilonBase(p, epsilon),
-            randomDistribution_(0, this->A-1) {}
+            PolicyInterface::Base(p.getA()), EpsilonBase(p, epsilon) {}
 
-    size_t EpsilonPolicy::sampleRandomAction() const {
-        return randomDistribution_(rand_);
+    size_t EpsilonPolicy::sampleRandomAction(RandomEngine & rnd) const {
+        // We don't store the distribution so that this can be called concurrently.
+        return std::uniform_int_distribution<size_t>(0, A-1)(rnd);
     }
 
     double EpsilonPolicy::getRandomActionProbability() const {
@@ -10,6 +10,25 @@ namespace AIToolbox::Bandit {
         return wrap.sampleAction();
     }
 
+    size_t QGreedyPolicy::sampleAction(RandomEngine & rnd) const {
+        std::vector<size_t> bestActions(A);
+        auto wrap = QGreedyPolicyWrapper(q_, bestActions, rnd);
+        return wrap.sampleAction();
+    }
+
+    void QGreedyPolicy::sampleActions(std::span<size_t> out) const {
+        const Vector p = getPolicy();
+
+        size_t count = 0;
+        for (size_t a = 0; a < A; ++a)
+            if (p[a] > 0.0)
+                bestActions_[count++] = a;
+
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        for (auto & a : out)
+            a = bestActions_[pick(rand_)];
+    }
+
     double QGreedyPolicy::getActionProbability(const size_t & a) const {
         auto wrap = QGreedyPolicyWrapper(q_, bestActions_, rand_);
         return wrap.getActionProbability(a);
@@ -17,8 +17,25 @@ namespace AIToolbox::Bandit {
         return wrap.sampleAction();
     }
 
+    size_t QSoftmaxPolicy::sampleAction(RandomEngine & rnd) const {
+        std::vector<size_t> bestActions(A);
+        Vector vbuffer(A);
+        auto wrap = QSoftmaxPolicyWrapper(temperature_, q_, vbuffer, bestActions, rnd);
+        return wrap.sampleAction();
+    }
+
+    void QSoftmaxPolicy::sampleActions(std::span<size_t> out) const {
+        const VoseAliasSampler sampler(getPolicy());
+
+        for (auto & a : out)
+            a = sampler.sampleProbability(rand_);
+    }
+
     double QSoftmaxPolicy::getActionProbability(const size_t & a) const {
-        auto wrap = QSoftmaxPolicyWrapper(temperature_, q_, vbuffer_, bestActions_, rand_);
+        // This writes to the value buffer, so we use a local one to keep
+        // this function safe to call concurrently.
+        Vector vbuffer(A);
+        auto wrap = QSoftmaxPolicyWrapper(temperature_, q_, vbuffer, bestActions_, rand_);
         return wrap.getActionProbability(a);
     }
 
@@ -9,6 +9,16 @@ namespace AIToolbox::Bandit {
         return randomDistribution_(rand_);
     }
 
+    size_t RandomPolicy::sampleAction(RandomEngine & rnd) const {
+        // We don't use the stored distribution so that this can be called concurrently.
+        return std::uniform_int_distribution<size_t>(0, A-1)(rnd);
+    }
+
+    void RandomPolicy::sampleActions(std::span<size_t> out) const {
+        for (auto & a : out)
+            a = randomDistribution_(rand_);
+    }
+
     double RandomPolicy::getActionProbability(const size_t &) const {
         return 1.0/getA();
     }
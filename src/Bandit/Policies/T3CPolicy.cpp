@@ -1,22 +1,27 @@
 #include <AIToolbox/Bandit/Policies/T3CPolicy.hpp>
 
 #include <random>
+#include <vector>
 
 namespace AIToolbox::Bandit {
     T3CPolicy::T3CPolicy(const Experience & exp, const double beta, const double var) :
             Base(exp.getRewardMatrix().size()), policy_(exp), beta_(beta), var_(var) {}
 
     size_t T3CPolicy::sampleAction() const {
+        return sampleAction(rand_);
+    }
+
+    size_t T3CPolicy::sampleAction(RandomEngine & rnd) const {
         const auto & exp = policy_.getExperience();
         const auto & means = exp.getRewardMatrix();
         const auto & counts = exp.getVisitsTable();
 
-        size_t bestAction = policy_.sampleAction();
+        size_t bestAction = policy_.sampleAction(rnd);
 
         if (counts[bestAction] < 2) return bestAction;
 
         std::bernoulli_distribution pickBest(beta_);
-        if (pickBest(rand_))
+        if (pickBest(rnd))
             return bestAction;
 
         size_t secondBestAction = 0;
@@ -41,7 +46,7 @@ namespace AIToolbox::Bandit {
             } else if (W == lowestCost) {
                 // Uniformly sample from equal cost alternatives
                 std::bernoulli_distribution replace(1.0 / ++k);
-                if (replace(rand_)) {
+                if (replace(rnd)) {
                     lowestCost = W;
                     secondBestAction = a;
                 }
@@ -61,34 +66,52 @@ namespace AIToolbox::Bandit {
     }
 
     double T3CPolicy::getActionProbability(const size_t & a) const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 1000;
-        unsigned selected = 0;
-
-        for (size_t i = 0; i < trials; ++i)
-            if (sampleAction() == a)
-                ++selected;
-
-        return static_cast<double>(selected) / trials;
+        return getPolicy()[a];
     }
 
     Vector T3CPolicy::getPolicy() const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 100000;
+        const auto & exp = policy_.getExperience();
+        const auto & means = exp.getRewardMatrix();
+        const auto & counts = exp.getVisitsTable();
+
+        const Vector leader = policy_.getPolicy();
+
+        // If some arm has less than 2 samples, it's always the leader, and
+        // sampleAction() always returns it.
+        for (size_t a = 0; a < A; ++a)
+            if (counts[a] < 2)
+                return leader;
 
-        Vector retval{A};
-        retval.setZero();
+        Vector retval = beta_ * leader;
+        std::vector<size_t> challengers;
+        for (size_t l = 0; l < A; ++l) {
+            if (leader[l] == 0.0) continue;
 
-        for (size_t i = 0; i < trials; ++i)
-            retval[sampleAction()] += 1.0;
+            // Same costs as in sampleAction(), but we keep all ties since
+            // each of them is picked uniformly.
+            double lowestCost = std::numeric_limits<double>::max();
+            challengers.clear();
+            for (size_t a = 0; a < A; ++a) {
+                if (a == l) continue;
+
+                const double W = (means[a] >= means[l]) ? 0.0 :
+                        std::pow(means[l] - means[a], 2) / (2 * var_ * (1.0 / counts[l] + 1.0 / counts[a]));
+
+                if (W < lowestCost) {
+                    lowestCost = W;
+                    challengers.assign(1, a);
+                } else if (W == lowestCost) {
+                    challengers.push_back(a);
+                }
+            }
+            // With a single arm, sampleAction() returns arm 0.
+            if (challengers.empty()) challengers.push_back(0);
+
+            const double p = (1.0 - beta_) * leader[l] / challengers.size();
+            for (const auto a : challengers)
+                retval[a] += p;
+        }
 
-        retval /= retval.sum();
         return retval;
     }
 
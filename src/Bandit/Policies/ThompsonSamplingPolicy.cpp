@@ -7,12 +7,16 @@ namespace AIToolbox::Bandit {
             Base(exp.getRewardMatrix().size()), exp_(exp) {}
 
     size_t ThompsonSamplingPolicy::sampleAction() const {
+        return sampleAction(rand_);
+    }
+
+    size_t ThompsonSamplingPolicy::sampleAction(RandomEngine & rnd) const {
         // For each arm, we sample its mean. Note that here we use a
         // standardized Student-t distribution, which we then scale using our
         // QFunction and counts parameters to obtain the correct mean
         // estimates.
         size_t bestAction = 0;
-        double bestValue = std::numeric_limits<double>::min();
+        double bestValue = std::numeric_limits<double>::lowest();
 
         const auto & counts = exp_.getVisitsTable();
         const auto & q = exp_.getRewardMatrix();
@@ -30,7 +34,7 @@ namespace AIToolbox::Bandit {
             // and
             //     t = student_t sample with n-1 degrees of freedom
             std::student_t_distribution<double> dist(counts[a] - 1);
-            const double val = q[a] + dist(rand_) * std::sqrt(m2[a] / (counts[a] * (counts[a] - 1)));
+            const double val = q[a] + dist(rnd) * std::sqrt(m2[a] / (counts[a] * (counts[a] - 1)));
 
             if (val > bestValue) {
                 bestAction = a;
@@ -42,34 +46,39 @@ namespace AIToolbox::Bandit {
     }
 
     double ThompsonSamplingPolicy::getActionProbability(const size_t & a) const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 1000;
-        unsigned selected = 0;
-
-        for (size_t i = 0; i < trials; ++i)
-            if (sampleAction() == a)
-                ++selected;
-
-        return static_cast<double>(selected) / trials;
+        const auto & counts = exp_.getVisitsTable();
+        for (size_t b = 0; b < A; ++b)
+            if (counts[b] < 2)
+                return a == b;
+
+        return computeMaxProbability(getPosteriors(), a);
     }
 
     Vector ThompsonSamplingPolicy::getPolicy() const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 100000;
+        const auto & counts = exp_.getVisitsTable();
+        for (size_t a = 0; a < A; ++a) {
+            if (counts[a] < 2) {
+                // sampleAction() always returns the first arm without
+                // enough samples.
+                Vector retval = Vector::Zero(A);
+                retval[a] = 1.0;
+                return retval;
+            }
+        }
+
+        return computeMaxProbabilities(getPosteriors());
+    }
 
-        Vector retval{A};
-        retval.setZero();
+    std::vector<ValueDistribution> ThompsonSamplingPolicy::getPosteriors() const {
+        const auto & counts = exp_.getVisitsTable();
+        const auto & q = exp_.getRewardMatrix();
+        const auto & m2 = exp_.getM2Matrix();
 
-        for (size_t i = 0; i < trials; ++i)
-            retval[sampleAction()] += 1.0;
+        std::vector<ValueDistribution> retval;
+        retval.reserve(A);
+        for (size_t a = 0; a < A; ++a)
+            retval.push_back(ValueDistribution::studentT(counts[a] - 1, q[a], std::sqrt(m2[a] / (counts[a] * (counts[a] - 1)))));
 
-        retval /= retval.sum();
         return retval;
     }
 
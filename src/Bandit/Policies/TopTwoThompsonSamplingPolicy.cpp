@@ -7,19 +7,23 @@ namespace AIToolbox::Bandit {
             Base(exp.getRewardMatrix().size()), policy_(exp), beta_(beta) {}
 
     size_t TopTwoThompsonSamplingPolicy::sampleAction() const {
-        size_t bestAction = policy_.sampleAction();
+        return sampleAction(rand_);
+    }
+
+    size_t TopTwoThompsonSamplingPolicy::sampleAction(RandomEngine & rnd) const {
+        size_t bestAction = policy_.sampleAction(rnd);
 
         const auto & counts = policy_.getExperience().getVisitsTable();
 
         if (counts[bestAction] < 2) return bestAction;
 
         std::bernoulli_distribution pickBest(beta_);
-        if (pickBest(rand_))
+        if (pickBest(rnd))
             return bestAction;
 
         size_t secondBestAction;
         do {
-            secondBestAction = policy_.sampleAction();
+            secondBestAction = policy_.sampleAction(rnd);
         } while (bestAction == secondBestAction);
 
         return secondBestAction;
@@ -35,34 +39,34 @@ namespace AIToolbox::Bandit {
     }
 
     double TopTwoThompsonSamplingPolicy::getActionProbability(const size_t & a) const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 1000;
-        unsigned selected = 0;
-
-        for (size_t i = 0; i < trials; ++i)
-            if (sampleAction() == a)
-                ++selected;
-
-        return static_cast<double>(selected) / trials;
+        return getPolicy()[a];
     }
 
     Vector TopTwoThompsonSamplingPolicy::getPolicy() const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 100000;
+        const Vector leader = policy_.getPolicy();
 
-        Vector retval{A};
-        retval.setZero();
-
-        for (size_t i = 0; i < trials; ++i)
-            retval[sampleAction()] += 1.0;
+        // If some arm has less than 2 samples, it's always the leader, and
+        // sampleAction() always returns it.
+        const auto & counts = policy_.getExperience().getVisitsTable();
+        for (size_t a = 0; a < A; ++a)
+            if (counts[a] < 2)
+                return leader;
+
+        Vector retval = beta_ * leader;
+        for (size_t l = 0; l < A; ++l) {
+            if (leader[l] == 0.0) continue;
+
+            const double rest = 1.0 - leader[l];
+            if (rest <= 0.0) {
+                // No other arm can ever be sampled as challenger.
+                retval[l] += (1.0 - beta_) * leader[l];
+                continue;
+            }
+            for (size_t a = 0; a < A; ++a)
+                if (a != l)
+                    retval[a] += (1.0 - beta_) * leader[l] * leader[a] / rest;
+        }
 
-        retval /= retval.sum();
         return retval;
     }
 
@@ -6,6 +6,10 @@ namespace AIToolbox::Factored::Bandit {
 
     LocalSearch::LocalSearch() : rnd_(Seeder::getSeed()) {}
 
+    void LocalSearch::seed(const unsigned seed) {
+        rnd_.seed(seed);
+    }
+
     LocalSearch::Result LocalSearch::operator()(const Action & A, const Graph & graph) {
         Action startAction = makeRandomValue(A, rnd_);
         return (*this)(A, graph, std::move(startAction));
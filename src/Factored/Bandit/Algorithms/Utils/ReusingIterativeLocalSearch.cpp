@@ -12,6 +12,11 @@ namespace AIToolbox::Factored::Bandit {
         rnd_(Seeder::getSeed())
     {}
 
+    void ReusingIterativeLocalSearch::seed(const unsigned seed) {
+        rnd_.seed(seed);
+        ls_.seed(rnd_());
+    }
+
     ReusingIterativeLocalSearch::Result ReusingIterativeLocalSearch::operator()(const Action & A, const Graph & graph) {
         // If we haven't initialized the action yet, do so. Otherwise we keep
         // the old one, hoping that the graph has not changed too much and that
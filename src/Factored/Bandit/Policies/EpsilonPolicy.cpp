@@ -4,19 +4,15 @@
 
 namespace AIToolbox::Factored::Bandit {
     EpsilonPolicy::EpsilonPolicy(const PolicyInterface & p, double epsilon) :
-            PolicyInterface::Base(p.getA()), EpsilonBase(p, epsilon)
-    {
-        randomDistribution_.reserve(getA().size());
-        for (size_t i = 0; i < getA().size(); ++i)
-            randomDistribution_.emplace_back(0, getA()[i] - 1);
-    }
+            PolicyInterface::Base(p.getA()), EpsilonBase(p, epsilon) {}
 
-    Action EpsilonPolicy::sampleRandomAction() const {
+    Action EpsilonPolicy::sampleRandomAction(RandomEngine & rnd) const {
         Action a;
         a.reserve(getA().size());
 
+        // We don't store the distributions so that this can be called concurrently.
         for (size_t i = 0; i < getA().size(); ++i)
-            a.push_back(randomDistribution_[i](rand_));
+            a.push_back(std::uniform_int_distribution<size_t>(0, getA()[i] - 1)(rnd));
 
         return a;
     }
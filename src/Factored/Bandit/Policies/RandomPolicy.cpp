@@ -14,6 +14,22 @@ namespace AIToolbox::Factored::Bandit {
         return sampleActionNoAlloc();
     }
 
+    Action RandomPolicy::sampleAction(RandomEngine & rnd) const {
+        Action retval(getA().size());
+        // We don't use the stored distributions so that this can be called concurrently.
+        for (size_t a = 0; a < getA().size(); ++a)
+            retval[a] = std::uniform_int_distribution<size_t>(0, getA()[a]-1)(rnd);
+        return retval;
+    }
+
+    void RandomPolicy::sampleActions(std::span<Action> out) const {
+        for (auto & action : out) {
+            action.resize(getA().size());
+            for (size_t a = 0; a < getA().size(); ++a)
+                action[a] = randomDistributions_[a](rand_);
+        }
+    }
+
     const Action & RandomPolicy::sampleActionNoAlloc() const {
         for (size_t a = 0; a < getA().size(); ++a)
             action_[a] = randomDistributions_[a](rand_);
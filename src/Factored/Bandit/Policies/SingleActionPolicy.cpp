@@ -10,6 +10,10 @@ namespace AIToolbox::Factored::Bandit {
         return currentAction_;
     }
 
+    Action SingleActionPolicy::sampleAction(RandomEngine &) const {
+        return currentAction_;
+    }
+
     double SingleActionPolicy::getActionProbability(const Action & a) const {
         return veccmp(a, currentAction_) == 0 ? 1.0 : 0.0;
     }
@@ -1,6 +1,9 @@
 #include <AIToolbox/Factored/Bandit/Policies/ThompsonSamplingPolicy.hpp>
 
 #include <random>
+#include <stdexcept>
+
+#include <AIToolbox/Utils/MaxProbability.hpp>
 
 namespace AIToolbox::Factored::Bandit {
     void ThompsonSamplingPolicy::setupGraph(const Experience & exp, VariableElimination::GVE::Graph & graph, RandomEngine & rnd) {
@@ -47,33 +50,39 @@ namespace AIToolbox::Factored::Bandit {
     }
 
     ThompsonSamplingPolicy::ThompsonSamplingPolicy(const Experience & exp) :
-            Base(exp.getA()), exp_(exp) {}
+            Base(exp.getA()), exp_(exp), errorBound_(0.016), threads_(1) {}
 
     Action ThompsonSamplingPolicy::sampleAction() const {
+        return sampleAction(rand_);
+    }
+
+    Action ThompsonSamplingPolicy::sampleAction(RandomEngine & rnd) const {
         using VE = Bandit::VariableElimination;
         VE::GVE::Graph graph(A.size());
 
-        setupGraph(exp_, graph, rand_);
+        setupGraph(exp_, graph, rnd);
 
         VE ve;
         return std::get<0>(ve(A, graph));
     }
 
     double ThompsonSamplingPolicy::getActionProbability(const Action & a) const {
-        // The true formula here is hard, so we don't compute this exactly.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 1000;
-        unsigned selected = 0;
-
-        for (size_t i = 0; i < trials; ++i)
-            if (sampleAction() == a)
-                ++selected;
-
-        return static_cast<double>(selected) / trials;
+        auto sampler = [this, &a](RandomEngine & rnd) -> size_t {
+            return sampleAction(rnd) == a;
+        };
+        return estimateFrequencies(2, sampler, errorBound_, threads_)[1];
     }
 
+    void ThompsonSamplingPolicy::setErrorBound(const double errorBound) {
+        if (errorBound <= 0.0) throw std::invalid_argument("Error bound must be positive");
+        errorBound_ = errorBound;
+    }
+
+    double ThompsonSamplingPolicy::getErrorBound() const { return errorBound_; }
+
+    void ThompsonSamplingPolicy::setThreads(const unsigned threads) { threads_ = threads; }
+    unsigned ThompsonSamplingPolicy::getThreads() const { return threads_; }
+
     const Experience & ThompsonSamplingPolicy::getExperience() const {
         return exp_;
     }
@@ -122,7 +122,7 @@ namespace AIToolbox::Factored::MDP {
         // to avoid building zero rules as they just slow down the LP solve
         // process without adding anything. So we add a column at a time just
         // for the non-zero entries.
-        LP lp(returnVars);
+        LP lp(returnVars, LP::Backend::LpSolve);
 
         for (size_t i = 0; i < h.bases.size(); ++i)
             lp.row[i] = h.bases[i].values.sum() / h.bases[i].values.size();
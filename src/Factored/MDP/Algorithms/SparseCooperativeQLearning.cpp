@@ -1,5 +1,7 @@
 #include <AIToolbox/Factored/MDP/Algorithms/SparseCooperativeQLearning.hpp>
 
+#include <map>
+
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Factored/Utils/Core.hpp>
 
@@ -18,34 +20,74 @@ namespace AIToolbox::Factored::MDP {
     SparseCooperativeQLearning::SparseCooperativeQLearning(State s, Action a, const std::vector<QFunctionRule> & rules, const double discount, const double alpha) :
             S(std::move(s)), A(std::move(a)), discount_(discount), alpha_(alpha),
             rules_(initMap(S, A, rules)),
-            policy_(S, A, rules_)
-    {}
+            graph_(MakeGraph<Bandit::VariableElimination>()(rules_, A))
+    {
+        // Group the rules by the features they depend on.
+        std::map<std::pair<PartialKeys, PartialKeys>, size_t> familyIds;
+        for (size_t id = 0; id < rules_.size(); ++id) {
+            const auto & rule = rules_[id];
+
+            auto [it, inserted] = familyIds.try_emplace({rule.state.first, rule.action.first}, families_.size());
+            if (inserted)
+                families_.push_back({rule.state.first, rule.action.first, factorSpacePartial(rule.action.first, A), {}});
+
+            auto & family = families_[it->second];
+            family.rules.emplace_back(toIndexPartial(S, rule.state) * family.actionSpace + toIndexPartial(A, rule.action), id);
+        }
+        for (auto & family : families_)
+            std::sort(std::begin(family.rules), std::end(family.rules));
+    }
+
+    void SparseCooperativeQLearning::matchRules(const State & s, const Action * a, std::vector<size_t> & ids) const {
+        ids.clear();
+        for (const auto & family : families_) {
+            // All rules of this family matching s are contiguous, and if
+            // we know the action we can restrict them further.
+            auto lo = toIndexPartial(family.stateTag, S, s) * family.actionSpace;
+            auto hi = lo + family.actionSpace;
+            if (a) {
+                lo += toIndexPartial(family.actionTag, A, *a);
+                hi = lo + 1;
+            }
+
+            auto it = std::lower_bound(std::begin(family.rules), std::end(family.rules), lo,
+                [](const auto & rule, const size_t key) { return rule.first < key; }
+            );
+            for (; it != std::end(family.rules) && it->first < hi; ++it)
+                ids.push_back(it->second);
+        }
+    }
 
     Action SparseCooperativeQLearning::stepUpdateQ(const State & s, const Action & a, const State & s1, const Rewards & rew) {
-        const auto a1 = policy_.sampleAction(s1);
+        // Compute the best next action from the rules matching s1.
+        matchRules(s1, nullptr, afterIds_);
+        UpdateGraph<Bandit::VariableElimination>()(graph_, IndexMap(&afterIds_, rules_.getContainer()), S, A, s1);
+        const auto a1 = std::get<0>(ve_(A, graph_));
 
-        auto beforeRules = rules_.filter(join(s, a));
-        const auto afterRules = rules_.filter(join(s1, a1));
+        matchRules(s, &a, beforeIds_);
+        matchRules(s1, &a1, afterIds_);
 
         Vector perAgentRews(A.size());
         perAgentRews.setZero();
 
         // First, count how many before rules contain each agent.
-        for (const auto & br : beforeRules)
-            for (auto a : br.action.first)
+        for (const auto id : beforeIds_)
+            for (auto a : rules_[id].action.first)
                 ++perAgentRews[a];
 
         // Then, weight the per-agent reward between the rules.
         perAgentRews.array() = rew.array() / perAgentRews.array();
 
         // Now, for each after rule, add its weighted discounted value.
-        for (const auto & ar : afterRules) {
+        for (const auto id : afterIds_) {
+            const auto & ar = rules_[id];
             const double val = discount_ * ar.value / ar.action.first.size();
             for (auto a : ar.action.first)
                 perAgentRews[a] += val;
         }
         // Finally, remove the weighted value of the original rules.
-        for (const auto & br : beforeRules) {
+        for (const auto id : beforeIds_) {
+            const auto & br = rules_[id];
             const double val = -br.value / br.action.first.size();
             for (auto a : br.action.first)
                 perAgentRews[a] += val;
@@ -53,7 +95,8 @@ namespace AIToolbox::Factored::MDP {
         // Update each rule weighted by the learning rate.
         perAgentRews.array() *= alpha_;
 
-        for (auto & br : beforeRules) {
+        for (const auto id : beforeIds_) {
+            auto & br = rules_[id];
             double update = 0;
             for (auto a : br.action.first)
                 update += perAgentRews[a];
@@ -30,6 +30,8 @@ namespace AIToolbox::Factored::MDP {
     //     Remove initial variables - "paste" them in.
 
     std::optional<Vector> FactoredLP::operator()(const FactoredVector & C, const FactoredVector & b, bool addConstantBasis) {
+        SolverStatisticsRecorder record(stats_);
+
         // Clear everything so we can use this function multiple times.
         VE::Graph graph(S.size());
 
@@ -70,7 +72,7 @@ namespace AIToolbox::Factored::MDP {
         for (const auto & f : b.bases) startingVars += f.values.size() * 2;
 
         // Init LP with starting variables
-        LP lp(startingVars);
+        LP lp(startingVars, LP::Backend::LpSolve);
         lp.setObjective(phiId, false); // Minimize phi
         lp.row.setZero();
 
@@ -154,6 +156,10 @@ namespace AIToolbox::Factored::MDP {
         return lp.solve(phiId);
     }
 
+    const SolverStatistics & FactoredLP::getStatistics() const {
+        return stats_;
+    }
+
     // Here's the implementation for the specifics of this Variable Elimination setup.
 
     void Global::initNewFactor() {
@@ -0,0 +1,193 @@
+#include <AIToolbox/Factored/MDP/Algorithms/ValueIteration.hpp>
+
+#include <chrono>
+
+#include <Eigen/QR>
+
+#include <AIToolbox/Logging.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/LP.hpp>
+#include <AIToolbox/Factored/Utils/Core.hpp>
+#include <AIToolbox/Factored/Utils/BayesianNetwork.hpp>
+#include <AIToolbox/Factored/Bandit/Algorithms/Utils/VariableElimination.hpp>
+#include <AIToolbox/Factored/MDP/Algorithms/Utils/GraphUtils.hpp>
+
+namespace AIToolbox::Factored::MDP {
+    ValueIteration::ValueIteration(const unsigned horizon, const double tolerance, const Projection projection, const bool policyIteration) :
+            horizon_(horizon), projection_(projection), policyIteration_(policyIteration)
+    {
+        setTolerance(tolerance);
+    }
+
+    std::tuple<double, Vector, QFunction> ValueIteration::operator()(const CooperativeModel & m, const FactoredVector & h, const std::vector<State> & samples) {
+        using VE = Bandit::VariableElimination;
+
+        const auto & S = m.getS();
+        const auto & A = m.getA();
+        const auto & R = m.getRewardFunction();
+        const auto discount = m.getDiscount();
+
+        const size_t K = h.bases.size();
+        const size_t N = samples.size();
+
+        stats_.clear();
+
+        // g_k(s,a) = sum_s' T(s,a,s') * h_k(s'). This does not depend on
+        // the weights, so it is computed once.
+        const auto g = backProject(m.getTransitionFunction(), h);
+
+        // H(n,k) = h_k(s_n)
+        Matrix2D H(N, K);
+        for (size_t n = 0; n < N; ++n)
+            for (size_t k = 0; k < K; ++k)
+                H(n, k) = h.bases[k].values[toIndexPartial(h.bases[k].tag, S, samples[n])];
+
+        // In value iteration with least-squares the matrix to project onto
+        // never changes, so we decompose it a single time. Bases are often
+        // linearly dependent (for example, indicators over different
+        // features all sum up to one), so we need the minimum norm solution
+        // to avoid the weights drifting away along the null space.
+        Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> qr;
+        const bool reuseQR = !policyIteration_ && projection_ == Projection::LeastSquares;
+        if (reuseQR)
+            qr.compute(H);
+
+        Vector w = Vector::Zero(K);
+        Vector v0 = Vector::Zero(N), v1;
+        Vector target(N);
+
+        // Policy iteration only: the evaluation matrix and rewards of the
+        // current greedy policy.
+        std::vector<Action> policy;
+        Matrix2D M;
+        Vector r;
+        if (policyIteration_) {
+            policy.resize(N);
+            M.resize(N, K);
+            r.resize(N);
+        }
+
+        auto makeQ = [&] {
+            QFunction q = g * (w * discount);
+            plusEqual(S, A, q, R);
+            return q;
+        };
+
+        QFunction q = makeQ();
+        VE ve;
+        auto graph = MakeGraph<VE>()(q, A);
+
+        unsigned timestep = 0;
+        double variation = tolerance_ * 2; // Make it bigger
+
+        const bool useTolerance = tolerance_ > 0.0;
+        while ( timestep < horizon_ && (!useTolerance || variation > tolerance_) ) {
+            ++timestep;
+            AI_LOGGER(AI_SEVERITY_DEBUG, "Processing timestep " << timestep);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            if (timestep > 1) q = makeQ();
+
+            // Greedy backup of each sample.
+            for (size_t n = 0; n < N; ++n) {
+                UpdateGraph<VE>()(graph, q, S, A, samples[n]);
+                auto [a, v] = ve(A, graph);
+                target[n] = v;
+                if (policyIteration_) policy[n] = std::move(a);
+            }
+            const double residual = N ? (v0 - target).cwiseAbs().maxCoeff() : 0.0;
+
+            if (!policyIteration_) {
+                w = reuseQR ? Vector(qr.solve(target)) : project(H, target);
+            } else {
+                // Evaluate the greedy policy by minimizing its Bellman residual:
+                //
+                //     sum_k w_k * (h_k(s) - discount * g_k(s,pi(s))) = R(s,pi(s))
+                for (size_t n = 0; n < N; ++n) {
+                    const auto & s = samples[n];
+                    const auto & a = policy[n];
+                    for (size_t k = 0; k < K; ++k) {
+                        const auto & gk = g.bases[k];
+                        const auto sId = toIndexPartial(gk.tag, S, s);
+                        const auto aId = toIndexPartial(gk.actionTag, A, a);
+                        M(n, k) = H(n, k) - discount * gk.values(sId, aId);
+                    }
+                    r[n] = R.getValue(S, A, s, a);
+                }
+                w = project(M, r);
+            }
+
+            v1 = H * w;
+            variation = N ? (v1 - v0).cwiseAbs().maxCoeff() : 0.0;
+            std::swap(v0, v1);
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats_.push_back({residual, variation, seconds});
+
+            AI_LOGGER(AI_SEVERITY_DEBUG, "Residual " << residual << ", variation " << variation << ", time " << seconds << "s");
+        }
+
+        // We do not guarantee that the weights are the best possible ones,
+        // as we stop as within the given tolerance.
+        return std::make_tuple(useTolerance ? variation : 0.0, std::move(w), makeQ());
+    }
+
+    Vector ValueIteration::project(const Matrix2D & M, const Vector & b) const {
+        const auto K = M.cols();
+        const auto N = M.rows();
+
+        if (projection_ == Projection::LeastSquares)
+            return Eigen::MatrixXd(M).completeOrthogonalDecomposition().solve(b);
+
+        // Max-norm projection:
+        //
+        //     minimize phi
+        //     s.t.  M * w - b <= phi
+        //           b - M * w <= phi
+        //
+        // The weights are unbounded, while phi is positive by default.
+        LP lp(K + 1);
+
+        lp.row.setZero();
+        lp.row[K] = 1.0;
+        lp.setObjective(false);
+
+        Matrix2D rows(2 * N, K + 1);
+        rows.topLeftCorner(N, K) = M;
+        rows.bottomLeftCorner(N, K) = -M;
+        rows.col(K).fill(-1.0);
+
+        Vector values(2 * N);
+        values << b, -b;
+
+        lp.pushRows(rows, LP::Constraint::LessEqual, values);
+
+        for (int k = 0; k < K; ++k)
+            lp.setUnbounded(k);
+
+        auto solution = lp.solve(K);
+        if (!solution)
+            throw std::runtime_error("Could not solve the max-norm projection LP");
+
+        return std::move(*solution);
+    }
+
+    void ValueIteration::setTolerance(const double t) {
+        if ( t < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
+        tolerance_ = t;
+    }
+
+    void ValueIteration::setHorizon(const unsigned h) { horizon_ = h; }
+    void ValueIteration::setProjection(const Projection p) { projection_ = p; }
+    void ValueIteration::setPolicyIteration(const bool p) { policyIteration_ = p; }
+
+    double ValueIteration::getTolerance() const { return tolerance_; }
+    unsigned ValueIteration::getHorizon() const { return horizon_; }
+    ValueIteration::Projection ValueIteration::getProjection() const { return projection_; }
+    bool ValueIteration::getPolicyIteration() const { return policyIteration_; }
+
+    const std::vector<ValueIteration::IterationStats> & ValueIteration::getIterationStats() const {
+        return stats_;
+    }
+}
@@ -58,6 +58,25 @@ namespace AIToolbox::Factored::MDP {
         timesteps_ = 0;
     }
 
+    void CooperativeExperience::setVisitsTable(const VisitsTable & v) {
+        for (size_t i = 0; i < visits_.size(); ++i)
+            visits_[i] = v[i];
+    }
+
+    void CooperativeExperience::setRewardMatrix(const RewardMatrix & r) {
+        for (size_t i = 0; i < rewards_.size(); ++i)
+            rewards_[i] = r[i];
+    }
+
+    void CooperativeExperience::setM2Matrix(const RewardMatrix & mm) {
+        for (size_t i = 0; i < M2s_.size(); ++i)
+            M2s_[i] = mm[i];
+    }
+
+    void CooperativeExperience::setTimesteps(const unsigned long t) {
+        timesteps_ = t;
+    }
+
     unsigned long CooperativeExperience::getTimesteps() const {
         return timesteps_;
     }
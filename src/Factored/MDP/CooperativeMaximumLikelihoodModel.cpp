@@ -4,7 +4,8 @@
 
 namespace AIToolbox::Factored::MDP {
     CooperativeMaximumLikelihoodModel::CooperativeMaximumLikelihoodModel(const CooperativeExperience & exp, const double discount, const bool toSync)
-            : experience_(exp), discount_(discount), transitions_({experience_.getGraph(), {}})
+            : experience_(exp), discount_(discount), transitions_({experience_.getGraph(), {}}),
+              sampler_(experience_.getGraph())
     {
         const auto & S = experience_.getS();
         auto & tProbs = transitions_.transitions;
@@ -24,6 +25,7 @@ namespace AIToolbox::Factored::MDP {
 
             rewards_.back().setZero();
         }
+        sampler_.update(transitions_);
         if (toSync) sync();
     }
 
@@ -57,6 +59,31 @@ namespace AIToolbox::Factored::MDP {
         }
     }
 
+    void CooperativeMaximumLikelihoodModel::syncIncremental(const CooperativeExperience::Indeces & indeces, const State & s1) {
+        const auto & S = experience_.getS();
+        const auto & vtable  = experience_.getVisitsTable();
+        const auto & rmatrix = experience_.getRewardMatrix();
+        auto & tProbs = transitions_.transitions;
+
+        for (size_t i = 0; i < S.size(); ++i) {
+            const auto j = indeces[i];
+            const auto totalVisits = vtable[i](j, S[i]);
+
+            // With a single visit the old row was the default one, and
+            // must be replaced entirely.
+            if (totalVisits == 1) {
+                tProbs[i].row(j).setZero();
+                tProbs[i](j, s1[i]) = 1.0;
+            } else {
+                const double w = 1.0 / totalVisits;
+                tProbs[i].row(j) *= 1.0 - w;
+                tProbs[i](j, s1[i]) += w;
+            }
+            rewards_[i][j] = rmatrix[i][j];
+            sampler_.update(transitions_, i, j);
+        }
+    }
+
     void CooperativeMaximumLikelihoodModel::syncRow(size_t i, size_t j) {
         const auto & S = experience_.getS();
         const auto & vtable  = experience_.getVisitsTable();
@@ -68,6 +95,7 @@ namespace AIToolbox::Factored::MDP {
 
         tProbs[i].row(j) = vtable[i].row(j).head(S[i]).cast<double>() / totalVisits;
         rewards_[i][j] = rmatrix[i][j];
+        sampler_.update(transitions_, i, j);
     }
 
     std::tuple<State, double> CooperativeMaximumLikelihoodModel::sampleSR(const State & s, const Action & a) const {
@@ -123,6 +151,16 @@ namespace AIToolbox::Factored::MDP {
         getExpectedRewards(s, a, s1, rews);
     }
 
+    void CooperativeMaximumLikelihoodModel::sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const {
+        assert(rews);
+
+        sampler_.sample(transitions_, s, a, s1, rand_);
+
+        rews->resize(s.size());
+        for (size_t n = 0; n < s.size(); ++n)
+            (*rews)[n] = getExpectedReward(s[n], a[n], (*s1)[n]);
+    }
+
     double CooperativeMaximumLikelihoodModel::getTransitionProbability(const State & s, const Action & a, const State & s1) const {
         return transitions_.getTransitionProbability(s, a, s1);
     }
@@ -9,7 +9,7 @@ namespace AIToolbox::Factored::MDP {
             discount_(discount),
             graph_(std::move(graph)),
             transitions_({graph_, std::move(transitions)}), rewards_(std::move(rewards)),
-            rand_(Seeder::getSeed())
+            rand_(Seeder::getSeed()), sampler_(graph_)
     {
         // Now we validate both the transition function and the rewards.
         // The DDN graph we can already trust since it's a class and not a
@@ -79,13 +79,15 @@ namespace AIToolbox::Factored::MDP {
             if (r.values.rows() != static_cast<long>(factorSpacePartial(r.tag, S)))
                 throw std::invalid_argument("Input reward function base " + std::to_string(i) + " contains an incorrect number of rows!");
         }
+
+        sampler_.update(transitions_);
     }
 
     CooperativeModel::CooperativeModel(const CooperativeModel & other) :
             discount_(other.discount_),
             graph_(other.graph_),
             transitions_({graph_, other.transitions_.transitions}), rewards_(other.rewards_),
-            rand_(other.rand_)
+            rand_(other.rand_), sampler_(other.sampler_)
     {}
 
     std::tuple<State, double> CooperativeModel::sampleSR(const State & s, const Action & a) const {
@@ -151,6 +153,16 @@ namespace AIToolbox::Factored::MDP {
         }
     }
 
+    void CooperativeModel::sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const {
+        assert(rews);
+
+        sampler_.sample(transitions_, s, a, s1, rand_);
+
+        rews->resize(s.size());
+        for (size_t n = 0; n < s.size(); ++n)
+            (*rews)[n] = rewards_.getValue(graph_.getS(), graph_.getA(), s[n], a[n]);
+    }
+
     double CooperativeModel::getTransitionProbability(const State & s, const Action & a, const State & s1) const {
         return transitions_.getTransitionProbability(s, a, s1);
     }
@@ -4,7 +4,9 @@
 
 namespace AIToolbox::Factored::MDP {
     CooperativeThompsonModel::CooperativeThompsonModel(const CooperativeExperience & exp, const double discount)
-            : experience_(exp), discount_(discount), transitions_({experience_.getGraph(), {}})
+            : experience_(exp), discount_(discount), resampleVisits_(0), resampleStaleness_(0),
+              transitions_({experience_.getGraph(), {}}),
+              sampler_(experience_.getGraph())
     {
         const auto & S = experience_.getS();
         auto & tProbs = transitions_.transitions;
@@ -18,6 +20,9 @@ namespace AIToolbox::Factored::MDP {
 
             tProbs.emplace_back(d1, d2);
             rewards_.emplace_back(d1);
+
+            sampledVisits_.emplace_back(d1);
+            sampledTimesteps_.emplace_back(d1);
         }
         sync();
     }
@@ -38,7 +43,7 @@ namespace AIToolbox::Factored::MDP {
         for (size_t i = 0; i < S.size(); ++i) {
             const auto j = experience_.getGraph().getId(i, s, a);
 
-            syncRow(i, j);
+            lazySyncRow(i, j);
         }
     }
 
@@ -48,8 +53,20 @@ namespace AIToolbox::Factored::MDP {
         for (size_t i = 0; i < S.size(); ++i) {
             const auto j = indeces[i];
 
-            syncRow(i, j);
+            lazySyncRow(i, j);
+        }
+    }
+
+    void CooperativeThompsonModel::lazySyncRow(const size_t i, const size_t j) {
+        if (resampleVisits_ > 0) {
+            const auto visits = experience_.getVisitsTable()[i](j, experience_.getS()[i]);
+            const bool enough = visits - sampledVisits_[i][j] >= resampleVisits_;
+            const bool stale = resampleStaleness_ > 0 &&
+                               experience_.getTimesteps() - sampledTimesteps_[i][j] >= resampleStaleness_;
+
+            if (!enough && !stale) return;
         }
+        syncRow(i, j);
     }
 
     void CooperativeThompsonModel::syncRow(const size_t i, const size_t j) {
@@ -77,6 +94,9 @@ namespace AIToolbox::Factored::MDP {
             std::student_t_distribution<double> dist(totalVisits - 1);
             rewards_[i][j] = rmatrix[i][j] + dist(rand_) * std::sqrt(m2matrix[i][j] / (totalVisits * (totalVisits - 1)));
         }
+        sampledVisits_[i][j] = totalVisits;
+        sampledTimesteps_[i][j] = experience_.getTimesteps();
+        sampler_.update(transitions_, i, j);
     }
 
     std::tuple<State, double> CooperativeThompsonModel::sampleSR(const State & s, const Action & a) const {
@@ -132,6 +152,16 @@ namespace AIToolbox::Factored::MDP {
         getExpectedRewards(s, a, s1, rews);
     }
 
+    void CooperativeThompsonModel::sampleSRBatch(const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1, std::vector<double> * rews) const {
+        assert(rews);
+
+        sampler_.sample(transitions_, s, a, s1, rand_);
+
+        rews->resize(s.size());
+        for (size_t n = 0; n < s.size(); ++n)
+            (*rews)[n] = getExpectedReward(s[n], a[n], (*s1)[n]);
+    }
+
     double CooperativeThompsonModel::getTransitionProbability(const State & s, const Action & a, const State & s1) const {
         return transitions_.getTransitionProbability(s, a, s1);
     }
@@ -176,6 +206,11 @@ namespace AIToolbox::Factored::MDP {
     void CooperativeThompsonModel::setDiscount(const double d) { discount_ = d; }
     double CooperativeThompsonModel::getDiscount() const { return discount_; }
 
+    void CooperativeThompsonModel::setResampleVisits(const unsigned long visits) { resampleVisits_ = visits; }
+    unsigned long CooperativeThompsonModel::getResampleVisits() const { return resampleVisits_; }
+    void CooperativeThompsonModel::setResampleStaleness(const unsigned long timesteps) { resampleStaleness_ = timesteps; }
+    unsigned long CooperativeThompsonModel::getResampleStaleness() const { return resampleStaleness_; }
+
     const State & CooperativeThompsonModel::getS() const { return experience_.getS(); }
     const Action & CooperativeThompsonModel::getA() const { return experience_.getA(); }
     const CooperativeExperience & CooperativeThompsonModel::getExperience() const { return experience_; }
@@ -0,0 +1,225 @@
+#include <AIToolbox/Factored/MDP/StreamingCooperativeExperience.hpp>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace AIToolbox::Factored::MDP {
+    namespace {
+        // Past this weight for new events, all tables are rescaled so that
+        // the newest events have weight 1 again.
+        constexpr double MaxIncrement = 1e150;
+    }
+
+    StreamingCooperativeExperience::StreamingCooperativeExperience(const DDNGraph & graph, const double decay, const unsigned long window)
+            : graph_(graph), decay_(decay), window_(window), increment_(1.0), timesteps_(0), blockTimesteps_(0)
+    {
+        if (decay_ <= 0.0 || decay_ > 1.0)
+            throw std::invalid_argument("Decay must be in (0, 1]");
+        if (window_ && decay_ != 1.0)
+            throw std::invalid_argument("Exponential and windowed decay cannot be used together");
+
+        const auto & S = graph_.getS();
+
+        for (auto * b : {&current_, &previous_}) {
+            // The previous block is only needed with a window.
+            if (b == &previous_ && !window_) break;
+
+            b->visits.reserve(S.size());
+            b->rewards.reserve(S.size());
+            b->M2s.reserve(S.size());
+            for (size_t i = 0; i < S.size(); ++i) {
+                b->visits.emplace_back(graph_.getSize(i), S[i] + 1);
+                b->rewards.emplace_back(graph_.getSize(i));
+                b->M2s.emplace_back(graph_.getSize(i));
+            }
+            zero(*b);
+        }
+        indeces_.resize(S.size());
+    }
+
+    const StreamingCooperativeExperience::Indeces & StreamingCooperativeExperience::record(const State & s, const Action & a, const State & s1, const Rewards & rew) {
+        ++timesteps_;
+
+        if (window_) {
+            if (blockTimesteps_ == window_) {
+                std::swap(current_, previous_);
+                zero(current_);
+                blockTimesteps_ = 0;
+            }
+            ++blockTimesteps_;
+        } else if (decay_ < 1.0) {
+            // Rather than decaying all previous events, we make the new one
+            // weigh more.
+            increment_ /= decay_;
+            if (increment_ > MaxIncrement)
+                rescale();
+        }
+        const double w = increment_;
+
+        const auto & S = graph_.getS();
+        for (size_t i = 0; i < S.size(); ++i) {
+            auto & rNode = current_.rewards[i];
+            auto & mNode = current_.M2s[i];
+            auto & vNode = current_.visits[i];
+
+            const auto id = graph_.getId(i, s, a);
+
+            vNode(id, s1[i]) += w; // Single
+            vNode(id, S[i]) += w;  // Sum
+
+            updateWelford(vNode(id, S[i]), rNode(id), mNode(id), w, rew[i]);
+
+            indeces_[i] = id;
+        }
+        return indeces_;
+    }
+
+    void StreamingCooperativeExperience::merge(const StreamingCooperativeExperience & other) {
+        if (&graph_ != &other.graph_ || decay_ != other.decay_ || window_ != other.window_)
+            throw std::invalid_argument("Cannot merge StreamingCooperativeExperiences with different parameters");
+
+        // Bring the weights of the other instance to the scale of ours.
+        mergeBlock(current_, other.current_, increment_ / other.increment_);
+        if (window_) {
+            mergeBlock(previous_, other.previous_, 1.0);
+            blockTimesteps_ = std::max(blockTimesteps_, other.blockTimesteps_);
+        }
+        timesteps_ += other.timesteps_;
+    }
+
+    void StreamingCooperativeExperience::mergeBlock(Block & lhs, const Block & rhs, const double scale) {
+        for (size_t i = 0; i < lhs.visits.size(); ++i) {
+            auto & lv = lhs.visits[i];
+            const auto & rv = rhs.visits[i];
+            const auto sum = lv.cols() - 1;
+
+            for (int j = 0; j < lv.rows(); ++j) {
+                double n = lv(j, sum);
+                mergeWelford(n, lhs.rewards[i][j], lhs.M2s[i][j], rv(j, sum) * scale, rhs.rewards[i][j], rhs.M2s[i][j] * scale);
+            }
+            lv += rv * scale;
+        }
+    }
+
+    void StreamingCooperativeExperience::exportTo(CooperativeExperience * exp) const {
+        assert(exp);
+
+        const auto & S = graph_.getS();
+
+        CooperativeExperience::VisitsTable visits(S.size());
+        CooperativeExperience::RewardMatrix rewards(S.size()), M2s(S.size());
+
+        for (size_t i = 0; i < S.size(); ++i) {
+            const auto rows = graph_.getSize(i);
+
+            visits[i].resize(rows, S[i] + 1);
+            rewards[i].resize(rows);
+            M2s[i].resize(rows);
+
+            for (size_t j = 0; j < rows; ++j) {
+                unsigned long sum = 0;
+                size_t best = 0;
+                double bestVisits = 0.0;
+                for (size_t s1 = 0; s1 < S[i]; ++s1) {
+                    const double v = getVisits(i, j, s1);
+                    visits[i](j, s1) = std::llround(v);
+                    sum += visits[i](j, s1);
+                    if (v > bestVisits) {
+                        best = s1;
+                        bestVisits = v;
+                    }
+                }
+
+                double n, mean, m2;
+                getRow(i, j, &n, &mean, &m2);
+                // Rows that have been visited are never exported as unvisited.
+                if (sum == 0 && n > 0.0) {
+                    visits[i](j, best) = 1;
+                    sum = 1;
+                }
+                visits[i](j, S[i]) = sum;
+
+                if (sum == 0) {
+                    rewards[i][j] = 0.0;
+                    M2s[i][j] = 0.0;
+                } else {
+                    rewards[i][j] = mean;
+                    M2s[i][j] = m2 * (sum / n);
+                }
+            }
+        }
+        exp->setVisitsTable(visits);
+        exp->setRewardMatrix(rewards);
+        exp->setM2Matrix(M2s);
+        exp->setTimesteps(timesteps_);
+    }
+
+    void StreamingCooperativeExperience::reset() {
+        zero(current_);
+        if (window_) zero(previous_);
+
+        increment_ = 1.0;
+        timesteps_ = 0;
+        blockTimesteps_ = 0;
+    }
+
+    void StreamingCooperativeExperience::getRow(const size_t i, const size_t j, double * n, double * mean, double * m2) const {
+        const auto sum = graph_.getS()[i];
+
+        *n = current_.visits[i](j, sum);
+        *mean = current_.rewards[i][j];
+        *m2 = current_.M2s[i][j];
+
+        if (window_)
+            mergeWelford(*n, *mean, *m2, previous_.visits[i](j, sum), previous_.rewards[i][j], previous_.M2s[i][j]);
+
+        *n /= increment_;
+        *m2 /= increment_;
+    }
+
+    double StreamingCooperativeExperience::getVisits(const size_t i, const size_t j, const size_t s1) const {
+        double retval = current_.visits[i](j, s1);
+        if (window_) retval += previous_.visits[i](j, s1);
+        return retval / increment_;
+    }
+
+    double StreamingCooperativeExperience::getReward(const size_t i, const size_t j) const {
+        double n, mean, m2;
+        getRow(i, j, &n, &mean, &m2);
+        return mean;
+    }
+
+    double StreamingCooperativeExperience::getM2(const size_t i, const size_t j) const {
+        double n, mean, m2;
+        getRow(i, j, &n, &mean, &m2);
+        return m2;
+    }
+
+    void StreamingCooperativeExperience::rescale() {
+        const double scale = 1.0 / increment_;
+        for (size_t i = 0; i < current_.visits.size(); ++i) {
+            current_.visits[i] *= scale;
+            current_.M2s[i] *= scale;
+        }
+        increment_ = 1.0;
+    }
+
+    void StreamingCooperativeExperience::zero(Block & b) const {
+        for (size_t i = 0; i < b.visits.size(); ++i) {
+            b.visits[i].setZero();
+            b.rewards[i].setZero();
+            b.M2s[i].setZero();
+        }
+    }
+
+    unsigned long StreamingCooperativeExperience::getTimesteps() const { return timesteps_; }
+    double StreamingCooperativeExperience::getDecay() const { return decay_; }
+    unsigned long StreamingCooperativeExperience::getWindow() const { return window_; }
+
+    const State & StreamingCooperativeExperience::getS() const { return graph_.getS(); }
+    const Action & StreamingCooperativeExperience::getA() const { return graph_.getA(); }
+    const DDNGraph & StreamingCooperativeExperience::getGraph() const { return graph_; }
+}
@@ -8,6 +8,8 @@ namespace AIToolbox::Factored {
     DDNGraph::DynamicDecisionNetworkGraph(State SS, Action AA) : S(std::move(SS)), A(std::move(AA)) {
         parents_.reserve(S.size());
         startIds_.reserve(S.size());
+        agentStrides_.reserve(S.size());
+        featureStrides_.reserve(S.size());
     }
 
     void DDNGraph::push(ParentSet parents) {
@@ -67,6 +69,24 @@ namespace AIToolbox::Factored {
         // Save overall length needed to store one element per parent
         // set for this node.
         newStartIds.back() = newStartId;
+
+        // Precompute the multiplier of each parent, so that ids for full
+        // states and actions are simple dot products.
+        const auto makeStrides = [](const PartialKeys & keys, const Factors & space) {
+            Strides strides;
+            strides.reserve(keys.size());
+            size_t multiplier = 1;
+            for (const auto k : keys) {
+                strides.emplace_back(k, multiplier);
+                multiplier *= space[k];
+            }
+            return strides;
+        };
+        agentStrides_.emplace_back(makeStrides(newParents.agents, A));
+        auto & newFeatureStrides = featureStrides_.emplace_back();
+        newFeatureStrides.reserve(newParents.features.size());
+        for (const auto & features : newParents.features)
+            newFeatureStrides.emplace_back(makeStrides(features, S));
     }
 
     // ID CODE
@@ -92,9 +112,13 @@ namespace AIToolbox::Factored {
     }
 
     std::pair<size_t, size_t> DDNGraph::getIds(const size_t feature, const State & s, const Action & a) const {
-        const auto actionId = toIndexPartial(parents_[feature].agents, A, a);
-        const auto & features = parents_[feature].features[actionId];
-        const auto parentId = toIndexPartial(features, S, s);
+        size_t actionId = 0;
+        for (const auto & [k, m] : agentStrides_[feature])
+            actionId += a[k] * m;
+
+        size_t parentId = 0;
+        for (const auto & [k, m] : featureStrides_[feature][actionId])
+            parentId += s[k] * m;
 
         return {parentId, actionId};
     }
@@ -0,0 +1,52 @@
+#include <AIToolbox/Factored/Utils/DDNSampler.hpp>
+
+#include <AIToolbox/Utils/Probability.hpp>
+
+namespace AIToolbox::Factored {
+    DDNSampler::DDNSampler(const DDNGraph & graph) {
+        const auto & S = graph.getS();
+        tables_.reserve(S.size());
+        for (size_t i = 0; i < S.size(); ++i) {
+            const double scale = S[i] / (static_cast<double>(RandomEngine::max()) + 1.0);
+            tables_.push_back({S[i], scale, std::vector<Coin>(graph.getSize(i) * S[i])});
+        }
+    }
+
+    DDNSampler::DDNSampler(const DDN & ddn) : DDNSampler(ddn.graph) {
+        update(ddn);
+    }
+
+    void DDNSampler::update(const DDN & ddn, const size_t i, const size_t j) {
+        auto & t = tables_[i];
+
+        std::vector<double> prob(t.size);
+        std::vector<size_t> alias(t.size);
+        buildAliasTable(ddn.transitions[i].row(j).transpose(), prob.data(), alias.data());
+
+        auto row = t.coins.data() + j * t.size;
+        for (size_t x = 0; x < t.size; ++x)
+            row[x] = {prob[x], alias[x]};
+    }
+
+    void DDNSampler::sample(const DDN & ddn, const std::vector<State> & s, const std::vector<Action> & a, std::vector<State> * s1p, RandomEngine & rnd) const {
+        assert(s1p);
+        assert(s.size() == a.size());
+
+        const auto & graph = ddn.graph;
+        const auto F = graph.getS().size();
+        auto & s1 = *s1p;
+
+        s1.resize(s.size());
+        for (size_t n = 0; n < s.size(); ++n) {
+            s1[n].resize(F);
+            for (size_t i = 0; i < F; ++i)
+                s1[n][i] = sample(ddn, i, graph.getId(i, s[n], a[n]), rnd);
+        }
+    }
+
+    void DDNSampler::update(const DDN & ddn) {
+        for (size_t i = 0; i < tables_.size(); ++i)
+            for (size_t j = 0; j < ddn.graph.getSize(i); ++j)
+                update(ddn, i, j);
+    }
+}
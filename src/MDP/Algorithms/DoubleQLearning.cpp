@@ -1,16 +1,18 @@
 #include <AIToolbox/MDP/Algorithms/DoubleQLearning.hpp>
 
 namespace AIToolbox::MDP {
-    DoubleQLearning::DoubleQLearning(const size_t ss, const size_t aa, const double discount, const double alpha) :
+    template <typename T>
+    DoubleQLearningT<T>::DoubleQLearningT(const size_t ss, const size_t aa, const double discount, const double alpha) :
             S(ss), A(aa), discount_(discount), dist_(0.5),
-            qa_(makeQFunction(S, A)),
-            qc_(makeQFunction(S, A))
+            qa_(QFunctionT<T>::Zero(S, A)),
+            qc_(QFunctionT<T>::Zero(S, A))
     {
         setDiscount(discount);
         setLearningRate(alpha);
     }
 
-    void DoubleQLearning::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const double rew) {
+    template <typename T>
+    void DoubleQLearningT<T>::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const double rew) {
         size_t a1;
 
         if (dist_(rand_)) {
@@ -24,30 +26,43 @@ namespace AIToolbox::MDP {
         }
     }
 
-    void DoubleQLearning::setLearningRate(const double a) {
+    template <typename T>
+    void DoubleQLearningT<T>::setLearningRate(const double a) {
         if ( a <= 0.0 || a > 1.0 ) throw std::invalid_argument("Learning rate parameter must be in (0,1]");
         alpha_ = a;
     }
 
-    double DoubleQLearning::getLearningRate() const { return alpha_; }
+    template <typename T>
+    double DoubleQLearningT<T>::getLearningRate() const { return alpha_; }
 
-    void DoubleQLearning::setDiscount(const double d) {
+    template <typename T>
+    void DoubleQLearningT<T>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
     }
 
-    double DoubleQLearning::getDiscount() const { return discount_; }
+    template <typename T>
+    double DoubleQLearningT<T>::getDiscount() const { return discount_; }
 
-    size_t DoubleQLearning::getS() const { return S; }
-    size_t DoubleQLearning::getA() const { return A; }
+    template <typename T>
+    size_t DoubleQLearningT<T>::getS() const { return S; }
+    template <typename T>
+    size_t DoubleQLearningT<T>::getA() const { return A; }
 
-    const QFunction & DoubleQLearning::getQFunction() const { return qc_; }
-    const QFunction & DoubleQLearning::getQFunctionA() const { return qa_; }
-    QFunction DoubleQLearning::getQFunctionB() const { return qc_ - qa_; }
-    void DoubleQLearning::setQFunction(const QFunction & qfun) {
+    template <typename T>
+    const QFunctionT<T> & DoubleQLearningT<T>::getQFunction() const { return qc_; }
+    template <typename T>
+    const QFunctionT<T> & DoubleQLearningT<T>::getQFunctionA() const { return qa_; }
+    template <typename T>
+    QFunctionT<T> DoubleQLearningT<T>::getQFunctionB() const { return qc_ - qa_; }
+    template <typename T>
+    void DoubleQLearningT<T>::setQFunction(const QFunctionT<T> & qfun) {
         assert(qc_.rows() == qfun.rows());
         assert(qc_.cols() == qfun.cols());
         qa_ = qfun;
         qc_ = qfun * 2;
     }
+
+    template class DoubleQLearningT<double>;
+    template class DoubleQLearningT<float>;
 }
@@ -1,8 +1,9 @@
 #include <AIToolbox/MDP/Algorithms/SARSAL.hpp>
 
 namespace AIToolbox::MDP {
-    SARSAL::SARSAL(const size_t ss, const size_t aa, const double discount, const double alpha, const double lambda, const double tolerance) :
-            S(ss), A(aa), q_(makeQFunction(S, A))
+    template <typename T>
+    SARSALT<T>::SARSALT(const size_t ss, const size_t aa, const double discount, const double alpha, const double lambda, const double tolerance) :
+            S(ss), A(aa), q_(QFunctionT<T>::Zero(S, A))
     {
         setDiscount(discount);
         setLearningRate(alpha);
@@ -10,7 +11,8 @@ namespace AIToolbox::MDP {
         setTolerance(tolerance);
     }
 
-    void SARSAL::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const size_t a1, const double rew) {
+    template <typename T>
+    void SARSALT<T>::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const size_t a1, const double rew) {
         const auto error = alpha_ * ( rew + discount_ * q_(s1, a1) - q_(s, a) );
         bool newTrace = true;
 
@@ -47,59 +49,77 @@ namespace AIToolbox::MDP {
         }
     }
 
-    void SARSAL::clearTraces() {
+    template <typename T>
+    void SARSALT<T>::clearTraces() {
         traces_.clear();
     }
 
-    const SARSAL::Traces & SARSAL::getTraces() const {
+    template <typename T>
+    const typename SARSALT<T>::Traces & SARSALT<T>::getTraces() const {
         return traces_;
     }
 
-    void SARSAL::setTraces(const Traces & t) {
+    template <typename T>
+    void SARSALT<T>::setTraces(const Traces & t) {
         traces_ = t;
     }
 
-    void SARSAL::setLearningRate(const double a) {
+    template <typename T>
+    void SARSALT<T>::setLearningRate(const double a) {
         if ( a <= 0.0 || a > 1.0 ) throw std::invalid_argument("Learning rate parameter must be in (0,1]");
         alpha_ = a;
     }
 
-    double SARSAL::getLearningRate() const { return alpha_; }
+    template <typename T>
+    double SARSALT<T>::getLearningRate() const { return alpha_; }
 
-    void SARSAL::setDiscount(const double d) {
+    template <typename T>
+    void SARSALT<T>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
         gammaL_ = lambda_ * discount_;
     }
 
-    double SARSAL::getDiscount() const { return discount_; }
+    template <typename T>
+    double SARSALT<T>::getDiscount() const { return discount_; }
 
-    void SARSAL::setLambda(const double lambda) {
+    template <typename T>
+    void SARSALT<T>::setLambda(const double lambda) {
         if ( lambda < 0.0 || lambda > 1.0 ) throw std::invalid_argument("Lambda parameter must be in [0,1]");
 
         lambda_ = lambda;
         gammaL_ = lambda_ * discount_;
     }
 
-    double SARSAL::getLambda() const {
+    template <typename T>
+    double SARSALT<T>::getLambda() const {
         return lambda_;
     }
 
-    void SARSAL::setTolerance(const double tolerance) {
+    template <typename T>
+    void SARSALT<T>::setTolerance(const double tolerance) {
         tolerance_ = tolerance;
     }
 
-    double SARSAL::getTolerance() const {
+    template <typename T>
+    double SARSALT<T>::getTolerance() const {
         return tolerance_;
     }
 
-    size_t SARSAL::getS() const { return S; }
-    size_t SARSAL::getA() const { return A; }
+    template <typename T>
+    size_t SARSALT<T>::getS() const { return S; }
+    template <typename T>
+    size_t SARSALT<T>::getA() const { return A; }
 
-    const QFunction & SARSAL::getQFunction() const { return q_; }
-    void SARSAL::setQFunction(const QFunction & qfun) { 
+    template <typename T>
+    const QFunctionT<T> & SARSALT<T>::getQFunction() const { return q_; }
+    template <typename T>
+    void SARSALT<T>::setQFunction(const QFunctionT<T> & qfun) { 
         assert(q_.rows() == qfun.rows());
         assert(q_.cols() == qfun.cols());
         q_ = qfun; 
     }
+
+    template class SARSALT<double>;
+    template class SARSALT<float>;
 }
@@ -25,4 +25,6 @@ namespace AIToolbox::MDP {
     unsigned ValueIteration::getHorizon() const { return horizon_; }
 
     const ValueFunction & ValueIteration::getValueFunction() const { return vParameter_; }
+
+    const SolverStatistics & ValueIteration::getStatistics() const { return stats_; }
 }
@@ -0,0 +1,71 @@
+#ifndef AI_TOOLBOX_MDP_COALESCED_EVENTS_HEADER_FILE
+#define AI_TOOLBOX_MDP_COALESCED_EVENTS_HEADER_FILE
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This struct contains the combined statistics of the buffered events of a state-action pair.
+     *
+     * The visits of each new state of the pair are stored in a separate
+     * vector, in the range [begin, end).
+     */
+    struct CoalescedPair {
+        size_t s, a;
+        unsigned long n;
+        double mean, m2;
+        size_t begin, end;
+    };
+
+    /**
+     * @brief This struct contains the number of buffered events of a transition.
+     */
+    struct CoalescedTransition {
+        size_t s1;
+        unsigned long visits;
+    };
+
+    /**
+     * @brief This function combines buffered events, so that they can be applied once per state-action pair.
+     *
+     * The rewards of each pair are combined with Welford's algorithm, so
+     * that they can be merged into the shared statistics with
+     * mergeWelford().
+     *
+     * The events are sorted in the process.
+     *
+     * @param events The events to combine; each must have s, a, s1 and rew fields.
+     * @param pairs The output statistics for each state-action pair.
+     * @param transitions The output visits for each transition.
+     */
+    template <typename Event>
+    void coalesceEvents(std::vector<Event> & events, std::vector<CoalescedPair> & pairs, std::vector<CoalescedTransition> & transitions) {
+        pairs.clear();
+        transitions.clear();
+
+        std::sort(std::begin(events), std::end(events), [](const Event & lhs, const Event & rhs) {
+            return std::tie(lhs.s, lhs.a, lhs.s1) < std::tie(rhs.s, rhs.a, rhs.s1);
+        });
+
+        for (const auto & e : events) {
+            if (pairs.empty() || pairs.back().s != e.s || pairs.back().a != e.a)
+                pairs.push_back({e.s, e.a, 0, 0.0, 0.0, transitions.size(), transitions.size()});
+
+            auto & p = pairs.back();
+            if (p.end == p.begin || transitions.back().s1 != e.s1) {
+                transitions.push_back({e.s1, 0});
+                ++p.end;
+            }
+            ++transitions.back().visits;
+
+            ++p.n;
+            updateWelford(p.n, p.mean, p.m2, 1.0, e.rew);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include <AIToolbox/MDP/ConcurrentExperience.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+#include "CoalescedEvents.hpp"
+
+namespace AIToolbox::MDP {
+    ConcurrentExperience::Buffer::Buffer(ConcurrentExperience & exp, const size_t batchSize) :
+            exp_(&exp), batchSize_(std::max(batchSize, size_t(1)))
+    {
+        events_.reserve(batchSize_);
+    }
+
+    ConcurrentExperience::Buffer::~Buffer() {
+        flush();
+    }
+
+    void ConcurrentExperience::Buffer::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        events_.push_back({s, a, s1, rew});
+        if (events_.size() >= batchSize_)
+            flush();
+    }
+
+    void ConcurrentExperience::Buffer::flush() {
+        if (events_.empty()) return;
+
+        std::vector<CoalescedPair> pairs;
+        std::vector<CoalescedTransition> transitions;
+        coalesceEvents(events_, pairs, transitions);
+
+        auto & exp = *exp_;
+        const auto S = exp.S, A = exp.A;
+
+        exp.beginWrite();
+        for (const auto & p : pairs) {
+            for (size_t i = p.begin; i < p.end; ++i)
+                exp.visits_[(p.a * S + p.s) * S + transitions[i].s1].fetch_add(transitions[i].visits, std::memory_order_relaxed);
+
+            const auto id = p.s * A + p.a;
+            exp.lockPair(id);
+
+            double n = exp.visitsSum_[id].load(std::memory_order_relaxed);
+            auto & r = exp.rewards_[id];
+            mergeWelford(n, r.mean, r.m2, p.n, p.mean, p.m2);
+            exp.visitsSum_[id].fetch_add(p.n, std::memory_order_relaxed);
+
+            exp.unlockPair(id);
+        }
+        exp.timesteps_.fetch_add(events_.size(), std::memory_order_relaxed);
+        exp.endWrite();
+
+        events_.clear();
+    }
+
+    size_t ConcurrentExperience::Buffer::size() const {
+        return events_.size();
+    }
+
+    ConcurrentExperience::ConcurrentExperience(const size_t s, const size_t a) :
+            S(s), A(a), visits_(S * A * S), visitsSum_(S * A),
+            rewards_(S * A), locks_(S * A), timesteps_(0),
+            pausing_(false), writers_(0),
+            visitsBuffer_(A, Table2D(S, S)), rewardsBuffer_(S, A), M2sBuffer_(S, A)
+    {
+        reset();
+    }
+
+    ConcurrentExperience::Buffer ConcurrentExperience::makeBuffer(const size_t batchSize) {
+        return Buffer(*this, batchSize);
+    }
+
+    void ConcurrentExperience::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        beginWrite();
+
+        const auto id = s * A + a;
+
+        visits_[(a * S + s) * S + s1].fetch_add(1, std::memory_order_relaxed);
+
+        lockPair(id);
+        const auto n = visitsSum_[id].fetch_add(1, std::memory_order_relaxed) + 1;
+        auto & r = rewards_[id];
+        updateWelford(n, r.mean, r.m2, 1.0, rew);
+        unlockPair(id);
+
+        timesteps_.fetch_add(1, std::memory_order_relaxed);
+
+        endWrite();
+    }
+
+    void ConcurrentExperience::beginWrite() {
+        // Register as a writer, unless a snapshot is being taken. Both this
+        // and the snapshot use sequentially consistent operations on the
+        // two flags, so at least one of them sees the other.
+        while (true) {
+            writers_.fetch_add(1);
+            if (!pausing_.load()) break;
+            writers_.fetch_sub(1);
+            pausing_.wait(true);
+        }
+    }
+
+    void ConcurrentExperience::endWrite() {
+        writers_.fetch_sub(1, std::memory_order_release);
+    }
+
+    void ConcurrentExperience::lockPair(const size_t id) const {
+        // Updates of a pair are a handful of operations, so we just spin.
+        while (locks_[id].test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    void ConcurrentExperience::unlockPair(const size_t id) const {
+        locks_[id].clear(std::memory_order_release);
+    }
+
+    void ConcurrentExperience::snapshot(Experience * exp) {
+        assert(exp);
+        assert(exp->getS() == S && exp->getA() == A);
+
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+
+        // Stop new writers, and wait for the current ones to finish.
+        pausing_.store(true);
+        while (writers_.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+
+        for (size_t a = 0; a < A; ++a)
+            for (size_t s = 0; s < S; ++s)
+                for (size_t s1 = 0; s1 < S; ++s1)
+                    visitsBuffer_[a](s, s1) = visits_[(a * S + s) * S + s1].load(std::memory_order_relaxed);
+
+        // No writer is active, so the rewards can be read without locking.
+        for (size_t s = 0; s < S; ++s) {
+            for (size_t a = 0; a < A; ++a) {
+                const auto & r = rewards_[s * A + a];
+                rewardsBuffer_(s, a) = r.mean;
+                M2sBuffer_(s, a) = r.m2;
+            }
+        }
+        const auto timesteps = timesteps_.load(std::memory_order_relaxed);
+
+        pausing_.store(false);
+        pausing_.notify_all();
+
+        exp->setVisitsTable(visitsBuffer_);
+        exp->setRewardMatrix(rewardsBuffer_);
+        exp->setM2Matrix(M2sBuffer_);
+        exp->setTimesteps(timesteps);
+    }
+
+    void ConcurrentExperience::reset() {
+        for (auto & v : visits_) v.store(0, std::memory_order_relaxed);
+        for (auto & v : visitsSum_) v.store(0, std::memory_order_relaxed);
+        std::fill(std::begin(rewards_), std::end(rewards_), Rewards{0.0, 0.0});
+        timesteps_.store(0);
+    }
+
+    unsigned long ConcurrentExperience::getTimesteps() const {
+        return timesteps_.load(std::memory_order_relaxed);
+    }
+
+    unsigned long ConcurrentExperience::getVisits(const size_t s, const size_t a, const size_t s1) const {
+        return visits_[(a * S + s) * S + s1].load(std::memory_order_relaxed);
+    }
+
+    unsigned long ConcurrentExperience::getVisitsSum(const size_t s, const size_t a) const {
+        return visitsSum_[s * A + a].load(std::memory_order_relaxed);
+    }
+
+    double ConcurrentExperience::getReward(const size_t s, const size_t a) const {
+        const auto id = s * A + a;
+        lockPair(id);
+        const auto retval = rewards_[id].mean;
+        unlockPair(id);
+        return retval;
+    }
+
+    double ConcurrentExperience::getM2(const size_t s, const size_t a) const {
+        const auto id = s * A + a;
+        lockPair(id);
+        const auto retval = rewards_[id].m2;
+        unlockPair(id);
+        return retval;
+    }
+
+    size_t ConcurrentExperience::getS() const { return S; }
+    size_t ConcurrentExperience::getA() const { return A; }
+}
@@ -0,0 +1,90 @@
+#include <AIToolbox/MDP/ConcurrentSparseExperience.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+#include "CoalescedEvents.hpp"
+
+namespace AIToolbox::MDP {
+    ConcurrentSparseExperience::Buffer::Buffer(ConcurrentSparseExperience & exp, const size_t batchSize) :
+            exp_(&exp), batchSize_(std::max(batchSize, size_t(1)))
+    {
+        events_.reserve(batchSize_);
+    }
+
+    ConcurrentSparseExperience::Buffer::~Buffer() {
+        flush();
+    }
+
+    void ConcurrentSparseExperience::Buffer::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        events_.push_back({s, a, s1, rew});
+        if (events_.size() >= batchSize_)
+            flush();
+    }
+
+    void ConcurrentSparseExperience::Buffer::flush() {
+        if (events_.empty()) return;
+
+        // We combine the events outside the lock, so that under it we only
+        // touch each state-action pair once.
+        std::vector<CoalescedPair> pairs;
+        std::vector<CoalescedTransition> transitions;
+        coalesceEvents(events_, pairs, transitions);
+
+        {
+            std::lock_guard<std::mutex> lock(exp_->mutex_);
+            auto & exp = exp_->exp_;
+
+            for (const auto & p : pairs) {
+                for (size_t i = p.begin; i < p.end; ++i)
+                    exp.visits_[p.a].coeffRef(p.s, transitions[i].s1) += transitions[i].visits;
+
+                auto & visitsSum = exp.visitsSum_.coeffRef(p.s, p.a);
+                double n = visitsSum;
+                mergeWelford(n, exp.rewards_.coeffRef(p.s, p.a), exp.M2s_.coeffRef(p.s, p.a), p.n, p.mean, p.m2);
+                visitsSum += p.n;
+            }
+            exp.timesteps_ += events_.size();
+        }
+        events_.clear();
+    }
+
+    size_t ConcurrentSparseExperience::Buffer::size() const {
+        return events_.size();
+    }
+
+    ConcurrentSparseExperience::ConcurrentSparseExperience(const size_t S, const size_t A) :
+            exp_(S, A) {}
+
+    ConcurrentSparseExperience::Buffer ConcurrentSparseExperience::makeBuffer(const size_t batchSize) {
+        return Buffer(*this, batchSize);
+    }
+
+    void ConcurrentSparseExperience::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exp_.record(s, a, s1, rew);
+    }
+
+    void ConcurrentSparseExperience::snapshot(SparseExperience * exp) const {
+        assert(exp);
+        assert(exp->getS() == exp_.getS() && exp->getA() == exp_.getA());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        *exp = exp_;
+    }
+
+    void ConcurrentSparseExperience::reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exp_.reset();
+    }
+
+    unsigned long ConcurrentSparseExperience::getTimesteps() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return exp_.getTimesteps();
+    }
+
+    size_t ConcurrentSparseExperience::getS() const { return exp_.getS(); }
+    size_t ConcurrentSparseExperience::getA() const { return exp_.getA(); }
+}
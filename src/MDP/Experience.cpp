@@ -48,6 +48,10 @@ namespace AIToolbox::MDP {
         M2s_ = mm;
     }
 
+    void Experience::setTimesteps(const unsigned long t) {
+        timesteps_ = t;
+    }
+
     unsigned long Experience::getTimesteps() const {
         return timesteps_;
     }
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include <AIToolbox/Utils/IO.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
 
 #include <AIToolbox/MDP/Experience.hpp>
 #include <AIToolbox/MDP/SparseExperience.hpp>
@@ -22,6 +23,22 @@ namespace AIToolbox::MDP {
         return Model(S, A, T, R, discount);
     }
 
+    SparseModel parseCassandraSparse(const std::string & filename, const unsigned threads) {
+        const MappedFile file(filename);
+        CassandraParser parser;
+
+        auto [S, A, T, R, discount] = parser.parseSparseMDP(file.getData(), threads);
+
+        if (!isProbability(T))
+            throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
+
+        SparseModel model(NO_CHECK, S, A, std::move(T), std::move(R), discount);
+        // This validates the discount, which the unchecked constructor does not.
+        model.setDiscount(discount);
+
+        return model;
+    }
+
     std::ostream & operator<<(std::ostream & os, const Experience & exp) {
         os << exp.getTimesteps() << '\n';
         write(os, exp.getVisitsTable());
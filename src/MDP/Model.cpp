@@ -1,14 +1,16 @@
 #include <AIToolbox/MDP/Model.hpp>
 
 namespace AIToolbox::MDP {
-    Model::Model(NoCheck, const size_t s, const size_t a, TransitionMatrix && t, RewardMatrix && r, const double d) :
+    template <typename T>
+    ModelT<T>::ModelT(NoCheck, const size_t s, const size_t a, TransitionMatrix && t, RewardMatrix && r, const double d) :
             S(s), A(a), discount_(d),
             transitions_(std::move(t)),
             rewards_(std::move(r)),
             rand_(Seeder::getSeed()) {}
 
-    Model::Model(const size_t s, const size_t a, const double discount) :
-            S(s), A(a), discount_(discount), transitions_(A, Matrix2D(S, S)),
+    template <typename T>
+    ModelT<T>::ModelT(const size_t s, const size_t a, const double discount) :
+            S(s), A(a), discount_(discount), transitions_(A, Matrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         // Make transition matrix true probability
@@ -18,7 +20,8 @@ namespace AIToolbox::MDP {
         rewards_.setZero();
     }
 
-    void Model::setTransitionFunction(const Matrix3D & t) {
+    template <typename T>
+    void ModelT<T>::setTransitionFunction(const TransitionMatrix & t) {
         if (!isProbability(t))
             throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
 
@@ -26,42 +29,62 @@ namespace AIToolbox::MDP {
         transitions_ = t;
     }
 
-    void Model::setRewardFunction(const RewardMatrix & r) {
+    template <typename T>
+    void ModelT<T>::setRewardFunction(const RewardMatrix & r) {
         rewards_ = r;
     }
 
-    std::tuple<size_t, double> Model::sampleSR(const size_t s, const size_t a) const {
-        size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
+    template <typename T>
+    std::tuple<size_t, double> ModelT<T>::sampleSR(const size_t s, const size_t a) const {
+        return sampleSR(s, a, rand_);
+    }
+
+    template <typename T>
+    std::tuple<size_t, double> ModelT<T>::sampleSR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        size_t s1 = sampleProbability(S, transitions_[a].row(s), rnd);
 
         return std::make_tuple(s1, rewards_(s, a));
     }
 
-    double Model::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+    template <typename T>
+    double ModelT<T>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
         return transitions_[a](s, s1);
     }
 
-    double Model::getExpectedReward(const size_t s, const size_t a, const size_t) const {
+    template <typename T>
+    double ModelT<T>::getExpectedReward(const size_t s, const size_t a, const size_t) const {
         return rewards_(s, a);
     }
 
-    void Model::setDiscount(const double d) {
+    template <typename T>
+    void ModelT<T>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
     }
 
-    bool Model::isTerminal(const size_t s) const {
+    template <typename T>
+    bool ModelT<T>::isTerminal(const size_t s) const {
         for ( size_t a = 0; a < A; ++a )
             if ( !checkEqualSmall(1.0, transitions_[a](s, s)) )
                 return false;
         return true;
     }
 
-    size_t Model::getS() const { return S; }
-    size_t Model::getA() const { return A; }
-    double Model::getDiscount() const { return discount_; }
+    template <typename T>
+    size_t ModelT<T>::getS() const { return S; }
+    template <typename T>
+    size_t ModelT<T>::getA() const { return A; }
+    template <typename T>
+    double ModelT<T>::getDiscount() const { return discount_; }
+
+    template <typename T>
+    const typename ModelT<T>::TransitionMatrix & ModelT<T>::getTransitionFunction() const { return transitions_; }
+    template <typename T>
+    const typename ModelT<T>::RewardMatrix &     ModelT<T>::getRewardFunction()     const { return rewards_; }
 
-    const Model::TransitionMatrix & Model::getTransitionFunction() const { return transitions_; }
-    const Model::RewardMatrix &     Model::getRewardFunction()     const { return rewards_; }
+    template <typename T>
+    const Matrix2DT<T> & ModelT<T>::getTransitionFunction(const size_t a) const { return transitions_[a]; }
 
-    const Matrix2D & Model::getTransitionFunction(const size_t a) const { return transitions_[a]; }
+    template class ModelT<double>;
+    template class ModelT<float>;
 }
@@ -2,17 +2,27 @@
 
 namespace AIToolbox::MDP {
     EpsilonPolicy::EpsilonPolicy(const PolicyInterface & p, double epsilon) :
-            PolicyInterface::Base(p.getS(), p.getA()), EpsilonBase(p, epsilon),
-            randomDistribution_(0, this->A-1) {}
+            PolicyInterface::Base(p.getS(), p.getA()), EpsilonBase(p, epsilon) {}
 
-    size_t EpsilonPolicy::sampleRandomAction() const {
-        return randomDistribution_(rand_);
+    size_t EpsilonPolicy::sampleRandomAction(RandomEngine & rnd) const {
+        // We don't store the distribution so that this can be called concurrently.
+        return std::uniform_int_distribution<size_t>(0, A-1)(rnd);
     }
 
     double EpsilonPolicy::getRandomActionProbability() const {
         return 1.0 / A;
     }
 
+    Matrix2D EpsilonPolicy::getActionProbabilities(std::span<const size_t> states) const {
+        const auto & wrapped = dynamic_cast<const PolicyInterface &>(policy_);
+        auto p = wrapped.getActionProbabilities(states);
+
+        p *= (1.0 - epsilon_);
+        p.array() += epsilon_ / A;
+
+        return p;
+    }
+
     Matrix2D EpsilonPolicy::getPolicy() const {
         const auto & wrapped = dynamic_cast<const PolicyInterface &>(policy_);
         auto p = wrapped.getPolicy();
@@ -13,10 +13,25 @@ namespace AIToolbox::MDP {
         return sampleProbability(A, policy_.row(s), rand_);
     }
 
+    size_t PolicyWrapper::sampleAction(const size_t & s, RandomEngine & rnd) const {
+        return sampleProbability(A, policy_.row(s), rnd);
+    }
+
     double PolicyWrapper::getActionProbability(const size_t & s, const size_t & a) const {
         return policy_(s, a);
     }
 
+    void PolicyWrapper::sampleActions(std::span<const size_t> states, std::span<size_t> out) const {
+        if (states.size() != out.size()) throw std::invalid_argument("Input and output sizes of sampleActions differ");
+
+        for (size_t i = 0; i < states.size(); ++i)
+            out[i] = sampleProbability(A, policy_.row(states[i]), rand_);
+    }
+
+    Matrix2D PolicyWrapper::getActionProbabilities(std::span<const size_t> states) const {
+        return policy_(states, Eigen::all);
+    }
+
     const PolicyWrapper::PolicyMatrix & PolicyWrapper::getPolicyMatrix() const {
         return policy_;
     }
@@ -11,11 +11,37 @@ namespace AIToolbox::MDP {
         return wrap.sampleAction();
     }
 
+    size_t QGreedyPolicy::sampleAction(const size_t & s, RandomEngine & rnd) const {
+        std::vector<size_t> bestActions(A);
+        auto wrap = Bandit::QGreedyPolicyWrapper(q_.row(s), bestActions, rnd);
+        return wrap.sampleAction();
+    }
+
     double QGreedyPolicy::getActionProbability(const size_t & s, const size_t & a) const {
         auto wrap = Bandit::QGreedyPolicyWrapper(q_.row(s), bestActions_, rand_);
         return wrap.getActionProbability(a);
     }
 
+    void QGreedyPolicy::sampleActions(std::span<const size_t> states, std::span<size_t> out) const {
+        if (states.size() != out.size()) throw std::invalid_argument("Input and output sizes of sampleActions differ");
+
+        for (size_t i = 0; i < states.size(); ++i) {
+            auto wrap = Bandit::QGreedyPolicyWrapper(q_.row(states[i]), bestActions_, rand_);
+            out[i] = wrap.sampleAction();
+        }
+    }
+
+    Matrix2D QGreedyPolicy::getActionProbabilities(std::span<const size_t> states) const {
+        Matrix2D retval(states.size(), A);
+
+        for (size_t i = 0; i < states.size(); ++i) {
+            auto wrap = Bandit::QGreedyPolicyWrapper(q_.row(states[i]), bestActions_, rand_);
+            wrap.getPolicy(retval.row(i));
+        }
+
+        return retval;
+    }
+
     Matrix2D QGreedyPolicy::getPolicy() const {
         Matrix2D retval(S, A);
 
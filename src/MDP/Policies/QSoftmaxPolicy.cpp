@@ -15,22 +15,65 @@ namespace AIToolbox::MDP {
         return wrap.sampleAction();
     }
 
+    size_t QSoftmaxPolicy::sampleAction(const size_t & s, RandomEngine & rnd) const {
+        std::vector<size_t> bestActions(A);
+        Vector vbuffer(A);
+        auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(s), vbuffer, bestActions, rnd);
+        return wrap.sampleAction();
+    }
+
     double QSoftmaxPolicy::getActionProbability(const size_t & s, const size_t & a) const {
-        auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(s), vbuffer_, bestActions_, rand_);
+        // The wrapper writes to its buffers, so we use local ones to keep
+        // this function safe to call concurrently.
+        std::vector<size_t> bestActions(A);
+        Vector vbuffer(A);
+        auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(s), vbuffer, bestActions, rand_);
         return wrap.getActionProbability(a);
     }
 
     Matrix2D QSoftmaxPolicy::getPolicy() const {
         Matrix2D retval(S, A);
 
+        std::vector<size_t> bestActions(A);
+        Vector vbuffer(A);
         for (size_t s = 0; s < S; ++s) {
-            auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(s), vbuffer_, bestActions_, rand_);
+            auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(s), vbuffer, bestActions, rand_);
             wrap.getPolicy(retval.row(s));
         }
 
         return retval;
     }
 
+    void QSoftmaxPolicy::sampleActions(std::span<const size_t> states, std::span<size_t> out) const {
+        if (states.size() != out.size()) throw std::invalid_argument("Input and output sizes of sampleActions differ");
+
+        const Matrix2D probs = getActionProbabilities(states);
+        for (size_t i = 0; i < states.size(); ++i)
+            out[i] = sampleProbability(A, probs.row(i), rand_);
+    }
+
+    Matrix2D QSoftmaxPolicy::getActionProbabilities(std::span<const size_t> states) const {
+        Matrix2D retval = q_(states, Eigen::all);
+        const Vector max = retval.rowwise().maxCoeff();
+
+        // Greedy policies and infinite values are handled row by row.
+        if ( checkEqualSmall(temperature_, 0.0) || !max.allFinite() ) {
+            std::vector<size_t> bestActions(A);
+            Vector vbuffer(A);
+            for (size_t i = 0; i < states.size(); ++i) {
+                auto wrap = Bandit::QSoftmaxPolicyWrapper(temperature_, q_.row(states[i]), vbuffer, bestActions, rand_);
+                wrap.getPolicy(retval.row(i));
+            }
+            return retval;
+        }
+
+        retval.colwise() -= max;
+        retval = (retval / temperature_).array().exp();
+        retval.array().colwise() /= retval.rowwise().sum().array();
+
+        return retval;
+    }
+
     void QSoftmaxPolicy::setTemperature(const double t) {
         if ( t < 0.0 ) throw std::invalid_argument("Temperature must be >= 0");
         temperature_ = t;
@@ -35,6 +35,23 @@ namespace AIToolbox::MDP {
         timesteps_ = 0;
     }
 
+    void SparseExperience::reserveRows(const size_t rowCapacity) {
+        for ( auto & v : visits_ )
+            reserveSparseRows(v, rowCapacity);
+        reserveSparseRows(visitsSum_, rowCapacity);
+        reserveSparseRows(rewards_, rowCapacity);
+        reserveSparseRows(M2s_, rowCapacity);
+    }
+
+    void SparseExperience::compress() {
+        // Visits are never zero; pruning also compresses the tables.
+        for ( auto & v : visits_ )
+            v.makeCompressed();
+        visitsSum_.makeCompressed();
+        rewards_.prune(0.0);
+        M2s_.prune(0.0);
+    }
+
     void SparseExperience::setVisitsTable(const SparseTable3D & v) {
         visits_ = v;
         visitsSum_.setZero();
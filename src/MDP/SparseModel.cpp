@@ -1,11 +1,13 @@
 #include <AIToolbox/MDP/SparseModel.hpp>
 
 namespace AIToolbox::MDP {
-    SparseModel::SparseModel(NoCheck, const size_t s, const size_t a, TransitionMatrix && t, RewardMatrix && r, const double d) :
+    template <typename T>
+    SparseModelT<T>::SparseModelT(NoCheck, const size_t s, const size_t a, TransitionMatrix && t, RewardMatrix && r, const double d) :
             S(s), A(a), discount_(d), transitions_(t), rewards_(r), rand_(Seeder::getSeed()) {}
 
-    SparseModel::SparseModel(const size_t s, const size_t a, const double discount) :
-            S(s), A(a), discount_(discount), transitions_(A, SparseMatrix2D(S, S)),
+    template <typename T>
+    SparseModelT<T>::SparseModelT(const size_t s, const size_t a, const double discount) :
+            S(s), A(a), discount_(discount), transitions_(A, SparseMatrix2DT<T>(S, S)),
             rewards_(S, A), rand_(Seeder::getSeed())
     {
         // Make transition matrix true probability
@@ -13,49 +15,70 @@ namespace AIToolbox::MDP {
             transitions_[a].setIdentity();
     }
 
-    void SparseModel::setTransitionFunction(const SparseMatrix3D & t) {
+    template <typename T>
+    void SparseModelT<T>::setTransitionFunction(const TransitionMatrix & t) {
         if (!isProbability(t))
             throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
         // Then we copy.
         transitions_ = t;
     }
 
-    void SparseModel::setRewardFunction(const RewardMatrix & r) {
+    template <typename T>
+    void SparseModelT<T>::setRewardFunction(const RewardMatrix & r) {
         rewards_ = r;
     }
 
-    std::tuple<size_t, double> SparseModel::sampleSR(const size_t s, const size_t a) const {
-        const size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
+    template <typename T>
+    std::tuple<size_t, double> SparseModelT<T>::sampleSR(const size_t s, const size_t a) const {
+        return sampleSR(s, a, rand_);
+    }
+
+    template <typename T>
+    std::tuple<size_t, double> SparseModelT<T>::sampleSR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        const size_t s1 = sampleProbability(S, transitions_[a].row(s), rnd);
 
         return std::make_tuple(s1, getExpectedReward(s, a, s1));
     }
 
-    double SparseModel::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+    template <typename T>
+    double SparseModelT<T>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
         return transitions_[a].coeff(s, s1);
     }
 
-    double SparseModel::getExpectedReward(const size_t s, const size_t a, const size_t) const {
+    template <typename T>
+    double SparseModelT<T>::getExpectedReward(const size_t s, const size_t a, const size_t) const {
         return rewards_.coeff(s, a);
     }
 
-    void SparseModel::setDiscount(const double d) {
+    template <typename T>
+    void SparseModelT<T>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
     }
 
-    bool SparseModel::isTerminal(const size_t s) const {
+    template <typename T>
+    bool SparseModelT<T>::isTerminal(const size_t s) const {
         for ( size_t a = 0; a < A; ++a )
             if ( !checkEqualSmall(1.0, getTransitionProbability(s, a, s)) )
                 return false;
         return true;
     }
 
-    size_t SparseModel::getS() const { return S; }
-    size_t SparseModel::getA() const { return A; }
-    double SparseModel::getDiscount() const { return discount_; }
+    template <typename T>
+    size_t SparseModelT<T>::getS() const { return S; }
+    template <typename T>
+    size_t SparseModelT<T>::getA() const { return A; }
+    template <typename T>
+    double SparseModelT<T>::getDiscount() const { return discount_; }
+
+    template <typename T>
+    const typename SparseModelT<T>::TransitionMatrix & SparseModelT<T>::getTransitionFunction() const { return transitions_; }
+    template <typename T>
+    const typename SparseModelT<T>::RewardMatrix &     SparseModelT<T>::getRewardFunction()     const { return rewards_; }
 
-    const SparseModel::TransitionMatrix & SparseModel::getTransitionFunction() const { return transitions_; }
-    const SparseModel::RewardMatrix &     SparseModel::getRewardFunction()     const { return rewards_; }
+    template <typename T>
+    const SparseMatrix2DT<T> & SparseModelT<T>::getTransitionFunction(const size_t a) const { return transitions_[a]; }
 
-    const SparseMatrix2D & SparseModel::getTransitionFunction(const size_t a) const { return transitions_[a]; }
+    template class SparseModelT<double>;
+    template class SparseModelT<float>;
 }
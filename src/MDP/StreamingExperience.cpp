@@ -0,0 +1,199 @@
+#include <AIToolbox/MDP/StreamingExperience.hpp>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace AIToolbox::MDP {
+    namespace {
+        // Past this weight for new events, all tables are rescaled so that
+        // the newest events have weight 1 again.
+        constexpr double MaxIncrement = 1e150;
+    }
+
+    StreamingExperience::StreamingExperience(const size_t s, const size_t a, const double decay, const unsigned long window)
+            : S(s), A(a), decay_(decay), window_(window), increment_(1.0), timesteps_(0), blockTimesteps_(0)
+    {
+        if (decay_ <= 0.0 || decay_ > 1.0)
+            throw std::invalid_argument("Decay must be in (0, 1]");
+        if (window_ && decay_ != 1.0)
+            throw std::invalid_argument("Exponential and windowed decay cannot be used together");
+
+        for (auto * b : {&current_, &previous_}) {
+            // The previous block is only needed with a window.
+            if (b == &previous_ && !window_) break;
+
+            b->visits.resize(A, Matrix2D(S, S));
+            b->visitsSum.resize(S, A);
+            b->rewards.resize(S, A);
+            b->M2s.resize(S, A);
+            zero(*b);
+        }
+    }
+
+    void StreamingExperience::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        ++timesteps_;
+
+        if (window_) {
+            if (blockTimesteps_ == window_) {
+                std::swap(current_, previous_);
+                zero(current_);
+                blockTimesteps_ = 0;
+            }
+            ++blockTimesteps_;
+        } else if (decay_ < 1.0) {
+            // Rather than decaying all previous events, we make the new one
+            // weigh more.
+            increment_ /= decay_;
+            if (increment_ > MaxIncrement)
+                rescale();
+        }
+        const double w = increment_;
+
+        current_.visits[a](s, s1) += w;
+        const double n = current_.visitsSum(s, a) += w;
+
+        updateWelford(n, current_.rewards(s, a), current_.M2s(s, a), w, rew);
+    }
+
+    void StreamingExperience::merge(const StreamingExperience & other) {
+        if (S != other.S || A != other.A || decay_ != other.decay_ || window_ != other.window_)
+            throw std::invalid_argument("Cannot merge StreamingExperiences with different parameters");
+
+        // Bring the weights of the other instance to the scale of ours.
+        mergeBlock(current_, other.current_, increment_ / other.increment_);
+        if (window_) {
+            mergeBlock(previous_, other.previous_, 1.0);
+            blockTimesteps_ = std::max(blockTimesteps_, other.blockTimesteps_);
+        }
+        timesteps_ += other.timesteps_;
+    }
+
+    void StreamingExperience::mergeBlock(Block & lhs, const Block & rhs, const double scale) {
+        for (int s = 0; s < lhs.visitsSum.rows(); ++s) {
+            for (int a = 0; a < lhs.visitsSum.cols(); ++a) {
+                double n = lhs.visitsSum(s, a);
+                mergeWelford(n, lhs.rewards(s, a), lhs.M2s(s, a), rhs.visitsSum(s, a) * scale, rhs.rewards(s, a), rhs.M2s(s, a) * scale);
+            }
+        }
+        for (size_t a = 0; a < lhs.visits.size(); ++a)
+            lhs.visits[a] += rhs.visits[a] * scale;
+        lhs.visitsSum += rhs.visitsSum * scale;
+    }
+
+    void StreamingExperience::exportTo(Experience * exp) const {
+        assert(exp);
+
+        Table3D visits(A, Table2D(S, S));
+        Matrix2D rewards(S, A), M2s(S, A);
+
+        for (size_t s = 0; s < S; ++s) {
+            for (size_t a = 0; a < A; ++a) {
+                unsigned long sum = 0;
+                size_t best = 0;
+                double bestVisits = 0.0;
+                for (size_t s1 = 0; s1 < S; ++s1) {
+                    const double v = getVisits(s, a, s1);
+                    visits[a](s, s1) = std::llround(v);
+                    sum += visits[a](s, s1);
+                    if (v > bestVisits) {
+                        best = s1;
+                        bestVisits = v;
+                    }
+                }
+
+                double n, mean, m2;
+                getPair(s, a, &n, &mean, &m2);
+                // Pairs that have been visited are never exported as unvisited.
+                if (sum == 0 && n > 0.0) {
+                    visits[a](s, best) = 1;
+                    sum = 1;
+                }
+
+                if (sum == 0) {
+                    rewards(s, a) = 0.0;
+                    M2s(s, a) = 0.0;
+                } else {
+                    rewards(s, a) = mean;
+                    M2s(s, a) = m2 * (sum / n);
+                }
+            }
+        }
+        exp->setVisitsTable(visits);
+        exp->setRewardMatrix(rewards);
+        exp->setM2Matrix(M2s);
+        exp->setTimesteps(timesteps_);
+    }
+
+    void StreamingExperience::reset() {
+        zero(current_);
+        if (window_) zero(previous_);
+
+        increment_ = 1.0;
+        timesteps_ = 0;
+        blockTimesteps_ = 0;
+    }
+
+    void StreamingExperience::getPair(const size_t s, const size_t a, double * n, double * mean, double * m2) const {
+        *n = current_.visitsSum(s, a);
+        *mean = current_.rewards(s, a);
+        *m2 = current_.M2s(s, a);
+
+        if (window_)
+            mergeWelford(*n, *mean, *m2, previous_.visitsSum(s, a), previous_.rewards(s, a), previous_.M2s(s, a));
+
+        *n /= increment_;
+        *m2 /= increment_;
+    }
+
+    double StreamingExperience::getVisits(const size_t s, const size_t a, const size_t s1) const {
+        double retval = current_.visits[a](s, s1);
+        if (window_) retval += previous_.visits[a](s, s1);
+        return retval / increment_;
+    }
+
+    double StreamingExperience::getVisitsSum(const size_t s, const size_t a) const {
+        double retval = current_.visitsSum(s, a);
+        if (window_) retval += previous_.visitsSum(s, a);
+        return retval / increment_;
+    }
+
+    double StreamingExperience::getReward(const size_t s, const size_t a) const {
+        double n, mean, m2;
+        getPair(s, a, &n, &mean, &m2);
+        return mean;
+    }
+
+    double StreamingExperience::getM2(const size_t s, const size_t a) const {
+        double n, mean, m2;
+        getPair(s, a, &n, &mean, &m2);
+        return m2;
+    }
+
+    void StreamingExperience::rescale() {
+        const double scale = 1.0 / increment_;
+        for (auto & v : current_.visits)
+            v *= scale;
+        current_.visitsSum *= scale;
+        current_.M2s *= scale;
+        increment_ = 1.0;
+    }
+
+    void StreamingExperience::zero(Block & b) {
+        for (auto & v : b.visits)
+            v.setZero();
+        b.visitsSum.setZero();
+        b.rewards.setZero();
+        b.M2s.setZero();
+    }
+
+    unsigned long StreamingExperience::getTimesteps() const { return timesteps_; }
+    double StreamingExperience::getDecay() const { return decay_; }
+    unsigned long StreamingExperience::getWindow() const { return window_; }
+
+    size_t StreamingExperience::getS() const { return S; }
+    size_t StreamingExperience::getA() const { return A; }
+}
@@ -26,22 +26,26 @@ namespace AIToolbox::POMDP {
         return precisionDigits_;
     }
 
+    const SolverStatistics & GapMin::getStatistics() const {
+        return stats_;
+    }
+
     bool GapMin::QueueElementLess::operator() (const QueueElement& arg1, const QueueElement& arg2) const
     {
         return std::get<1>(arg1) < std::get<1>(arg2);
     }
 
-    void GapMin::cleanUp(const MDP::QFunction & ubQ, UpperBoundValueFunction * ubVp, Matrix2D * fibQp) {
+    void GapMin::cleanUp(const MDP::QFunction & ubQ, IndexedPointSurface * ubVp, Matrix2D * fibQp) {
         assert(ubVp);
         assert(fibQp);
 
-        UpperBoundValueFunction & ubV = *ubVp;
+        IndexedPointSurface & ubV = *ubVp;
         Matrix2D & fibQ = *fibQp;
 
-        if (ubV.first.size() == 1) return;
+        if (ubV.size() == 1) return;
 
         std::vector<size_t> toRemove;
-        size_t i = ubV.first.size();
+        size_t i = ubV.size();
 
         // For each belief, we try to compute its upper bound with the others.
         // If it doesn't change, it means that we don't really need it, and
@@ -49,14 +53,11 @@ namespace AIToolbox::POMDP {
         do {
             --i;
 
-            std::swap(ubV.first[i], ubV.first.back());
-            std::swap(ubV.second[i], ubV.second.back());
+            // Erasing moves the last belief in place of the removed one.
+            auto belief = ubV.getPoints()[i];
+            auto value = ubV.getValues()[i];
 
-            auto belief = std::move(ubV.first.back());
-            auto value = ubV.second.back();
-
-            ubV.first.pop_back();
-            ubV.second.pop_back();
+            ubV.erase(i);
 
             const auto [v, dist] = LPInterpolation(belief, ubQ, ubV);
             (void)dist;
@@ -67,13 +68,10 @@ namespace AIToolbox::POMDP {
                 // Unpop and unswap, since we need to keep the order consistent
                 // (fibQ depends on it). This could be done with a couple less
                 // moves but like this it's more clear.
-                ubV.first.emplace_back(std::move(belief));
-                ubV.second.emplace_back(value);
-
-                std::swap(ubV.first[i], ubV.first.back());
-                std::swap(ubV.second[i], ubV.second.back());
+                ubV.add(std::move(belief), value);
+                ubV.swap(i, ubV.size() - 1);
             }
-        } while (i != 0 && ubV.first.size() > 1);
+        } while (i != 0 && ubV.size() > 1);
         // If all beliefs are useful, we're done.
         if (toRemove.size() == 0) return;
 
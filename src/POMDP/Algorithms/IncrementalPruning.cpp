@@ -23,6 +23,14 @@ namespace AIToolbox::POMDP {
         return tolerance_;
     }
 
+    const SolverStatistics & IncrementalPruning::getStatistics() const {
+        return stats_;
+    }
+
+    const LP::Statistics & IncrementalPruning::getLPStatistics() const {
+        return lpStats_;
+    }
+
     VList IncrementalPruning::crossSum(const VList & l1, const VList & l2, const size_t a, const bool order) {
         VList c;
 
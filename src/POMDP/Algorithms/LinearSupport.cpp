@@ -28,4 +28,8 @@ namespace AIToolbox::POMDP {
     double LinearSupport::getTolerance() const {
         return tolerance_;
     }
+
+    const LP::Statistics & LinearSupport::getLPStatistics() const {
+        return lpStats_;
+    }
 }
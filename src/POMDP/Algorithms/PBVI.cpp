@@ -25,4 +25,6 @@ namespace AIToolbox::POMDP {
     double PBVI::getTolerance() const { return tolerance_; }
     unsigned PBVI::getHorizon() const { return horizon_; }
     size_t PBVI::getBeliefSize() const { return beliefSize_; }
+
+    const SolverStatistics & PBVI::getStatistics() const { return stats_; }
 }
@@ -482,4 +482,6 @@ namespace AIToolbox::POMDP {
     double SARSOP::getTolerance() const { return tolerance_; }
     void SARSOP::setDelta(double delta) { initialDelta_ = delta; }
     double SARSOP::getDelta() const { return initialDelta_; }
+
+    const SolverStatistics & SARSOP::getStatistics() const { return stats_; }
 }
@@ -20,4 +20,8 @@ namespace AIToolbox::POMDP {
     double Witness::getTolerance() const {
         return tolerance_;
     }
+
+    const LP::Statistics & Witness::getLPStatistics() const {
+        return lpStats_;
+    }
 }
@@ -1,6 +1,7 @@
 #include <AIToolbox/POMDP/IO.hpp>
 
 #include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
 
 #include <AIToolbox/Tools/CassandraParser.hpp>
 
@@ -13,6 +14,24 @@ namespace AIToolbox::POMDP {
         return Model<MDP::Model>(O, W, S, A, T, R, discount);
     }
 
+    SparseModel<MDP::SparseModel> parseCassandraSparse(const std::string & filename, const unsigned threads) {
+        const MappedFile file(filename);
+        CassandraParser parser;
+
+        auto [S, A, O, T, R, W, discount] = parser.parseSparsePOMDP(file.getData(), threads);
+
+        if (!isProbability(T))
+            throw std::invalid_argument("Input transition matrix does not contain valid probabilities.");
+        if (!isProbability(W))
+            throw std::invalid_argument("Input observation matrix does not contain valid probabilities.");
+
+        SparseModel<MDP::SparseModel> model(NO_CHECK, O, std::move(W), NO_CHECK, S, A, std::move(T), std::move(R), discount);
+        // This validates the discount, which the unchecked constructor does not.
+        model.setDiscount(discount);
+
+        return model;
+    }
+
     std::ostream& operator<<(std::ostream &os, const Policy & p) {
         const auto & vf = p.getValueFunction();
 
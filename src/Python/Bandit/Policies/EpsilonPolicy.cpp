@@ -35,7 +35,7 @@ void exportBanditEpsilonPolicy() {
              "@param epsilon The parameter that controls the amount of exploration."
         , (arg("self"), "p", "epsilon")))
 
-        .def("sampleAction",            &EpsilonPolicy::sampleAction,
+        .def("sampleAction",            static_cast<size_t(EpsilonPolicy::*)() const>(&EpsilonPolicy::sampleAction),
              "This function chooses an action for state s, following the policy distribution and epsilon.\n"
              "\n"
              "This function has a probability of (1 - epsilon) of selecting\n"
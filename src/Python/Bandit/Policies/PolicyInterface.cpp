@@ -17,7 +17,7 @@ void exportBanditPolicyInterface() {
          "\n"
          "In the case of bandits, the class works without requiring states.", no_init}
 
-        .def("sampleAction",            &Bandit::PolicyInterface::sampleAction,
+        .def("sampleAction",            static_cast<size_t(Bandit::PolicyInterface::Base::*)() const>(&Bandit::PolicyInterface::sampleAction),
              "This function chooses a random action, following the policy distribution.\n"
              "\n"
              "@return The chosen action."
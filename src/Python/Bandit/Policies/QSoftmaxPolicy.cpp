@@ -23,7 +23,7 @@ void exportBanditQSoftmaxPolicy() {
                  "@param temperature The parameter that controls the amount of exploration."
         , (arg("self"), "q", "temperature")))
 
-        .def("sampleAction",        &QSoftmaxPolicy::sampleAction,
+        .def("sampleAction",        static_cast<size_t(QSoftmaxPolicy::*)() const>(&QSoftmaxPolicy::sampleAction),
                  "This function chooses an action for state s with probability dependent on value.\n"
                  "\n"
                  "This class implements softmax through the Boltzmann\n"
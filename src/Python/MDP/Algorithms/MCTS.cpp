@@ -20,8 +20,16 @@ void exportMCTSByModel(std::string className) {
 
     using V = MCTS<M>;
 
-    size_t (V::*sampleAction1)(const size_t &, unsigned) = &V::sampleAction;
-    size_t (V::*sampleAction2)(size_t, const size_t &, unsigned) = &V::sampleAction;
+    // Planning does not touch Python objects (GenerativeModelPython takes
+    // the GIL back when needed), so we let other threads run meanwhile.
+    auto sampleAction1 = +[](V & self, const size_t & s, const unsigned horizon) {
+        ReleaseGIL gil;
+        return self.sampleAction(s, horizon);
+    };
+    auto sampleAction2 = +[](V & self, const size_t a, const size_t & s1, const unsigned horizon) {
+        ReleaseGIL gil;
+        return self.sampleAction(a, s1, horizon);
+    };
 
     class_<V>{("MCTS" + className).c_str(), (
 
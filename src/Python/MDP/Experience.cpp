@@ -2,10 +2,53 @@
 
 #include <boost/python.hpp>
 
+#include "../Utils.hpp"
+
 void exportMDPExperience() {
+    using namespace AIToolbox;
     using namespace AIToolbox::MDP;
     using namespace boost::python;
 
+    // We pickle the raw data of the tables, the visit sums are recomputed.
+    struct ExperiencePickle : boost::python::pickle_suite {
+        static boost::python::tuple getinitargs(const Experience& e) {
+            return boost::python::make_tuple(e.getS(), e.getA());
+        }
+        static boost::python::tuple getstate(const Experience& e) {
+            std::string out;
+            appendBytes(out, e.getTimesteps());
+            for (size_t a = 0; a < e.getA(); ++a)
+                appendBytes(out, e.getVisitsTable(a));
+            appendBytes(out, e.getRewardMatrix());
+            appendBytes(out, e.getM2Matrix());
+            return boost::python::make_tuple(toPythonBytes(out));
+        }
+        static void setstate(Experience& e, boost::python::tuple state) {
+            if (len(state) != 1) {
+                PyErr_SetObject(PyExc_ValueError,
+                        ("expected 1-item tuple in call to __setstate__; got %s" % state).ptr()
+                        );
+                throw_error_already_set();
+            }
+            const auto S = e.getS(), A = e.getA();
+            unsigned long timesteps;
+            Table3D visits(A, Table2D(S, S));
+            Matrix2D rewards(S, A), m2(S, A);
+
+            BytesReader in(state[0]);
+            in.read(timesteps);
+            for (auto & v : visits) in.read(v);
+            in.read(rewards);
+            in.read(m2);
+            in.finish();
+
+            e.setVisitsTable(visits);
+            e.setRewardMatrix(rewards);
+            e.setM2Matrix(m2);
+            e.setTimesteps(timesteps);
+        }
+    };
+
     class_<Experience>{"Experience",
 
          "This class keeps track of registered events and rewards.\n"
@@ -126,5 +169,38 @@ void exportMDPExperience() {
                  "This function returns the number of available actions to the agent.\n"
                  "\n"
                  "@return The total number of actions."
-        , (arg("self")));
+        , (arg("self")))
+
+        .def("getVisitsTable",  static_cast<const Table2D & (Experience::*)(size_t) const>(&Experience::getVisitsTable), return_internal_reference<>(),
+                 "This function returns the SxS visits table for a given action.\n"
+                 "\n"
+                 "The returned Table2D references the data of the Experience, and\n"
+                 "can be viewed without copies (e.g. with numpy.asarray). It must\n"
+                 "not be modified.\n"
+                 "\n"
+                 "@param a The action requested."
+        , (arg("self"), "a"))
+
+        .def("getVisitsSumTable", &Experience::getVisitsSumTable, return_internal_reference<>(),
+                 "This function returns the SxA visits sum table.\n"
+                 "\n"
+                 "The returned Table2D references the data of the Experience, and\n"
+                 "can be viewed without copies (e.g. with numpy.asarray)."
+        , (arg("self")))
+
+        .def("getRewardMatrix", &Experience::getRewardMatrix, return_internal_reference<>(),
+                 "This function returns the SxA matrix of average rewards.\n"
+                 "\n"
+                 "The returned Matrix2D references the data of the Experience, and\n"
+                 "can be viewed without copies (e.g. with numpy.asarray)."
+        , (arg("self")))
+
+        .def("getM2Matrix",     &Experience::getM2Matrix, return_internal_reference<>(),
+                 "This function returns the SxA matrix of M2 statistics.\n"
+                 "\n"
+                 "The returned Matrix2D references the data of the Experience, and\n"
+                 "can be viewed without copies (e.g. with numpy.asarray)."
+        , (arg("self")))
+
+        .def_pickle(ExperiencePickle());
 }
@@ -11,9 +11,33 @@ void exportMDPGenerativeModelPython() {
          "\n"
          "This class wraps an instance of a Python class that provides generator\n"
          "methods to sample states and rewards from, so that one does not need to\n"
-         "always specify transition and reward functions from Python.", no_init}
+         "always specify transition and reward functions from Python.\n"
+         "\n"
+         "Since calling into Python is slow, this class avoids it whenever it\n"
+         "can. The number of states and actions and the discount are read once\n"
+         "on construction, and whether each state is terminal is asked only\n"
+         "once, and cached as states are seen.\n"
+         "\n"
+         "If the batch size is greater than one, samples are requested from\n"
+         "Python in batches for each state-action pair, and the ones not\n"
+         "immediately used are kept in a pool, to be served one at a time\n"
+         "the next time that same pair is sampled. The pool holds at most a\n"
+         "fixed number of samples; when a new batch does not fit, the whole\n"
+         "pool is discarded.\n"
+         "\n"
+         "All calls into Python acquire the GIL, so that algorithms using\n"
+         "this model can release it while they run. The caches are also only\n"
+         "read and modified while holding the GIL, so a single model can be\n"
+         "shared by solvers planning concurrently on different threads.\n"
+         "\n"
+         "Note that all this assumes that the Python model is stateless: it\n"
+         "must not change during its use, and its samples must be independent\n"
+         "and identically distributed, as a pooled sample may be served long\n"
+         "after it was generated. If the Python model changes, clearCache()\n"
+         "must be called. Models whose samples depend on previous calls must\n"
+         "not use batching.", no_init}
 
-        .def(init<boost::python::object>(
+        .def(init<boost::python::object, optional<unsigned, size_t>>(
                  "Basic constructor."
                  "\n"
                  "This constructor takes a Python object, which will be used to\n"
@@ -27,8 +51,20 @@ void exportMDPGenerativeModelPython() {
                  "- isTerminal(s): returns whether a given state is a terminal state.\n"
                  "- sampleSR(s, a): returns a tuple containing new state and reward, from the input state and action.\n"
                  "\n"
-                 "@param instance The Python object instance to call methods on."
-        , (arg("self"), "instance")))
+                 "If batchSize is greater than one, the instance must also have:\n"
+                 "\n"
+                 "- sampleSRBatch(states, actions): takes two equally sized\n"
+                 "  lists of states and actions, and returns a tuple containing\n"
+                 "  a sequence of new states and a sequence of rewards, one for\n"
+                 "  each input state-action pair.\n"
+                 "\n"
+                 "The pool size must be at least the batch size, otherwise\n"
+                 "the constructor will throw.\n"
+                 "\n"
+                 "@param instance The Python object instance to call methods on.\n"
+                 "@param batchSize The number of samples to request at once for each state-action pair.\n"
+                 "@param poolSize The maximum number of unused samples to keep."
+        , (arg("self"), "instance", "batchSize", "poolSize")))
 
         .def("getS",                        &GenerativeModelPython::getS,
                 "This function returns the number of states of the world."
@@ -63,5 +99,19 @@ void exportMDPGenerativeModelPython() {
 
         .def("isTerminal",                  &GenerativeModelPython::isTerminal,
                 "This function returns whether a given state is a terminal."
-        , (arg("self"), "s"));
+        , (arg("self"), "s"))
+
+        .def("getBatchSize",                &GenerativeModelPython::getBatchSize,
+                "This function returns the number of samples requested at once for each state-action pair."
+        , (arg("self")))
+
+        .def("getPooledSamples",            &GenerativeModelPython::getPooledSamples,
+                "This function returns the number of unused samples currently kept by the model."
+        , (arg("self")))
+
+        .def("clearCache",                  &GenerativeModelPython::clearCache,
+                "This function discards all cached terminal states and pooled samples.\n"
+                "\n"
+                "This must be called if the wrapped Python model changes."
+        , (arg("self")));
 }
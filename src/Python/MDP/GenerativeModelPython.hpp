@@ -1,9 +1,16 @@
 #ifndef AI_TOOLBOX_MDP_GENERATIVE_MODEL_PYTHON_HEADER_FILE
 #define AI_TOOLBOX_MDP_GENERATIVE_MODEL_PYTHON_HEADER_FILE
 
+#include <vector>
+#include <tuple>
+#include <stdexcept>
+#include <unordered_map>
+
 #include <boost/python.hpp>
 #include <boost/python/object.hpp>
 
+#include "../Utils.hpp"
+
 namespace AIToolbox::MDP {
     /**
      * @brief This class allows to import generative models from Python.
@@ -11,6 +18,30 @@ namespace AIToolbox::MDP {
      * This class wraps an instance of a Python class that provides generator
      * methods to sample states and rewards from, so that one does not need to
      * always specify transition and reward functions from Python.
+     *
+     * Since calling into Python is slow, this class avoids it whenever it
+     * can. The number of states and actions and the discount are read once
+     * on construction, and whether each state is terminal is asked only
+     * once, and cached as states are seen.
+     *
+     * If the batch size is greater than one, samples are requested from
+     * Python in batches for each state-action pair, and the ones not
+     * immediately used are kept in a pool, to be served one at a time
+     * the next time that same pair is sampled. The pool holds at most a
+     * fixed number of samples; when a new batch does not fit, the whole
+     * pool is discarded.
+     *
+     * All calls into Python acquire the GIL, so that algorithms using
+     * this model can release it while they run. The caches are also only
+     * read and modified while holding the GIL, so a single model can be
+     * shared by solvers planning concurrently on different threads.
+     *
+     * Note that all this assumes that the Python model is stateless: it
+     * must not change during its use, and its samples must be independent
+     * and identically distributed, as a pooled sample may be served long
+     * after it was generated. If the Python model changes, clearCache()
+     * must be called. Models whose samples depend on previous calls must
+     * not use batching.
      */
     class GenerativeModelPython {
         public:
@@ -28,41 +59,169 @@ namespace AIToolbox::MDP {
              * - isTerminal(s): returns whether a given state is a terminal state.
              * - sampleSR(s, a): returns a tuple containing new state and reward, from the input state and action.
              *
+             * If batchSize is greater than one, the instance must also have:
+             *
+             * - sampleSRBatch(states, actions): takes two equally sized
+             *   lists of states and actions, and returns a tuple containing
+             *   a sequence of new states and a sequence of rewards, one for
+             *   each input state-action pair.
+             *
+             * The pool size must be at least the batch size, otherwise
+             * the constructor will throw an std::invalid_argument.
+             *
              * @param instance The Python object instance to call methods on.
+             * @param batchSize The number of samples to request at once for each state-action pair.
+             * @param poolSize The maximum number of unused samples to keep.
+             */
+            GenerativeModelPython(boost::python::object instance, unsigned batchSize = 0, size_t poolSize = DefaultPoolSize);
+
+            /**
+             * @brief The default maximum number of unused samples kept by the model.
              */
-            GenerativeModelPython(boost::python::object instance) :
-                    instance_(instance) {}
+            static constexpr size_t DefaultPoolSize = 1 << 16;
 
             /**
              * @brief This function returns the number of states of the environment.
              */
-            size_t getS() const { return boost::python::extract<size_t>(instance_.attr("getS")()); }
+            size_t getS() const { return S; }
 
             /**
              * @brief This function returns the number of actions of the environment.
              */
-            size_t getA() const { return boost::python::extract<size_t>(instance_.attr("getA")()); }
+            size_t getA() const { return A; }
 
             /**
              * @brief This function returns the discount of the environment.
              */
-            double getDiscount() const { return boost::python::extract<double>(instance_.attr("getDiscount")()); }
+            double getDiscount() const { return discount_; }
 
             /**
              * @brief This function returns whether a given state is a terminal state.
              */
-            bool isTerminal(const size_t s) const { return boost::python::extract<bool>(instance_.attr("isTerminal")(s)); }
+            bool isTerminal(size_t s) const;
 
             /**
              * @brief This function returns a tuple containing a new state and reward, from the input state and action.
              */
-            std::tuple<size_t, double> sampleSR(const size_t s, const size_t a) const {
-                return boost::python::extract<std::tuple<size_t, double>>(instance_.attr("sampleSR")(s, a));
-            }
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the number of samples requested at once for each state-action pair.
+             */
+            unsigned getBatchSize() const { return batchSize_; }
+
+            /**
+             * @brief This function returns the number of unused samples currently kept by the model.
+             */
+            size_t getPooledSamples() const { return pooled_; }
+
+            /**
+             * @brief This function discards all cached terminal states and pooled samples.
+             *
+             * This must be called if the wrapped Python model changes.
+             */
+            void clearCache();
 
         private:
+            /**
+             * @brief This function requests a new batch of samples for the input state-action pair.
+             */
+            void refill(std::vector<std::tuple<size_t, double>> & samples, size_t s, size_t a) const;
+
             boost::python::object instance_;
+            size_t S, A;
+            double discount_;
+            unsigned batchSize_;
+            size_t poolSize_;
+
+            // Whether each state seen so far is terminal.
+            mutable std::unordered_map<size_t, bool> terminal_;
+            // Unused batched samples, for each s * A + a; pairs without
+            // samples are removed, so this never has more than pooled_ entries.
+            mutable std::unordered_map<size_t, std::vector<std::tuple<size_t, double>>> samples_;
+            mutable size_t pooled_;
     };
+
+    inline GenerativeModelPython::GenerativeModelPython(boost::python::object instance, const unsigned batchSize, const size_t poolSize) :
+            instance_(instance),
+            S(boost::python::extract<size_t>(instance_.attr("getS")())),
+            A(boost::python::extract<size_t>(instance_.attr("getA")())),
+            discount_(boost::python::extract<double>(instance_.attr("getDiscount")())),
+            batchSize_(batchSize), poolSize_(poolSize), pooled_(0)
+    {
+        if (batchSize_ > 1 && !PyObject_HasAttrString(instance_.ptr(), "sampleSRBatch"))
+            throw std::invalid_argument("A batch size was specified, but the instance has no sampleSRBatch method");
+        if (batchSize_ > 1 && poolSize_ < batchSize_)
+            throw std::invalid_argument("The pool size must be at least the batch size");
+    }
+
+    inline bool GenerativeModelPython::isTerminal(const size_t s) const {
+        // The GIL also guards the cache, as other threads may share it.
+        AcquireGIL gil;
+        if (const auto it = terminal_.find(s); it != terminal_.end())
+            return it->second;
+
+        const bool t = boost::python::extract<bool>(instance_.attr("isTerminal")(s));
+        terminal_.emplace(s, t);
+        return t;
+    }
+
+    inline void GenerativeModelPython::clearCache() {
+        terminal_.clear();
+        samples_.clear();
+        pooled_ = 0;
+    }
+
+    inline std::tuple<size_t, double> GenerativeModelPython::sampleSR(const size_t s, const size_t a) const {
+        AcquireGIL gil;
+        if (batchSize_ < 2)
+            return boost::python::extract<std::tuple<size_t, double>>(instance_.attr("sampleSR")(s, a));
+
+        const size_t key = s * A + a;
+        auto it = samples_.find(key);
+        if (it == samples_.end()) {
+            // We make room for a full batch by dropping all old samples.
+            // As these are independent, this does not bias the others.
+            if (pooled_ + batchSize_ > poolSize_) {
+                samples_.clear();
+                pooled_ = 0;
+            }
+            std::vector<std::tuple<size_t, double>> batch;
+            refill(batch, s, a);
+            pooled_ += batch.size();
+            it = samples_.emplace(key, std::move(batch)).first;
+        }
+
+        auto & samples = it->second;
+        const auto retval = samples.back();
+        samples.pop_back();
+        --pooled_;
+        if (samples.empty())
+            samples_.erase(it);
+
+        return retval;
+    }
+
+    inline void GenerativeModelPython::refill(std::vector<std::tuple<size_t, double>> & samples, const size_t s, const size_t a) const {
+        namespace bp = boost::python;
+        // Called with the GIL already held by sampleSR.
+
+        bp::list states, actions;
+        for (unsigned i = 0; i < batchSize_; ++i) {
+            states.append(s);
+            actions.append(a);
+        }
+        const bp::object result = instance_.attr("sampleSRBatch")(states, actions);
+        const bp::object newStates = result[0], rewards = result[1];
+
+        const auto size = bp::len(newStates);
+        if (static_cast<size_t>(size) != batchSize_ || bp::len(rewards) != size)
+            throw std::runtime_error("sampleSRBatch must return a state and a reward for each input state-action pair");
+
+        samples.reserve(size);
+        for (decltype(bp::len(newStates)) i = 0; i < size; ++i)
+            samples.emplace_back(bp::extract<size_t>(newStates[i]), bp::extract<double>(rewards[i]));
+    }
 }
 
 #endif
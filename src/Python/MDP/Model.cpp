@@ -12,19 +12,25 @@
 #include <sstream>
 #include <string>
 
+#include "../Utils.hpp"
+
 void exportMDPModel() {
+    using namespace AIToolbox;
     using namespace AIToolbox::MDP;
 
     struct ModelPickle : boost::python::pickle_suite {
         static boost::python::tuple getinitargs(const Model& m) {
             return boost::python::make_tuple(m.getS(), m.getA(), m.getDiscount());
         }
-        // To avoid enabling pickling of the internal matrices, which would be
-        // annoying, we pickle the policy as a string and reload it later.
+        // We pickle the raw data of the transition and reward matrices, which
+        // is much faster than going through the text format. Older pickles
+        // which stored the model as a string can still be loaded.
         static boost::python::tuple getstate(const Model& m) {
-            std::ostringstream out; out << m;
-            std::string outString = out.str();
-            return boost::python::make_tuple(outString);
+            std::string out;
+            for (size_t a = 0; a < m.getA(); ++a)
+                appendBytes(out, m.getTransitionFunction(a));
+            appendBytes(out, m.getRewardFunction());
+            return boost::python::make_tuple(toPythonBytes(out));
         }
         static void setstate(Model& m, boost::python::tuple state) {
             using namespace boost::python;
@@ -34,9 +40,22 @@ void exportMDPModel() {
                         );
                 throw_error_already_set();
             }
-            std::string inString = extract<std::string>(state[0]);
-            std::istringstream in(inString);
-            in >> m;
+            if (PyUnicode_Check(object(state[0]).ptr())) {
+                std::string inString = extract<std::string>(state[0]);
+                std::istringstream in(inString);
+                in >> m;
+                return;
+            }
+            const auto S = m.getS(), A = m.getA();
+            Model::TransitionMatrix t(A, Matrix2D(S, S));
+            Model::RewardMatrix r(S, A);
+
+            BytesReader in(state[0]);
+            for (auto & ta : t) in.read(ta);
+            in.read(r);
+            in.finish();
+
+            m = Model(NO_CHECK, S, A, std::move(t), std::move(r), m.getDiscount());
         }
     };
 
@@ -179,7 +198,7 @@ void exportMDPModel() {
                 "This function returns the currently set discount factor."
         , (arg("self")))
 
-        .def("sampleSR",                    &Model::sampleSR,
+        .def("sampleSR",                    static_cast<std::tuple<size_t, double>(Model::*)(size_t, size_t) const>(&Model::sampleSR),
                  "This function samples the MDP for the specified state action pair.\n"
                  "\n"
                  "This function samples the model for simulated experience.\n"
@@ -210,5 +229,24 @@ void exportMDPModel() {
                 "This function returns whether a given state is a terminal."
         , (arg("self"), "s"))
 
+        .def("getTransitionFunction",       static_cast<const Matrix2D & (Model::*)(size_t) const>(&Model::getTransitionFunction), return_internal_reference<>(),
+                "This function returns the transition function for a given action.\n"
+                "\n"
+                "The returned Matrix2D references the data of the Model, and can\n"
+                "be viewed without copies (e.g. with numpy.asarray). It must not be\n"
+                "modified.\n"
+                "\n"
+                "@param a The action requested.\n"
+                "\n"
+                "@return The SxS transition matrix for the action."
+        , (arg("self"), "a"))
+
+        .def("getRewardFunction",           &Model::getRewardFunction, return_internal_reference<>(),
+                "This function returns the SxA reward function.\n"
+                "\n"
+                "The returned Matrix2D references the data of the Model, and can\n"
+                "be viewed without copies (e.g. with numpy.asarray)."
+        , (arg("self")))
+
         .def_pickle(ModelPickle());
 }
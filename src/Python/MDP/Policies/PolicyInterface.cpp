@@ -18,7 +18,7 @@ void exportMDPPolicyInterface() {
          "In the case of MDPs, the class works using integer states, which\n"
          "represent the discrete states from which we are sampling.", no_init}
 
-        .def("sampleAction",            &MDP::PolicyInterface::sampleAction,
+        .def("sampleAction",            static_cast<size_t(MDP::PolicyInterface::Base::*)(const size_t &) const>(&MDP::PolicyInterface::sampleAction),
              "This function chooses a random action for state s, following the policy distribution.\n"
              "\n"
              "@param s The sampled state of the policy.\n"
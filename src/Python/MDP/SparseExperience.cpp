@@ -46,6 +46,17 @@ void exportMDPSparseExperience() {
                  "This function resets all experienced rewards and transitions."
         , (arg("self")))
 
+        .def("reserveRows",     &SparseExperience::reserveRows,
+                 "This function reserves slack capacity in each row of the internal tables.\n"
+                 "\n"
+                 "After this call the tables are kept uncompressed, so that new\n"
+                 "transitions are recorded in place."
+        , (arg("self"), "rowCapacity"))
+
+        .def("compress",        &SparseExperience::compress,
+                 "This function packs the internal tables into compressed form."
+        , (arg("self")))
+
         .def("getTimesteps",    &SparseExperience::getTimesteps,
                  "This function returns the number of times that record has been called."
         , (arg("self")))
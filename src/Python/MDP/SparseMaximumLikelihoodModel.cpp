@@ -141,6 +141,22 @@ void exportMDPSparseMaximumLikelihoodModel() {
                  "@param s1 The final state of the transition that got updated in the Experience."
         , (arg("self"), "s", "a", "s1"))
 
+        .def("reserveRows",                 &SparseMaximumLikelihoodModelBinded::reserveRows,
+                 "This function reserves slack capacity in each row of the model.\n"
+                 "\n"
+                 "After this call the transition and reward matrices are kept\n"
+                 "uncompressed, so that syncs which add new transitions insert them\n"
+                 "in place without moving the data of the other rows."
+        , (arg("self"), "rowCapacity"))
+
+        .def("compress",                    &SparseMaximumLikelihoodModelBinded::compress,
+                 "This function packs the transition and reward matrices into compressed form."
+        , (arg("self")))
+
+        .def("isCompressed",                &SparseMaximumLikelihoodModelBinded::isCompressed,
+                 "This function returns whether the transition and reward matrices are in compressed form."
+        , (arg("self")))
+
         .def("sampleSR",                    &SparseMaximumLikelihoodModelBinded::sampleSR,
                  "This function samples the MDP for the specified state action pair.\n"
                  "\n"
@@ -12,19 +12,26 @@
 #include <sstream>
 #include <string>
 
+#include "../Utils.hpp"
+
 void exportMDPSparseModel() {
+    using namespace AIToolbox;
     using namespace AIToolbox::MDP;
 
     struct SparseModelPickle : boost::python::pickle_suite {
         static boost::python::tuple getinitargs(const SparseModel& m) {
             return boost::python::make_tuple(m.getS(), m.getA(), m.getDiscount());
         }
-        // To avoid enabling pickling of the internal matrices, which would be
-        // annoying, we pickle the policy as a string and reload it later.
+        // We pickle the non-zero entries of the transition and reward
+        // matrices in binary, which is much faster than going through the
+        // text format. Older pickles which stored the model as a string can
+        // still be loaded.
         static boost::python::tuple getstate(const SparseModel& m) {
-            std::ostringstream out; out << m;
-            std::string outString = out.str();
-            return boost::python::make_tuple(outString);
+            std::string out;
+            for (size_t a = 0; a < m.getA(); ++a)
+                appendBytes(out, m.getTransitionFunction(a));
+            appendBytes(out, m.getRewardFunction());
+            return boost::python::make_tuple(toPythonBytes(out));
         }
         static void setstate(SparseModel& m, boost::python::tuple state) {
             using namespace boost::python;
@@ -34,9 +41,22 @@ void exportMDPSparseModel() {
                         );
                 throw_error_already_set();
             }
-            std::string inString = extract<std::string>(state[0]);
-            std::istringstream in(inString);
-            in >> m;
+            if (PyUnicode_Check(object(state[0]).ptr())) {
+                std::string inString = extract<std::string>(state[0]);
+                std::istringstream in(inString);
+                in >> m;
+                return;
+            }
+            const auto S = m.getS(), A = m.getA();
+            SparseModel::TransitionMatrix t(A, SparseMatrix2D(S, S));
+            SparseModel::RewardMatrix r(S, A);
+
+            BytesReader in(state[0]);
+            for (auto & ta : t) in.read(ta);
+            in.read(r);
+            in.finish();
+
+            m = SparseModel(NO_CHECK, S, A, std::move(t), std::move(r), m.getDiscount());
         }
     };
 
@@ -189,7 +209,7 @@ void exportMDPSparseModel() {
                 "This function returns the currently set discount factor."
         , (arg("self")))
 
-        .def("sampleSR",                    &SparseModel::sampleSR,
+        .def("sampleSR",                    static_cast<std::tuple<size_t, double>(SparseModel::*)(size_t, size_t) const>(&SparseModel::sampleSR),
                  "This function samples the MDP for the specified state action pair.\n"
                  "\n"
                  "This function samples the model for simulated experience.\n"
@@ -20,8 +20,16 @@ void exportPOMCPByModel(std::string className) {
 
     using V = POMCP<M>;
 
-    size_t (V::*sampleAction1)(const Belief &, unsigned) = &V::sampleAction;
-    size_t (V::*sampleAction2)(size_t, size_t, unsigned) = &V::sampleAction;
+    // Planning does not touch Python objects, so we let other threads run
+    // meanwhile.
+    auto sampleAction1 = +[](V & self, const Belief & b, const unsigned horizon) {
+        ReleaseGIL gil;
+        return self.sampleAction(b, horizon);
+    };
+    auto sampleAction2 = +[](V & self, const size_t a, const size_t o, const unsigned horizon) {
+        ReleaseGIL gil;
+        return self.sampleAction(a, o, horizon);
+    };
 
     class_<V>{("POMCP" + className).c_str(), (
 
@@ -68,14 +76,17 @@ void exportPOMCPByModel(std::string className) {
          "In order to avoid performing belief updates between each\n"
          "action/observation pair, which can be expensive, POMCP uses particle\n"
          "beliefs. These approximate the beliefs at every step, and are used\n"
-         "to select states in the rollouts.\n"
+         "to select states in the rollouts. Particles are stored as weighted\n"
+         "state counts, so that the memory used by each node is bounded by\n"
+         "the number of states it has seen.\n"
          "\n"
-         "A weakness of this implementation is that, as every particle\n"
-         "approximation of continuous values, it will lose particles in time.\n"
-         "To fight this a possibility is to implement a particle\n"
-         "reinvigoration method, which would introduce noise in the particle\n"
-         "beliefs in order to keep them 'fresh' (possibly using domain\n"
-         "knowledge).").c_str(), no_init}
+         "As every particle approximation, the beliefs lose particles in time,\n"
+         "since nodes deep in the tree are visited less often. To fight this,\n"
+         "when moving the root POMCP reinvigorates the new belief: it samples\n"
+         "states from the old root belief, simulates the action taken with the\n"
+         "generative model, and keeps the resulting states whose observation\n"
+         "matches the one received. The new belief is then brought back to\n"
+         "the initial belief size with systematic resampling.").c_str(), no_init}
 
         .def(init<const M&, size_t, unsigned, double>(
                  "Basic constructor.\n"
@@ -113,9 +124,13 @@ void exportPOMCPByModel(std::string className) {
                  "using the existing graph: this should make search faster,\n"
                  "and also not require any belief updates.\n"
                  "\n"
-                 "NOTE: Currently there is no particle reinvigoration\n"
-                 "implemented, so for long horizons you can expect\n"
-                 "progressively degrading performances.\n"
+                 "If the new root has less particles than the belief size,\n"
+                 "new particles are generated from the previous root belief\n"
+                 "(see setReinvigorationAttempts()). The new root belief is\n"
+                 "then resampled to the belief size.\n"
+                 "\n"
+                 "If no particles can be obtained at all, this function falls\n"
+                 "back to a uniform belief.\n"
                  "\n"
                  "@param a The action taken in the last timestep.\n"
                  "@param o The observation received in the last timestep.\n"
@@ -134,6 +149,23 @@ void exportPOMCPByModel(std::string className) {
                  "@param beliefSize The new particle belief size."
         , (arg("self"), "beliefSize"))
 
+        .def("setReinvigorationAttempts", &V::setReinvigorationAttempts,
+                 "This function sets the number of reinvigoration attempts per missing particle.\n"
+                 "\n"
+                 "When the root is moved to a new belief with less than\n"
+                 "getBeliefSize() particles, POMCP tries to generate the\n"
+                 "missing ones by sampling the previous belief and simulating\n"
+                 "the action taken, keeping the states which produce the\n"
+                 "observation received.\n"
+                 "\n"
+                 "As observations can be unlikely, this number bounds the\n"
+                 "number of simulations to the number of missing particles\n"
+                 "times the number of attempts. Setting it to zero disables\n"
+                 "reinvigoration.\n"
+                 "\n"
+                 "@param attempts The number of attempts per missing particle."
+        , (arg("self"), "attempts"))
+
         .def("setIterations",           &V::setIterations,
                  "This function sets the number of performed rollouts in POMCP."
         , (arg("self"), "iterations"))
@@ -158,6 +190,10 @@ void exportPOMCPByModel(std::string className) {
                  "This function returns the initial particle size for converted Beliefs."
         , (arg("self")))
 
+        .def("getReinvigorationAttempts", &V::getReinvigorationAttempts,
+                 "This function returns the number of reinvigoration attempts per missing particle."
+        , (arg("self")))
+
         .def("getIterations",           &V::getIterations,
                  "This function returns the number of iterations performed to plan for an action."
         , (arg("self")))
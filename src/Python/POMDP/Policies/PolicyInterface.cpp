@@ -21,7 +21,7 @@ void exportPOMDPPolicyInterface() {
          "In case of POMDPs, the template parameter is of type Belief, which\n"
          "allows us to sample the policy from different beliefs.", no_init}
 
-        .def("sampleAction",            &P::sampleAction,
+        .def("sampleAction",            static_cast<size_t(P::*)(const POMDP::Belief &) const>(&P::sampleAction),
              "This function chooses a random action for state s, following the policy distribution.\n"
              "\n"
              "@param s The sampled state of the policy.\n"
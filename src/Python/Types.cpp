@@ -24,33 +24,40 @@ int getVectorLen(const AIToolbox::Vector& v) {
     return v.size();
 }
 
-double getMatrix2DItem(const AIToolbox::Matrix2D& m, boost::python::tuple i) {
+template <typename M>
+typename M::Scalar getMatrix2DItem(const M& m, boost::python::tuple i) {
     return m((int)boost::python::extract<int>(i[0]), (int)boost::python::extract<int>(i[1]));
 }
 
-void setMatrix2DItem(AIToolbox::Matrix2D & m, boost::python::tuple i, double value) {
+template <typename M>
+void setMatrix2DItem(M & m, boost::python::tuple i, typename M::Scalar value) {
     m((int)boost::python::extract<int>(i[0]), (int)boost::python::extract<int>(i[1])) = value;
 }
 
-boost::python::tuple getMatrix2DShape(const AIToolbox::Matrix2D& m) {
+template <typename M>
+boost::python::tuple getMatrix2DShape(const M& m) {
     return boost::python::make_tuple(m.rows(), m.cols());
 }
 
-struct VectorPickle : boost::python::pickle_suite {
-    static boost::python::tuple getinitargs(const AIToolbox::Vector& v) {
+// Eigen objects are pickled as their raw binary data. Older pickles, which
+// stored the data as Python lists, can still be loaded.
+template <typename M>
+struct EigenPickle : boost::python::pickle_suite {
+    static boost::python::tuple getinitargs(const M& m) {
         using namespace boost::python;
-        return make_tuple(v.size());
+        if constexpr (M::IsVectorAtCompileTime)
+            return make_tuple(m.size());
+        else
+            return make_tuple(m.rows(), m.cols());
     }
 
-    static boost::python::tuple getstate(const AIToolbox::Vector& v) {
-        using namespace boost::python;
-        boost::python::list l;
-        for (size_t i = 0; i < static_cast<size_t>(v.size()); ++i)
-            l.append(v[i]);
-        return make_tuple(l);
+    static boost::python::tuple getstate(const M& m) {
+        std::string out;
+        appendBytes(out, m);
+        return boost::python::make_tuple(toPythonBytes(out));
     }
 
-    static void setstate(AIToolbox::Vector& v, boost::python::tuple state) {
+    static void setstate(M& m, boost::python::tuple state) {
         using namespace boost::python;
         if (len(state) != 1) {
             PyErr_SetObject(PyExc_ValueError,
@@ -58,60 +65,36 @@ struct VectorPickle : boost::python::pickle_suite {
             );
             throw_error_already_set();
         }
-        if (v.size() != len(state[0])) {
-            PyErr_SetObject(PyExc_ValueError,
-                ("state obtained in __setstate__ cannot be applied to this object; got %s" % state).ptr()
-            );
-            throw_error_already_set();
+        if (PyList_Check(object(state[0]).ptr())) {
+            setstateFromList(m, state);
+            return;
         }
-
-        for (size_t i = 0; i < static_cast<size_t>(v.size()); ++i)
-            v[i] = extract<double>(state[0][i]);
-    }
-};
-
-struct Matrix2DPickle : boost::python::pickle_suite {
-    static boost::python::tuple getinitargs(const AIToolbox::Matrix2D& m) {
-        using namespace boost::python;
-        return make_tuple(m.rows(), m.cols());
+        BytesReader in(state[0]);
+        in.read(m);
+        in.finish();
     }
 
-    static boost::python::tuple getstate(const AIToolbox::Matrix2D& m) {
+    static void setstateFromList(M& m, boost::python::tuple state) {
         using namespace boost::python;
-        boost::python::list rows;
-        for (size_t i = 0; i < static_cast<size_t>(m.rows()); ++i) {
-            boost::python::list row;
-            for (size_t j = 0; j < static_cast<size_t>(m.cols()); ++j)
-                row.append(m(i, j));
-            rows.append(row);
-        }
-        return make_tuple(rows);
-    }
-
-    static void setstate(AIToolbox::Matrix2D& m, boost::python::tuple state) {
-        using namespace boost::python;
-        if (len(state) != 1) {
-            PyErr_SetObject(PyExc_ValueError,
-                ("expected 1-item tuple in call to __setstate__; got %s" % state).ptr()
-            );
-            throw_error_already_set();
-        }
-        if (m.rows() != len(state[0])) {
+        const auto mismatch = [&]{
             PyErr_SetObject(PyExc_ValueError,
                 ("state obtained in __setstate__ cannot be applied to this object; got %s" % state).ptr()
             );
             throw_error_already_set();
-        }
-
-        for (size_t i = 0; i < static_cast<size_t>(m.rows()); ++i) {
-            if (m.cols() != len(state[0][i])) {
-                PyErr_SetObject(PyExc_ValueError,
-                    ("state obtained in __setstate__ cannot be applied to this object; got %s" % state).ptr()
-                );
-                throw_error_already_set();
+        };
+        if constexpr (M::IsVectorAtCompileTime) {
+            if (m.size() != len(state[0])) mismatch();
+
+            for (size_t i = 0; i < static_cast<size_t>(m.size()); ++i)
+                m[i] = extract<typename M::Scalar>(state[0][i]);
+        } else {
+            if (m.rows() != len(state[0])) mismatch();
+
+            for (size_t i = 0; i < static_cast<size_t>(m.rows()); ++i) {
+                if (m.cols() != len(state[0][i])) mismatch();
+                for (size_t j = 0; j < static_cast<size_t>(m.cols()); ++j)
+                    m(i, j) = extract<typename M::Scalar>(state[0][i][j]);
             }
-            for (size_t j = 0; j < static_cast<size_t>(m.cols()); ++j)
-                m(i, j) = extract<double>(state[0][i][j]);
         }
     }
 };
@@ -120,21 +103,31 @@ void exportTypes() {
     using namespace AIToolbox;
     using namespace boost::python;
 
+    // Eigen types support the buffer protocol, so that they can be viewed
+    // without copies (e.g. via numpy.asarray).
+
     // Eigen Vector
-    class_<Vector>{"Vector", init<int>()}
+    EigenBuffer<Vector>{class_<Vector>{"Vector", init<int>()}
         .def("__getitem__", &getVectorItem)
         .def("__setitem__", &setVectorItem)
         .def("__len__",     &getVectorLen)
-        .def_pickle(VectorPickle());
+        .def_pickle(EigenPickle<Vector>())};
 
     EigenVectorFromPython();
 
     // 2D Eigen matrix
-    class_<Matrix2D>{"Matrix2D", init<int, int>()}
-        .def("__getitem__", &getMatrix2DItem)
-        .def("__setitem__", &setMatrix2DItem)
-        .add_property("shape",       &getMatrix2DShape)
-        .def_pickle(Matrix2DPickle());
+    EigenBuffer<Matrix2D>{class_<Matrix2D>{"Matrix2D", init<int, int>()}
+        .def("__getitem__", &getMatrix2DItem<Matrix2D>)
+        .def("__setitem__", &setMatrix2DItem<Matrix2D>)
+        .add_property("shape",       &getMatrix2DShape<Matrix2D>)
+        .def_pickle(EigenPickle<Matrix2D>())};
+
+    // 2D Eigen table (counts...)
+    EigenBuffer<Table2D>{class_<Table2D>{"Table2D", init<int, int>()}
+        .def("__getitem__", &getMatrix2DItem<Table2D>)
+        .def("__setitem__", &setMatrix2DItem<Table2D>)
+        .add_property("shape",       &getMatrix2DShape<Table2D>)
+        .def_pickle(EigenPickle<Table2D>())};
 
     // std::vector<size_t> (actions...)
     class_<std::vector<size_t>>{"vec_size_t"}
@@ -2,8 +2,14 @@
 #define AI_TOOLBOX_PYTHON_UTILS_HEADER_FILE
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <tuple>
+#include <string>
+#include <type_traits>
+
+#include <AIToolbox/Types.hpp>
 
 #include <boost/python.hpp>
 
@@ -230,4 +236,213 @@ struct Vector3DFromPython {
     }
 };
 
+// Zero-copy buffers
+
+/**
+ * @brief This class exposes the storage of an Eigen type via the buffer protocol.
+ *
+ * Constructing it on an exported class allows Python to look at the data
+ * of its instances without copying it, via memoryview or numpy.asarray.
+ * The views are writable, and remain valid only as long as the underlying
+ * object is not resized.
+ */
+template <typename M>
+struct EigenBuffer {
+    using Scalar = typename M::Scalar;
+
+    static_assert(M::IsVectorAtCompileTime || M::IsRowMajor, "Only vectors and row-major matrices are supported");
+
+    EigenBuffer(const boost::python::object & cls) {
+        reinterpret_cast<PyTypeObject*>(cls.ptr())->tp_as_buffer = &procs;
+    }
+
+    static constexpr const char * format() {
+        if constexpr (std::is_same_v<Scalar, double>)             return "d";
+        else if constexpr (std::is_same_v<Scalar, float>)         return "f";
+        else if constexpr (std::is_same_v<Scalar, int>)           return "i";
+        else if constexpr (std::is_same_v<Scalar, long>)          return "l";
+        else if constexpr (std::is_same_v<Scalar, unsigned long>) return "L";
+        else {
+            static_assert(std::is_same_v<Scalar, unsigned>, "Unsupported scalar type");
+            return "I";
+        }
+    }
+
+    static int getBuffer(PyObject * obj, Py_buffer * view, int flags) {
+        boost::python::extract<M&> e(obj);
+        if (!e.check()) {
+            view->obj = nullptr;
+            PyErr_SetString(PyExc_BufferError, "object does not contain Eigen data");
+            return -1;
+        }
+        M & m = e();
+
+        // Shape followed by strides; freed in releaseBuffer.
+        auto dims = new Py_ssize_t[4];
+        constexpr Py_ssize_t size = sizeof(Scalar);
+        if constexpr (M::IsVectorAtCompileTime) {
+            view->ndim = 1;
+            dims[0] = m.size();
+            dims[2] = size;
+        } else {
+            view->ndim = 2;
+            dims[0] = m.rows(); dims[1] = m.cols();
+            dims[2] = m.cols() * size; dims[3] = size;
+        }
+
+        view->obj = boost::python::incref(obj);
+        view->buf = m.data();
+        view->len = m.size() * size;
+        view->itemsize = size;
+        view->readonly = 0;
+        view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(format()) : nullptr;
+        view->shape = (flags & PyBUF_ND) == PyBUF_ND ? dims : nullptr;
+        view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? dims + 2 : nullptr;
+        view->suboffsets = nullptr;
+        view->internal = dims;
+        return 0;
+    }
+
+    static void releaseBuffer(PyObject *, Py_buffer * view) {
+        delete [] static_cast<Py_ssize_t*>(view->internal);
+    }
+
+    inline static PyBufferProcs procs = { &getBuffer, &releaseBuffer };
+};
+
+// Binary pickling
+
+/**
+ * @brief This function creates a Python bytes object from a string.
+ */
+inline boost::python::object toPythonBytes(const std::string & bytes) {
+    return boost::python::object(boost::python::handle<>(PyBytes_FromStringAndSize(bytes.data(), bytes.size())));
+}
+
+/**
+ * @brief This function appends the binary representation of a value to a string.
+ */
+template <typename T>
+void appendBytes(std::string & out, const T & value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    } else if constexpr (std::is_base_of_v<Eigen::SparseMatrixBase<T>, T>) {
+        appendBytes(out, static_cast<std::int64_t>(value.nonZeros()));
+        for (std::int64_t k = 0; k < value.outerSize(); ++k) {
+            for (typename T::InnerIterator it(value, k); it; ++it) {
+                appendBytes(out, static_cast<std::int64_t>(it.row()));
+                appendBytes(out, static_cast<std::int64_t>(it.col()));
+                appendBytes(out, it.value());
+            }
+        }
+    } else {
+        out.append(reinterpret_cast<const char *>(value.data()), value.size() * sizeof(typename T::Scalar));
+    }
+}
+
+/**
+ * @brief This class reads back values written with appendBytes from a Python bytes object.
+ *
+ * Eigen containers must already have the correct size. On malformed
+ * input a Python ValueError is raised.
+ */
+class BytesReader {
+    public:
+        BytesReader(const boost::python::object & bytes) : bytes_(bytes), pos_(0) {
+            char * data; Py_ssize_t size;
+            if (PyBytes_AsStringAndSize(bytes_.ptr(), &data, &size) != 0)
+                boost::python::throw_error_already_set();
+            data_ = data; size_ = size;
+        }
+
+        template <typename T>
+        void read(T & value) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            } else if constexpr (std::is_base_of_v<Eigen::SparseMatrixBase<T>, T>) {
+                std::int64_t nonZeros;
+                read(nonZeros);
+                if (nonZeros < 0 || static_cast<size_t>(nonZeros) > (size_ - pos_) / (2 * sizeof(std::int64_t) + sizeof(typename T::Scalar)))
+                    fail();
+
+                std::vector<Eigen::Triplet<typename T::Scalar>> triplets;
+                triplets.reserve(nonZeros);
+                for (std::int64_t i = 0; i < nonZeros; ++i) {
+                    std::int64_t row, col; typename T::Scalar v;
+                    read(row); read(col); read(v);
+                    if (row < 0 || row >= value.rows() || col < 0 || col >= value.cols())
+                        fail();
+                    triplets.emplace_back(row, col, v);
+                }
+                value.setFromTriplets(std::begin(triplets), std::end(triplets));
+                value.makeCompressed();
+            } else {
+                const size_t size = value.size() * sizeof(typename T::Scalar);
+                std::memcpy(value.data(), take(size), size);
+            }
+        }
+
+        /**
+         * @brief This function raises a ValueError if not all bytes have been read.
+         */
+        void finish() const {
+            if (pos_ != size_) fail();
+        }
+
+    private:
+        const char * take(const size_t size) {
+            if (size_ - pos_ < size) fail();
+            const char * retval = data_ + pos_;
+            pos_ += size;
+            return retval;
+        }
+
+        [[noreturn]] void fail() const {
+            PyErr_SetString(PyExc_ValueError, "state obtained in __setstate__ does not match this object");
+            throw boost::python::error_already_set();
+        }
+
+        boost::python::object bytes_;
+        const char * data_;
+        size_t size_, pos_;
+};
+
+// GIL management
+
+/**
+ * @brief This class releases the GIL for its lifetime.
+ *
+ * This should wrap calls into C++ code which run for a while without
+ * touching Python objects, so that other Python threads can run meanwhile.
+ * Any code that needs to call back into Python must use AcquireGIL.
+ */
+class ReleaseGIL {
+    public:
+        ReleaseGIL() : state_(PyEval_SaveThread()) {}
+        ~ReleaseGIL() { PyEval_RestoreThread(state_); }
+
+        ReleaseGIL(const ReleaseGIL &) = delete;
+        ReleaseGIL & operator=(const ReleaseGIL &) = delete;
+
+    private:
+        PyThreadState * state_;
+};
+
+/**
+ * @brief This class acquires the GIL for its lifetime.
+ *
+ * This can be used even if the GIL is already held by the current thread.
+ */
+class AcquireGIL {
+    public:
+        AcquireGIL() : state_(PyGILState_Ensure()) {}
+        ~AcquireGIL() { PyGILState_Release(state_); }
+
+        AcquireGIL(const AcquireGIL &) = delete;
+        AcquireGIL & operator=(const AcquireGIL &) = delete;
+
+    private:
+        PyGILState_STATE state_;
+};
+
 #endif
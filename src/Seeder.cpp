@@ -2,22 +2,63 @@
 
 #include <chrono>
 #include <limits>
+#include <array>
+#include <type_traits>
 
 namespace AIToolbox {
     Seeder Seeder::instance_;
 
-    Seeder::Seeder() {
+    namespace {
+        thread_local Seeder::StreamScope * currentScope = nullptr;
+
+        // Top-level scopes use this child of their stream, so that the seeds
+        // they produce differ from the output of getStreamEngine() on the
+        // same stream id.
+        constexpr std::uint64_t scopeChild = ~std::uint64_t(0);
+
+        template <typename E>
+        E makeEngine(Philox philox) {
+            if constexpr (std::is_same_v<E, Philox>) {
+                return philox;
+            } else {
+                // We fill the whole state so that different streams do not overlap.
+                std::array<std::uint32_t, E::state_size> data;
+                for (auto & d : data) d = philox();
+                std::seed_seq seq(std::begin(data), std::end(data));
+
+                return E(seq);
+            }
+        }
+    }
+
+    Seeder::StreamScope::StreamScope(const std::uint64_t stream) :
+            engine_(currentScope ? currentScope->engine_.split(stream) : getStream(stream).split(scopeChild)),
+            parent_(currentScope)
+    {
+        currentScope = this;
+    }
+
+    Seeder::StreamScope::~StreamScope() {
+        currentScope = parent_;
+    }
+
+    Seeder::Seeder() : threadStreams_(0) {
         rootSeed_ = std::chrono::system_clock::now().time_since_epoch().count();
         generator_.seed(rootSeed_);
     }
 
     unsigned Seeder::getSeed() {
-        static std::uniform_int_distribution<unsigned> dist(0, std::numeric_limits<unsigned>::max());
+        std::uniform_int_distribution<unsigned> dist(0, std::numeric_limits<unsigned>::max());
+
+        if (currentScope)
+            return dist(currentScope->engine_);
 
+        std::lock_guard lock(instance_.generatorMutex_);
         return dist(instance_.generator_);
     }
 
     void Seeder::setRootSeed(const unsigned seed) {
+        std::lock_guard lock(instance_.generatorMutex_);
         instance_.rootSeed_ = seed;
         instance_.generator_.seed(instance_.rootSeed_);
     }
@@ -25,4 +66,23 @@ namespace AIToolbox {
     unsigned Seeder::getRootSeed() {
         return instance_.rootSeed_;
     }
+
+    Philox Seeder::getStream(const std::uint64_t stream) {
+        return Philox(instance_.rootSeed_, stream);
+    }
+
+    RandomEngine Seeder::getStreamEngine(const std::uint64_t stream) {
+        return getStreamEngine(getStream(stream));
+    }
+
+    RandomEngine Seeder::getStreamEngine(const Philox & stream) {
+        return makeEngine<RandomEngine>(stream);
+    }
+
+    RandomEngine & Seeder::getThreadEngine() {
+        constexpr std::uint64_t threadBit = std::uint64_t(1) << 63;
+
+        thread_local RandomEngine engine = getStreamEngine(threadBit | instance_.threadStreams_++);
+        return engine;
+    }
 }
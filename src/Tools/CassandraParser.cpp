@@ -3,11 +3,185 @@
 #include <numeric>
 #include <istream>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <exception>
+#include <limits>
+#include <thread>
 
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <AIToolbox/Utils/Core.hpp>
+
 namespace AIToolbox {
+    namespace {
+        using Triplet = Eigen::Triplet<double>;
+        using Triplets = std::vector<Triplet>;
+
+        // Marks a '*' index, which applies to all values of its dimension.
+        constexpr size_t All = std::numeric_limits<size_t>::max();
+
+        // A reward statement; rewards are expanded only after parsing, see
+        // CassandraParser::parseSparseBody.
+        struct RewardEntry {
+            size_t a, s, s1;
+            double value;
+        };
+
+        // The entries of a matrix, for each action. If a statement sets the
+        // whole matrix of an action, all previous entries are dropped, and
+        // the action is marked as cleared.
+        struct Section {
+            std::vector<Triplets> triplets;
+            std::vector<char> cleared;
+        };
+
+        // The results of parsing a chunk of statements.
+        struct Chunk {
+            Section T, W;
+            std::vector<RewardEntry> R;
+        };
+
+        inline bool isSeparator(const char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == ':';
+        }
+
+        std::string_view trim(std::string_view str) {
+            while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) str.remove_prefix(1);
+            while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))  str.remove_suffix(1);
+            return str;
+        }
+
+        // Returns the next token of the line, and removes it from the line.
+        std::string_view nextToken(std::string_view & line) {
+            size_t b = 0;
+            while (b < line.size() && isSeparator(line[b])) ++b;
+            size_t e = b;
+            while (e < line.size() && !isSeparator(line[e])) ++e;
+
+            const auto retval = line.substr(b, e - b);
+            line.remove_prefix(e);
+            return retval;
+        }
+
+        [[noreturn]] void parseError(const std::string_view what, const std::string_view str) {
+            throw std::runtime_error("Parsing error: " + std::string(what) + " in '" + std::string(str) + "'");
+        }
+
+        double parseDouble(std::string_view str) {
+            // std::from_chars does not accept an explicit plus sign.
+            if (str.size() > 1 && str[0] == '+') str.remove_prefix(1);
+
+            double retval;
+            const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), retval);
+            if (ec != std::errc() || ptr != str.data() + str.size())
+                parseError("invalid number", str);
+            return retval;
+        }
+
+        template <typename Map>
+        size_t parseIndex(const std::string_view str, const Map & map, const size_t max) {
+            if (str == "*") return All;
+            if (const auto it = map.find(str); it != std::end(map)) return it->second;
+
+            size_t retval;
+            const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), retval);
+            if (ec != std::errc() || ptr != str.data() + str.size())
+                parseError("invalid index", str);
+            if (retval >= max) throw std::runtime_error("Input value too high");
+            return retval;
+        }
+
+        // Calls f for each index an entry applies to.
+        template <typename F>
+        void forEachIndex(const size_t i, const size_t max, F && f) {
+            if (i != All) f(i);
+            else for (size_t j = 0; j < max; ++j) f(j);
+        }
+
+        // Parses the remaining tokens of a line as a vector of N values;
+        // 'uniform' is also accepted.
+        void readValues(std::string_view line, const size_t N, std::vector<double> & out) {
+            const auto fullLine = line;
+
+            out.clear();
+            auto token = nextToken(line);
+            if (token == "uniform") {
+                out.assign(N, 1.0 / N);
+                token = nextToken(line);
+            } else {
+                for (; !token.empty() && out.size() <= N; token = nextToken(line))
+                    out.push_back(parseDouble(token));
+            }
+            if (!token.empty() || out.size() != N)
+                parseError("wrong number of elements", fullLine);
+        }
+
+        // Runs f(0), ..., f(n-1) on the input number of threads. If any call
+        // throws, the exception with the lowest index is rethrown, so that
+        // errors do not depend on scheduling.
+        template <typename F>
+        void parallelFor(const size_t n, unsigned threads, F && f) {
+            threads = std::max(1u, static_cast<unsigned>(std::min<size_t>(threads, n)));
+
+            std::vector<std::exception_ptr> errors(n);
+            std::atomic<size_t> next = 0;
+
+            auto worker = [&]() {
+                for (size_t i = next++; i < n; i = next++) {
+                    try {
+                        f(i);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < threads; ++t)
+                workers.emplace_back(worker);
+            worker();
+            for (auto & w : workers) w.join();
+
+            for (const auto & e : errors)
+                if (e) std::rethrow_exception(e);
+        }
+
+        // Builds a sparse matrix from triplets spread over multiple chunks.
+        // Later triplets override earlier ones, and zeros are removed.
+        SparseMatrix2D buildMatrix(const size_t rows, const size_t cols, std::vector<Chunk> & chunks, Section Chunk::* section, const size_t a) {
+            // Chunks before the last clear of this action do not matter.
+            size_t first = chunks.size() - 1;
+            while (first > 0 && !(chunks[first].*section).cleared[a]) --first;
+
+            Triplets merged;
+            Triplets * triplets = &(chunks[first].*section).triplets[a];
+            if (first + 1 < chunks.size()) {
+                size_t size = 0;
+                for (size_t c = first; c < chunks.size(); ++c)
+                    size += (chunks[c].*section).triplets[a].size();
+
+                merged.reserve(size);
+                for (size_t c = first; c < chunks.size(); ++c) {
+                    auto & t = (chunks[c].*section).triplets[a];
+                    merged.insert(std::end(merged), std::begin(t), std::end(t));
+                    Triplets().swap(t);
+                }
+                triplets = &merged;
+            }
+
+            SparseMatrix2D retval(rows, cols);
+            retval.setFromTriplets(std::begin(*triplets), std::end(*triplets), [](double, const double b) { return b; });
+            Triplets().swap(*triplets);
+
+            retval.prune([](auto, auto, const double v) { return checkDifferentSmall(v, 0.0); });
+            retval.makeCompressed();
+            return retval;
+        }
+    }
+
     CassandraParser::CassandraParser() {
         // Assign an action to parse each value for the preambles. Lines parsed
         // in the preamble are parsed before the others.
@@ -101,6 +275,41 @@ namespace AIToolbox {
         return retval;
     }
 
+    CassandraParser::SparseMDPVals CassandraParser::parseSparseMDP(const std::string_view input, const unsigned threads) {
+        SparseMDPVals retval;
+        auto & [S, A, T, R, discount] = retval;
+
+        const auto lines = parseModelInfo(input);
+        S = S_;
+        A = A_;
+        discount = discount_;
+
+        if (!S || !A)
+            throw std::runtime_error("MDP definition is incomplete");
+
+        parseSparseBody(lines, threads, T, R, nullptr);
+
+        return retval;
+    }
+
+    CassandraParser::SparsePOMDPVals CassandraParser::parseSparsePOMDP(const std::string_view input, const unsigned threads) {
+        SparsePOMDPVals retval;
+        auto & [S, A, O, T, R, W, discount] = retval;
+
+        const auto lines = parseModelInfo(input);
+        S = S_;
+        A = A_;
+        O = O_;
+        discount = discount_;
+
+        if (!S || !A || !O)
+            throw std::runtime_error("POMDP definition is incomplete");
+
+        parseSparseBody(lines, threads, T, R, &W);
+
+        return retval;
+    }
+
     // ############################
     // ####  PRIVATE FUNCTIONS  ###
     // ############################
@@ -293,4 +502,238 @@ namespace AIToolbox {
             default: throw std::runtime_error("Parsing error: wrong number of ':' in '" + str + "'");
         }
     }
+
+    std::vector<std::string_view> CassandraParser::parseModelInfo(const std::string_view input) {
+        std::vector<std::string_view> lines;
+        S_ = 0, A_ = 0, O_ = 0;
+        discount_ = 1.0;
+
+        for (size_t pos = 0; pos < input.size(); ) {
+            size_t end = input.find('\n', pos);
+            if (end == std::string_view::npos) end = input.size();
+
+            auto line = input.substr(pos, end - pos);
+            pos = end + 1;
+
+            if (const auto c = line.find('#'); c != std::string_view::npos)
+                line = line.substr(0, c);
+            line = trim(line);
+            if (line.empty()) continue;
+
+            // All preamble keywords are lowercase, while statements and
+            // numbers are not, so we can skip most lines quickly. The
+            // preamble is short, so we reuse the actions of the dense parser.
+            bool parsed = false;
+            if (std::islower(static_cast<unsigned char>(line[0]))) {
+                for (const auto & it : initMap_) {
+                    if (line.starts_with(it.first)) {
+                        it.second(std::string(line));
+                        parsed = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!parsed)
+                lines.push_back(line);
+        }
+        return lines;
+    }
+
+    void CassandraParser::parseSparseBody(const std::vector<std::string_view> & lines, unsigned threads, SparseMatrix3D & T, SparseMatrix2D & R, SparseMatrix3D * W) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Chunks must start with a statement, so that each chunk contains the
+        // data lines of its own statements. Using more chunks than threads
+        // helps balancing statements of very different sizes; the result
+        // does not depend on the number of chunks.
+        const auto isStatement = [](const std::string_view line) {
+            return line[0] == 'T' || line[0] == 'O' || line[0] == 'R';
+        };
+        const size_t chunksN = threads == 1 ? 1 : std::max<size_t>(1, std::min<size_t>(lines.size(), threads * 4));
+        std::vector<size_t> bounds(chunksN + 1, lines.size());
+        bounds[0] = 0;
+        for (size_t c = 1; c < chunksN; ++c) {
+            size_t b = std::max(bounds[c-1], c * lines.size() / chunksN);
+            while (b < lines.size() && !isStatement(lines[b])) ++b;
+            bounds[c] = b;
+        }
+
+        // M: <action> [: <d1> [: <d3> <val>]], followed by the data lines if needed.
+        const auto processMatrix = [&](Section & M, size_t & i, const IDMap & d1map, const IDMap & d3map, const size_t D1, const size_t D3, std::vector<double> & values) {
+            const auto str = lines[i];
+            auto line = str;
+
+            nextToken(line); // The name of the matrix.
+            const auto av = parseIndex(nextToken(line), actionMap_, A_);
+            const auto forEachAction = [&](auto && f) { forEachIndex(av, A_, f); };
+
+            switch (std::count(std::begin(str), std::end(str), ':')) {
+                case 3: {
+                    const auto d1v = parseIndex(nextToken(line), d1map, D1);
+                    const auto d3v = parseIndex(nextToken(line), d3map, D3);
+                    const auto val = parseDouble(nextToken(line));
+
+                    forEachAction([&](const size_t a) {
+                        forEachIndex(d1v, D1, [&](const size_t d1) {
+                            forEachIndex(d3v, D3, [&](const size_t d3) {
+                                M.triplets[a].emplace_back(d1, d3, val);
+                            });
+                        });
+                    });
+                    break;
+                }
+                case 2: {
+                    const auto d1v = parseIndex(nextToken(line), d1map, D1);
+                    if (trim(line).empty()) {
+                        if (i + 1 >= lines.size()) parseError("missing vector", str);
+                        line = lines[++i];
+                    }
+                    readValues(line, D3, values);
+
+                    // Zeros must be kept, as they override previous entries.
+                    forEachAction([&](const size_t a) {
+                        forEachIndex(d1v, D1, [&](const size_t d1) {
+                            for (size_t d3 = 0; d3 < D3; ++d3)
+                                M.triplets[a].emplace_back(d1, d3, values[d3]);
+                        });
+                    });
+                    break;
+                }
+                case 1: {
+                    // The whole matrix is set, so previous entries (and zeros) do not matter.
+                    forEachAction([&](const size_t a) {
+                        M.triplets[a].clear();
+                        M.cleared[a] = true;
+                    });
+
+                    if (i + 1 >= lines.size()) parseError("missing matrix", str);
+                    if (lines[i + 1] == "identity") {
+                        ++i;
+                        if (D1 != D3) parseError("identity matrix must be square", str);
+                        forEachAction([&](const size_t a) {
+                            for (size_t d = 0; d < D1; ++d)
+                                M.triplets[a].emplace_back(d, d, 1.0);
+                        });
+                    } else if (lines[i + 1] == "uniform") {
+                        ++i;
+                        forEachAction([&](const size_t a) {
+                            for (size_t d1 = 0; d1 < D1; ++d1)
+                                for (size_t d3 = 0; d3 < D3; ++d3)
+                                    M.triplets[a].emplace_back(d1, d3, 1.0 / D3);
+                        });
+                    } else {
+                        for (size_t d1 = 0; d1 < D1; ++d1) {
+                            if (i + 1 >= lines.size()) parseError("missing matrix row", str);
+                            readValues(lines[++i], D3, values);
+
+                            forEachAction([&](const size_t a) {
+                                for (size_t d3 = 0; d3 < D3; ++d3)
+                                    if (values[d3] != 0.0)
+                                        M.triplets[a].emplace_back(d1, d3, values[d3]);
+                            });
+                        }
+                    }
+                    break;
+                }
+                default: parseError("wrong number of ':'", str);
+            }
+        };
+
+        // R: <action> : <start-state> : <end-state> : <obs> <val>
+        const auto processReward = [&](const std::string_view str, std::vector<RewardEntry> & out) {
+            if (std::count(std::begin(str), std::end(str), ':') != 4)
+                parseError("wrong number of ':'", str);
+
+            auto line = str;
+            nextToken(line); // R
+
+            RewardEntry e;
+            e.a  = parseIndex(nextToken(line), actionMap_, A_);
+            e.s  = parseIndex(nextToken(line), stateMap_,  S_);
+            e.s1 = parseIndex(nextToken(line), stateMap_,  S_);
+            nextToken(line); // As in the dense parser, observations are ignored.
+            e.value = parseDouble(nextToken(line));
+
+            out.push_back(e);
+        };
+
+        std::vector<Chunk> chunks(chunksN);
+        parallelFor(chunksN, threads, [&](const size_t c) {
+            auto & chunk = chunks[c];
+            chunk.T.triplets.resize(A_);
+            chunk.T.cleared.resize(A_, false);
+            if (W) {
+                chunk.W.triplets.resize(A_);
+                chunk.W.cleared.resize(A_, false);
+            }
+
+            std::vector<double> values;
+            for (size_t i = bounds[c]; i < bounds[c+1]; ++i) {
+                switch (lines[i][0]) {
+                    case 'T': processMatrix(chunk.T, i, stateMap_, stateMap_, S_, S_, values); break;
+                    case 'O': if (W) processMatrix(chunk.W, i, stateMap_, observationMap_, S_, O_, values); break;
+                    case 'R': processReward(lines[i], chunk.R); break;
+                    default: break;
+                }
+            }
+        });
+
+        T.resize(A_);
+        if (W) W->resize(A_);
+        parallelFor(A_, threads, [&](const size_t a) {
+            T[a] = buildMatrix(S_, S_, chunks, &Chunk::T, a);
+            if (W) (*W)[a] = buildMatrix(S_, O_, chunks, &Chunk::W, a);
+        });
+
+        // We only need the expected rewards for each state-action pair, so
+        // we avoid expanding rewards over all end states. Entries with a '*'
+        // end state set a base reward for their pair; the others override
+        // it for a single end state, as long as they come after it. Then
+        //
+        //     R(s,a) = base(s,a) * sum_s1 T(s,a,s1) + sum_overrides T(s,a,s1) * (val - base(s,a))
+        Matrix2D base = Matrix2D::Zero(S_, A_);
+        std::vector<size_t> baseSeq(S_ * A_, 0);
+        // Start state, end state, sequence number and value.
+        std::vector<std::vector<std::tuple<size_t, size_t, size_t, double>>> overrides(A_);
+
+        size_t seq = 0;
+        for (const auto & c : chunks) {
+            for (const auto & e : c.R) {
+                ++seq;
+                forEachIndex(e.a, A_, [&](const size_t a) {
+                    forEachIndex(e.s, S_, [&](const size_t s) {
+                        if (e.s1 == All) {
+                            base(s, a) = e.value;
+                            baseSeq[s * A_ + a] = seq;
+                        } else {
+                            overrides[a].emplace_back(s, e.s1, seq, e.value);
+                        }
+                    });
+                });
+            }
+        }
+
+        Matrix2D rewards(S_, A_);
+        parallelFor(A_, threads, [&](const size_t a) {
+            rewards.col(a) = base.col(a).cwiseProduct(T[a] * Vector::Ones(S_));
+
+            auto & ov = overrides[a];
+            std::sort(std::begin(ov), std::end(ov));
+            for (size_t j = 0; j < ov.size(); ++j) {
+                const auto & [s, s1, sq, val] = ov[j];
+                // Only the last entry for each transition matters.
+                if (j + 1 < ov.size() && std::get<0>(ov[j+1]) == s && std::get<1>(ov[j+1]) == s1) continue;
+                if (sq > baseSeq[s * A_ + a])
+                    rewards(s, a) += T[a].coeff(s, s1) * (val - base(s, a));
+            }
+        });
+
+        R.resize(S_, A_);
+        for (size_t s = 0; s < S_; ++s)
+            for (size_t a = 0; a < A_; ++a)
+                if (checkDifferentSmall(rewards(s, a), 0.0))
+                    R.insert(s, a) = rewards(s, a);
+        R.makeCompressed();
+    }
 }
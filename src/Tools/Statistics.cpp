@@ -3,6 +3,7 @@
 #include <iostream>
 #include <tuple>
 #include <cmath>
+#include <stdexcept>
 
 namespace AIToolbox {
     Statistics::Statistics(size_t timesteps) :
@@ -24,6 +25,21 @@ namespace AIToolbox {
         sqsum += currentCumulativeValue_ * currentCumulativeValue_;
     }
 
+    void Statistics::merge(const Statistics & other) {
+        if (other.data_.size() != data_.size())
+            throw std::invalid_argument("Cannot merge Statistics with a different number of timesteps");
+
+        for (size_t t = 0; t < data_.size(); ++t) {
+            auto & [count, sum, square, sqsum] = data_[t];
+            const auto & [oCount, oSum, oSquare, oSqsum] = other.data_[t];
+
+            count += oCount;
+            sum += oSum;
+            square += oSquare;
+            sqsum += oSqsum;
+        }
+    }
+
     Statistics::Results Statistics::process() const {
         Results retval;
         retval.reserve(data_.size());
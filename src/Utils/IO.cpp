@@ -2,6 +2,17 @@
 
 #include <limits>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AI_IO_USE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <AIToolbox/Logging.hpp>
 
@@ -280,4 +291,58 @@ namespace AIToolbox {
         if (is) t = std::move(in);
         return is;
     }
+
+    // ################################################
+    // ################## MAPPED FILE #################
+    // ################################################
+
+    MappedFile::MappedFile(const std::string & filename) :
+            data_(nullptr), size_(0), mapped_(false)
+    {
+#ifdef AI_IO_USE_MMAP
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Could not open file '" + filename + "'");
+
+        struct stat info;
+        if (::fstat(fd, &info) == -1) {
+            ::close(fd);
+            throw std::runtime_error("Could not read file '" + filename + "'");
+        }
+        size_ = info.st_size;
+
+        // Empty files cannot be mapped, but they also have nothing to read.
+        if (size_ > 0) {
+            void * data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char *>(data);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+        if (mapped_ || size_ == 0) return;
+#endif
+        // Fallback: read the whole file in memory.
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Could not open file '" + filename + "'");
+
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        buffer_ = std::move(contents).str();
+
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef AI_IO_USE_MMAP
+        if (mapped_) ::munmap(const_cast<char *>(data_), size_);
+#endif
+    }
+
+    std::string_view MappedFile::getData() const {
+        return std::string_view(data_, size_);
+    }
 }
@@ -0,0 +1,43 @@
+#include <AIToolbox/Utils/Instrumentation.hpp>
+
+#include <atomic>
+
+#include <AIToolbox/Utils/LP.hpp>
+
+namespace AIToolbox {
+    namespace {
+        std::atomic<bool> instrumentationEnabled = false;
+    }
+
+    double SolverStatistics::getSimulationsPerSecond() const {
+        if (seconds <= 0.0) return 0.0;
+        return simulations / seconds;
+    }
+
+    void setInstrumentationEnabled(const bool enabled) {
+        instrumentationEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isInstrumentationEnabled() {
+        return instrumentationEnabled.load(std::memory_order_relaxed);
+    }
+
+    SolverStatisticsRecorder::SolverStatisticsRecorder(SolverStatistics & stats, const bool countLPCalls) :
+            stats_(nullptr), countLPCalls_(countLPCalls), lpSolves_(0)
+    {
+        stats = {};
+        if (!isInstrumentationEnabled()) return;
+
+        stats_ = &stats;
+        lpSolves_ = LP::getThreadSolves();
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    SolverStatisticsRecorder::~SolverStatisticsRecorder() {
+        if (!stats_) return;
+
+        if (countLPCalls_)
+            stats_->lpCalls += LP::getThreadSolves() - lpSolves_;
+        stats_->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+}
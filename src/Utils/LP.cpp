@@ -0,0 +1,162 @@
+#include <AIToolbox/Utils/LP.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+
+#include "LP/LPBackend.hpp"
+
+#ifndef AI_LP_DEFAULT_BACKEND
+#define AI_LP_DEFAULT_BACKEND Automatic
+#endif
+
+namespace AIToolbox {
+    namespace {
+        // LPs may be constructed concurrently from worker threads.
+        std::atomic<LP::Backend> defaultBackend = LP::Backend::AI_LP_DEFAULT_BACKEND;
+        thread_local LP::Statistics threadStats;
+
+        LP::Backend selectBackend(const LP::Backend backend, const size_t vars) {
+            if (backend != LP::Backend::Automatic)
+                return backend;
+            if (const auto def = defaultBackend.load(std::memory_order_relaxed); def != LP::Backend::Automatic)
+                return def;
+            return vars <= LP::DenseSimplexMaxVariables ? LP::Backend::DenseSimplex : LP::Backend::LpSolve;
+        }
+    }
+
+    struct LP::LP_impl {
+        LP_impl(size_t vars, Backend backend);
+        void resize(size_t vars);
+
+        Backend type_;
+        std::unique_ptr<LPBackend> backend_;
+        // Row is stored from 1 since lp_solve reads element from 1 onwards.
+        std::unique_ptr<double[]> data_;
+    };
+
+    LP::LP_impl::LP_impl(const size_t vars, const Backend backend) :
+            type_(backend),
+            backend_(backend == Backend::LpSolve ? makeLpSolveBackend(vars) : makeDenseSimplexBackend(vars)),
+            data_(new double[vars + 1]) {}
+
+    void LP::LP_impl::resize(const size_t vars) {
+        data_.reset(new double[vars + 1]);
+    }
+
+    LP::~LP() = default;
+
+    LP::LP(const size_t varNumber, const Backend backend) :
+            pimpl_(new LP_impl(varNumber, selectBackend(backend, varNumber))),
+            row(pimpl_->data_.get()+1, varNumber),
+            varNumber_(varNumber), maximize_(false), warmStart_(false) {}
+
+    void LP::setObjective(const size_t n, const bool maximize) {
+        pimpl_->backend_->setObjective(n, maximize);
+        maximize_ = maximize;
+    }
+
+    void LP::setObjective(const bool maximize) {
+        pimpl_->backend_->setObjective(pimpl_->data_.get(), maximize);
+        maximize_ = maximize;
+    }
+
+    void LP::pushRow(const Constraint c, const double value) {
+        pimpl_->backend_->pushRow(pimpl_->data_.get(), c, value);
+    }
+
+    void LP::pushRows(const Matrix2D & rows, const Constraint c, const Vector & values) {
+        assert(static_cast<size_t>(rows.cols()) == varNumber_);
+        assert(rows.rows() == values.size());
+
+        pimpl_->backend_->pushRows(rows, c, values);
+    }
+
+    void LP::popRow() {
+        pimpl_->backend_->popRow();
+    }
+
+    size_t LP::addColumn() {
+        ++varNumber_;
+        // Add element to row
+        pimpl_->resize(varNumber_);
+        // Reassign MAP to new row
+        new (&row) Eigen::Map<Vector>(pimpl_->data_.get()+1, varNumber_);
+        // Add new empty column to LP
+        pimpl_->backend_->addColumn();
+
+        return varNumber_;
+    }
+
+    void LP::setUnbounded(const size_t n) {
+        pimpl_->backend_->setUnbounded(n);
+    }
+
+    std::optional<Vector> LP::solve(const size_t variables, double * objective) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto before = stats_;
+        auto solution = pimpl_->backend_->solve(variables, objective, stats_);
+
+        ++stats_.solves;
+        stats_.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        threadStats += stats_;
+        threadStats -= before;
+
+        return solution;
+    }
+
+    void LP::resize(const size_t rows) {
+        pimpl_->backend_->resize(rows);
+    }
+
+    double LP::getPrecision() {
+        // I'm ignorant and cannot make much sense of the epsilons that can be
+        // read from lp_solve (get_epsd, get_epsel, get_epsint, etc..) so I'm
+        // not sure which one would be best returned here.
+        // The number I return is the default minimal accuracy for a successful
+        // solve (IIUC). The DenseSimplex is at least as precise.
+        return 5e-7;
+        // The equivalent call to obtain this number (can't work as a static
+        // method though) would be:
+        // return static_cast<double>(get_break_numeric_accuracy(pimpl_->lp_.get()));
+    }
+
+    void LP::setWarmStart(const bool warmStart) {
+        warmStart_ = warmStart;
+        pimpl_->backend_->setWarmStart(warmStart);
+    }
+
+    bool LP::getWarmStart() const {
+        return warmStart_;
+    }
+
+    LP::Backend LP::getBackend() const {
+        return pimpl_->type_;
+    }
+
+    void LP::setDefaultBackend(const Backend backend) {
+        defaultBackend.store(backend, std::memory_order_relaxed);
+    }
+
+    LP::Backend LP::getDefaultBackend() {
+        return defaultBackend.load(std::memory_order_relaxed);
+    }
+
+    const LP::Statistics & LP::getStatistics() const {
+        return stats_;
+    }
+
+    void LP::resetStatistics() {
+        stats_ = {};
+    }
+
+    size_t LP::getThreadSolves() {
+        return threadStats.solves;
+    }
+
+    const LP::Statistics & LP::getThreadStatistics() {
+        return threadStats;
+    }
+}
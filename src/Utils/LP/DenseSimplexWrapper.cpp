@@ -0,0 +1,76 @@
+#include "LPBackend.hpp"
+
+#include <AIToolbox/Utils/LP/DenseSimplex.hpp>
+
+namespace AIToolbox {
+    class DenseSimplexBackend : public LPBackend {
+        public:
+            DenseSimplexBackend(size_t vars) : lp_(vars) {}
+
+            void setObjective(const size_t n, const bool maximize) override {
+                lp_.setObjective(n, maximize);
+            }
+
+            void setObjective(double * row, const bool maximize) override {
+                lp_.setObjective(Eigen::Map<Vector>(row + 1, lp_.getVariables()), maximize);
+            }
+
+            void pushRow(double * row, const LP::Constraint c, const double value) override {
+                lp_.pushRow(Eigen::Map<Vector>(row + 1, lp_.getVariables()), c, value);
+            }
+
+            void pushRows(const Matrix2D & rows, const LP::Constraint c, const Vector & values) override {
+                lp_.reserve(lp_.getRows() + rows.rows());
+                for (int r = 0; r < rows.rows(); ++r)
+                    lp_.pushRow(rows.row(r).transpose(), c, values[r]);
+            }
+
+            void popRow() override { lp_.popRow(); }
+            void addColumn() override { lp_.addColumn(); }
+            void setUnbounded(const size_t n) override { lp_.setUnbounded(n); }
+            void setWarmStart(const bool warmStart) override { lp_.setWarmStart(warmStart); }
+
+            void resize(const size_t rows) override {
+                while (lp_.getRows() > rows)
+                    lp_.popRow();
+                lp_.reserve(rows);
+            }
+
+            std::optional<Vector> solve(const size_t variables, double * objective, LP::Statistics & stats) override {
+                const bool warm = lp_.canWarmStart();
+
+                auto result = lp_.solve();
+                stats.pivots += lp_.getIterations();
+
+                // As with lp_solve, if a warm start fails we redo the solve
+                // from scratch. A failed solve discards the basis, so the
+                // second one starts from the all-slack basis.
+                if (warm) {
+                    ++stats.warmStarts;
+                    if (result == DenseSimplex::Result::Failed) {
+                        ++stats.fallbacks;
+                        result = lp_.solve();
+                        stats.pivots += lp_.getIterations();
+                    }
+                }
+
+                // Again as lp_solve, we return nothing if the problem is
+                // infeasible or unbounded.
+                std::optional<Vector> solution;
+                if (result == DenseSimplex::Result::Optimal)
+                    solution = lp_.getSolution().head(variables);
+
+                if (objective)
+                    *objective = solution ? lp_.getObjective() : 0.0;
+
+                return solution;
+            }
+
+        private:
+            DenseSimplex lp_;
+    };
+
+    std::unique_ptr<LPBackend> makeDenseSimplexBackend(const size_t vars) {
+        return std::make_unique<DenseSimplexBackend>(vars);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef AI_TOOLBOX_UTILS_LP_BACKEND_HEADER_FILE
+#define AI_TOOLBOX_UTILS_LP_BACKEND_HEADER_FILE
+
+#include <memory>
+#include <optional>
+
+#include <AIToolbox/Utils/LP.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This class is the interface that each LP library must implement.
+     *
+     * The LP class owns the `row` buffer and forwards all calls to an
+     * instance of this class. Rows are passed as they are stored by LP, that
+     * is following the lp_solve convention: the buffer has one element more
+     * than the number of variables, and element 0 is unused.
+     */
+    class LPBackend {
+        public:
+            virtual ~LPBackend() = default;
+
+            virtual void setObjective(size_t n, bool maximize) = 0;
+            virtual void setObjective(double * row, bool maximize) = 0;
+            virtual void pushRow(double * row, LP::Constraint c, double value) = 0;
+            virtual void pushRows(const Matrix2D & rows, LP::Constraint c, const Vector & values) = 0;
+            virtual void popRow() = 0;
+            virtual void addColumn() = 0;
+            virtual void setUnbounded(size_t n) = 0;
+            virtual void resize(size_t rows) = 0;
+            virtual void setWarmStart(bool warmStart) = 0;
+
+            /**
+             * @brief This function solves the LP, and records the pivots and warm starts done.
+             */
+            virtual std::optional<Vector> solve(size_t variables, double * objective, LP::Statistics & stats) = 0;
+    };
+
+    std::unique_ptr<LPBackend> makeLpSolveBackend(size_t vars);
+    std::unique_ptr<LPBackend> makeDenseSimplexBackend(size_t vars);
+}
+
+#endif
@@ -1,45 +1,65 @@
-#include <AIToolbox/Utils/LP.hpp>
+#include "LPBackend.hpp"
 
 #include <type_traits>
+#include <cassert>
+#include <algorithm>
+#include <vector>
 
 #include <lpsolve/lp_lib.h>
 
 namespace AIToolbox {
     constexpr bool conversionNeeded = !std::is_same_v<REAL, double>;
 
-    template <typename Impl, bool realConversionNeeded>
-    struct ConversionArray {
-        ConversionArray(const size_t) {}
-        void conversionResize(size_t) {}
-        double * conversionData() { return static_cast<Impl*>(this)->data_.get(); }
+    class LpSolveBackend : public LPBackend {
+        public:
+            LpSolveBackend(size_t vars);
+
+            void setObjective(size_t n, bool maximize) override;
+            void setObjective(double * row, bool maximize) override;
+            void pushRow(double * row, LP::Constraint c, double value) override;
+            void pushRows(const Matrix2D & rows, LP::Constraint c, const Vector & values) override;
+            void popRow() override;
+            void addColumn() override;
+            void setUnbounded(size_t n) override;
+            void resize(size_t rows) override;
+            void setWarmStart(bool warmStart) override;
+            std::optional<Vector> solve(size_t variables, double * objective, LP::Statistics & stats) override;
+
+        private:
+            REAL * convert(double * row);
+
+            // Basis bookkeeping for warm starts.
+            void addRowsToBasis(int oldRows, int cols, int added);
+            void removeLastRowFromBasis(int rows, int cols);
+            void addColumnToBasis(int rows, int cols);
+            void invalidateBasis();
+
+            std::unique_ptr<lprec, void(*)(lprec*)> lp_;
+            size_t vars_;
+            bool warmStart_;
+
+            // The basis is stored in lp_solve's own format: element 0 is unused,
+            // elements [1, rows] are the basic variables, and the rest are the
+            // nonbasic ones. Variables [1, rows] are the row slacks, while the
+            // ones after are the columns. Negative indeces are at their lower
+            // bound, positive ones at their upper bound.
+            std::vector<int> basis_;
+            bool basisValid_;
+
+            // When popping a row whose slack is nonbasic we can't easily shrink
+            // the basis, so we keep it around in case a new row is pushed in
+            // the same place (which is what WitnessLP does).
+            std::vector<int> stash_;
+            int stashRows_;
+
+            // Buffer for REAL conversions, and for pushRows.
+            std::vector<REAL> conv_;
+            std::vector<int> batchCols_;
     };
 
-    template <typename Impl>
-    struct ConversionArray<Impl, true> {
-        ConversionArray(const size_t vars) : conv_(new REAL[vars + 1]) {}
-        REAL * conversionData() {
-            auto & row = static_cast<Impl*>(this)->data_.get();
-            for (int v = 1; v < std::size(row); ++v )
-                conv_[v] = static_cast<REAL>(row[v]);
-            return conv_.get();
-        }
-        void conversionResize(const size_t vars) {
-            conv_.reset(new REAL[vars + 1]);
-        }
-        std::unique_ptr<REAL[]> conv_;
-    };
-
-    struct LP::LP_impl : public ConversionArray<LP_impl, conversionNeeded> {
-        LP_impl(size_t vars);
-        void resize(size_t vars);
-
-        std::unique_ptr<lprec, void(*)(lprec*)> lp_;
-        std::unique_ptr<double[]> data_;
-    };
-
-    LP::LP_impl::LP_impl(const size_t vars) :
-            ConversionArray(vars), lp_(make_lp(0, vars), delete_lp),
-            data_(new double[vars + 1])
+    LpSolveBackend::LpSolveBackend(const size_t vars) :
+            lp_(make_lp(0, vars), delete_lp), vars_(vars), warmStart_(false),
+            basisValid_(false), stashRows_(0)
     {
         // Make lp shut up. Could redirect stream to /dev/null if needed.
         set_verbose(lp_.get(), SEVERE /*or CRITICAL*/);
@@ -55,9 +75,83 @@ namespace AIToolbox {
         // set_BFP(lp_.get(), "../../libbfp_etaPFI.so");
     }
 
-    void LP::LP_impl::resize(const size_t vars) {
-        data_.reset(new double[vars + 1]);
-        conversionResize(vars);
+    REAL * LpSolveBackend::convert(double * row) {
+        if constexpr (conversionNeeded) {
+            conv_.resize(vars_ + 1);
+            for (size_t v = 1; v <= vars_; ++v)
+                conv_[v] = static_cast<REAL>(row[v]);
+            return conv_.data();
+        } else {
+            return row;
+        }
+    }
+
+    void LpSolveBackend::addRowsToBasis(const int oldRows, const int cols, const int added) {
+        if (!basisValid_) {
+            // If we are back to the same shape of the stashed basis, we
+            // reuse it. The new rows will likely be similar to the old ones.
+            if (stashRows_ == oldRows + added) {
+                basis_.swap(stash_);
+                basisValid_ = true;
+            }
+            stashRows_ = 0;
+            return;
+        }
+        stashRows_ = 0;
+
+        // Columns come after the slacks, so they get shifted. The new slacks
+        // are basic, so that the basis stays valid.
+        for (auto & b : basis_) {
+            if (std::abs(b) > oldRows)
+                b += b > 0 ? added : -added;
+        }
+        basis_.insert(std::begin(basis_) + oldRows + 1, added, 0);
+        for (int i = 1; i <= added; ++i)
+            basis_[oldRows + i] = -(oldRows + i);
+
+        assert(static_cast<int>(basis_.size()) == oldRows + added + cols + 1);
+    }
+
+    void LpSolveBackend::removeLastRowFromBasis(const int rows, const int cols) {
+        if (!basisValid_) {
+            stashRows_ = 0;
+            return;
+        }
+        const auto begin = std::begin(basis_) + 1;
+        const auto pos = std::find_if(begin, std::end(basis_), [rows](int b){ return std::abs(b) == rows; });
+        assert(pos != std::end(basis_));
+
+        if (pos >= begin + rows) {
+            // The slack is nonbasic, so one of the other variables would
+            // need to leave the basis. Finding one which keeps the basis
+            // non-singular is not worth it, so we give up on it.
+            basis_.swap(stash_);
+            stashRows_ = rows;
+            basisValid_ = false;
+            return;
+        }
+        basis_.erase(pos);
+        for (auto & b : basis_) {
+            if (std::abs(b) > rows)
+                b += b > 0 ? -1 : 1;
+        }
+        assert(static_cast<int>(basis_.size()) == rows + cols);
+    }
+
+    void LpSolveBackend::addColumnToBasis(const int rows, const int cols) {
+        stashRows_ = 0;
+        if (!basisValid_) return;
+        // New columns are nonbasic at their lower bound.
+        basis_.push_back(-(rows + cols));
+    }
+
+    void LpSolveBackend::invalidateBasis() {
+        basisValid_ = false;
+        stashRows_ = 0;
+    }
+
+    constexpr bool isSolved(const int result) {
+        return result == OPTIMAL || result == SUBOPTIMAL;
     }
 
     constexpr int toLpSolveConstraint(LP::Constraint c) {
@@ -68,71 +162,118 @@ namespace AIToolbox {
         return EQ;
     }
 
-    LP::~LP() = default;
-
-    // Row is initialized from 1 since lp_solve reads element from 1 onwards
-    LP::LP(const size_t varNumber) :
-            pimpl_(new LP_impl(varNumber)), row(pimpl_->data_.get()+1, varNumber),
-            varNumber_(varNumber), maximize_(false) {}
-
-    void LP::setObjective(const size_t n, const bool maximize) {
-        set_obj(pimpl_->lp_.get(), n+1, 1.0);
+    void LpSolveBackend::setObjective(const size_t n, const bool maximize) {
+        set_obj(lp_.get(), n+1, 1.0);
         if (maximize)
-            set_maxim(pimpl_->lp_.get());
+            set_maxim(lp_.get());
         else
-            set_minim(pimpl_->lp_.get());
-        maximize_ = maximize;
+            set_minim(lp_.get());
     }
 
-    void LP::setObjective(const bool maximize) {
-        set_obj_fn(pimpl_->lp_.get(), pimpl_->conversionData());
+    void LpSolveBackend::setObjective(double * row, const bool maximize) {
+        set_obj_fn(lp_.get(), convert(row));
 
         if (maximize)
-            set_maxim(pimpl_->lp_.get());
+            set_maxim(lp_.get());
         else
-            set_minim(pimpl_->lp_.get());
-        maximize_ = maximize;
+            set_minim(lp_.get());
+    }
+
+    void LpSolveBackend::pushRow(double * row, const LP::Constraint c, const double value) {
+        auto lp = lp_.get();
+        const int rows = get_Nrows(lp);
+        add_constraint(lp, convert(row), toLpSolveConstraint(c), static_cast<REAL>(value));
+        addRowsToBasis(rows, get_Ncolumns(lp), 1);
     }
 
-    void LP::pushRow(const Constraint c, const double value) {
-        add_constraint(pimpl_->lp_.get(), pimpl_->conversionData(), toLpSolveConstraint(c), static_cast<REAL>(value));
+    void LpSolveBackend::pushRows(const Matrix2D & rows, const LP::Constraint c, const Vector & values) {
+        auto lp = lp_.get();
+        const int oldRows = get_Nrows(lp);
+        const int cols = get_Ncolumns(lp);
+        const int added = rows.rows();
+        if (added == 0) return;
+
+        // Reserve all the space we need in one go.
+        resize_lp(lp, oldRows + added, cols);
+
+        if (batchCols_.size() != vars_) {
+            batchCols_.resize(vars_);
+            for (size_t i = 0; i < vars_; ++i)
+                batchCols_[i] = i + 1;
+        }
+        conv_.resize(vars_);
+        const int type = toLpSolveConstraint(c);
+        for (int r = 0; r < added; ++r) {
+            for (size_t i = 0; i < vars_; ++i)
+                conv_[i] = static_cast<REAL>(rows(r, i));
+            add_constraintex(lp, vars_, conv_.data(), batchCols_.data(), type, static_cast<REAL>(values[r]));
+        }
+        addRowsToBasis(oldRows, cols, added);
     }
 
-    // TODO: Implement this version of pushRow to improve performance.
+    // TODO: Implement a sparse version of pushRow to improve performance.
     // void LP::pushRow(const std::vector<int> & ids, const Constraint c, const double value) {
     //     add_constraintex(pimpl_->lp_.get(), ids.size(), pimpl_->conversionData(), ids.data(), toLpSolveConstraint(c), static_cast<REAL>(value));
     // }
 
-    void LP::popRow() {
-        del_constraint(pimpl_->lp_.get(), get_Nrows(pimpl_->lp_.get()));
+    void LpSolveBackend::popRow() {
+        auto lp = lp_.get();
+        const int rows = get_Nrows(lp);
+        del_constraint(lp, rows);
+        removeLastRowFromBasis(rows, get_Ncolumns(lp));
     }
 
-    size_t LP::addColumn() {
-        ++varNumber_;
-        // Add element to row
-        pimpl_->resize(varNumber_);
-        // Reassign MAP to new row
-        new (&row) Eigen::Map<Vector>(pimpl_->data_.get()+1, varNumber_);
+    void LpSolveBackend::addColumn() {
+        ++vars_;
         // Add new empty column to LP
-        add_columnex(pimpl_->lp_.get(), 0, NULL, NULL);
+        add_columnex(lp_.get(), 0, NULL, NULL);
+        addColumnToBasis(get_Nrows(lp_.get()), vars_);
+    }
 
-        return varNumber_;
+    void LpSolveBackend::setUnbounded(const size_t n) {
+        set_unbounded(lp_.get(), n+1);
+        // Free nonbasic variables have no bound to sit on.
+        invalidateBasis();
     }
 
-    void LP::setUnbounded(const size_t n) {
-        set_unbounded(pimpl_->lp_.get(), n+1);
+    void LpSolveBackend::setWarmStart(const bool warmStart) {
+        warmStart_ = warmStart;
+        if (!warmStart_) invalidateBasis();
     }
 
-    std::optional<Vector> LP::solve(const size_t variables, double * objective) {
-        auto lp = pimpl_->lp_.get();
-        // lp_solve uses the result of the previous runs to bootstrap
-        // the new solution. Sometimes this breaks down for some reason,
-        // so we just avoid it - it does not really even give a performance
-        // boost..
-        default_basis(lp);
+    std::optional<Vector> LpSolveBackend::solve(const size_t variables, double * objective, LP::Statistics & stats) {
+        auto lp = lp_.get();
+
+        // lp_solve could use the result of the previous runs to bootstrap
+        // the new solution on its own. Sometimes this breaks down for some
+        // reason, so by default we just avoid it. When warm starting, we
+        // instead explicitly feed the basis we have kept in sync with the
+        // rows and columns, and redo the solve from scratch if it fails.
+        const bool warm = warmStart_ && basisValid_ && set_basis(lp, basis_.data(), TRUE);
+        if (!warm)
+            default_basis(lp);
+
+        // print_lp(lp_.get());
+        auto result = ::solve(lp);
+        stats.pivots += get_total_iter(lp);
+
+        if (warm) {
+            ++stats.warmStarts;
+            if (!isSolved(result)) {
+                ++stats.fallbacks;
+                default_basis(lp);
+                result = ::solve(lp);
+                stats.pivots += get_total_iter(lp);
+            }
+        }
 
-        // print_lp(pimpl_->lp_.get());
-        const auto result = ::solve(lp);
+        if (warmStart_ && isSolved(result)) {
+            basis_.resize(1 + get_Nrows(lp) + get_Ncolumns(lp));
+            basisValid_ = get_basis(lp, basis_.data(), TRUE);
+            stashRows_ = 0;
+        } else {
+            invalidateBasis();
+        }
 
         REAL * vp;
         get_ptr_variables(lp, &vp);
@@ -142,25 +283,25 @@ namespace AIToolbox {
 
         std::optional<Vector> solution;
 
-        if ( result == 0 || result == 1 )
+        if ( isSolved(result) )
             solution = Eigen::Map<Vector>(vp, variables);
 
         return solution;
     }
 
-    void LP::resize(const size_t rows) {
-        resize_lp(pimpl_->lp_.get(), rows, row.size());
+    void LpSolveBackend::resize(const size_t rows) {
+        auto lp = lp_.get();
+        const int cols = get_Ncolumns(lp);
+        for (int r = get_Nrows(lp); r > static_cast<int>(rows); --r) {
+            removeLastRowFromBasis(r, cols);
+            // The stash is only useful for a single popped row.
+            stashRows_ = 0;
+        }
+
+        resize_lp(lp, rows, vars_);
     }
 
-    double LP::getPrecision() {
-        // I'm ignorant and cannot make much sense of the epsilons that can be
-        // read from lp_solve (get_epsd, get_epsel, get_epsint, etc..) so I'm
-        // not sure which one would be best returned here.
-        // The number I return is the default minimal accuracy for a successful
-        // solve (IIUC).
-        return 5e-7;
-        // The equivalent call to obtain this number (can't work as a static
-        // method though) would be:
-        // return static_cast<double>(get_break_numeric_accuracy(pimpl_->lp_.get()));
+    std::unique_ptr<LPBackend> makeLpSolveBackend(const size_t vars) {
+        return std::make_unique<LpSolveBackend>(vars);
     }
 }
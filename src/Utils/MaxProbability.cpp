@@ -0,0 +1,323 @@
+#include <AIToolbox/Utils/MaxProbability.hpp>
+
+#include <array>
+#include <numbers>
+#include <stdexcept>
+
+#include <boost/math/distributions/students_t.hpp>
+#include <boost/math/special_functions/beta.hpp>
+#include <boost/math/quadrature/gauss_kronrod.hpp>
+
+namespace AIToolbox {
+    namespace {
+        /**
+         * @brief This class maps a continuous distribution to a bounded integration domain.
+         *
+         * Each distribution is integrated over a variable t, where x(t) is
+         * its value and weight(t) = f(x(t)) * x'(t) is bounded. The domain
+         * is cut where the remaining tail mass is negligible.
+         */
+        class Transform {
+            public:
+                Transform(const ValueDistribution & d) : d_(d) {
+                    using K = ValueDistribution::Kind;
+                    switch (d.kind) {
+                        case K::Gaussian:
+                            lo_ = -9.0; hi_ = 9.0;
+                            logC_ = -0.5 * std::log(2.0 * std::numbers::pi);
+                            break;
+                        case K::StudentT: {
+                            // The weight is proportional to cos(t)^(dof-1),
+                            // which is below exp(-(dof-1) t^2 / 2).
+                            const double dof = d.p0;
+                            hi_ = dof > 1.0 ? std::min(std::numbers::pi / 2.0, 9.0 / std::sqrt(dof - 1.0)) : std::numbers::pi / 2.0;
+                            lo_ = -hi_;
+                            logC_ = std::lgamma((dof + 1.0) / 2.0) - std::lgamma(dof / 2.0) - 0.5 * std::log(std::numbers::pi);
+                            break;
+                        }
+                        case K::Beta: {
+                            const double a = d.p0, b = d.p1;
+                            lo_ = toT(boost::math::ibeta_inv(a, b, 1e-15));
+                            hi_ = toT(boost::math::ibetac_inv(a, b, 1e-15));
+                            logC_ = std::log(2.0) + std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b);
+                            break;
+                        }
+                        default:
+                            // Point distributions are never integrated.
+                            lo_ = hi_ = logC_ = 0.0;
+                    }
+                }
+
+                double toX(const double t) const {
+                    using K = ValueDistribution::Kind;
+                    switch (d_.kind) {
+                        case K::Gaussian: return d_.p0 + d_.p1 * t;
+                        case K::StudentT: return d_.p1 + d_.p2 * std::sqrt(d_.p0) * std::tan(t);
+                        default:          return std::pow(std::sin(t), 2);
+                    }
+                }
+
+                double toT(const double x) const {
+                    using K = ValueDistribution::Kind;
+                    switch (d_.kind) {
+                        case K::Gaussian: return (x - d_.p0) / d_.p1;
+                        case K::StudentT: return std::atan((x - d_.p1) / (d_.p2 * std::sqrt(d_.p0)));
+                        default:          return std::asin(std::sqrt(std::clamp(x, 0.0, 1.0)));
+                    }
+                }
+
+                double weight(const double t) const {
+                    using K = ValueDistribution::Kind;
+                    switch (d_.kind) {
+                        case K::Gaussian: return std::exp(logC_ - 0.5 * t * t);
+                        case K::StudentT: return std::exp(logC_ + (d_.p0 - 1.0) * std::log(std::cos(t)));
+                        default:          return std::exp(logC_ + logPow(std::sin(t), 2.0 * d_.p0 - 1.0)
+                                                                + logPow(std::cos(t), 2.0 * d_.p1 - 1.0));
+                    }
+                }
+
+                double lo() const { return lo_; }
+                double hi() const { return hi_; }
+
+                /**
+                 * @brief This function returns the cumulative distribution function at the input point.
+                 *
+                 * Exact CDFs (especially the Student-t one) are expensive,
+                 * and we need lots of them. Instead, we approximate the
+                 * (smooth) weight over the domain with a Chebyshev series,
+                 * which we then integrate analytically. The series is built
+                 * on the first call.
+                 */
+                double cdf(const double x) const {
+                    if (d_.kind == ValueDistribution::Kind::Gaussian || (d_.kind == ValueDistribution::Kind::StudentT && d_.p0 < 1.0))
+                        return d_.cdf(x);
+
+                    const double t = toT(x);
+                    if (t <= lo_) return 0.0;
+                    if (t >= hi_) return 1.0;
+
+                    if (cdf_.empty()) buildCdf();
+                    return std::clamp(evalCdf(t) / total_, 0.0, 1.0);
+                }
+
+            private:
+                // Computes log(v^e), with 0^0 = 1.
+                static double logPow(const double v, const double e) {
+                    return e == 0.0 ? 0.0 : e * std::log(v);
+                }
+
+                void buildCdf() const {
+                    const auto & cosines = chebyshevCosines();
+
+                    const double mid = 0.5 * (hi_ + lo_), half = 0.5 * (hi_ - lo_);
+
+                    std::array<double, ChebN> w, c;
+                    for (size_t j = 0; j < ChebN; ++j)
+                        w[j] = weight(mid + half * cosines[1 * ChebN + j]);
+                    for (size_t k = 0; k < ChebN; ++k) {
+                        double sum = 0.0;
+                        for (size_t j = 0; j < ChebN; ++j)
+                            sum += w[j] * cosines[k * ChebN + j];
+                        c[k] = sum * 2.0 / ChebN;
+                    }
+
+                    // Integrate the series, so that the integral is zero at lo_.
+                    cdf_.resize(ChebN);
+                    const double con = 0.5 * half;
+                    double sum = 0.0, fac = 1.0;
+                    for (size_t k = 1; k < ChebN - 1; ++k) {
+                        cdf_[k] = con * (c[k-1] - c[k+1]) / k;
+                        sum += fac * cdf_[k];
+                        fac = -fac;
+                    }
+                    cdf_[ChebN-1] = con * c[ChebN-2] / (ChebN - 1);
+                    sum += fac * cdf_[ChebN-1];
+                    cdf_[0] = 2.0 * sum;
+
+                    // Normalize away the cut tails and approximation errors.
+                    total_ = evalCdf(hi_);
+                }
+
+                double evalCdf(const double t) const {
+                    const double u = (2.0 * t - lo_ - hi_) / (hi_ - lo_), u2 = 2.0 * u;
+                    double d = 0.0, dd = 0.0;
+                    for (size_t k = ChebN - 1; k > 0; --k) {
+                        const double sv = d;
+                        d = u2 * d - dd + cdf_[k];
+                        dd = sv;
+                    }
+                    return u * d - dd + 0.5 * cdf_[0];
+                }
+
+                // Returns cos(pi * k * (j + 0.5) / N) at [k * N + j].
+                static const std::vector<double> & chebyshevCosines() {
+                    static const std::vector<double> cosines = []{
+                        std::vector<double> retval(ChebN * ChebN);
+                        for (size_t k = 0; k < ChebN; ++k)
+                            for (size_t j = 0; j < ChebN; ++j)
+                                retval[k * ChebN + j] = std::cos(std::numbers::pi * k * (j + 0.5) / ChebN);
+                        return retval;
+                    }();
+                    return cosines;
+                }
+
+                static constexpr size_t ChebN = 64;
+
+                const ValueDistribution & d_;
+                double lo_, hi_, logC_;
+                mutable std::vector<double> cdf_;
+                mutable double total_;
+        };
+
+        // Returns the point around which a distribution concentrates its
+        // mass, and the width of that region.
+        std::pair<double, double> location(const ValueDistribution & d) {
+            using K = ValueDistribution::Kind;
+            switch (d.kind) {
+                case K::Point:    return {d.p0, 0.0};
+                case K::Gaussian: return {d.p0, d.p1};
+                case K::StudentT: return {d.p1, d.p2};
+                default: {
+                    const double n = d.p0 + d.p1;
+                    return {d.p0 / n, std::sqrt(d.p0 * d.p1 / (n * n * (n + 1.0)))};
+                }
+            }
+        }
+
+        // Boost's adaptive quadrature uses a relative tolerance, which makes
+        // it refine needlessly the integrals of very unlikely arms. We want
+        // an absolute tolerance, so we do the bisection ourselves.
+        template <typename F>
+        double integrateAdaptive(const F & f, const double lo, const double hi, const double tolerance, const unsigned depth) {
+            using GK = boost::math::quadrature::gauss_kronrod<double, 15>;
+
+            // Without refinement, the error is reported as if over [-1, 1].
+            double error = 0.0;
+            const double retval = GK::integrate(f, lo, hi, 0, 0.0, &error);
+            if (error * 0.5 * (hi - lo) <= tolerance || depth == 0)
+                return retval;
+
+            const double mid = 0.5 * (lo + hi);
+            return integrateAdaptive(f, lo, mid, 0.5 * tolerance, depth - 1) +
+                   integrateAdaptive(f, mid, hi, 0.5 * tolerance, depth - 1);
+        }
+
+        double integratePoint(const std::vector<ValueDistribution> & dists, const std::vector<Transform> & transforms, const size_t a) {
+            const double v = dists[a].p0;
+            double p = 1.0;
+            for (size_t b = 0; b < dists.size() && p > 0.0; ++b) {
+                if (b == a) continue;
+                if (dists[b].kind == ValueDistribution::Kind::Point)
+                    // Ties go to the lowest index.
+                    p *= (dists[b].p0 < v || (dists[b].p0 == v && b > a)) ? 1.0 : 0.0;
+                else
+                    p *= transforms[b].cdf(v);
+            }
+            return p;
+        }
+
+        double integrateArm(const std::vector<ValueDistribution> & dists, const std::vector<Transform> & transforms, const size_t a, const double tolerance) {
+            if (dists[a].kind == ValueDistribution::Kind::Point)
+                return integratePoint(dists, transforms, a);
+
+            const auto & tr = transforms[a];
+
+            // We split the domain at our center, and at the centers of the
+            // distributions much narrower than us: these produce steep steps
+            // in the integrand, which the quadrature might otherwise miss.
+            const auto [center, width] = location(dists[a]);
+            std::vector<double> cuts{tr.lo(), tr.hi()};
+            for (const auto & d : dists) {
+                const auto [c, w] = location(d);
+                if (&d != &dists[a] && w * 4.0 > width) continue;
+
+                const double t = tr.toT(c);
+                if (t > tr.lo() && t < tr.hi())
+                    cuts.push_back(t);
+            }
+            std::sort(std::begin(cuts), std::end(cuts));
+            cuts.erase(std::unique(std::begin(cuts), std::end(cuts)), std::end(cuts));
+
+            // Below this the integrand does not matter anymore.
+            const double negligible = tolerance * 1e-6;
+            auto f = [&](const double t) {
+                const double x = tr.toX(t);
+                double p = tr.weight(t);
+                for (size_t b = 0; b < dists.size() && p > negligible; ++b) {
+                    if (b == a) continue;
+                    if (dists[b].kind == ValueDistribution::Kind::Point)
+                        p *= x >= dists[b].p0;
+                    else
+                        p *= transforms[b].cdf(x);
+                }
+                return p;
+            };
+
+            double retval = 0.0;
+            const double segmentTolerance = tolerance / (cuts.size() - 1);
+            for (size_t i = 1; i < cuts.size(); ++i)
+                retval += integrateAdaptive(f, cuts[i-1], cuts[i], segmentTolerance, 12);
+
+            return std::clamp(retval, 0.0, 1.0);
+        }
+
+        std::vector<Transform> makeTransforms(const std::vector<ValueDistribution> & dists) {
+            std::vector<Transform> retval;
+            retval.reserve(dists.size());
+            for (const auto & d : dists)
+                retval.emplace_back(d);
+            return retval;
+        }
+    }
+
+    ValueDistribution ValueDistribution::point(const double value) {
+        return {Kind::Point, value, 0.0, 0.0};
+    }
+
+    ValueDistribution ValueDistribution::gaussian(const double mean, const double stddev) {
+        if (stddev < 0.0) throw std::invalid_argument("Standard deviation must be non-negative");
+        if (stddev == 0.0) return point(mean);
+        return {Kind::Gaussian, mean, stddev, 0.0};
+    }
+
+    ValueDistribution ValueDistribution::studentT(const double dof, const double location, const double scale) {
+        if (dof <= 0.0) throw std::invalid_argument("Degrees of freedom must be positive");
+        if (scale < 0.0) throw std::invalid_argument("Scale must be non-negative");
+        if (scale == 0.0) return point(location);
+        return {Kind::StudentT, dof, location, scale};
+    }
+
+    ValueDistribution ValueDistribution::beta(const double alpha, const double beta) {
+        if (alpha < 0.5 || beta < 0.5) throw std::invalid_argument("Beta parameters must be at least 0.5");
+        return {Kind::Beta, alpha, beta, 0.0};
+    }
+
+    double ValueDistribution::cdf(const double x) const {
+        switch (kind) {
+            case Kind::Point:
+                return x >= p0 ? 1.0 : 0.0;
+            case Kind::Gaussian:
+                return 0.5 * std::erfc(-(x - p0) / (p1 * std::numbers::sqrt2));
+            case Kind::StudentT:
+                return boost::math::cdf(boost::math::students_t_distribution<double>(p0), (x - p1) / p2);
+            default:
+                if (x <= 0.0) return 0.0;
+                if (x >= 1.0) return 1.0;
+                return boost::math::ibeta(p0, p1, x);
+        }
+    }
+
+    Vector computeMaxProbabilities(const std::vector<ValueDistribution> & dists, const double tolerance) {
+        const auto transforms = makeTransforms(dists);
+
+        Vector retval(dists.size());
+        for (size_t a = 0; a < dists.size(); ++a)
+            retval[a] = integrateArm(dists, transforms, a, tolerance);
+
+        return retval;
+    }
+
+    double computeMaxProbability(const std::vector<ValueDistribution> & dists, const size_t a, const double tolerance) {
+        return integrateArm(dists, makeTransforms(dists), a, tolerance);
+    }
+}
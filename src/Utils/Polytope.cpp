@@ -56,6 +56,226 @@ namespace AIToolbox {
         return retval;
     }
 
+    namespace {
+        /**
+         * @brief This function computes the LP interpolation of a point given the Points compatible with it.
+         *
+         * This is the common part of both LPInterpolation() overloads.
+         *
+         * @param point The point to compute the value of.
+         * @param ubQ A set of Hyperplanes to use as a baseline surface.
+         * @param cornerVals The maximum values of ubQ at each corner.
+         * @param points All the Points in the surface.
+         * @param nonZeroStates The coordinates where the input point is not zero.
+         * @param compatiblePoints The ids of the Points to use for interpolation, in ascending order.
+         * @param heights The value of each compatible Point minus its value on the corner surface.
+         *
+         * @return The value of the point, and the interpolation coefficients.
+         */
+        std::tuple<double, Vector> interpolateWithCompatiblePoints(
+            const Point & point, const CompactHyperplanes & ubQ, const Vector & cornerVals,
+            const std::vector<Point> & points, const std::vector<size_t> & nonZeroStates,
+            const std::vector<size_t> & compatiblePoints, const std::vector<double> & heights)
+        {
+            const size_t S = point.size();
+
+            // If there's no other point on the same plane as this one, the V can't
+            // help us with the bound. So we just use the Q, and we copy its values in the
+            // corners of the point.
+            if (compatiblePoints.size() == 0) {
+                Vector retval(S + points.size());
+
+                retval.head(S).noalias() = point;
+                retval.tail(points.size()).setZero();
+
+                return std::make_tuple((point.transpose() * ubQ).maxCoeff(), std::move(retval));
+            }
+
+            double unscaledValue;
+            Vector result;
+
+            // If there's only a single compatible point, we don't really need to run
+            // an LP.
+            if (compatiblePoints.size() == 1) {
+                const auto & compPoint = points[compatiblePoints[0]];
+
+                result.resize(1);
+                result[0] = std::numeric_limits<double>::max();
+                for (const auto s : nonZeroStates)
+                    if (compPoint[s] != 0.0)
+                        result[0] = std::min(result[0], point[s] / compPoint[s]);
+
+                unscaledValue = result[0] * heights[0];
+            } else {
+                /*
+                 * Here we run the LP.
+                 *
+                 * In order to obtain the linear approximation for the upper bound of
+                 * the input point, given that we already know the values for a set of
+                 * points, we need to solve an LP in the form:
+                 *
+                 * c[0] * b[0][0] + c[1] * b[1][0] + ...                = bin[0]
+                 * c[0] * b[0][1] + c[1] * b[1][1] + ...                = bin[1]
+                 * c[0] * b[0][2] + c[1] * b[1][2] + ...                = bin[2]
+                 * ...
+                 * c[0] * v[0]    + c[1] * v[1]    + ... - K            = 0
+                 *
+                 * And we minimize K to get:
+                 *
+                 * argmin(c) = sum( c * v ) = K
+                 *
+                 * This way K will be the minimum upper bound possible for the input
+                 * point (bin), found by interpolating all other known points. At the
+                 * same time we apply the linear approximation by enforcing
+                 *
+                 * sum( c * b ) = bin
+                 *
+                 * We also set each c to be >= 0.
+                 *
+                 * OPTIMIZATIONS:
+                 *
+                 * Once we have defined the problem, we can apply a series of
+                 * optimizations to reduce the size of the LP to be solved. These were
+                 * taken from the MATLAB code published for the GapMin algorithm. Written
+                 * interpretation below is mine.
+                 *
+                 * - Nonzero & Compatible Points
+                 *
+                 * If the input point is restricted to a subset of dimensions in the
+                 * VFunction (meaning some of its values are zero), and we have points
+                 * in that exact same subset, we can just use those in order to determine
+                 * the upper bound of the input. This is true since additional dimensions
+                 * won't affect the ValueFunction in the particular subspace the input
+                 * point is in. All other points are discarded. Note that we'll need
+                 * to fill in zeroes for the coefficients of the discarded points after
+                 * we are done.
+                 *
+                 * - Removal of Corner Values
+                 *
+                 * Ideally, one would want the corner points/values to be included in
+                 * the list of points to use for interpolation, since they are needed.
+                 * However, all other point values can simply be scaled down as if the
+                 * corner values were zero, and the resulting solution would not change.
+                 * The only thing is that the values obtained for the target function
+                 * would need to be scaled back before being returned by the LP.
+                 *
+                 * The other thing is that removing the corner values from the
+                 * points also means removing the coefficients for them in the LP.
+                 * This is good as the LP is simpler, but pretty much makes it
+                 * infeasible. So what we do is change the constraints, and instead
+                 * of making them equal, we make them less or equal.
+                 *
+                 * In the end we're going to fix all missing numbers anyway by
+                 * filling the corners with the needed numbers.
+                 */
+
+                // We're going to have one column per compatible point (plus one, but
+                // that's implied).
+                LP lp(compatiblePoints.size() + 1);
+                lp.resize(nonZeroStates.size() + 1); // One row per state, plus the K constraint.
+                size_t i;
+
+                // Goal: minimize K.
+                lp.setObjective(compatiblePoints.size(), false);
+
+                // IMPORTANT: K is unbounded, since the value function may be negative.
+                lp.setUnbounded(compatiblePoints.size());
+
+                // By default we don't have K, only at the end.
+                lp.row[compatiblePoints.size()] = +0.0;
+
+                // So each row contains the same-index element from all the compatible
+                // points, and they should sum up to that same element in the input point.
+                for (const auto s : nonZeroStates) {
+                    i = 0;
+                    for (const auto b : compatiblePoints)
+                        lp.row[i++] = points[b][s];
+                    lp.pushRow(LP::Constraint::LessEqual, point[s]);
+                }
+
+                // Finally we setup the last row, using the values of the
+                // points minus their corner values.
+                for (i = 0; i < compatiblePoints.size(); ++i)
+                    lp.row[i] = heights[i];
+                lp.row[i] = -1.0;
+                lp.pushRow(LP::Constraint::Equal, 0.0);
+
+                // Now solve
+                auto tmp = lp.solve(compatiblePoints.size(), &unscaledValue);
+                if (!tmp)
+                    throw std::runtime_error("GapMin UB process failed!");
+                result = *tmp;
+            }
+
+            // We scale back the value as if we had considered the corners.
+            double ubValue = unscaledValue + point.transpose() * cornerVals;
+
+            Vector retval(S + points.size());
+            retval.setZero();
+
+            // And we fix the coefficients in order to actually make the equalities
+            // hold.
+            for (const auto s : nonZeroStates) {
+                double sum = 0.0;
+                for (size_t i = 0; i < compatiblePoints.size(); ++i)
+                    sum += points[compatiblePoints[i]][s] * result[i];
+                retval[s] = point[s] - sum;
+            }
+            for (size_t i = 0; i < compatiblePoints.size(); ++i)
+                retval[S + compatiblePoints[i]] = result[i];
+            // Remove infinitesimal/negative values
+            for (auto i = 0; i < retval.size(); ++i)
+                if (checkEqualSmall(retval[i], 0.0) || retval[i] < 0.0) retval[i] = 0.0;
+
+            return std::make_tuple(ubValue, std::move(retval));
+        }
+
+        /**
+         * @brief This function builds the output of the sawtoothInterpolation() overloads.
+         *
+         * @param point The point to compute the value of.
+         * @param ubQ A set of Hyperplanes to use as a baseline surface.
+         * @param cornerVals The maximum values of ubQ at each corner.
+         * @param pointsN The number of Points in the surface.
+         * @param minPoint The Point that gives the lowest sawtooth surface, if any.
+         * @param minI The id of minPoint.
+         * @param minC The ratio of minPoint used in the interpolation.
+         * @param minCF The amount by which minPoint lowers the corner surface.
+         *
+         * @return The value of the point, and the interpolation coefficients.
+         */
+        std::tuple<double, Vector> makeSawtoothResult(
+            const Point & point, const CompactHyperplanes & ubQ, const Vector & cornerVals,
+            const size_t pointsN, const Point * minPoint, const size_t minI,
+            const double minC, const double minCF)
+        {
+            const size_t S = point.size();
+
+            // Naive height
+            const auto basicV = (point.transpose() * ubQ).maxCoeff();
+            // Sawtooth height (note that minCF is negative)
+            const auto v = point.dot(cornerVals) + minCF;
+
+            Vector retval(S + pointsN);
+            // Set to zero all coefficients for the beliefs only, since we are
+            // going to write in the corner ones anyway.
+            retval.tail(pointsN).setZero();
+
+            // If we didn't need the interpolation to begin with (maybe we didn't
+            // find any points that can help us)..
+            if (!minPoint || basicV < v) {
+                retval.head(S).noalias() = point;
+
+                return std::make_tuple(std::min(basicV, v), std::move(retval));
+            }
+
+            retval.head(S).noalias() = point - *minPoint * minC;
+            retval[S + minI] = minC;
+
+            return std::make_tuple(v, std::move(retval));
+        }
+    }
+
     std::tuple<double, Vector> LPInterpolation(const Point & point, const CompactHyperplanes & ubQ, const PointSurface & ubV) {
         // Here we find all points that have the same "zeroes" as the input one.
         // This is done to reduce the amount of work the LP has to do.
@@ -86,157 +306,39 @@ namespace AIToolbox {
             }
         }
 
-        // If there's no other point on the same plane as this one, the V can't
-        // help us with the bound. So we just use the Q, and we copy its values in the
-        // corners of the point.
-        if (compatiblePoints.size() == 0) {
-            Vector retval(point.size() + ubV.first.size());
-
-            retval.head(point.size()).noalias() = point;
-            retval.tail(ubV.first.size()).setZero();
-
-            return std::make_tuple((point.transpose() * ubQ).maxCoeff(), std::move(retval));
-        }
-
         const Vector cornerVals = ubQ.rowwise().maxCoeff();
 
-        double unscaledValue;
-        Vector result;
-
-        // If there's only a single compatible point, we don't really need to run
-        // an LP.
-        if (compatiblePoints.size() == 1) {
-            const auto & compPoint = ubV.first[compatiblePoints[0]];
-
-            result.resize(1);
-            result[0] = (point.cwiseQuotient(compPoint)).minCoeff();
+        std::vector<double> heights;
+        heights.reserve(compatiblePoints.size());
+        for (const auto b : compatiblePoints) {
+            double val = ubV.second[b];
+            for (const auto s : nonZeroStates)
+                val -= ubV.first[b][s] * cornerVals[s];
+            heights.push_back(val);
+        }
 
-            unscaledValue = result[0] * (ubV.second[compatiblePoints[0]] - compPoint.transpose() * cornerVals);
-        } else {
-            /*
-             * Here we run the LP.
-             *
-             * In order to obtain the linear approximation for the upper bound of
-             * the input point, given that we already know the values for a set of
-             * points, we need to solve an LP in the form:
-             *
-             * c[0] * b[0][0] + c[1] * b[1][0] + ...                = bin[0]
-             * c[0] * b[0][1] + c[1] * b[1][1] + ...                = bin[1]
-             * c[0] * b[0][2] + c[1] * b[1][2] + ...                = bin[2]
-             * ...
-             * c[0] * v[0]    + c[1] * v[1]    + ... - K            = 0
-             *
-             * And we minimize K to get:
-             *
-             * argmin(c) = sum( c * v ) = K
-             *
-             * This way K will be the minimum upper bound possible for the input
-             * point (bin), found by interpolating all other known points. At the
-             * same time we apply the linear approximation by enforcing
-             *
-             * sum( c * b ) = bin
-             *
-             * We also set each c to be >= 0.
-             *
-             * OPTIMIZATIONS:
-             *
-             * Once we have defined the problem, we can apply a series of
-             * optimizations to reduce the size of the LP to be solved. These were
-             * taken from the MATLAB code published for the GapMin algorithm. Written
-             * interpretation below is mine.
-             *
-             * - Nonzero & Compatible Points
-             *
-             * If the input point is restricted to a subset of dimensions in the
-             * VFunction (meaning some of its values are zero), and we have points
-             * in that exact same subset, we can just use those in order to determine
-             * the upper bound of the input. This is true since additional dimensions
-             * won't affect the ValueFunction in the particular subspace the input
-             * point is in. All other points are discarded. Note that we'll need
-             * to fill in zeroes for the coefficients of the discarded points after
-             * we are done.
-             *
-             * - Removal of Corner Values
-             *
-             * Ideally, one would want the corner points/values to be included in
-             * the list of points to use for interpolation, since they are needed.
-             * However, all other point values can simply be scaled down as if the
-             * corner values were zero, and the resulting solution would not change.
-             * The only thing is that the values obtained for the target function
-             * would need to be scaled back before being returned by the LP.
-             *
-             * The other thing is that removing the corner values from the
-             * points also means removing the coefficients for them in the LP.
-             * This is good as the LP is simpler, but pretty much makes it
-             * infeasible. So what we do is change the constraints, and instead
-             * of making them equal, we make them less or equal.
-             *
-             * In the end we're going to fix all missing numbers anyway by
-             * filling the corners with the needed numbers.
-             */
-
-            // We're going to have one column per compatible point (plus one, but
-            // that's implied).
-            LP lp(compatiblePoints.size() + 1);
-            lp.resize(nonZeroStates.size() + 1); // One row per state, plus the K constraint.
-            size_t i;
-
-            // Goal: minimize K.
-            lp.setObjective(compatiblePoints.size(), false);
-
-            // IMPORTANT: K is unbounded, since the value function may be negative.
-            lp.setUnbounded(compatiblePoints.size());
-
-            // By default we don't have K, only at the end.
-            lp.row[compatiblePoints.size()] = +0.0;
-
-            // So each row contains the same-index element from all the compatible
-            // points, and they should sum up to that same element in the input point.
-            for (const auto s : nonZeroStates) {
-                i = 0;
-                for (const auto b : compatiblePoints)
-                    lp.row[i++] = ubV.first[b][s];
-                lp.pushRow(LP::Constraint::LessEqual, point[s]);
-            }
+        return interpolateWithCompatiblePoints(point, ubQ, cornerVals, ubV.first, nonZeroStates, compatiblePoints, heights);
+    }
 
-            // Finally we setup the last row.
-            i = 0;
-            for (const auto b : compatiblePoints) {
-                double val = ubV.second[b];
-                for (const auto s : nonZeroStates)
-                    val -= ubV.first[b][s] * cornerVals[s];
-                lp.row[i++] = val;
-            }
-            lp.row[i] = -1.0;
-            lp.pushRow(LP::Constraint::Equal, 0.0);
-
-            // Now solve
-            auto tmp = lp.solve(compatiblePoints.size(), &unscaledValue);
-            if (!tmp)
-                throw std::runtime_error("GapMin UB process failed!");
-            result = *tmp;
+    std::tuple<double, Vector> LPInterpolation(const Point & point, const CompactHyperplanes & ubQ, const IndexedPointSurface & ubV) {
+        std::vector<char> zeroStates(point.size());
+        std::vector<size_t> nonZeroStates;
+        for (size_t s = 0; s < zeroStates.size(); ++s) {
+            zeroStates[s] = checkEqualSmall(point[s], 0.0);
+            if (!zeroStates[s])
+                nonZeroStates.push_back(s);
         }
 
-        // We scale back the value as if we had considered the corners.
-        double ubValue = unscaledValue + point.transpose() * cornerVals;
+        // Here the index can skip whole groups of points at a time, and we
+        // already have the heights of all points cached.
+        const auto compatiblePoints = ubV.getCompatiblePoints(zeroStates);
 
-        Vector retval(point.size() + ubV.first.size());
-        retval.setZero();
+        std::vector<double> heights;
+        heights.reserve(compatiblePoints.size());
+        for (const auto b : compatiblePoints)
+            heights.push_back(ubV.getHeight(b));
 
-        // And we fix the coefficients in order to actually make the equalities
-        // hold.
-        for (const auto s : nonZeroStates) {
-            double sum = 0.0;
-            for (size_t i = 0; i < compatiblePoints.size(); ++i)
-                sum += ubV.first[compatiblePoints[i]][s] * result[i];
-            retval[s] = point[s] - sum;
-        }
-        retval.tail(compatiblePoints.size()) = result;
-        // Remove infinitesimal/negative values
-        for (auto i = 0; i < retval.size(); ++i)
-            if (checkEqualSmall(retval[i], 0.0) || retval[i] < 0.0) retval[i] = 0.0;
-
-        return std::make_tuple(ubValue, std::move(retval));
+        return interpolateWithCompatiblePoints(point, ubQ, ubV.getCornerValues(), ubV.getPoints(), nonZeroStates, compatiblePoints, heights);
     }
 
     std::tuple<double, Vector> sawtoothInterpolation(const Point & point, const CompactHyperplanes & ubQ, const PointSurface & ubV) {
@@ -253,7 +355,8 @@ namespace AIToolbox {
         // input point's value. Obviously we are going to pick the lowest, as
         // this function is computing an upper bound.
         size_t minI = 0;
-        double minCF = 0.0, minC;
+        double minCF = 0.0, minC = 0.0;
+        const Point * minPoint = nullptr;
         for (size_t i = 0; i < ubV.first.size(); ++i) {
             // This finds the corner of the simplex we can "skip" in order to
             // obtain the lowest surface possible at the input point.
@@ -288,37 +391,204 @@ namespace AIToolbox {
                     minC = c;
                     minCF = cf;
                     minI = i;
+                    minPoint = &ubV.first[i];
                 }
             }
 next:;
         }
-        // Naive height
-        const auto basicV = (point.transpose() * ubQ).maxCoeff();
-        // Sawtooth height (note that minCF is negative)
-        const auto v = point.dot(cornerVals) + minCF;
-
-        Vector retval(point.size() + ubV.first.size());
-        // Set to zero all coefficients for the beliefs only, since we are
-        // going to write in the corner ones anyway.
-        retval.tail(ubV.first.size()).setZero();
-
-        // If we didn't need the interpolation to begin with (maybe we didn't
-        // find any points that can help us)..
-        if (basicV < v) {
-            retval.head(point.size()).noalias() = point;
-
-            return std::make_tuple(basicV, std::move(retval));
+        return makeSawtoothResult(point, ubQ, cornerVals, ubV.first.size(), minPoint, minI, minC, minCF);
+    }
+
+    std::tuple<double, Vector> sawtoothInterpolation(const Point & point, const CompactHyperplanes & ubQ, const IndexedPointSurface & ubV) {
+        const auto & points = ubV.getPoints();
+
+        // Cache zero elements since checkEqualSmall is somewhat expensive.
+        std::vector<char> zeroStates(point.size());
+        for (size_t s = 0; s < zeroStates.size(); ++s)
+            zeroStates[s] = checkEqualSmall(point[s], 0.0);
+
+        size_t minI = 0;
+        double minCF = 0.0, minC = 0.0;
+        for (const auto & bucket : ubV.buckets_) {
+            // All points in a bucket share the same zeroes, so we can check
+            // compatibility with the input once for all of them.
+            if (bucket.ids.size() == 0) continue;
+            if (std::any_of(std::begin(bucket.support), std::end(bucket.support), [&](size_t s){ return zeroStates[s]; }))
+                continue;
+
+            // Points are sorted by height. Since the ratio c is at most 1,
+            // c * height is never lower than the height itself, so once we
+            // get to points that are not lower than what we have found we
+            // can stop.
+            for (const auto i : bucket.ids) {
+                const auto & data = ubV.data_[i];
+                const double height = ubV.getHeight(i);
+                if (height >= 0.0 || height > minCF) break;
+
+                // The ratio can't be higher than the one of the highest
+                // coordinate of the point, so we use it as a cheap check.
+                const double maxC = std::min(1.0, point[bucket.support[data.dominant]] * data.inverse[data.dominant]);
+                if (maxC * height > minCF) continue;
+
+                double c = 1.0;
+                for (size_t k = 0; k < bucket.support.size(); ++k)
+                    c = std::min(c, point[bucket.support[k]] * data.inverse[k]);
+
+                const auto cf = c * height;
+                // Ties are broken by id so we return the same result as the
+                // non-indexed version.
+                if (cf < minCF || (cf == minCF && i < minI)) {
+                    minC = c;
+                    minCF = cf;
+                    minI = i;
+                }
+            }
+        }
+        return makeSawtoothResult(point, ubQ, ubV.getCornerValues(), points.size(), minCF < 0.0 ? &points[minI] : nullptr, minI, minC, minCF);
+    }
+
+    // -----------------------------------------------------
+
+    IndexedPointSurface::IndexedPointSurface(const CompactHyperplanes & ubQ) :
+            cornerVals_(ubQ.rowwise().maxCoeff()) {}
+
+    IndexedPointSurface::IndexedPointSurface(const CompactHyperplanes & ubQ, const PointSurface & ubV) :
+            IndexedPointSurface(ubQ)
+    {
+        assert(ubV.first.size() == ubV.second.size());
+
+        for (size_t i = 0; i < ubV.first.size(); ++i)
+            add(ubV.first[i], ubV.second[i]);
+    }
+
+    void IndexedPointSurface::setCorners(const CompactHyperplanes & ubQ) {
+        Vector newCornerVals = ubQ.rowwise().maxCoeff();
+        if (newCornerVals == cornerVals_) return;
+
+        cornerVals_ = std::move(newCornerVals);
+        for (size_t i = 0; i < data_.size(); ++i)
+            data_[i].cornerValue = surface_.first[i].dot(cornerVals_);
+
+        // All heights have changed, so we need to re-sort the buckets.
+        for (auto & bucket : buckets_)
+            std::sort(std::begin(bucket.ids), std::end(bucket.ids), [this](size_t lhs, size_t rhs) {
+                return getHeight(lhs) < getHeight(rhs);
+            });
+    }
+
+    void IndexedPointSurface::add(Point p, const double value) {
+        const size_t id = data_.size();
+
+        std::vector<size_t> support;
+        for (size_t s = 0; s < static_cast<size_t>(p.size()); ++s)
+            if (checkDifferentSmall(p[s], 0.0))
+                support.push_back(s);
+
+        auto & data = data_.emplace_back();
+        data.cornerValue = p.dot(cornerVals_);
+        data.inverse.resize(support.size());
+        data.dominant = 0;
+        for (size_t k = 0; k < support.size(); ++k) {
+            data.inverse[k] = 1.0 / p[support[k]];
+            if (p[support[k]] > p[support[data.dominant]])
+                data.dominant = k;
+        }
+
+        const auto it = supportToBucket_.find(support);
+        if (it != std::end(supportToBucket_)) {
+            data.bucket = it->second;
+        } else {
+            data.bucket = buckets_.size();
+            supportToBucket_.emplace(support, data.bucket);
+            buckets_.emplace_back().support = std::move(support);
+        }
+
+        surface_.first.emplace_back(std::move(p));
+        surface_.second.push_back(value);
+
+        insertInBucket(id);
+    }
+
+    void IndexedPointSurface::erase(const size_t id) {
+        assert(id < size());
+
+        const size_t last = size() - 1;
+        removeFromBucket(id);
+        if (id != last) {
+            renameInBucket(data_[last].bucket, last, id);
+
+            surface_.first[id] = std::move(surface_.first[last]);
+            surface_.second[id] = surface_.second[last];
+            data_[id] = std::move(data_[last]);
+        }
+        surface_.first.pop_back();
+        surface_.second.pop_back();
+        data_.pop_back();
+    }
+
+    void IndexedPointSurface::swap(const size_t lhs, const size_t rhs) {
+        if (lhs == rhs) return;
+
+        // We temporarily use size() as an id that cannot be in any bucket.
+        const auto lhsBucket = data_[lhs].bucket, rhsBucket = data_[rhs].bucket;
+        renameInBucket(lhsBucket, lhs, size());
+        renameInBucket(rhsBucket, rhs, lhs);
+        renameInBucket(lhsBucket, size(), rhs);
+
+        std::swap(surface_.first[lhs], surface_.first[rhs]);
+        std::swap(surface_.second[lhs], surface_.second[rhs]);
+        std::swap(data_[lhs], data_[rhs]);
+    }
+
+    void IndexedPointSurface::setValue(const size_t id, const double value) {
+        removeFromBucket(id);
+        surface_.second[id] = value;
+        insertInBucket(id);
+    }
+
+    size_t IndexedPointSurface::size() const { return data_.size(); }
+    const std::vector<Point> & IndexedPointSurface::getPoints() const { return surface_.first; }
+    const std::vector<double> & IndexedPointSurface::getValues() const { return surface_.second; }
+    const Vector & IndexedPointSurface::getCornerValues() const { return cornerVals_; }
+
+    double IndexedPointSurface::getHeight(const size_t id) const {
+        return surface_.second[id] - data_[id].cornerValue;
+    }
+
+    std::vector<size_t> IndexedPointSurface::getCompatiblePoints(const std::vector<char> & zeroStates) const {
+        std::vector<size_t> retval;
+        for (const auto & bucket : buckets_) {
+            if (std::any_of(std::begin(bucket.support), std::end(bucket.support), [&](size_t s){ return zeroStates[s]; }))
+                continue;
+            retval.insert(std::end(retval), std::begin(bucket.ids), std::end(bucket.ids));
         }
+        std::sort(std::begin(retval), std::end(retval));
+        return retval;
+    }
 
-        retval.head(point.size()).noalias() = point - ubV.first[minI] * minC;
-        retval[minI] = minC;
+    void IndexedPointSurface::insertInBucket(const size_t id) {
+        auto & ids = buckets_[data_[id].bucket].ids;
+        const double height = getHeight(id);
+
+        const auto it = std::upper_bound(std::begin(ids), std::end(ids), height, [this](double h, size_t i) {
+            return h < getHeight(i);
+        });
+        ids.insert(it, id);
+    }
 
-        return std::make_tuple(v, std::move(retval));
+    void IndexedPointSurface::removeFromBucket(const size_t id) {
+        auto & ids = buckets_[data_[id].bucket].ids;
+        ids.erase(std::find(std::begin(ids), std::end(ids), id));
+    }
+
+    void IndexedPointSurface::renameInBucket(const size_t bucket, const size_t oldId, const size_t newId) {
+        auto & ids = buckets_[bucket].ids;
+        *std::find(std::begin(ids), std::end(ids), oldId) = newId;
     }
 
     // -----------------------------------------------------
 
-    WitnessLP::WitnessLP(const size_t s) : S(s), lp_(s+2)
+    WitnessLP::WitnessLP(const size_t s) : S(s), optimalRows_(0), lp_(s+2)
     {
         /*
          * Here we setup the part of the lp that never changes (at least with this number of states)
@@ -376,6 +646,9 @@ next:;
 
         lp_.row[S]     = -1.0;
         lp_.row[S + 1] = +0.0;
+
+        // All our LPs are very similar, so we can reuse the previous basis.
+        lp_.setWarmStart(true);
     }
 
     void WitnessLP::addOptimalRow(const Hyperplane & v) {
@@ -384,11 +657,23 @@ next:;
         // Temporarily set the delta constraint
         lp_.row[S+1] = +1.0;
         lp_.pushRow(LP::Constraint::LessEqual, 0.0);
+        ++optimalRows_;
 
         lp_.row[S+1] = 0.0;
     }
 
     std::optional<Point> WitnessLP::findWitness(const Hyperplane & v) {
+        // Without optimal rows delta is unbounded, and the LP backends
+        // return nothing. However, any point is then a witness, so we
+        // simply return the corner where v is highest.
+        if (optimalRows_ == 0) {
+            Point witness = Point::Zero(S);
+            size_t best;
+            v.maxCoeff(&best);
+            witness[best] = 1.0;
+            return witness;
+        }
+
         // Add witness constraint
         for ( size_t i = 0; i < S; ++i )
             lp_.row[i] = v[i];
@@ -412,9 +697,14 @@ next:;
 
     void WitnessLP::reset() {
         lp_.resize(1);
+        optimalRows_ = 0;
     }
 
     void WitnessLP::allocate(const size_t rows) {
         lp_.resize(rows+1);
     }
+
+    const LP::Statistics & WitnessLP::getStatistics() const {
+        return lp_.getStatistics();
+    }
 }
@@ -1,39 +1,52 @@
 #include <AIToolbox/Utils/Probability.hpp>
 
 namespace AIToolbox {
-    bool isProbability(const Matrix2D & in) {
+    template <typename T>
+    bool isProbability(const Matrix2DT<T> & in) {
         for (size_t row = 0; row < static_cast<size_t>(in.rows()); ++row)
-            if (in.row(row).minCoeff() < 0.0 || checkDifferentSmall(in.row(row).sum(), 1.0))
+            if (in.row(row).minCoeff() < 0.0 || checkDifferentSmall(in.row(row).template cast<double>().sum(), 1.0))
                 return false;
         return true;
     }
 
-    bool isProbability(const Matrix3D & in) {
+    template <typename T>
+    bool isProbability(const Matrix3DT<T> & in) {
         for (const auto & m2 : in)
             if (!isProbability(m2))
                 return false;
         return true;
     }
 
-    bool isProbability(const SparseMatrix2D & in) {
+    template <typename T>
+    bool isProbability(const SparseMatrix2DT<T> & in) {
         // Eigen sparse does not implement minCoeff so we can't check for negatives.
         // So we force the matrix to its abs, and if then the sum goes haywire then
         // we found an error.
         for (size_t row = 0; row < static_cast<size_t>(in.rows()); ++row)
             if (
-                checkDifferentSmall(in.row(row).sum(), 1.0) ||
-                checkDifferentSmall(in.row(row).cwiseAbs().sum(), 1.0)
+                checkDifferentSmall(in.row(row).template cast<double>().sum(), 1.0) ||
+                checkDifferentSmall(in.row(row).template cast<double>().cwiseAbs().sum(), 1.0)
             ) return false;
         return true;
     }
 
-    bool isProbability(const SparseMatrix3D & in) {
+    template <typename T>
+    bool isProbability(const SparseMatrix3DT<T> & in) {
         for (const auto & m2 : in)
             if (!isProbability(m2))
                 return false;
         return true;
     }
 
+    template bool isProbability(const Matrix2DT<double> &);
+    template bool isProbability(const Matrix2DT<float> &);
+    template bool isProbability(const Matrix3DT<double> &);
+    template bool isProbability(const Matrix3DT<float> &);
+    template bool isProbability(const SparseMatrix2DT<double> &);
+    template bool isProbability(const SparseMatrix2DT<float> &);
+    template bool isProbability(const SparseMatrix3DT<double> &);
+    template bool isProbability(const SparseMatrix3DT<float> &);
+
     ProbabilityVector projectToProbability(const Vector & v) {
         ProbabilityVector retval(v.size());
 
@@ -65,8 +78,18 @@ namespace AIToolbox {
     }
 
     VoseAliasSampler::VoseAliasSampler(const ProbabilityVector & p) :
-            prob_(p), alias_(prob_.size()), sampleDistribution_(0, prob_.size())
+            prob_(p.size()), alias_(p.size()), sampleDistribution_(0, p.size())
     {
+        buildAliasTable(p, prob_.data(), alias_.data());
+    }
+
+    void buildAliasTable(const ProbabilityVector & p, double * prob, size_t * alias) {
+        const size_t N = p.size();
+        for (size_t x = 0; x < N; ++x) {
+            prob[x] = p[x];
+            alias[x] = N;
+        }
+
         // Here we do the Vose Alias setup in a way that avoids the creation of
         // the small and large arrays.
         //
@@ -74,52 +97,53 @@ namespace AIToolbox {
         // elements and one for the small ones, and we move them along the
         // array as if we had already sorted the thing.
 
-        const auto avg = 1.0 / prob_.size();
-        auto small = 0, large = 0;
-        while (small < prob_.size() && prob_[small] >= avg) ++small;
-        while (large < prob_.size() && prob_[large] < avg) ++large;
+        const auto avg = 1.0 / N;
+        size_t small = 0, large = 0;
+        while (small < N && prob[small] >= avg) ++small;
+        while (large < N && prob[large] < avg) ++large;
 
         auto smallCheckpoint = small;
 
-        while (small < prob_.size() && large < prob_.size()) {
-            // Note: we do not do any assignments to prob_[small] here since if
+        while (small < N && large < N) {
+            // Note: we do not do any assignments to prob[small] here since if
             // we scaled the values already we might trip the large counter (as
             // it might be behind the small counter).
-            prob_[large] = (prob_[large] + prob_[small]) - avg;
-            alias_[small] = large;
+            prob[large] = (prob[large] + prob[small]) - avg;
+            alias[small] = large;
 
             // If the large became small, we temporarily move the small counter
             // here, and look around for a new large element.
             // Otherwise, we go back to our last small 'checkpoint', and we
             // look for a new small element.
-            if (prob_[large] < avg) {
+            if (prob[large] < avg) {
                 small = large;
                 ++large;
-                while (large < prob_.size() && prob_[large] < avg) ++large;
+                while (large < N && prob[large] < avg) ++large;
             } else {
                 small = smallCheckpoint + 1;
-                while (small < prob_.size() && prob_[small] >= avg) ++small;
+                while (small < N && prob[small] >= avg) ++small;
                 // Set the checkpoint again
                 smallCheckpoint = small;
             }
         }
 
-        // Now, for each entry which remained unassigned (so it is still with
-        // the 0 default in the alias vector), we set it to just reference
-        // itself. This takes care of both large and small entries which have
-        // been left with no pairings.
-        auto x = std::min(large, small);
-        while (x < prob_.size()) {
-            prob_[x] = 1.0;
-            alias_[x] = x;
-            ++x;
-            while (x < prob_.size() && alias_[x] != 0) ++x;
+        // Now, for each entry which remained unassigned (so it still has
+        // the out-of-range default in the alias vector), we set it to just
+        // reference itself. This takes care of both large and small entries
+        // which have been left with no pairings.
+        //
+        // Note that we can't use 0 as the default, as it is a valid alias.
+        for (size_t x = 0; x < N; ++x) {
+            if (alias[x] != N) continue;
+            prob[x] = 1.0;
+            alias[x] = x;
         }
 
         // Here we scale up the vector so that each entry can be correctly seen
         // as a weighted coin. Note that all 1.0 entries will now be larger,
         // but for those there's no choice so we don't care about the precise
         // value anyway.
-        prob_ *= prob_.size();
+        for (size_t x = 0; x < N; ++x)
+            prob[x] *= N;
     }
 }
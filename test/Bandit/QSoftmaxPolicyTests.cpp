@@ -66,3 +66,26 @@ BOOST_AUTO_TEST_CASE( sampling ) {
     BOOST_CHECK(p2 * samples - margin <= counts[2]);
     BOOST_CHECK(counts[2] <= p2 * samples + margin);
 }
+
+BOOST_AUTO_TEST_CASE( batch_sampling ) {
+    using namespace AIToolbox;
+    constexpr size_t A = 4;
+
+    Bandit::QFunction q(A);
+    q << 1.0, 2.0, 0.5, 2.0;
+
+    const Bandit::QSoftmaxPolicy softmax(q, 0.7);
+    const Bandit::QSoftmaxPolicy greedy(q, 0.0);
+
+    for (const Bandit::QSoftmaxPolicy * p : {&softmax, &greedy}) {
+        const auto policy = p->getPolicy();
+
+        std::vector<size_t> out(40000);
+        p->sampleActions(out);
+
+        std::vector<unsigned> counts(A);
+        for (auto a : out) ++counts[a];
+        for (size_t a = 0; a < A; ++a)
+            BOOST_CHECK_SMALL(counts[a] / static_cast<double>(out.size()) - policy[a], 0.01);
+    }
+}
@@ -8,6 +8,8 @@
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Bandit/Experience.hpp>
 #include <AIToolbox/Bandit/Policies/ThompsonSamplingPolicy.hpp>
+#include <AIToolbox/Bandit/Policies/TopTwoThompsonSamplingPolicy.hpp>
+#include <AIToolbox/Bandit/Policies/T3CPolicy.hpp>
 
 BOOST_AUTO_TEST_CASE( sampling ) {
     using namespace AIToolbox;
@@ -79,3 +81,89 @@ BOOST_AUTO_TEST_CASE( probability ) {
     BOOST_CHECK(0.375 < pol[1] && pol[1] < 0.485);
     BOOST_CHECK(0.375 < pol[2] && pol[2] < 0.485);
 }
+
+BOOST_AUTO_TEST_CASE( exact_probability ) {
+    using namespace AIToolbox;
+    constexpr size_t A = 4;
+
+    Bandit::Experience exp(A);
+    Bandit::ThompsonSamplingPolicy p(exp);
+    Bandit::TopTwoThompsonSamplingPolicy tt(exp, 0.5);
+    Bandit::T3CPolicy t3c(exp, 0.5, 1.0);
+
+    // Arms with less than 2 pulls are picked deterministically.
+    exp.record(0, 1.0);
+    exp.record(0, 2.0);
+    exp.record(2, 1.0);
+
+    BOOST_CHECK_EQUAL(p.getActionProbability(1), 1.0);
+    BOOST_CHECK_EQUAL(p.getActionProbability(2), 0.0);
+    BOOST_CHECK_EQUAL(p.getPolicy()[1], 1.0);
+    BOOST_CHECK_EQUAL(tt.getPolicy()[1], 1.0);
+    BOOST_CHECK_EQUAL(t3c.getPolicy()[1], 1.0);
+
+    RandomEngine rnd(Seeder::getSeed());
+    std::normal_distribution<double> reward(0.0, 1.0);
+    const std::array<double, A> means{{0.2, 0.5, 0.4, -0.5}};
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t a = 0; a < A; ++a)
+            exp.record(a, means[a] + reward(rnd));
+
+    const auto pol = p.getPolicy();
+    BOOST_CHECK_CLOSE(pol.sum(), 1.0, 1e-5);
+    for (size_t a = 0; a < A; ++a)
+        BOOST_CHECK_CLOSE(p.getActionProbability(a), pol[a], 1e-6);
+
+    const auto ttPol = tt.getPolicy();
+    const auto t3cPol = t3c.getPolicy();
+    BOOST_CHECK_CLOSE(ttPol.sum(), 1.0, 1e-5);
+    BOOST_CHECK_CLOSE(t3cPol.sum(), 1.0, 1e-5);
+
+    // Compare against the sampled frequencies.
+    constexpr unsigned trials = 20000;
+    std::array<unsigned, A> counts{}, ttCounts{}, t3cCounts{};
+    for (unsigned i = 0; i < trials; ++i) {
+        ++counts[p.sampleAction()];
+        ++ttCounts[tt.sampleAction()];
+        ++t3cCounts[t3c.sampleAction()];
+    }
+
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_TEST_INFO("a = " << a);
+        BOOST_CHECK_SMALL(pol[a] - counts[a] / double(trials), 0.02);
+        BOOST_CHECK_SMALL(ttPol[a] - ttCounts[a] / double(trials), 0.02);
+        BOOST_CHECK_SMALL(t3cPol[a] - t3cCounts[a] / double(trials), 0.02);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( t3c_external_generator ) {
+    using namespace AIToolbox;
+    constexpr size_t A = 4;
+
+    Bandit::Experience exp(A);
+    const Bandit::T3CPolicy p(exp, 0.5, 1.0);
+
+    RandomEngine rnd(Seeder::getSeed());
+    std::normal_distribution<double> reward(0.0, 1.0);
+    const std::array<double, A> means{{0.2, 0.5, 0.4, -0.5}};
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t a = 0; a < A; ++a)
+            exp.record(a, means[a] + reward(rnd));
+
+    // The same generator state produces the same actions.
+    auto rnd1 = Seeder::getStreamEngine(0), rnd2 = Seeder::getStreamEngine(0);
+    for (unsigned i = 0; i < 100; ++i)
+        BOOST_CHECK_EQUAL(p.sampleAction(rnd1), p.sampleAction(rnd2));
+
+    const auto pol = p.getPolicy();
+
+    constexpr unsigned trials = 20000;
+    std::array<unsigned, A> counts{};
+    for (unsigned i = 0; i < trials; ++i)
+        ++counts[p.sampleAction(rnd1)];
+
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_TEST_INFO("a = " << a);
+        BOOST_CHECK_SMALL(pol[a] - counts[a] / double(trials), 0.02);
+    }
+}
@@ -6,6 +6,8 @@
 
 #include <AIToolbox/Factored/Bandit/Algorithms/Utils/LocalSearch.hpp>
 #include <AIToolbox/Factored/Bandit/Algorithms/Utils/GraphUtils.hpp>
+#include <AIToolbox/Factored/Bandit/Policies/QGreedyPolicy.hpp>
+#include <AIToolbox/Seeder.hpp>
 
 namespace aif = AIToolbox::Factored;
 namespace fb = AIToolbox::Factored::Bandit;
@@ -173,3 +175,40 @@ BOOST_AUTO_TEST_CASE( negative_graph_2 ) {
     BOOST_CHECK_EQUAL(val, solV);
     BOOST_CHECK(bestAction == solA1 || bestAction == solA2);
 }
+
+BOOST_AUTO_TEST_CASE( policy_external_generator ) {
+    // Same problem as simple_graph, which has a local optimum.
+    const aif::Action A{2, 2, 2};
+    const std::vector<fb::QFunctionRule> rules {
+        // Actions,                     Value
+        {  {{0, 2}, {1, 0}},            4.0},
+        {  {{0, 1}, {1, 0}},            5.0},
+        {  {{1},    {0}},               2.0},
+        {  {{1, 2}, {1, 1}},            5.0},
+    };
+    const auto solA = aif::Action{1, 0, 0};
+
+    aif::FilterMap<fb::QFunctionRule> q(A);
+    for (const auto & rule : rules)
+        q.emplace(rule.action, rule);
+
+    const fb::QGreedyPolicy<LS> p(A, q);
+
+    // The same generator state produces the same actions.
+    auto rnd1 = AIToolbox::Seeder::getStreamEngine(0), rnd2 = AIToolbox::Seeder::getStreamEngine(0);
+    for (unsigned i = 0; i < 50; ++i) {
+        const auto a1 = p.sampleAction(rnd1), a2 = p.sampleAction(rnd2);
+        BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(a1), std::end(a1),
+                                      std::begin(a2), std::end(a2));
+    }
+
+    // The search depends on the input generator, so repeated calls can
+    // end up in different optima.
+    unsigned optimal = 0;
+    constexpr unsigned trials = 200;
+    for (unsigned i = 0; i < trials; ++i)
+        optimal += p.sampleAction(rnd1) == solA;
+
+    BOOST_TEST_INFO("optimal = " << optimal);
+    BOOST_CHECK(0 < optimal && optimal < trials);
+}
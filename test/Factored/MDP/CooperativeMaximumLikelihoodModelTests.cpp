@@ -4,6 +4,7 @@
 #include <boost/test/unit_test.hpp>
 #include "GlobalFixtures.hpp"
 
+#include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Factored/MDP/CooperativeMaximumLikelihoodModel.hpp>
 
@@ -163,3 +164,82 @@ BOOST_AUTO_TEST_CASE( syncing ) {
         BOOST_CHECK_EQUAL(r1[i], r2[i]);
     }
 }
+
+BOOST_AUTO_TEST_CASE( batch_sampling_after_sync ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+
+    afm::CooperativeExperience exp(model.getGraph());
+    afm::CooperativeMaximumLikelihoodModel rl(exp, 0.9, false);
+
+    aif::Rewards rew(6); rew.setZero();
+    const aif::State s{0, 1, 1, 1, 2, 1}, s1{1, 1, 1, 2, 2, 0}, s2{0, 2, 1, 1, 0, 0};
+    const aif::Action a{0, 0, 0};
+
+    exp.record(s, a, s1, rew);
+    rl.sync(s, a);
+
+    constexpr size_t trials = 10000;
+    std::vector<aif::State> states(trials, s), newStates;
+    std::vector<aif::Action> actions(trials, a);
+    std::vector<double> rewards;
+
+    rl.sampleSRBatch(states, actions, &newStates, &rewards);
+    for (const auto & ns : newStates)
+        BOOST_CHECK(ns == s1);
+
+    // After syncing the alias tables must reflect the new probabilities.
+    exp.record(s, a, s2, rew);
+    rl.sync(s, a);
+
+    rl.sampleSRBatch(states, actions, &newStates, &rewards);
+    unsigned count = 0;
+    for (const auto & ns : newStates) {
+        BOOST_CHECK(ns[2] == 1);
+        count += ns[0] == s2[0];
+    }
+    BOOST_CHECK_SMALL(static_cast<double>(count) / trials - 0.5, 0.03);
+}
+
+BOOST_AUTO_TEST_CASE( incremental_syncing ) {
+    auto model = afm::makeSysAdminBiRing(4, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+
+    afm::CooperativeExperience exp(model.getGraph());
+    afm::CooperativeMaximumLikelihoodModel full(exp, 0.9, false);
+    afm::CooperativeMaximumLikelihoodModel incr(exp, 0.9, false);
+
+    const auto & S = model.getS();
+    const auto & A = model.getA();
+    aif::Rewards rew(S.size());
+    aif::State s(S.size(), 0);
+    aif::Action a(A.size(), 0);
+
+    ai::RandomEngine rnd(ai::Seeder::getSeed());
+    std::uniform_int_distribution<size_t> dist(0, 1);
+    std::uniform_real_distribution<double> rdist(0.0, 10.0);
+
+    for (size_t t = 0; t < 500; ++t) {
+        for (auto & aa : a)
+            aa = dist(rnd);
+        for (size_t i = 0; i < S.size(); ++i)
+            rew[i] = rdist(rnd);
+
+        auto [s1, r] = model.sampleSR(s, a);
+        (void)r;
+
+        const auto & ids = exp.record(s, a, s1, rew);
+        full.sync(ids);
+        incr.syncIncremental(ids, s1);
+
+        s = std::move(s1);
+    }
+
+    const auto & t1 = full.getTransitionFunction().transitions;
+    const auto & t2 = incr.getTransitionFunction().transitions;
+    const auto & r1 = full.getRewardFunction();
+    const auto & r2 = incr.getRewardFunction();
+
+    for (size_t i = 0; i < t1.size(); ++i) {
+        BOOST_CHECK(t1[i].isApprox(t2[i], 1e-9));
+        BOOST_CHECK(r1[i] == r2[i]);
+    }
+}
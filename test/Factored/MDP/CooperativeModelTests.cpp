@@ -5,6 +5,10 @@
 #include "GlobalFixtures.hpp"
 
 #include <AIToolbox/Factored/MDP/CooperativeModel.hpp>
+#include <AIToolbox/Factored/Utils/DDNSampler.hpp>
+#include <AIToolbox/Seeder.hpp>
+
+#include <thread>
 
 #include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
 
@@ -136,3 +140,78 @@ BOOST_AUTO_TEST_CASE( sampling ) {
     BOOST_CHECK(totReward < 10000 * pDoneF + 100);
     BOOST_CHECK(totReward > 10000 * pDoneF - 100);
 }
+
+BOOST_AUTO_TEST_CASE( batch_sampling ) {
+    using namespace AIToolbox::Factored;
+    using namespace AIToolbox::Factored::MDP;
+
+    auto problem = makeSysAdminBiRing(5, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = problem.getS();
+    const auto & graph = problem.getGraph();
+    const auto & T = problem.getTransitionFunction().transitions;
+
+    State s{0, 0, 1, 1, 1, 0, 2, 2, 0, 0};
+    Action a{0, 1, 0, 1, 0};
+
+    constexpr size_t trials = 20000;
+    std::vector<State> states(trials, s), newStates;
+    std::vector<Action> actions(trials, a);
+    std::vector<double> rewards;
+
+    problem.sampleSRBatch(states, actions, &newStates, &rewards);
+
+    BOOST_CHECK_EQUAL(newStates.size(), trials);
+    BOOST_CHECK_EQUAL(rewards.size(), trials);
+
+    // Each feature must follow its own row of the DDN.
+    for (size_t i = 0; i < S.size(); ++i) {
+        std::vector<unsigned> counts(S[i]);
+        for (const auto & s1 : newStates)
+            ++counts[s1[i]];
+
+        const auto j = graph.getId(i, s, a);
+        for (size_t v = 0; v < S[i]; ++v)
+            BOOST_CHECK_SMALL(static_cast<double>(counts[v]) / trials - T[i](j, v), 0.015);
+    }
+    for (size_t n = 0; n < trials; ++n)
+        BOOST_CHECK_EQUAL(rewards[n], problem.getExpectedReward(s, a, newStates[n]));
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_sampler ) {
+    using namespace AIToolbox::Factored;
+    using namespace AIToolbox::Factored::MDP;
+
+    auto problem = makeSysAdminBiRing(5, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = problem.getS();
+    const auto & ddn = problem.getTransitionFunction();
+
+    State s{0, 0, 1, 1, 1, 0, 2, 2, 0, 0};
+    Action a{0, 1, 0, 1, 0};
+
+    // All tables are built on construction, so the sampler can be shared.
+    const DDNSampler sampler(ddn);
+
+    constexpr unsigned threads = 4;
+    constexpr size_t trials = 5000;
+    std::vector<std::vector<State>> newStates(threads);
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]{
+            auto rnd = AIToolbox::Seeder::getStreamEngine(t);
+            sampler.sample(ddn, std::vector<State>(trials, s), std::vector<Action>(trials, a), &newStates[t], rnd);
+        });
+    }
+    for (auto & w : workers) w.join();
+
+    for (size_t i = 0; i < S.size(); ++i) {
+        std::vector<unsigned> counts(S[i]);
+        for (const auto & batch : newStates)
+            for (const auto & s1 : batch)
+                ++counts[s1[i]];
+
+        const auto j = ddn.graph.getId(i, s, a);
+        for (size_t v = 0; v < S[i]; ++v)
+            BOOST_CHECK_SMALL(static_cast<double>(counts[v]) / (threads * trials) - ddn.transitions[i](j, v), 0.015);
+    }
+}
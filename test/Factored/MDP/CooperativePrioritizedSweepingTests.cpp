@@ -92,3 +92,107 @@ BOOST_AUTO_TEST_CASE( simple_rule_update ) {
     // is mostly to see that the output at least makes somewhat sense.
     BOOST_CHECK(maxDiff <= 1.7540832510009725);
 }
+
+BOOST_AUTO_TEST_CASE( parallel_batch_update ) {
+    ai::Seeder::setRootSeed(42);
+    auto problem = fm::makeSysAdminUniRing(4, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+
+    fm::CooperativeExperience exp(problem.getGraph());
+    fm::CooperativeMaximumLikelihoodModel model(exp, problem.getDiscount());
+
+    std::vector<std::vector<size_t>> domains{
+        {0, 1}, {2, 3}, {4, 5}, {6, 7}
+    };
+
+    fm::CooperativePrioritizedSweeping serial(model, domains);
+    fm::CooperativePrioritizedSweeping parallel(model, domains);
+
+    fm::QGreedyPolicy p(model.getS(), model.getA(), serial.getQFunction());
+    fm::EpsilonPolicy ep(p, 0.5);
+
+    aif::State s(model.getS().size());
+    aif::Rewards r(model.getS().size());
+    r.setZero();
+    for (size_t t = 0; t < 1000; ++t) {
+        auto a = ep.sampleAction(s);
+
+        auto [s1, x] = problem.sampleSR(s, a);
+        (void)x;
+
+        for (size_t l = 1; l < model.getS().size(); l += 2)
+            r[l] = (s1[l] == fm::SysAdminUtils::Done);
+
+        const auto & ids = exp.record(s, a, s1, r);
+        model.sync(ids);
+
+        serial.stepUpdateQ(s, a, s1, r);
+        serial.batchUpdateQ(50);
+
+        parallel.stepUpdateQ(s, a, s1, r);
+        parallel.batchUpdateQ(50, 4);
+
+        s = std::move(s1);
+    }
+
+    // The parallel version does not perform the exact same updates, but it
+    // should learn approximately the same QFunction. Note that two serial
+    // runs with different samples differ by a similar amount.
+    const auto & q1 = serial.getQFunction();
+    const auto & q2 = parallel.getQFunction();
+
+    double maxDiff = 0.0, maxValue = 0.0;
+    for (size_t i = 0; i < q1.bases.size(); ++i) {
+        maxDiff = std::max(maxDiff, (q1.bases[i].values - q2.bases[i].values).cwiseAbs().maxCoeff());
+        maxValue = std::max(maxValue, q1.bases[i].values.cwiseAbs().maxCoeff());
+    }
+    BOOST_CHECK(maxValue > 1.0);
+    BOOST_CHECK(maxDiff < 0.25 * maxValue);
+}
+
+BOOST_AUTO_TEST_CASE( parallel_batch_update_exceptions ) {
+    auto problem = fm::makeSysAdminUniRing(4, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+
+    fm::CooperativeExperience exp(problem.getGraph());
+    fm::CooperativeMaximumLikelihoodModel model(exp, problem.getDiscount());
+
+    // A model which starts failing after a number of samples.
+    struct FailingModel {
+        const fm::CooperativeMaximumLikelihoodModel & m;
+        mutable unsigned samples;
+
+        const aif::State & getS() const { return m.getS(); }
+        const aif::Action & getA() const { return m.getA(); }
+        double getDiscount() const { return m.getDiscount(); }
+        const auto & getGraph() const { return m.getGraph(); }
+        const auto & getTransitionFunction() const { return m.getTransitionFunction(); }
+
+        void sampleSRs(const aif::State & s, const aif::Action & a, aif::State * s1, aif::Rewards * rews) const {
+            if (samples == 0) throw std::runtime_error("model failure");
+            --samples;
+            m.sampleSRs(s, a, s1, rews);
+        }
+    };
+    FailingModel failing{model, 0};
+
+    std::vector<std::vector<size_t>> domains{
+        {0, 1}, {2, 3}, {4, 5}, {6, 7}
+    };
+    fm::CooperativePrioritizedSweeping<FailingModel> solver(failing, domains);
+
+    aif::State s(model.getS().size()), s1(model.getS().size());
+    aif::Action a(model.getA().size());
+    aif::Rewards r(model.getS().size());
+    r.setOnes();
+    for (size_t t = 0; t < 20; ++t) {
+        s[t % s.size()] = t % 3;
+        a[t % a.size()] = t % 2;
+        solver.stepUpdateQ(s, a, s1, r);
+    }
+
+    // The first samples are taken in the calling thread, the following
+    // ones from the barrier completion; both must reach the caller.
+    for (const unsigned allowed : {0u, 5u, 13u}) {
+        failing.samples = allowed;
+        BOOST_CHECK_THROW(solver.batchUpdateQ(50, 4), std::runtime_error);
+    }
+}
@@ -9,6 +9,7 @@
 #include <AIToolbox/Factored/MDP/Algorithms/CooperativeQLearning.hpp>
 
 #include <AIToolbox/Factored/MDP/Policies/QGreedyPolicy.hpp>
+#include <AIToolbox/Factored/MDP/Policies/EpsilonPolicy.hpp>
 
 #include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
 
@@ -251,4 +252,12 @@ BOOST_AUTO_TEST_CASE( action_returned ) {
     const auto cqla = cqlp.sampleAction(s);
 
     BOOST_CHECK(AIToolbox::veccmp(scqla, cqla) == 0);
+
+    // Sampling with an external generator gives the same greedy action,
+    // also through an epsilon wrapper.
+    BOOST_CHECK(AIToolbox::veccmp(scqlp.sampleAction(s, rnd), scqla) == 0);
+    BOOST_CHECK(AIToolbox::veccmp(cqlp.sampleAction(s, rnd), cqla) == 0);
+
+    fm::EpsilonPolicy ep(cqlp, 0.0);
+    BOOST_CHECK(AIToolbox::veccmp(ep.sampleAction(s, rnd), cqla) == 0);
 }
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE Factored_MDP_CooperativeThompsonModel
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Factored/MDP/CooperativeThompsonModel.hpp>
+
+#include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
+
+namespace aif = AIToolbox::Factored;
+namespace afm = AIToolbox::Factored::MDP;
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    auto model = afm::makeSysAdminBiRing(5, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+
+    afm::CooperativeExperience exp(model.getGraph());
+    afm::CooperativeThompsonModel rl(exp, 0.9);
+
+    const auto & t = rl.getTransitionFunction().transitions;
+    const auto & r = rl.getRewardFunction();
+
+    BOOST_CHECK_EQUAL(rl.getDiscount(), 0.9);
+    BOOST_CHECK_EQUAL(rl.getResampleVisits(), 0);
+    BOOST_CHECK_EQUAL(rl.getResampleStaleness(), 0);
+
+    for (size_t i = 0; i < t.size(); ++i) {
+        BOOST_CHECK(t[i].rowwise().sum().isOnes());
+        BOOST_CHECK(r[i].isZero());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( lazy_resampling ) {
+    auto model = afm::makeSysAdminBiRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+
+    afm::CooperativeExperience exp(model.getGraph());
+    afm::CooperativeThompsonModel rl(exp, 0.9);
+
+    const auto & t = rl.getTransitionFunction().transitions;
+
+    const aif::State s{0, 1, 1, 1, 2, 1}, s1{1, 1, 1, 2, 2, 0};
+    const aif::State o{2, 2, 2, 2, 2, 2};
+    const aif::Action a{0, 0, 0}, oa{1, 1, 1};
+    aif::Rewards rew(6); rew.setZero();
+
+    rl.setResampleVisits(3);
+    rl.setResampleStaleness(10);
+
+    const auto j = model.getGraph().getId(0, s, a);
+    AIToolbox::Vector row = t[0].row(j);
+
+    // Not enough new visits, the row keeps its old sample.
+    for (size_t n = 0; n < 2; ++n) {
+        rl.sync(exp.record(s, a, s1, rew));
+        BOOST_CHECK(t[0].row(j) == row.transpose());
+    }
+    // The third visit triggers resampling.
+    rl.sync(exp.record(s, a, s1, rew));
+    BOOST_CHECK(t[0].row(j) != row.transpose());
+    row = t[0].row(j);
+
+    // Once the row is stale, a single visit is enough.
+    for (size_t n = 0; n < 10; ++n)
+        rl.sync(exp.record(o, oa, o, rew));
+    rl.sync(exp.record(s, a, s1, rew));
+    BOOST_CHECK(t[0].row(j) != row.transpose());
+    row = t[0].row(j);
+
+    // Without lazy resampling every sync resamples.
+    rl.setResampleVisits(0);
+    rl.sync(s, a);
+    BOOST_CHECK(t[0].row(j) != row.transpose());
+}
@@ -4,6 +4,9 @@
 #include <boost/test/unit_test.hpp>
 #include "GlobalFixtures.hpp"
 
+#include <algorithm>
+
+#include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Factored/MDP/Algorithms/SparseCooperativeQLearning.hpp>
 
@@ -50,3 +53,82 @@ BOOST_AUTO_TEST_CASE( simple_rule_update ) {
     BOOST_CHECK_EQUAL(container[4].value, v5 + alpha * (R2 + gamma * (v3 / 2.0) - v5 / 2.0 + R3 + gamma * v6 - v5 / 2.0));
     BOOST_CHECK_EQUAL(container[5].value,  v6);
 }
+
+BOOST_AUTO_TEST_CASE( many_rule_families ) {
+    // We compare against a straightforward implementation of the update,
+    // which finds the rules through a FilterMap.
+    const aif::State S{3, 2, 3};
+    const aif::Action A{2, 3, 2, 2};
+
+    AIToolbox::RandomEngine rand(AIToolbox::Seeder::getSeed());
+    std::uniform_real_distribution<double> vdist(-5.0, 5.0);
+
+    // Every rule over every pair of state features and pair of agents.
+    std::vector<fm::QFunctionRule> rules;
+    for (size_t s0 = 0; s0 < S.size(); ++s0)
+    for (size_t s1 = s0 + 1; s1 < S.size(); ++s1)
+    for (size_t a0 = 0; a0 < A.size(); ++a0)
+    for (size_t a1 = a0 + 1; a1 < A.size(); ++a1) {
+        aif::PartialFactorsEnumerator se(S, {s0, s1});
+        for (; se.isValid(); se.advance()) {
+            aif::PartialFactorsEnumerator ae(A, {a0, a1});
+            for (; ae.isValid(); ae.advance())
+                rules.push_back({*se, *ae, vdist(rand)});
+        }
+    }
+    // Shuffle them so that families are interleaved.
+    std::shuffle(std::begin(rules), std::end(rules), rand);
+
+    const double alpha = 0.3, gamma = 0.9;
+    fm::SparseCooperativeQLearning solver(S, A, rules, gamma, alpha);
+
+    aif::FilterMap<fm::QFunctionRule> ref(aif::join(S, A));
+    for (const auto & rule : rules)
+        ref.emplace(aif::join(S.size(), rule.state, rule.action), rule);
+    fm::QGreedyPolicy<> refPolicy(S, A, ref);
+
+    aif::Rewards rew(A.size());
+    aif::State s(S.size()), s1(S.size());
+    aif::Action a(A.size());
+    auto randomize = [&](auto & f, const auto & F) {
+        for (size_t i = 0; i < f.size(); ++i)
+            f[i] = std::uniform_int_distribution<size_t>(0, F[i] - 1)(rand);
+    };
+
+    for (size_t t = 0; t < 100; ++t) {
+        randomize(s, S); randomize(s1, S); randomize(a, A);
+        for (size_t i = 0; i < A.size(); ++i)
+            rew[i] = vdist(rand);
+
+        const auto a1 = solver.stepUpdateQ(s, a, s1, rew);
+
+        // Reference update.
+        const auto refA1 = refPolicy.sampleAction(s1);
+        BOOST_CHECK(AIToolbox::veccmp(a1, refA1) == 0);
+
+        auto beforeRules = ref.filter(aif::join(s, a));
+        const auto afterRules = ref.filter(aif::join(s1, refA1));
+
+        AIToolbox::Vector perAgentRews(A.size());
+        perAgentRews.setZero();
+        for (const auto & br : beforeRules)
+            for (auto ag : br.action.first)
+                ++perAgentRews[ag];
+        perAgentRews.array() = rew.array() / perAgentRews.array();
+        for (const auto & ar : afterRules)
+            for (auto ag : ar.action.first)
+                perAgentRews[ag] += gamma * ar.value / ar.action.first.size();
+        for (const auto & br : beforeRules)
+            for (auto ag : br.action.first)
+                perAgentRews[ag] -= br.value / br.action.first.size();
+        perAgentRews.array() *= alpha;
+        for (auto & br : beforeRules)
+            for (auto ag : br.action.first)
+                br.value += perAgentRews[ag];
+    }
+
+    const auto & container = solver.getQFunctionRules().getContainer();
+    const auto & refContainer = ref.getContainer();
+    for (size_t i = 0; i < container.size(); ++i)
+        BOOST_CHECK_SMALL(container[i].value - refContainer[i].value, 1e-8);
+}
@@ -0,0 +1,258 @@
+#define BOOST_TEST_MODULE Factored_MDP_StreamingCooperativeExperience
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <thread>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+
+#include <AIToolbox/Factored/MDP/StreamingCooperativeExperience.hpp>
+#include <AIToolbox/Factored/MDP/CooperativeExperience.hpp>
+#include <AIToolbox/Factored/MDP/CooperativeMaximumLikelihoodModel.hpp>
+
+#include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
+
+namespace ai = AIToolbox;
+namespace aif = AIToolbox::Factored;
+namespace afm = AIToolbox::Factored::MDP;
+
+struct Event {
+    aif::State s;
+    aif::Action a;
+    aif::State s1;
+    ai::Vector rew;
+};
+
+std::vector<Event> makeEvents(const afm::CooperativeModel & model, size_t n) {
+    ai::RandomEngine rnd(ai::Seeder::getSeed());
+
+    std::vector<Event> retval;
+    retval.reserve(n);
+
+    aif::State s(model.getS().size(), 0);
+    aif::Action a(model.getA().size());
+    for (size_t t = 0; t < n; ++t) {
+        for (auto & aa : a) aa = rnd() % 2;
+
+        aif::State s1 = std::get<0>(model.sampleSR(s, a));
+
+        // We use random rewards to have some variance to check.
+        ai::Vector rew(s.size());
+        for (auto & r : rew) r = std::uniform_real_distribution<double>(-1.0, 1.0)(rnd);
+
+        retval.push_back({s, a, s1, std::move(rew)});
+        s = std::move(s1);
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+
+    afm::StreamingCooperativeExperience exp(model.getGraph(), 0.9);
+
+    BOOST_CHECK_EQUAL(exp.getDecay(), 0.9);
+    BOOST_CHECK_EQUAL(exp.getWindow(), 0);
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 0);
+    BOOST_CHECK(ai::veccmp(exp.getS(), model.getS()) == 0);
+    BOOST_CHECK(ai::veccmp(exp.getA(), model.getA()) == 0);
+
+    BOOST_CHECK_THROW(afm::StreamingCooperativeExperience(model.getGraph(), 0.0), std::invalid_argument);
+    BOOST_CHECK_THROW(afm::StreamingCooperativeExperience(model.getGraph(), 1.1), std::invalid_argument);
+    BOOST_CHECK_THROW(afm::StreamingCooperativeExperience(model.getGraph(), 0.9, 10), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( no_decay_matches_experience ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = model.getS();
+    const auto & graph = model.getGraph();
+
+    afm::CooperativeExperience exp(graph), exported(graph);
+    afm::StreamingCooperativeExperience stream(graph);
+
+    for (const auto & e : makeEvents(model, 2000)) {
+        exp.record(e.s, e.a, e.s1, e.rew);
+        stream.record(e.s, e.a, e.s1, e.rew);
+    }
+
+    stream.exportTo(&exported);
+
+    BOOST_CHECK_EQUAL(exported.getTimesteps(), exp.getTimesteps());
+    for (size_t i = 0; i < S.size(); ++i) {
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i], exp.getVisitsTable()[i]);
+        for (size_t j = 0; j < graph.getSize(i); ++j) {
+            BOOST_CHECK_SMALL(exported.getRewardMatrix()[i][j] - exp.getRewardMatrix()[i][j], 1e-9);
+            BOOST_CHECK_SMALL(exported.getM2Matrix()[i][j] - exp.getM2Matrix()[i][j], 1e-9);
+        }
+    }
+
+    // Models can be built on top of the exported experience.
+    afm::CooperativeMaximumLikelihoodModel ref(exp, 0.9, true), model2(exported, 0.9, true);
+    for (size_t i = 0; i < S.size(); ++i)
+        BOOST_CHECK(ref.getTransitionFunction().transitions[i].isApprox(model2.getTransitionFunction().transitions[i]));
+}
+
+BOOST_AUTO_TEST_CASE( exponential_decay ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = model.getS();
+    const auto & graph = model.getGraph();
+
+    const double decay = 0.5;
+    afm::StreamingCooperativeExperience exp(graph, decay);
+
+    aif::State s(S.size(), 0), s1(S.size(), 1);
+    aif::Action a(model.getA().size(), 0);
+    ai::Vector rew(S.size());
+
+    rew.fill(1.0);
+    const auto ids = exp.record(s, a, s1, rew);
+    rew.fill(4.0);
+    exp.record(s, a, s, rew);
+
+    for (size_t i = 0; i < S.size(); ++i) {
+        const auto j = ids[i];
+        BOOST_CHECK_CLOSE(exp.getVisits(i, j, 1), 0.5, 1e-9);
+        BOOST_CHECK_CLOSE(exp.getVisits(i, j, 0), 1.0, 1e-9);
+        BOOST_CHECK_CLOSE(exp.getVisits(i, j, S[i]), 1.5, 1e-9);
+
+        // Weighted average and weighted sum of squared differences.
+        const double mean = (0.5 * 1.0 + 1.0 * 4.0) / 1.5;
+        BOOST_CHECK_CLOSE(exp.getReward(i, j), mean, 1e-9);
+        BOOST_CHECK_CLOSE(exp.getM2(i, j), 0.5 * (1.0 - mean) * (1.0 - mean) + (4.0 - mean) * (4.0 - mean), 1e-9);
+    }
+
+    // Record many more times so that weights are rescaled internally; the
+    // effective visits must converge to 1 / (1 - decay).
+    rew.fill(2.0);
+    for (size_t t = 0; t < 2000; ++t)
+        exp.record(s, a, s, rew);
+
+    for (size_t i = 0; i < S.size(); ++i) {
+        const auto j = ids[i];
+        BOOST_CHECK_CLOSE(exp.getVisits(i, j, S[i]), 1.0 / (1.0 - decay), 1e-6);
+        BOOST_CHECK_SMALL(exp.getVisits(i, j, 1), 1e-12);
+        BOOST_CHECK_CLOSE(exp.getReward(i, j), 2.0, 1e-6);
+        BOOST_CHECK_SMALL(exp.getM2(i, j), 1e-6);
+    }
+
+    afm::CooperativeExperience exported(graph);
+    exp.exportTo(&exported);
+    for (size_t i = 0; i < S.size(); ++i) {
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i](ids[i], 0), 2);
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i](ids[i], S[i]), 2);
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i](ids[i], 1), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( windowed_decay ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = model.getS();
+
+    afm::StreamingCooperativeExperience exp(model.getGraph(), 1.0, 2);
+
+    aif::State s(S.size(), 0), s1(S.size(), 1);
+    aif::Action a(model.getA().size(), 0);
+    ai::Vector rew(S.size());
+
+    // Each record uses a different s1 and reward, so that we can check
+    // which ones have been discarded.
+    std::vector<size_t> ids;
+    for (size_t t = 0; t < 5; ++t) {
+        rew.fill(t);
+        aif::State ss1(S.size(), t % 3);
+        ids = exp.record(s, a, ss1, rew);
+    }
+
+    // The blocks contain {2, 3} and {4}.
+    for (size_t i = 0; i < S.size(); ++i) {
+        const auto j = ids[i];
+        BOOST_CHECK_EQUAL(exp.getVisits(i, j, S[i]), 3.0);
+        BOOST_CHECK_EQUAL(exp.getVisits(i, j, 0), 1.0); // t = 3
+        BOOST_CHECK_EQUAL(exp.getVisits(i, j, 1), 1.0); // t = 4
+        BOOST_CHECK_EQUAL(exp.getVisits(i, j, 2), 1.0); // t = 2
+        BOOST_CHECK_CLOSE(exp.getReward(i, j), 3.0, 1e-9);
+        BOOST_CHECK_CLOSE(exp.getM2(i, j), 2.0, 1e-9);
+    }
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 5);
+
+    exp.reset();
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 0);
+    for (size_t i = 0; i < S.size(); ++i)
+        BOOST_CHECK_EQUAL(exp.getVisits(i, ids[i], S[i]), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( sharded_merge ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = model.getS();
+    const auto & graph = model.getGraph();
+
+    const auto events = makeEvents(model, 4000);
+    constexpr size_t shards = 4;
+
+    afm::StreamingCooperativeExperience serial(graph);
+    for (const auto & e : events)
+        serial.record(e.s, e.a, e.s1, e.rew);
+
+    // Each thread records into its own shard, then we reduce.
+    std::vector<afm::StreamingCooperativeExperience> shard(shards, afm::StreamingCooperativeExperience(graph));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < shards; ++t) {
+        threads.emplace_back([&, t]{
+            for (size_t n = t; n < events.size(); n += shards)
+                shard[t].record(events[n].s, events[n].a, events[n].s1, events[n].rew);
+        });
+    }
+    for (auto & t : threads) t.join();
+
+    for (size_t t = 1; t < shards; ++t)
+        shard[0].merge(shard[t]);
+
+    BOOST_CHECK_EQUAL(shard[0].getTimesteps(), serial.getTimesteps());
+    for (size_t i = 0; i < S.size(); ++i) {
+        for (size_t j = 0; j < graph.getSize(i); ++j) {
+            for (size_t s1 = 0; s1 <= S[i]; ++s1)
+                BOOST_CHECK_EQUAL(shard[0].getVisits(i, j, s1), serial.getVisits(i, j, s1));
+            BOOST_CHECK_SMALL(shard[0].getReward(i, j) - serial.getReward(i, j), 1e-9);
+            BOOST_CHECK_SMALL(shard[0].getM2(i, j) - serial.getM2(i, j), 1e-9);
+        }
+    }
+
+    afm::StreamingCooperativeExperience other(graph, 0.5);
+    BOOST_CHECK_THROW(shard[0].merge(other), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( export_keeps_faded_rows ) {
+    auto model = afm::makeSysAdminUniRing(3, 0.1, 0.2, 0.3, 0.4, 0.2, 0.2, 0.1);
+    const auto & S = model.getS();
+    const auto & graph = model.getGraph();
+
+    afm::StreamingCooperativeExperience exp(graph, 0.5);
+
+    aif::State s(S.size(), 0), s1(S.size(), 1), other(S.size(), 2);
+    aif::Action a(model.getA().size(), 0), b(model.getA().size(), 1);
+    ai::Vector rew(S.size());
+
+    // The first rows are visited once, and then decay to an effective
+    // weight well below 0.5.
+    rew.fill(3.0);
+    const auto ids = exp.record(s, a, s1, rew);
+    rew.fill(1.0);
+    std::vector<size_t> otherIds;
+    for (size_t t = 0; t < 10; ++t)
+        otherIds = exp.record(other, b, other, rew);
+
+    afm::CooperativeExperience exported(graph);
+    exp.exportTo(&exported);
+
+    for (size_t i = 0; i < S.size(); ++i) {
+        BOOST_REQUIRE(ids[i] != otherIds[i]);
+        BOOST_CHECK(exp.getVisits(i, ids[i], S[i]) < 0.01);
+
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i](ids[i], 1), 1);
+        BOOST_CHECK_EQUAL(exported.getVisitsTable()[i](ids[i], S[i]), 1);
+        BOOST_CHECK_CLOSE(exported.getRewardMatrix()[i][ids[i]], 3.0, 1e-9);
+    }
+}
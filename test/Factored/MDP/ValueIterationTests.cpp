@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE Factored_MDP_ValueIteration
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Factored/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/Factored/Utils/Core.hpp>
+
+#include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
+
+namespace fm = AIToolbox::Factored::MDP;
+namespace aif = AIToolbox::Factored;
+
+// Returns all states of the model.
+std::vector<aif::State> allStates(const aif::State & S) {
+    std::vector<aif::State> retval;
+    aif::PartialFactorsEnumerator e(S);
+    for (; e.isValid(); e.advance())
+        retval.push_back(e->second);
+    return retval;
+}
+
+// Returns the max Bellman residual of the input values over all states.
+double bellmanResidual(const fm::CooperativeModel & m, const std::vector<aif::State> & states, const AIToolbox::Vector & v) {
+    const auto & S = m.getS();
+
+    double retval = 0.0;
+    for (size_t s = 0; s < states.size(); ++s) {
+        double best = std::numeric_limits<double>::lowest();
+        aif::PartialFactorsEnumerator e(m.getA());
+        for (; e.isValid(); e.advance()) {
+            double q = 0.0;
+            for (size_t s1 = 0; s1 < states.size(); ++s1) {
+                const auto p = m.getTransitionProbability(states[s], e->second, states[s1]);
+                if (p == 0.0) continue;
+                q += p * (m.getExpectedReward(states[s], e->second, states[s1]) + m.getDiscount() * v[aif::toIndex(S, states[s1])]);
+            }
+            best = std::max(best, q);
+        }
+        retval = std::max(retval, std::abs(best - v[aif::toIndex(S, states[s])]));
+    }
+    return retval;
+}
+
+// Creates a basis function for each state of the model, so that any
+// ValueFunction can be represented exactly.
+aif::FactoredVector makeTabularBases(const aif::State & S) {
+    const auto size = aif::factorSpace(S);
+
+    aif::PartialKeys tag(S.size());
+    for (size_t i = 0; i < tag.size(); ++i) tag[i] = i;
+
+    aif::FactoredVector retval;
+    for (size_t s = 0; s < size; ++s) {
+        retval.bases.emplace_back(aif::BasisFunction{tag, AIToolbox::Vector::Zero(size)});
+        retval.bases.back().values[s] = 1.0;
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE( exact_value_iteration ) {
+    auto problem = fm::makeSysAdminUniRing(2, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+
+    const auto states = allStates(problem.getS());
+    const auto h = makeTabularBases(problem.getS());
+
+    fm::ValueIteration solver(10000, 1e-9);
+    auto [variation, w, q] = solver(problem, h, states);
+
+    BOOST_CHECK(variation <= 1e-9);
+    BOOST_CHECK_EQUAL(w.size(), h.bases.size());
+    BOOST_CHECK(bellmanResidual(problem, states, w) < 1e-7);
+
+    // Value iteration is a contraction, so the residual must decrease
+    // geometrically.
+    const auto & stats = solver.getIterationStats();
+    BOOST_CHECK(stats.size() > 1);
+    BOOST_CHECK(stats.size() < 10000);
+    for (size_t i = 1; i < stats.size(); ++i) {
+        BOOST_CHECK(stats[i].residual <= problem.getDiscount() * stats[i-1].residual + 1e-9);
+        BOOST_CHECK(stats[i].seconds >= 0.0);
+    }
+
+    // The returned QFunction should agree with the weights.
+    const auto & S = problem.getS();
+    const auto & A = problem.getA();
+    for (const auto & s : states) {
+        double best = std::numeric_limits<double>::lowest();
+        aif::PartialFactorsEnumerator e(A);
+        for (; e.isValid(); e.advance())
+            best = std::max(best, q.getValue(S, A, s, e->second));
+        BOOST_CHECK_SMALL(best - w[aif::toIndex(S, s)], 1e-7);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( exact_policy_iteration ) {
+    auto problem = fm::makeSysAdminUniRing(2, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+
+    const auto states = allStates(problem.getS());
+    const auto h = makeTabularBases(problem.getS());
+
+    fm::ValueIteration vi(10000, 1e-9);
+    const auto [vv, vw, vq] = vi(problem, h, states);
+
+    fm::ValueIteration pi(100, 1e-9, fm::ValueIteration::Projection::LeastSquares, true);
+    BOOST_CHECK(pi.getPolicyIteration());
+
+    const auto [pv, pw, pq] = pi(problem, h, states);
+
+    // Policy iteration converges in far fewer iterations.
+    BOOST_CHECK(pi.getIterationStats().size() < 20);
+    BOOST_CHECK(pi.getIterationStats().size() < vi.getIterationStats().size());
+
+    BOOST_CHECK(bellmanResidual(problem, states, pw) < 1e-7);
+    for (int i = 0; i < pw.size(); ++i)
+        BOOST_CHECK_SMALL(pw[i] - vw[i], 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE( approximate_projections ) {
+    auto problem = fm::makeSysAdminUniRing(2, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+    const auto & S = problem.getS();
+
+    // Same bases used in the LinearProgramming tests: one indicator per
+    // status/load pair of each machine.
+    aif::FactoredVector h;
+    for (size_t s = 0; s < S.size(); s += 2) {
+        for (size_t i = 0; i < 9; ++i) {
+            h.bases.emplace_back(aif::BasisFunction{{s, s+1}, AIToolbox::Vector::Zero(9)});
+            h.bases.back().values[i] = 1.0;
+        }
+    }
+
+    const auto states = allStates(S);
+    const auto tabular = makeTabularBases(S);
+
+    fm::ValueIteration exact(10000, 1e-9);
+    const auto [ev, ew, eq] = exact(problem, tabular, states);
+
+    AIToolbox::Vector vstar(states.size());
+    for (size_t n = 0; n < states.size(); ++n)
+        vstar[n] = ew[aif::toIndex(S, states[n])];
+
+    AIToolbox::Matrix2D H(states.size(), h.bases.size());
+    for (size_t n = 0; n < states.size(); ++n)
+        for (size_t k = 0; k < h.bases.size(); ++k)
+            H(n, k) = h.bases[k].values[aif::toIndexPartial(h.bases[k].tag, S, states[n])];
+
+    for (auto p : {fm::ValueIteration::Projection::LeastSquares, fm::ValueIteration::Projection::MaxNorm}) {
+        for (bool policyIteration : {false, true}) {
+            fm::ValueIteration solver(1000, 1e-6, p, policyIteration);
+            const auto [variation, w, q] = solver(problem, h, states);
+
+            BOOST_CHECK_EQUAL(w.size(), h.bases.size());
+            BOOST_CHECK(!solver.getIterationStats().empty());
+            BOOST_CHECK_EQUAL(solver.getIterationStats().back().variation, variation);
+
+            // The bases can't represent V* exactly, but should get close.
+            const AIToolbox::Vector v = H * w;
+            BOOST_TEST_INFO("Projection " << static_cast<int>(p) << ", policy iteration " << policyIteration);
+            BOOST_CHECK((v - vstar).cwiseAbs().maxCoeff() < 0.1 * vstar.cwiseAbs().maxCoeff());
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE MDP_ConcurrentExperience
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/ConcurrentExperience.hpp>
+#include <AIToolbox/MDP/MaximumLikelihoodModel.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace aim = AIToolbox::MDP;
+
+BOOST_AUTO_TEST_CASE( basic_experience ) {
+    static_assert(aim::IsExperience<aim::ConcurrentExperience>);
+}
+
+BOOST_AUTO_TEST_CASE( matches_experience ) {
+    const size_t S = 5, A = 3;
+
+    aim::Experience exp(S, A), snap(S, A);
+    aim::ConcurrentExperience cexp(S, A);
+
+    AIToolbox::RandomEngine rnd(AIToolbox::Seeder::getSeed());
+    std::uniform_real_distribution<double> rew(-5.0, 5.0);
+
+    for (size_t t = 0; t < 5000; ++t) {
+        const size_t s = rnd() % S, a = rnd() % A, s1 = rnd() % S;
+        const double r = rew(rnd);
+        exp.record(s, a, s1, r);
+        cexp.record(s, a, s1, r);
+    }
+
+    cexp.snapshot(&snap);
+
+    BOOST_CHECK_EQUAL(snap.getTimesteps(), exp.getTimesteps());
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            BOOST_CHECK_EQUAL(snap.getVisitsSum(s, a), exp.getVisitsSum(s, a));
+            BOOST_CHECK_EQUAL(cexp.getVisitsSum(s, a), exp.getVisitsSum(s, a));
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_EQUAL(snap.getVisits(s, a, s1), exp.getVisits(s, a, s1));
+
+            BOOST_CHECK_CLOSE(snap.getReward(s, a), exp.getReward(s, a), 1e-7);
+            BOOST_CHECK_CLOSE(snap.getM2(s, a), exp.getM2(s, a), 1e-7);
+            BOOST_CHECK_CLOSE(cexp.getM2(s, a), exp.getM2(s, a), 1e-7);
+        }
+    }
+
+    cexp.reset();
+    BOOST_CHECK_EQUAL(cexp.getTimesteps(), 0);
+    BOOST_CHECK_EQUAL(cexp.getVisitsSum(0, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE( buffered_large_rewards ) {
+    const size_t S = 3, A = 2;
+    const size_t threads = 4, records = 5000;
+
+    aim::ConcurrentExperience cexp(S, A);
+
+    // Rewards with a large mean and a small variance: computing M2 from
+    // sums of squares would cancel out all significant digits.
+    auto reward = [](size_t t, size_t i) { return 1e8 + static_cast<double>((t * records + i) % 7); };
+
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t]{
+            auto buffer = cexp.makeBuffer(64);
+            for (size_t i = 0; i < records; ++i) {
+                const size_t s = i % S, a = (i / S) % A;
+                // Mix buffered and direct recording.
+                if (i % 5 == 0) cexp.record(s, a, (s + 1) % S, reward(t, i));
+                else buffer.record(s, a, (s + 1) % S, reward(t, i));
+            }
+        });
+    }
+    for (auto & w : writers) w.join();
+
+    aim::Experience exp(S, A), snap(S, A);
+    for (size_t t = 0; t < threads; ++t)
+        for (size_t i = 0; i < records; ++i)
+            exp.record(i % S, (i / S) % A, (i % S + 1) % S, reward(t, i));
+
+    cexp.snapshot(&snap);
+
+    BOOST_CHECK_EQUAL(snap.getTimesteps(), exp.getTimesteps());
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            BOOST_CHECK_EQUAL(snap.getVisitsSum(s, a), exp.getVisitsSum(s, a));
+            BOOST_CHECK_EQUAL(snap.getVisits(s, a, (s + 1) % S), exp.getVisits(s, a, (s + 1) % S));
+            BOOST_CHECK_CLOSE(snap.getReward(s, a), exp.getReward(s, a), 1e-9);
+            BOOST_CHECK_CLOSE(snap.getM2(s, a), exp.getM2(s, a), 1e-4);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_snapshots ) {
+    const size_t S = 4, A = 2;
+    const size_t threads = 4, records = 20000;
+
+    aim::ConcurrentExperience cexp(S, A);
+
+    // Each thread always records the same reward for a given state-action
+    // pair, so we can check that snapshots are consistent.
+    auto reward = [](size_t s, size_t a) { return static_cast<double>(s * A + a); };
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t]{
+            AIToolbox::RandomEngine rnd(t);
+            for (size_t i = 0; i < records; ++i) {
+                const size_t s = rnd() % S, a = rnd() % A, s1 = rnd() % S;
+                cexp.record(s, a, s1, reward(s, a));
+            }
+        });
+    }
+
+    aim::Experience snap(S, A);
+    aim::MaximumLikelihoodModel<aim::Experience> model(snap, 0.9);
+
+    // Boost.Test checks are not thread-safe, so the reader only records
+    // whether it saw an inconsistent snapshot.
+    unsigned snapshots = 0;
+    bool consistent = true;
+    std::thread reader([&]{
+        do {
+            cexp.snapshot(&snap);
+            ++snapshots;
+
+            unsigned long total = 0;
+            for (size_t s = 0; s < S; ++s) {
+                for (size_t a = 0; a < A; ++a) {
+                    unsigned long sum = 0;
+                    for (size_t s1 = 0; s1 < S; ++s1)
+                        sum += snap.getVisits(s, a, s1);
+
+                    consistent = consistent && sum == snap.getVisitsSum(s, a);
+                    if (sum)
+                        consistent = consistent && std::abs(snap.getReward(s, a) - reward(s, a)) < 1e-9;
+                    total += sum;
+                }
+            }
+            consistent = consistent && total == snap.getTimesteps();
+
+            // The model can be synced while writers continue.
+            model.sync();
+        } while (!done);
+    });
+
+    for (auto & w : writers) w.join();
+    done = true;
+    reader.join();
+
+    BOOST_CHECK(consistent);
+    BOOST_CHECK(snapshots > 0);
+
+    cexp.snapshot(&snap);
+    BOOST_CHECK_EQUAL(snap.getTimesteps(), threads * records);
+    BOOST_CHECK_EQUAL(cexp.getTimesteps(), threads * records);
+}
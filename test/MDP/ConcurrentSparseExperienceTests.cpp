@@ -0,0 +1,139 @@
+#define BOOST_TEST_MODULE MDP_ConcurrentSparseExperience
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/MDP/ConcurrentSparseExperience.hpp>
+#include <AIToolbox/MDP/SparseMaximumLikelihoodModel.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace aim = AIToolbox::MDP;
+
+BOOST_AUTO_TEST_CASE( buffering ) {
+    const size_t S = 5, A = 3;
+
+    aim::ConcurrentSparseExperience cexp(S, A);
+    aim::SparseExperience exp(S, A), snap(S, A);
+
+    {
+        auto buffer = cexp.makeBuffer(4);
+
+        for (size_t t = 0; t < 6; ++t) {
+            buffer.record(t % S, t % A, (t + 1) % S, t);
+            exp.record(t % S, t % A, (t + 1) % S, t);
+        }
+
+        // The first 4 events have been flushed.
+        BOOST_CHECK_EQUAL(buffer.size(), 2);
+        BOOST_CHECK_EQUAL(cexp.getTimesteps(), 4);
+
+        cexp.snapshot(&snap);
+        BOOST_CHECK_EQUAL(snap.getTimesteps(), 4);
+        BOOST_CHECK_EQUAL(snap.getVisits(0, 0, 1), 1);
+        BOOST_CHECK_EQUAL(snap.getVisits(4, 1, 0), 0);
+    }
+
+    // The buffer flushes on destruction.
+    BOOST_CHECK_EQUAL(cexp.getTimesteps(), 6);
+
+    cexp.record(0, 0, 0, 10.0);
+    exp.record(0, 0, 0, 10.0);
+
+    cexp.snapshot(&snap);
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            BOOST_CHECK_EQUAL(snap.getVisitsSum(s, a), exp.getVisitsSum(s, a));
+            BOOST_CHECK_EQUAL(snap.getReward(s, a), exp.getReward(s, a));
+            BOOST_CHECK_EQUAL(snap.getM2(s, a), exp.getM2(s, a));
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_EQUAL(snap.getVisits(s, a, s1), exp.getVisits(s, a, s1));
+        }
+    }
+
+    cexp.reset();
+    BOOST_CHECK_EQUAL(cexp.getTimesteps(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( buffered_large_rewards ) {
+    const size_t S = 4, A = 2;
+
+    aim::ConcurrentSparseExperience cexp(S, A);
+    aim::SparseExperience exp(S, A), snap(S, A);
+
+    {
+        // Each flush sees many events of the same pairs, which are
+        // combined before being applied.
+        auto buffer = cexp.makeBuffer(50);
+        for (size_t t = 0; t < 1000; ++t) {
+            const size_t s = t % S, a = (t / S) % A, s1 = (t / 3) % S;
+            const double r = 1e8 + static_cast<double>(t % 7);
+            buffer.record(s, a, s1, r);
+            exp.record(s, a, s1, r);
+        }
+    }
+
+    cexp.snapshot(&snap);
+    BOOST_CHECK_EQUAL(snap.getTimesteps(), exp.getTimesteps());
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            BOOST_CHECK_EQUAL(snap.getVisitsSum(s, a), exp.getVisitsSum(s, a));
+            BOOST_CHECK_CLOSE(snap.getReward(s, a), exp.getReward(s, a), 1e-9);
+            BOOST_CHECK_CLOSE(snap.getM2(s, a), exp.getM2(s, a), 1e-4);
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_EQUAL(snap.getVisits(s, a, s1), exp.getVisits(s, a, s1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_snapshots ) {
+    const size_t S = 50, A = 4;
+    const size_t threads = 4, batch = 64, records = 300 * batch;
+
+    aim::ConcurrentSparseExperience cexp(S, A);
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t]{
+            AIToolbox::RandomEngine rnd(t);
+            auto buffer = cexp.makeBuffer(batch);
+            for (size_t i = 0; i < records; ++i) {
+                const size_t s = rnd() % S, a = rnd() % A;
+                buffer.record(s, a, (s + a) % S, 1.0);
+            }
+        });
+    }
+
+    aim::SparseExperience snap(S, A);
+    aim::SparseMaximumLikelihoodModel<aim::SparseExperience> model(snap, 0.9);
+
+    // Boost.Test checks are not thread-safe, so the reader only records
+    // whether it saw an inconsistent snapshot.
+    bool consistent = true;
+    std::thread reader([&]{
+        do {
+            cexp.snapshot(&snap);
+            // Only whole batches are ever visible.
+            consistent = consistent && snap.getTimesteps() % batch == 0;
+            consistent = consistent && snap.getVisitsSumTable().sum() == snap.getTimesteps();
+            model.sync();
+        } while (!done);
+    });
+
+    for (auto & w : writers) w.join();
+    done = true;
+    reader.join();
+
+    BOOST_CHECK(consistent);
+
+    cexp.snapshot(&snap);
+    model.sync();
+    BOOST_CHECK_EQUAL(snap.getTimesteps(), threads * records);
+    for (size_t s = 0; s < S; ++s)
+        for (size_t a = 0; a < A; ++a)
+            if (snap.getVisitsSum(s, a))
+                BOOST_CHECK_CLOSE(model.getTransitionProbability(s, a, (s + a) % S), 1.0, 1e-9);
+}
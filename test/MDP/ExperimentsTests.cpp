@@ -0,0 +1,45 @@
+#define BOOST_TEST_MODULE MDP_Experiments
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/MDP/Experiments.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/MDP/Policies/QGreedyPolicy.hpp>
+#include <AIToolbox/MDP/Environments/CornerProblem.hpp>
+
+#include "Utils/OldMDPModel.hpp"
+
+namespace ai = AIToolbox;
+namespace mdp = AIToolbox::MDP;
+
+BOOST_AUTO_TEST_CASE( corner_problem ) {
+    mdp::GridWorld grid(4, 4);
+    const auto model = mdp::makeCornerProblem(grid);
+
+    mdp::ValueIteration solver(1000000, 0.0001);
+    const auto [bound, vfun, qfun] = solver(model);
+    const mdp::QGreedyPolicy policy(qfun);
+
+    constexpr size_t s0 = 10, horizon = 100, episodes = 2000;
+    const auto stats = mdp::runEpisodes(model, policy, s0, episodes, horizon, 4).process();
+
+    // The results do not depend on the number of threads.
+    BOOST_CHECK(mdp::runEpisodes(model, policy, s0, episodes, horizon, 1).process() == stats);
+
+    // The model without sampleSR(s, a, rnd) is sampled in the same way.
+    const OldMDPModel old(model);
+    BOOST_CHECK(mdp::runEpisodes(old, policy, s0, episodes, horizon, 3).process() == stats);
+
+    // The discounted return must match the value of the starting state.
+    double value = 0.0, discount = 1.0;
+    for (size_t t = 0; t < horizon; ++t) {
+        value += discount * std::get<0>(stats[t]);
+        discount *= model.getDiscount();
+    }
+    BOOST_CHECK_CLOSE(value, vfun.values[s0], 5.0);
+
+    // Once in a corner, the episodes stop collecting rewards.
+    BOOST_CHECK_EQUAL(std::get<0>(stats[horizon - 1]), 0.0);
+}
@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE MDP_ImplicitModel
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/MDP/ImplicitModel.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/MDP/Environments/CornerProblem.hpp>
+#include <AIToolbox/MDP/Environments/CliffProblem.hpp>
+
+namespace ai = AIToolbox;
+namespace mdp = AIToolbox::MDP;
+
+// A two-state chain where the action decides whether we try to move.
+struct ChainKernel {
+    double p;
+
+    size_t getS() const { return 2; }
+    size_t getA() const { return 2; }
+
+    template <typename F>
+    void forEachTransition(size_t s, size_t a, F f) const {
+        if (a == 0) f(s, 1.0, 0.0);
+        else {
+            f(1 - s, p, 1.0);
+            f(s, 1.0 - p, -1.0);
+        }
+    }
+};
+
+static_assert(mdp::IsTransitionKernel<ChainKernel>);
+static_assert(mdp::IsModel<mdp::ImplicitModel<ChainKernel>>);
+static_assert(mdp::IsModelMatrixFree<mdp::ImplicitModel<ChainKernel>>);
+static_assert(!mdp::IsModelEigen<mdp::ImplicitModel<ChainKernel>>);
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    mdp::ImplicitModel model(ChainKernel{0.3}, 0.9);
+
+    BOOST_CHECK_EQUAL(model.getS(), 2);
+    BOOST_CHECK_EQUAL(model.getA(), 2);
+    BOOST_CHECK_EQUAL(model.getDiscount(), 0.9);
+
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(0, 1, 1), 0.3);
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(0, 1, 0), 0.7);
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(0, 0, 1), 0.0);
+
+    BOOST_CHECK_EQUAL(model.getExpectedReward(0, 1, 1),  1.0);
+    BOOST_CHECK_EQUAL(model.getExpectedReward(0, 1, 0), -1.0);
+    BOOST_CHECK_CLOSE(model.getRewardFunction()(0, 1), 0.3 - 0.7, 1e-8);
+
+    BOOST_CHECK(!model.isTerminal(0));
+    BOOST_CHECK(mdp::ImplicitModel(ChainKernel{0.0}).isTerminal(0));
+
+    // Invalid probabilities are rejected.
+    BOOST_CHECK_THROW(mdp::ImplicitModel(ChainKernel{1.5}), std::invalid_argument);
+    BOOST_CHECK_THROW(mdp::ImplicitModel(ChainKernel{0.5}, 0.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( sampling ) {
+    mdp::ImplicitModel model(ChainKernel{0.3});
+
+    constexpr unsigned samples = 20000;
+    unsigned moved = 0;
+    for (unsigned i = 0; i < samples; ++i) {
+        const auto [s1, r] = model.sampleSR(0, 1);
+        if (s1 == 1) {
+            ++moved;
+            BOOST_CHECK_EQUAL(r, 1.0);
+        } else {
+            BOOST_CHECK_EQUAL(r, -1.0);
+        }
+    }
+    BOOST_CHECK_CLOSE(static_cast<double>(moved) / samples, 0.3, 5.0);
+}
+
+template <typename E, typename I>
+void checkSameModel(const E & explicitModel, const I & implicitModel) {
+    const auto S = explicitModel.getS(), A = explicitModel.getA();
+    BOOST_REQUIRE_EQUAL(implicitModel.getS(), S);
+    BOOST_REQUIRE_EQUAL(implicitModel.getA(), A);
+    BOOST_CHECK_EQUAL(implicitModel.getDiscount(), explicitModel.getDiscount());
+
+    for (size_t s = 0; s < S; ++s) {
+        BOOST_CHECK_EQUAL(implicitModel.isTerminal(s), explicitModel.isTerminal(s));
+        for (size_t a = 0; a < A; ++a)
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_EQUAL(implicitModel.getTransitionProbability(s, a, s1), explicitModel.getTransitionProbability(s, a, s1));
+    }
+
+    const ai::Matrix2D ir = mdp::computeImmediateRewards(explicitModel);
+    BOOST_CHECK((ir - implicitModel.getRewardFunction()).cwiseAbs().maxCoeff() < 1e-12);
+
+    mdp::ValueIteration solver(1000000, 0.0001);
+    const auto [eb, ev, eq] = solver(explicitModel);
+    const auto [ib, iv, iq] = solver(implicitModel);
+
+    BOOST_CHECK((eq - iq).cwiseAbs().maxCoeff() < 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE( cornerProblem ) {
+    mdp::GridWorld grid(5, 4);
+
+    checkSameModel(mdp::makeCornerProblem(grid), mdp::makeImplicitCornerProblem(grid));
+    checkSameModel(mdp::makeCornerProblem(grid, 0.6), mdp::makeImplicitCornerProblem(grid, 0.6));
+}
+
+BOOST_AUTO_TEST_CASE( cliffProblem ) {
+    mdp::GridWorld grid(5, 3);
+
+    checkSameModel(mdp::makeCliffProblem(grid), mdp::makeImplicitCliffProblem(grid));
+}
@@ -182,3 +182,29 @@ BOOST_AUTO_TEST_CASE( variableActions ) {
     // Just check that we behaved correctly
     BOOST_CHECK(r3 == 5.0);
 }
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox::MDP;
+    namespace ai = AIToolbox;
+
+    GridWorld grid(4,4);
+    auto model = makeCornerProblem(grid);
+
+    MCTS solver(model, 1000, 5.0);
+
+    ai::setInstrumentationEnabled(true);
+    solver.sampleAction(6, 5);
+    ai::setInstrumentationEnabled(false);
+
+    const auto stats = solver.getStatistics();
+    BOOST_CHECK_EQUAL(stats.simulations, 1000);
+    // Each simulation adds at most one node to the tree.
+    BOOST_CHECK(stats.treeNodes > 0);
+    BOOST_CHECK(stats.treeNodes <= 1000);
+    BOOST_CHECK(stats.getSimulationsPerSecond() > 0.0);
+
+    // Disabling instrumentation clears the counters on the next call.
+    solver.sampleAction(6, 5);
+    BOOST_CHECK_EQUAL(solver.getStatistics().simulations, 0);
+    BOOST_CHECK_EQUAL(solver.getStatistics().treeNodes, 0);
+}
@@ -5,9 +5,13 @@
 #include "GlobalFixtures.hpp"
 
 #include <array>
+#include <thread>
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/MDP/Utils.hpp>
 #include <AIToolbox/MDP/Policies/QGreedyPolicy.hpp>
+#include <AIToolbox/MDP/Policies/QSoftmaxPolicy.hpp>
+#include <AIToolbox/MDP/Policies/EpsilonPolicy.hpp>
+#include <AIToolbox/MDP/Policies/Policy.hpp>
 
 BOOST_AUTO_TEST_CASE( sampling ) {
     using namespace AIToolbox;
@@ -119,3 +123,127 @@ BOOST_AUTO_TEST_CASE( getPolicy ) {
     BOOST_CHECK(checkEqualSmall(matrix(2,1), 1.0/3.0));
     BOOST_CHECK(checkEqualSmall(matrix(2,2), 1.0/3.0));
 }
+
+BOOST_AUTO_TEST_CASE( external_generator ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 2, A = 3;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 1.0; q(0,1) = 1.0; q(0,2) = 0.0;
+    q(1,0) = 0.0; q(1,1) = 0.0; q(1,2) = 0.0;
+
+    const QGreedyPolicy greedy(q);
+    const EpsilonPolicy p(greedy, 0.3);
+
+    // The same generator state produces the same actions.
+    auto rnd1 = Seeder::getStreamEngine(0), rnd2 = Seeder::getStreamEngine(0);
+    for (unsigned i = 0; i < 100; ++i)
+        BOOST_CHECK_EQUAL(p.sampleAction(0, rnd1), p.sampleAction(0, rnd2));
+
+    // A single policy can be sampled from multiple threads.
+    constexpr unsigned threads = 4, samples = 20000;
+    std::array<std::array<unsigned, A>, threads> counts{};
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]{
+            auto & rnd = Seeder::getThreadEngine();
+            for (unsigned i = 0; i < samples; ++i)
+                ++counts[t][p.sampleAction(i % S, rnd)];
+        });
+    }
+    for (auto & w : workers) w.join();
+
+    const auto policy = p.getPolicy();
+    for (size_t a = 0; a < A; ++a) {
+        const double expected = (policy(0, a) + policy(1, a)) / 2.0;
+        unsigned total = 0;
+        for (unsigned t = 0; t < threads; ++t)
+            total += counts[t][a];
+        BOOST_CHECK_SMALL(static_cast<double>(total) / (threads * samples) - expected, 0.01);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( batch ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 4, A = 3;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 45;   q(0,1) = 14;      q(0,2) = -15;
+    q(1,0) = 1001; q(1,1) = 1000.99; q(1,2) = 1001;
+    q(2,0) = 42;   q(2,1) = 42;      q(2,2) = 42;
+    q(3,0) = 1e6;  q(3,1) = 1e6 - 1; q(3,2) = 0;
+
+    const QGreedyPolicy greedy(q);
+    const QSoftmaxPolicy softmax(q, 2.0);
+    const EpsilonPolicy epsilon(softmax, 0.2);
+    const Policy policy(epsilon);
+
+    const std::vector<size_t> states{3, 0, 1, 2, 1, 3};
+
+    using PI = AIToolbox::MDP::PolicyInterface;
+    for (const PI * p : std::initializer_list<const PI *>{&greedy, &softmax, &epsilon, &policy}) {
+        const auto probs = p->getActionProbabilities(states);
+        BOOST_CHECK_EQUAL(probs.rows(), states.size());
+
+        for (size_t i = 0; i < states.size(); ++i)
+            for (size_t a = 0; a < A; ++a)
+                BOOST_CHECK_SMALL(probs(i, a) - p->getActionProbability(states[i], a), 1e-9);
+
+        // Check the sampled frequencies for a large batch of the same state.
+        const std::vector<size_t> many(30000, 1);
+        std::vector<size_t> out(many.size());
+        p->sampleActions(many, out);
+
+        std::array<unsigned, A> counts{};
+        for (auto a : out) ++counts[a];
+        for (size_t a = 0; a < A; ++a)
+            BOOST_CHECK_SMALL(counts[a] / static_cast<double>(many.size()) - probs(2, a), 0.015);
+    }
+
+    std::vector<size_t> wrongSize(2);
+    BOOST_CHECK_THROW(greedy.sampleActions(states, wrongSize), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( softmax_concurrent_queries ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 3, A = 4;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 1.0; q(0,1) = 1.0; q(0,2) = 0.0; q(0,3) = 1.0;
+    q(1,0) = 0.0; q(1,1) = 2.0; q(1,2) = 2.0; q(1,3) = 0.0;
+    q(2,0) = 3.0; q(2,1) = 0.0; q(2,2) = 0.0; q(2,3) = 0.0;
+
+    // With zero temperature all queries go through the greedy wrapper,
+    // which writes to its action buffer.
+    const QSoftmaxPolicy p(q, 0.0);
+    const auto expected = p.getPolicy();
+    const std::vector<size_t> states{0, 1, 2, 1, 0};
+
+    constexpr unsigned threads = 4, rounds = 2000;
+    std::array<bool, threads> ok{};
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]{
+            bool good = true;
+            for (unsigned i = 0; i < rounds; ++i) {
+                const size_t s = i % S, a = i % A;
+                good &= checkEqualSmall(p.getActionProbability(s, a), expected(s, a));
+                good &= p.getPolicy().isApprox(expected);
+
+                const auto probs = p.getActionProbabilities(states);
+                for (size_t j = 0; j < states.size(); ++j)
+                    good &= probs.row(j).isApprox(expected.row(states[j]));
+            }
+            ok[t] = good;
+        });
+    }
+    for (auto & w : workers) w.join();
+
+    for (unsigned t = 0; t < threads; ++t)
+        BOOST_CHECK(ok[t]);
+}
@@ -43,6 +43,24 @@ BOOST_AUTO_TEST_CASE( updates ) {
     }
 }
 
+BOOST_AUTO_TEST_CASE( float_storage ) {
+    using namespace AIToolbox::MDP;
+
+    QLearning solver(5, 5, 0.9, 0.5);
+    QLearningT<float> fsolver(5, 5, 0.9, 0.5);
+
+    AIToolbox::RandomEngine rnd(AIToolbox::Seeder::getSeed());
+    for (size_t t = 0; t < 1000; ++t) {
+        const size_t s = rnd() % 5, a = rnd() % 5, s1 = rnd() % 5;
+        const double rew = static_cast<double>(rnd() % 10);
+
+        solver.stepUpdateQ(s, a, s1, rew);
+        fsolver.stepUpdateQ(s, a, s1, rew);
+    }
+
+    BOOST_CHECK(fsolver.getQFunction().cast<double>().isApprox(solver.getQFunction(), 1e-5));
+}
+
 BOOST_AUTO_TEST_CASE( cliff ) {
     using namespace AIToolbox::MDP;
     using namespace GridWorldUtils;
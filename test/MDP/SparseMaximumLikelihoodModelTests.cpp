@@ -170,6 +170,93 @@ BOOST_AUTO_TEST_CASE( sampling ) {
     BOOST_CHECK_MESSAGE( k > 2000 && k < 4000, "This test may fail from time to time as it is based on sampling. k should be ~3333. k is " << k ); // Hopefully
 }
 
+BOOST_AUTO_TEST_CASE( online_storage ) {
+    using namespace AIToolbox::MDP;
+    const size_t S = 30, A = 3;
+
+    SparseExperience exp(S, A), plainExp(S, A);
+    SparseMaximumLikelihoodModel<SparseExperience> model(exp);
+
+    exp.reserveRows(S);
+    model.reserveRows(S);
+    BOOST_CHECK(!model.isCompressed());
+
+    std::vector<const double *> values;
+    std::vector<const unsigned long *> visits;
+    for (size_t a = 0; a < A; ++a) {
+        values.push_back(model.getTransitionFunction(a).valuePtr());
+        visits.push_back(exp.getVisitsTable(a).valuePtr());
+    }
+
+    AIToolbox::RandomEngine rnd(AIToolbox::Seeder::getSeed());
+    for (size_t t = 0; t < 5000; ++t) {
+        const size_t s = rnd() % S, a = rnd() % A, s1 = rnd() % S;
+        exp.record(s, a, s1, static_cast<double>(s1));
+        plainExp.record(s, a, s1, static_cast<double>(s1));
+        if (t % 2) model.sync(s, a, s1);
+        else       model.sync(s, a);
+    }
+    model.sync();
+
+    // Since every row had enough space, no table was reallocated.
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_CHECK_EQUAL(model.getTransitionFunction(a).valuePtr(), values[a]);
+        BOOST_CHECK_EQUAL(exp.getVisitsTable(a).valuePtr(), visits[a]);
+    }
+
+    SparseMaximumLikelihoodModel<SparseExperience> check(plainExp, 1.0, true);
+
+    model.compress();
+    exp.compress();
+    BOOST_CHECK(model.isCompressed());
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_CHECK(exp.getVisitsTable(a).isCompressed());
+        BOOST_CHECK_EQUAL((exp.getVisitsTable(a) - plainExp.getVisitsTable(a)).norm(), 0);
+    }
+
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            BOOST_CHECK_CLOSE(model.getExpectedReward(s, a, 0), check.getExpectedReward(s, a, 0), 1e-9);
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_SMALL(model.getTransitionProbability(s, a, s1) - check.getTransitionProbability(s, a, s1), 1e-9);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( compress_prunes_zeros ) {
+    using namespace AIToolbox::MDP;
+    const size_t S = 4, A = 2;
+
+    SparseExperience exp(S, A);
+    SparseMaximumLikelihoodModel<SparseExperience> model(exp);
+    BOOST_CHECK(model.isCompressed());
+
+    // No self-transitions, so every visited pair clears its initial one.
+    exp.record(0, 0, 1, 0.0);
+    model.sync(0, 0, 1);
+    exp.record(1, 0, 2, 5.0);
+    exp.record(1, 0, 3, 5.0);
+    model.sync(1, 0);
+    exp.record(2, 1, 0, 1.0);
+    model.sync(2, 1);
+
+    // New transitions uncompress the matrices even without reserveRows().
+    BOOST_CHECK(!model.isCompressed());
+
+    model.compress();
+    BOOST_CHECK(model.isCompressed());
+
+    // Visited transitions plus the self-transitions of unvisited pairs.
+    BOOST_CHECK_EQUAL(model.getTransitionFunction(0).nonZeros(), 3 + 2);
+    BOOST_CHECK_EQUAL(model.getTransitionFunction(1).nonZeros(), 1 + 3);
+    // The reward of (0, 0) is zero and must not be stored.
+    BOOST_CHECK_EQUAL(model.getRewardFunction().nonZeros(), 2);
+
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(0, 0, 1), 1.0);
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(1, 0, 3), 0.5);
+    BOOST_CHECK_EQUAL(model.getTransitionProbability(3, 1, 3), 1.0);
+}
+
 /*
 BOOST_AUTO_TEST_CASE( IO ) {
     const int S = 10, A = 8;
@@ -8,8 +8,11 @@
 #include <AIToolbox/MDP/SparseModel.hpp>
 
 #include <AIToolbox/MDP/Environments/CornerProblem.hpp>
+#include <AIToolbox/Tools/CassandraParser.hpp>
 
 #include <fstream>
+#include <random>
+#include <sstream>
 
 BOOST_AUTO_TEST_CASE( eigen_model ) {
     static_assert(AIToolbox::MDP::IsModelEigen<AIToolbox::MDP::SparseModel>);
@@ -152,3 +155,139 @@ BOOST_AUTO_TEST_CASE( setTransitionFunctionSparse ) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE( cassandraSparse ) {
+    using namespace AIToolbox::MDP;
+
+    const std::string inputFilename = "./data/corner.MDP";
+
+    std::ifstream inputFile(inputFilename);
+    if ( !inputFile ) BOOST_FAIL("Data to perform test could not be loaded: " + inputFilename);
+
+    const auto m = parseCassandra(inputFile);
+    const size_t S = m.getS(), A = m.getA();
+
+    for ( const unsigned threads : {1u, 3u} ) {
+        const auto m2 = parseCassandraSparse(inputFilename, threads);
+
+        BOOST_CHECK_EQUAL(m.getS(), m2.getS());
+        BOOST_CHECK_EQUAL(m.getA(), m2.getA());
+        BOOST_CHECK_EQUAL(m.getDiscount(), m2.getDiscount());
+
+        for ( size_t a = 0; a < A; ++a )
+        for ( size_t s = 0; s < S; ++s )
+        for ( size_t s1 = 0; s1 < S; ++s1 ) {
+            BOOST_CHECK(AIToolbox::checkEqualSmall(m.getTransitionProbability(s, a, s1), m2.getTransitionProbability(s, a, s1)));
+            BOOST_CHECK(AIToolbox::checkEqualGeneral(m.getExpectedReward(s, a, s1), m2.getExpectedReward(s, a, s1)));
+        }
+    }
+
+    BOOST_CHECK_THROW(parseCassandraSparse("./data/does_not_exist.MDP"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( cassandraSparseParser ) {
+    // We generate a file with many overlapping statements, using all the
+    // syntax supported by the dense parser, and check that the sparse
+    // parser gives the same results for any number of threads.
+    constexpr size_t S = 7, A = 3;
+
+    AIToolbox::RandomEngine rnd(12345);
+    std::uniform_int_distribution<size_t> stmtDist(0, 4), sDist(0, S - 1), aDist(0, A - 1), vDist(0, 8), wildDist(0, 4);
+
+    auto value = [&]{ return vDist(rnd) / 8.0; };
+    auto state = [&]{ return wildDist(rnd) == 0 ? std::string("*") : "s" + std::to_string(sDist(rnd)); };
+    auto action = [&]{ return wildDist(rnd) == 0 ? std::string("*") : std::to_string(aDist(rnd)); };
+
+    std::ostringstream file;
+    file << "discount: 0.9\nvalues: reward\nstates:";
+    for ( size_t s = 0; s < S; ++s ) file << " s" << s;
+    file << "\nactions: " << A << "\n\n";
+
+    for ( unsigned i = 0; i < 300; ++i ) {
+        switch ( stmtDist(rnd) ) {
+            case 0:
+                file << "T: " << action() << " : " << state() << " : " << state() << ' ' << value() << '\n';
+                break;
+            case 1:
+                file << "T: " << action() << " : " << state() << '\n';
+                for ( size_t s1 = 0; s1 < S; ++s1 ) file << value() << ' ';
+                file << '\n';
+                break;
+            case 2:
+                file << "T: " << action() << '\n';
+                for ( size_t s = 0; s < S; ++s ) {
+                    for ( size_t s1 = 0; s1 < S; ++s1 ) file << value() << ' ';
+                    file << '\n';
+                }
+                break;
+            default:
+                file << "R: " << action() << " : " << state() << " : " << state() << " : * " << value() - 0.5 << '\n';
+        }
+    }
+    const auto input = file.str();
+
+    AIToolbox::CassandraParser parser;
+    std::istringstream stream(input);
+    const auto [S1, A1, T1, R1, d1] = parser.parseMDP(stream);
+
+    for ( const unsigned threads : {1u, 2u, 5u, 16u} ) {
+        const auto [S2, A2, T2, R2, d2] = parser.parseSparseMDP(input, threads);
+
+        BOOST_CHECK_EQUAL(S1, S2);
+        BOOST_CHECK_EQUAL(A1, A2);
+        BOOST_CHECK_EQUAL(d1, d2);
+
+        for ( size_t s = 0; s < S; ++s ) {
+            for ( size_t a = 0; a < A; ++a ) {
+                double r = 0.0;
+                for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                    BOOST_CHECK_EQUAL(T1[s][a][s1], T2[a].coeff(s, s1));
+                    r += T1[s][a][s1] * R1[s][a][s1];
+                }
+                BOOST_CHECK(AIToolbox::checkEqualGeneral(r, R2.coeff(s, a)));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( cassandraSparseExtensions ) {
+    // Comments and matrix keywords are only supported by the sparse parser.
+    const std::string input =
+        "states: 3 # three states\n"
+        "actions: 2\n"
+        "T: * \n"
+        "identity\n"
+        "T: 0 : 2 : 0 1.0 # overrides part of the identity\n"
+        "T: 0 : 2 : 2 0\n"
+        "T: 1\n"
+        "uniform\n"
+        "T: 1 : 0 uniform\n"
+        "T: 1 : 1\n"
+        "0.5 0 0.5\n"
+        "R: * : * : * : * 1.0\n"
+        "R: 1 : 1 : 2 : * 3.0\n";
+
+    AIToolbox::CassandraParser parser;
+    const auto [S, A, T, R, discount] = parser.parseSparseMDP(input);
+
+    BOOST_CHECK_EQUAL(S, 3);
+    BOOST_CHECK_EQUAL(A, 2);
+    BOOST_CHECK_EQUAL(discount, 1.0);
+
+    BOOST_CHECK_EQUAL(T[0].nonZeros(), 3);
+    BOOST_CHECK_EQUAL(T[0].coeff(0, 0), 1.0);
+    BOOST_CHECK_EQUAL(T[0].coeff(1, 1), 1.0);
+    BOOST_CHECK_EQUAL(T[0].coeff(2, 0), 1.0);
+
+    BOOST_CHECK_EQUAL(T[1].nonZeros(), 8);
+    BOOST_CHECK_EQUAL(T[1].coeff(0, 2), 1.0 / 3.0);
+    BOOST_CHECK_EQUAL(T[1].coeff(1, 1), 0.0);
+    BOOST_CHECK_EQUAL(T[1].coeff(1, 2), 0.5);
+
+    BOOST_CHECK_EQUAL(R.coeff(0, 0), 1.0);
+    BOOST_CHECK_EQUAL(R.coeff(1, 1), 0.5 * 1.0 + 0.5 * 3.0);
+
+    BOOST_CHECK_THROW(parser.parseSparseMDP("states: 3\nactions: 2\nT: 0 : 1\n0.5 0.5\n"), std::runtime_error);
+    BOOST_CHECK_THROW(parser.parseSparseMDP("states: 3\nactions: 2\nT: 2 : 1 : 1 1.0\n"), std::runtime_error);
+    BOOST_CHECK_THROW(parser.parseSparseMDP("states: 3\nactions: 2\nT: 0 : 1 : 1 one\n", 4), std::runtime_error);
+}
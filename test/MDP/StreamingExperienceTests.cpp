@@ -0,0 +1,186 @@
+#define BOOST_TEST_MODULE MDP_StreamingExperience
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/MDP/StreamingExperience.hpp>
+#include <AIToolbox/MDP/Experience.hpp>
+#include <AIToolbox/MDP/MaximumLikelihoodModel.hpp>
+
+#include <random>
+#include <thread>
+
+namespace ai = AIToolbox;
+namespace aim = AIToolbox::MDP;
+
+struct Event {
+    size_t s, a, s1;
+    double rew;
+};
+
+std::vector<Event> makeEvents(const size_t S, const size_t A, const size_t n) {
+    ai::RandomEngine rnd(ai::Seeder::getSeed());
+    std::uniform_real_distribution<double> rew(-1.0, 1.0);
+
+    std::vector<Event> retval;
+    retval.reserve(n);
+    for (size_t t = 0; t < n; ++t)
+        retval.push_back({rnd() % S, rnd() % A, rnd() % S, rew(rnd)});
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    aim::StreamingExperience exp(5, 3, 0.9);
+
+    BOOST_CHECK_EQUAL(exp.getS(), 5);
+    BOOST_CHECK_EQUAL(exp.getA(), 3);
+    BOOST_CHECK_EQUAL(exp.getDecay(), 0.9);
+    BOOST_CHECK_EQUAL(exp.getWindow(), 0);
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 0);
+
+    BOOST_CHECK_THROW(aim::StreamingExperience(5, 3, 0.0), std::invalid_argument);
+    BOOST_CHECK_THROW(aim::StreamingExperience(5, 3, 1.1), std::invalid_argument);
+    BOOST_CHECK_THROW(aim::StreamingExperience(5, 3, 0.9, 10), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( no_decay_matches_experience ) {
+    const size_t S = 5, A = 3;
+
+    aim::Experience exp(S, A), exported(S, A);
+    aim::StreamingExperience stream(S, A);
+
+    for (const auto & e : makeEvents(S, A, 2000)) {
+        exp.record(e.s, e.a, e.s1, e.rew);
+        stream.record(e.s, e.a, e.s1, e.rew);
+    }
+
+    stream.exportTo(&exported);
+
+    BOOST_CHECK_EQUAL(exported.getTimesteps(), exp.getTimesteps());
+    for (size_t a = 0; a < A; ++a)
+        BOOST_CHECK_EQUAL(exported.getVisitsTable(a), exp.getVisitsTable(a));
+    BOOST_CHECK_EQUAL(exported.getVisitsSumTable(), exp.getVisitsSumTable());
+    BOOST_CHECK(exported.getRewardMatrix().isApprox(exp.getRewardMatrix(), 1e-9));
+    BOOST_CHECK(exported.getM2Matrix().isApprox(exp.getM2Matrix(), 1e-9));
+
+    // Models can be built on top of the exported experience.
+    aim::MaximumLikelihoodModel<aim::Experience> ref(exp, 0.9, true), model(exported, 0.9, true);
+    for (size_t a = 0; a < A; ++a)
+        BOOST_CHECK(ref.getTransitionFunction(a).isApprox(model.getTransitionFunction(a)));
+}
+
+BOOST_AUTO_TEST_CASE( exponential_decay ) {
+    const double decay = 0.5;
+    aim::StreamingExperience exp(3, 2, decay);
+
+    exp.record(0, 1, 1, 1.0);
+    exp.record(0, 1, 0, 4.0);
+
+    BOOST_CHECK_CLOSE(exp.getVisits(0, 1, 1), 0.5, 1e-9);
+    BOOST_CHECK_CLOSE(exp.getVisits(0, 1, 0), 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(exp.getVisitsSum(0, 1), 1.5, 1e-9);
+
+    // Weighted average and weighted sum of squared differences.
+    const double mean = (0.5 * 1.0 + 1.0 * 4.0) / 1.5;
+    BOOST_CHECK_CLOSE(exp.getReward(0, 1), mean, 1e-9);
+    BOOST_CHECK_CLOSE(exp.getM2(0, 1), 0.5 * (1.0 - mean) * (1.0 - mean) + (4.0 - mean) * (4.0 - mean), 1e-9);
+
+    // Record many more times so that weights are rescaled internally; the
+    // effective visits must converge to 1 / (1 - decay).
+    for (size_t t = 0; t < 2000; ++t)
+        exp.record(0, 1, 0, 2.0);
+
+    BOOST_CHECK_CLOSE(exp.getVisitsSum(0, 1), 1.0 / (1.0 - decay), 1e-6);
+    BOOST_CHECK_SMALL(exp.getVisits(0, 1, 1), 1e-12);
+    BOOST_CHECK_CLOSE(exp.getReward(0, 1), 2.0, 1e-6);
+    BOOST_CHECK_SMALL(exp.getM2(0, 1), 1e-6);
+
+    aim::Experience exported(3, 2);
+    exp.exportTo(&exported);
+    BOOST_CHECK_EQUAL(exported.getVisits(0, 1, 0), 2);
+    BOOST_CHECK_EQUAL(exported.getVisits(0, 1, 1), 0);
+    BOOST_CHECK_EQUAL(exported.getVisitsSum(0, 1), 2);
+}
+
+BOOST_AUTO_TEST_CASE( export_keeps_faded_pairs ) {
+    aim::StreamingExperience exp(3, 2, 0.5);
+
+    // The first pair is visited once, and then decays to an effective
+    // weight well below 0.5.
+    exp.record(1, 0, 2, 3.0);
+    for (size_t t = 0; t < 10; ++t)
+        exp.record(0, 1, 0, 1.0);
+
+    BOOST_CHECK(exp.getVisitsSum(1, 0) < 0.01);
+
+    aim::Experience exported(3, 2);
+    exp.exportTo(&exported);
+
+    BOOST_CHECK_EQUAL(exported.getVisits(1, 0, 2), 1);
+    BOOST_CHECK_EQUAL(exported.getVisitsSum(1, 0), 1);
+    BOOST_CHECK_CLOSE(exported.getReward(1, 0), 3.0, 1e-9);
+
+    // Pairs which were never visited stay so.
+    BOOST_CHECK_EQUAL(exported.getVisitsSum(2, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE( windowed_decay ) {
+    aim::StreamingExperience exp(3, 1, 1.0, 2);
+
+    // Each record uses a different s1 and reward, so that we can check
+    // which ones have been discarded.
+    for (size_t t = 0; t < 5; ++t)
+        exp.record(0, 0, t % 3, t);
+
+    // The blocks contain {2, 3} and {4}.
+    BOOST_CHECK_EQUAL(exp.getVisitsSum(0, 0), 3.0);
+    BOOST_CHECK_EQUAL(exp.getVisits(0, 0, 0), 1.0); // t = 3
+    BOOST_CHECK_EQUAL(exp.getVisits(0, 0, 1), 1.0); // t = 4
+    BOOST_CHECK_EQUAL(exp.getVisits(0, 0, 2), 1.0); // t = 2
+    BOOST_CHECK_CLOSE(exp.getReward(0, 0), 3.0, 1e-9);
+    BOOST_CHECK_CLOSE(exp.getM2(0, 0), 2.0, 1e-9);
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 5);
+
+    exp.reset();
+    BOOST_CHECK_EQUAL(exp.getTimesteps(), 0);
+    BOOST_CHECK_EQUAL(exp.getVisitsSum(0, 0), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( sharded_merge ) {
+    const size_t S = 5, A = 3;
+
+    const auto events = makeEvents(S, A, 4000);
+    constexpr size_t shards = 4;
+
+    aim::StreamingExperience serial(S, A);
+    for (const auto & e : events)
+        serial.record(e.s, e.a, e.s1, e.rew);
+
+    // Each thread records into its own shard, then we reduce.
+    std::vector<aim::StreamingExperience> shard(shards, aim::StreamingExperience(S, A));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < shards; ++t) {
+        threads.emplace_back([&, t]{
+            for (size_t n = t; n < events.size(); n += shards)
+                shard[t].record(events[n].s, events[n].a, events[n].s1, events[n].rew);
+        });
+    }
+    for (auto & t : threads) t.join();
+
+    for (size_t t = 1; t < shards; ++t)
+        shard[0].merge(shard[t]);
+
+    BOOST_CHECK_EQUAL(shard[0].getTimesteps(), serial.getTimesteps());
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            for (size_t s1 = 0; s1 < S; ++s1)
+                BOOST_CHECK_EQUAL(shard[0].getVisits(s, a, s1), serial.getVisits(s, a, s1));
+            BOOST_CHECK_SMALL(shard[0].getReward(s, a) - serial.getReward(s, a), 1e-9);
+            BOOST_CHECK_SMALL(shard[0].getM2(s, a) - serial.getM2(s, a), 1e-9);
+        }
+    }
+
+    aim::StreamingExperience other(S, A, 0.5);
+    BOOST_CHECK_THROW(shard[0].merge(other), std::invalid_argument);
+}
@@ -5,7 +5,9 @@
 #include "GlobalFixtures.hpp"
 
 #include <AIToolbox/Types.hpp>
+#include <AIToolbox/Seeder.hpp>
 #include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/Utils/Polytope.hpp>
 
 BOOST_AUTO_TEST_CASE( extractBestUsefulPointsTest ) {
@@ -118,3 +120,114 @@ BOOST_AUTO_TEST_CASE( optimistic_value_discovery ) {
 
     BOOST_CHECK(checkEqualGeneral(v, solution));
 }
+
+BOOST_AUTO_TEST_CASE( indexed_sawtooth_interpolation ) {
+    using namespace AIToolbox;
+
+    constexpr size_t S = 6, A = 3;
+    RandomEngine rand(Seeder::getSeed());
+    std::uniform_real_distribution<double> dist(0.0, 10.0);
+    std::bernoulli_distribution zero(0.3);
+
+    const auto makePoint = [&]{
+        Point p = makeRandomProbability(S, rand);
+        // Zero out some coordinates so that we get different supports.
+        for (size_t s = 0; s < S; ++s)
+            if (zero(rand)) p[s] = 0.0;
+        if (p.sum() == 0.0) p[0] = 1.0;
+        return Point(p / p.sum());
+    };
+
+    CompactHyperplanes ubQ(S, A);
+    for (size_t s = 0; s < S; ++s)
+        for (size_t a = 0; a < A; ++a)
+            ubQ(s, a) = dist(rand);
+
+    PointSurface ubV;
+    IndexedPointSurface index(ubQ);
+
+    const auto check = [&]{
+        BOOST_CHECK_EQUAL(index.size(), ubV.first.size());
+        for (size_t i = 0; i < 20; ++i) {
+            const auto p = makePoint();
+            const auto [v1, c1] = sawtoothInterpolation(p, ubQ, ubV);
+            const auto [v2, c2] = sawtoothInterpolation(p, ubQ, index);
+
+            BOOST_CHECK(checkEqualGeneral(v1, v2));
+            BOOST_CHECK_EQUAL(c1.size(), c2.size());
+        }
+    };
+
+    // Add points, each below the current surface so that it is useful.
+    for (size_t i = 0; i < 30; ++i) {
+        auto p = makePoint();
+        const double v = std::get<0>(sawtoothInterpolation(p, ubQ, ubV)) - dist(rand) * 0.1;
+        ubV.first.push_back(p);
+        ubV.second.push_back(v);
+        index.add(std::move(p), v);
+    }
+    check();
+
+    // Erasing moves the last point in place of the erased one.
+    for (auto id : {3, 10, 0}) {
+        std::swap(ubV.first[id], ubV.first.back());
+        std::swap(ubV.second[id], ubV.second.back());
+        ubV.first.pop_back();
+        ubV.second.pop_back();
+        index.erase(id);
+    }
+    for (size_t i = 0; i < index.size(); ++i) {
+        BOOST_CHECK(veccmp(index.getPoints()[i], ubV.first[i]) == 0);
+        BOOST_CHECK_EQUAL(index.getValues()[i], ubV.second[i]);
+    }
+    check();
+
+    // Swapping and changing values.
+    std::swap(ubV.first[1], ubV.first[5]);
+    std::swap(ubV.second[1], ubV.second[5]);
+    index.swap(1, 5);
+
+    ubV.second[7] -= 2.0;
+    index.setValue(7, ubV.second[7]);
+    check();
+
+    // Changing the corners requires resyncing the index.
+    ubQ(2, 1) = ubQ.maxCoeff() + 1.0;
+    index.setCorners(ubQ);
+    check();
+}
+
+BOOST_AUTO_TEST_CASE( indexed_lp_interpolation ) {
+    using namespace AIToolbox;
+
+    CompactHyperplanes ubQ(3, 2);
+    ubQ << 10.0, 4.0,
+            3.0, 8.0,
+            5.0, 5.0;
+
+    PointSurface ubV = {
+        {
+            (Point(3) << 0.5, 0.5, 0.0).finished(),
+            (Point(3) << 0.2, 0.3, 0.5).finished(),
+            (Point(3) << 0.0, 0.4, 0.6).finished(),
+            (Point(3) << 0.6, 0.2, 0.2).finished(),
+        },
+        {5.0, 4.0, 5.5, 6.0}
+    };
+    IndexedPointSurface index(ubQ, ubV);
+
+    const std::vector<Point> tests = {
+        (Point(3) << 0.3, 0.3, 0.4).finished(),
+        (Point(3) << 0.4, 0.6, 0.0).finished(),
+        (Point(3) << 0.0, 0.5, 0.5).finished(),
+        (Point(3) << 0.0, 0.0, 1.0).finished(),
+    };
+
+    for (const auto & p : tests) {
+        const auto [v1, c1] = LPInterpolation(p, ubQ, ubV);
+        const auto [v2, c2] = LPInterpolation(p, ubQ, index);
+
+        BOOST_CHECK(checkEqualSmall(v1, v2));
+        BOOST_CHECK(veccmpSmall(c1, c2) == 0);
+    }
+}
@@ -298,3 +298,58 @@ BOOST_AUTO_TEST_CASE( escapeToCornersNonEigen ) {
         BOOST_CHECK_EQUAL( qfun.row(s).maxCoeff(), values[s] );
     }
 }
+
+BOOST_AUTO_TEST_CASE( singlePrecisionModels ) {
+    using namespace AIToolbox::MDP;
+    using namespace GridWorldUtils;
+
+    GridWorld grid(4, 4);
+
+    Model model = makeCornerProblem(grid);
+    ModelT<float> fmodel(model);
+    SparseModelT<float> sfmodel(model);
+
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(fmodel.getTransitionFunction(0))>, AIToolbox::Matrix2DT<float>>);
+
+    ValueIteration solver(1000000, 0.001);
+
+    const auto [bound, vfun, qfun] = solver(model);
+    const auto [fbound, fvfun, fqfun] = solver(fmodel);
+    const auto [sfbound, sfvfun, sfqfun] = solver(sfmodel);
+
+    BOOST_CHECK( fbound <= solver.getTolerance() );
+    BOOST_CHECK( sfbound <= solver.getTolerance() );
+
+    // Values are still computed in double, so the only error comes from
+    // the products with the transition matrices.
+    BOOST_CHECK( (qfun - fqfun).cwiseAbs().maxCoeff() < 1e-5 );
+    BOOST_CHECK( (qfun - sfqfun).cwiseAbs().maxCoeff() < 1e-5 );
+    BOOST_CHECK( (vfun.values - fvfun.values).cwiseAbs().maxCoeff() < 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox::MDP;
+    namespace ai = AIToolbox;
+
+    GridWorld grid(4, 4);
+    const auto model = makeCornerProblem(grid);
+
+    ValueIteration solver(100, 0.0);
+    solver(model);
+
+    // Nothing is recorded by default.
+    BOOST_CHECK_EQUAL(solver.getStatistics().iterations, 0);
+    BOOST_CHECK(solver.getStatistics().residuals.empty());
+
+    ai::setInstrumentationEnabled(true);
+    const auto [variation, vf, q] = solver(model);
+    ai::setInstrumentationEnabled(false);
+
+    const auto & stats = solver.getStatistics();
+    BOOST_CHECK_EQUAL(stats.iterations, 100);
+    BOOST_REQUIRE_EQUAL(stats.residuals.size(), 100);
+    BOOST_CHECK(stats.residuals.back() < stats.residuals.front());
+    BOOST_CHECK_EQUAL(stats.lpCalls, 0);
+    // Recording does not change the tolerance-less result.
+    BOOST_CHECK_EQUAL(variation, 0.0);
+}
@@ -25,3 +25,28 @@ BOOST_AUTO_TEST_CASE( discountedHorizon ) {
     (void)vlist;
     (void)qfun;
 }
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox::POMDP;
+    namespace ai = AIToolbox;
+
+    GapMin gm(0.005, 3);
+
+    auto model = makeChengD35();
+
+    Belief initialBelief(model.getS());
+    initialBelief.fill(1.0 / model.getS());
+
+    ai::setInstrumentationEnabled(true);
+    const auto [lb, ub, vlist, qfun] = gm(model, initialBelief);
+    ai::setInstrumentationEnabled(false);
+
+    const auto & stats = gm.getStatistics();
+    BOOST_CHECK(stats.iterations > 0);
+    // The upper bound is interpolated with LPs.
+    BOOST_CHECK(stats.lpCalls > 0);
+    BOOST_REQUIRE_EQUAL(stats.residuals.size(), stats.iterations);
+    BOOST_CHECK_CLOSE(stats.residuals.back(), ub - lb, 1e-8);
+    (void)vlist;
+    (void)qfun;
+}
@@ -307,3 +307,28 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizonSparse ) {
         BOOST_CHECK_EQUAL(values, truthValues);
     }
 }
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox;
+
+    auto model = POMDP::makeTigerProblem();
+    model.setDiscount(0.95);
+
+    POMDP::IncrementalPruning solver(5, 0.0);
+
+    setInstrumentationEnabled(true);
+    solver(model);
+    setInstrumentationEnabled(false);
+
+    const auto & stats = solver.getStatistics();
+    BOOST_CHECK_EQUAL(stats.iterations, 5);
+    BOOST_REQUIRE_EQUAL(stats.residuals.size(), 5);
+    BOOST_CHECK(stats.prunedVectors > 0);
+    BOOST_CHECK_EQUAL(stats.lpCalls, 0);
+    BOOST_CHECK(stats.seconds > 0.0);
+
+    const auto & lpStats = solver.getLPStatistics();
+    BOOST_CHECK(lpStats.solves > 0);
+    BOOST_CHECK(lpStats.pivots > 0);
+    BOOST_CHECK(lpStats.seconds > 0.0);
+}
@@ -98,3 +98,24 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizon ) {
             BOOST_CHECK_EQUAL(vlist[i].action, it->action);
     }
 }
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox::POMDP;
+    namespace ai = AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    PBVI solver(100, 5, 0.0);
+
+    ai::setInstrumentationEnabled(true);
+    solver(model);
+    ai::setInstrumentationEnabled(false);
+
+    const auto & stats = solver.getStatistics();
+    BOOST_CHECK_EQUAL(stats.iterations, 5);
+    BOOST_CHECK_EQUAL(stats.residuals.size(), 5);
+    // Most beliefs share their best vector, so most are pruned.
+    BOOST_CHECK(stats.prunedVectors > 0);
+    BOOST_CHECK_EQUAL(stats.lpCalls, 0);
+}
@@ -92,7 +92,7 @@ BOOST_AUTO_TEST_CASE( horizonOneBelief ) {
         unsigned particleCount = 0;
         for ( auto & a : graph.children ) {
             for ( auto & b : a.children ) {
-                particleCount += b.second.belief.size();
+                particleCount += b.second.belief.getTotalWeight();
             }
         }
 
@@ -131,3 +131,54 @@ BOOST_AUTO_TEST_CASE( sampleOneTime ) {
     // We make a,o the new head
     solver.sampleAction( 0, o, horizon-1);
 }
+
+BOOST_AUTO_TEST_CASE( reinvigorateBelief ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.85);
+
+    Belief belief(2); belief.fill(0.5);
+
+    using namespace TigerProblemUtils;
+    constexpr size_t beliefSize = 500;
+
+    // With few iterations the children of the root do not receive
+    // enough particles, so they need to be reinvigorated.
+    POMCP solver(model, beliefSize, 50, 10000.0);
+    solver.sampleAction(belief, 5);
+
+    // We listen a few times and hear the tiger on the left; the belief
+    // should stay of the same size and converge to the tiger being there.
+    for (unsigned i = 0; i < 3; ++i) {
+        solver.sampleAction(A_LISTEN, TIG_LEFT, 5);
+
+        const auto & root = solver.getGraph().belief;
+        BOOST_CHECK_EQUAL(root.getTotalWeight(), beliefSize);
+    }
+    const auto b = solver.getGraph().belief.getBelief(model.getS());
+    BOOST_CHECK(b[TIG_LEFT] > 0.9);
+}
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.85);
+
+    POMCP solver(model, 1000, 1000, 10.0);
+    Belief b(2); b << 0.5, 0.5;
+
+    setInstrumentationEnabled(true);
+    solver.sampleAction(b, 5);
+    setInstrumentationEnabled(false);
+
+    const auto stats = solver.getStatistics();
+    BOOST_CHECK_EQUAL(stats.simulations, 1000);
+    // Each simulation adds at most one node to the tree.
+    BOOST_CHECK(stats.treeNodes > 0);
+    BOOST_CHECK(stats.treeNodes <= 1000);
+    BOOST_CHECK(stats.getSimulationsPerSecond() > 0.0);
+}
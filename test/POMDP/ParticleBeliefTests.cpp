@@ -0,0 +1,139 @@
+#define BOOST_TEST_MODULE POMDP_ParticleBelief
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <cmath>
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/POMDP/Algorithms/Utils/ParticleBelief.hpp>
+
+BOOST_AUTO_TEST_CASE( countedStorage ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    ParticleBelief belief;
+    BOOST_CHECK(belief.empty());
+
+    for (unsigned i = 0; i < 1000; ++i)
+        belief.addParticle(i % 3);
+    belief.addParticle(5, 2.5);
+
+    // Only a single entry per state is stored.
+    BOOST_CHECK_EQUAL(belief.size(), 4);
+    BOOST_CHECK_EQUAL(belief.getTotalWeight(), 1002.5);
+    BOOST_CHECK_EQUAL(belief.getWeight(0), 334.0);
+    BOOST_CHECK_EQUAL(belief.getWeight(5), 2.5);
+    BOOST_CHECK_EQUAL(belief.getWeight(4), 0.0);
+    BOOST_CHECK_EQUAL(belief.getMostLikelyState(), 0);
+
+    const auto b = belief.getBelief(6);
+    BOOST_CHECK_CLOSE(b.sum(), 1.0, 1e-8);
+    BOOST_CHECK_CLOSE(b[5], 2.5 / 1002.5, 1e-8);
+
+    belief.clear();
+    BOOST_CHECK(belief.empty());
+    BOOST_CHECK_EQUAL(belief.getTotalWeight(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( sampling ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    RandomEngine rand(Seeder::getSeed());
+
+    ParticleBelief belief;
+    belief.addParticle(0, 1.0);
+    belief.addParticle(1, 3.0);
+
+    constexpr unsigned samples = 40000;
+    unsigned ones = 0;
+    for (unsigned i = 0; i < samples; ++i)
+        ones += belief.sample(rand) == 1;
+
+    BOOST_CHECK_CLOSE(static_cast<double>(ones) / samples, 0.75, 2.0);
+
+    // Adding a particle must be reflected in the next samples.
+    belief.addParticle(2, 1000000.0);
+    unsigned twos = 0;
+    for (unsigned i = 0; i < 100; ++i)
+        twos += belief.sample(rand) == 2;
+    BOOST_CHECK(twos > 95);
+}
+
+BOOST_AUTO_TEST_CASE( systematicResampling ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    RandomEngine rand(Seeder::getSeed());
+
+    ParticleBelief belief;
+    belief.addParticle(0, 0.5);
+    belief.addParticle(1, 0.25);
+    belief.addParticle(2, 0.2);
+    belief.addParticle(3, 0.05);
+
+    BOOST_CHECK_CLOSE(belief.getEffectiveSampleSize(), 1.0 / (0.25 + 0.0625 + 0.04 + 0.0025), 1e-8);
+
+    belief.resample(100, rand);
+
+    // Systematic resampling places each state within one particle of
+    // its expected count.
+    BOOST_CHECK_EQUAL(belief.getTotalWeight(), 100.0);
+    double sum = 0.0;
+    for (const auto & [s, w] : belief.getParticles()) {
+        BOOST_CHECK_EQUAL(w, std::floor(w));
+        sum += w;
+    }
+    BOOST_CHECK_EQUAL(sum, 100.0);
+    BOOST_CHECK_CLOSE(belief.getEffectiveSampleSize(), 100.0, 1e-8);
+    BOOST_CHECK(std::fabs(belief.getWeight(0) - 50.0) <= 1.0);
+    BOOST_CHECK(std::fabs(belief.getWeight(1) - 25.0) <= 1.0);
+    BOOST_CHECK(std::fabs(belief.getWeight(2) - 20.0) <= 1.0);
+    BOOST_CHECK(std::fabs(belief.getWeight(3) -  5.0) <= 1.0);
+
+    // Resampling to less particles than states must drop some.
+    belief.resample(2, rand);
+    BOOST_CHECK_EQUAL(belief.getTotalWeight(), 2.0);
+    BOOST_CHECK(belief.size() <= 2);
+
+    ParticleBelief empty;
+    empty.resample(10, rand);
+    BOOST_CHECK(empty.empty());
+
+    BOOST_CHECK_THROW(belief.resample(0, rand), std::invalid_argument);
+    BOOST_CHECK_THROW(empty.resample(0, rand), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( fromBelief ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    RandomEngine rand(Seeder::getSeed());
+
+    Belief b(3); b << 0.0, 0.3, 0.7;
+    ParticleBelief belief(b, 1000, rand);
+
+    BOOST_CHECK_EQUAL(belief.getTotalWeight(), 1000.0);
+    BOOST_CHECK_EQUAL(belief.getWeight(0), 0.0);
+    BOOST_CHECK(belief.size() <= 2);
+}
+
+BOOST_AUTO_TEST_CASE( effectiveSampleSize ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    // Unweighted particles in the same state still count separately.
+    ParticleBelief belief;
+    for (unsigned i = 0; i < 10; ++i)
+        belief.addParticle(i % 2);
+    BOOST_CHECK_CLOSE(belief.getEffectiveSampleSize(), 10.0, 1e-8);
+
+    // A single heavy particle dominates the others.
+    belief.addParticle(1, 10.0);
+    BOOST_CHECK_CLOSE(belief.getEffectiveSampleSize(), 400.0 / 110.0, 1e-8);
+
+    belief.clear();
+    BOOST_CHECK_EQUAL(belief.getEffectiveSampleSize(), 0.0);
+}
@@ -26,3 +26,27 @@ BOOST_AUTO_TEST_CASE( discountedHorizon ) {
     (void)vlist;
     (void)qfun;
 }
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    using namespace AIToolbox::POMDP;
+    namespace ai = AIToolbox;
+
+    SARSOP sarsop(34);
+    const auto model = makeChengD35();
+
+    Belief initialBelief(model.getS());
+    initialBelief.fill(1.0 / model.getS());
+
+    ai::setInstrumentationEnabled(true);
+    const auto [lb, ub, vlist, qfun] = sarsop(model, initialBelief);
+    ai::setInstrumentationEnabled(false);
+
+    const auto & stats = sarsop.getStatistics();
+    BOOST_CHECK(stats.iterations > 0);
+    BOOST_CHECK(stats.treeNodes > 1);
+    BOOST_REQUIRE(stats.residuals.size() > 0);
+    // The residuals are the gaps at the initial belief.
+    BOOST_CHECK_CLOSE(stats.residuals.back(), ub - lb, 1e-8);
+    (void)vlist;
+    (void)qfun;
+}
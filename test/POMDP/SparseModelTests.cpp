@@ -191,3 +191,34 @@ BOOST_AUTO_TEST_CASE( setObservationFunctionSparse ) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE( cassandraSparse ) {
+    for ( const std::string inputFilename : {"./data/cheng.D3-5.POMDP", "./data/ejs4.POMDP"} ) {
+        std::ifstream inputFile(inputFilename);
+        if ( !inputFile ) BOOST_FAIL("Data to perform test could not be loaded: " + inputFilename);
+
+        const auto m = AIToolbox::POMDP::parseCassandra(inputFile);
+        const size_t S = m.getS(), A = m.getA(), O = m.getO();
+
+        for ( const unsigned threads : {1u, 4u} ) {
+            const auto m2 = AIToolbox::POMDP::parseCassandraSparse(inputFilename, threads);
+
+            BOOST_CHECK_EQUAL(m.getS(), m2.getS());
+            BOOST_CHECK_EQUAL(m.getA(), m2.getA());
+            BOOST_CHECK_EQUAL(m.getO(), m2.getO());
+            BOOST_CHECK_EQUAL(m.getDiscount(), m2.getDiscount());
+
+            for ( size_t s = 0; s < S; ++s ) {
+                for ( size_t a = 0; a < A; ++a ) {
+                    for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                        BOOST_CHECK(AIToolbox::checkEqualSmall(m.getTransitionProbability(s, a, s1), m2.getTransitionProbability(s, a, s1)));
+                        BOOST_CHECK(AIToolbox::checkEqualGeneral(m.getExpectedReward(s, a, s1), m2.getExpectedReward(s, a, s1)));
+                    }
+                    for ( size_t o = 0; o < O; ++o ) {
+                        BOOST_CHECK(AIToolbox::checkEqualSmall(m.getObservationProbability(s, a, o), m2.getObservationProbability(s, a, o)));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #include "GlobalFixtures.hpp"
 
 #include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/POMDP/Algorithms/Utils/Projecter.hpp>
 #include "Utils/OldPOMDPModel.hpp"
 #include <AIToolbox/MDP/Model.hpp>
 #include <AIToolbox/POMDP/Model.hpp>
@@ -112,3 +113,38 @@ BOOST_AUTO_TEST_CASE( beliefUpdatePartial ) {
         BOOST_CHECK(checkEqualProbability(resultEigen2, partialEigen2));
     }
 }
+
+BOOST_AUTO_TEST_CASE( floatProjections ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    const auto problem = makeTigerProblem();
+    const Model<MDP::ModelT<float>> fproblem(problem);
+
+    VList w;
+    VListT<float> fw;
+    for (const auto & values : {Vector{{1.0, -2.0}}, Vector{{0.5, 3.0}}}) {
+        w.emplace_back(values, 0, VObs{});
+        fw.emplace_back(values.cast<float>(), 0, VObs{});
+    }
+
+    Projecter project(problem);
+    Projecter<Model<MDP::Model>, float> fproject(problem);
+    Projecter<Model<MDP::ModelT<float>>, float> ffproject(fproblem);
+
+    const auto p = project(w);
+    const auto fp = fproject(fw);
+    const auto ffp = ffproject(fw);
+
+    for (size_t a = 0; a < problem.getA(); ++a) {
+        for (size_t o = 0; o < problem.getO(); ++o) {
+            BOOST_CHECK_EQUAL(fp[a][o].size(), p[a][o].size());
+            BOOST_CHECK_EQUAL(ffp[a][o].size(), p[a][o].size());
+            for (size_t i = 0; i < p[a][o].size(); ++i) {
+                BOOST_CHECK(fp[a][o][i].values.cast<double>().isApprox(p[a][o][i].values, 1e-5));
+                BOOST_CHECK(ffp[a][o][i].values.cast<double>().isApprox(p[a][o][i].values, 1e-5));
+                BOOST_CHECK_EQUAL(ffp[a][o][i].observations[0], p[a][o][i].observations[0]);
+            }
+        }
+    }
+}
@@ -146,3 +146,25 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizon ) {
         BOOST_CHECK_EQUAL(values, truthValues);
     }
 }
+
+BOOST_AUTO_TEST_CASE( lpStatistics ) {
+    using namespace AIToolbox;
+
+    auto model = POMDP::makeTigerProblem();
+    model.setDiscount(0.95);
+
+    POMDP::Witness solver(5, 0.0);
+
+    const auto solves = LP::getThreadSolves();
+    solver(model);
+
+    const auto lpStats = solver.getLPStatistics();
+    BOOST_CHECK_EQUAL(lpStats.solves, LP::getThreadSolves() - solves);
+    BOOST_CHECK(lpStats.solves > 0);
+    BOOST_CHECK(lpStats.pivots > 0);
+
+    // Statistics only refer to the last call.
+    solver.setHorizon(1);
+    solver(model);
+    BOOST_CHECK(solver.getLPStatistics().solves < lpStats.solves);
+}
@@ -0,0 +1,450 @@
+#define BOOST_TEST_MODULE Performance_Regression
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+// This module runs fixed-seed workloads on the test datasets and on some of
+// the built-in environments. For each workload it measures wall time,
+// iterations, heap allocations and peak resident memory, and compares them
+// against a JSON baseline; a test fails when any of them grows more than the
+// threshold allows.
+//
+// Options are passed after a double dash:
+//
+//     Performance_RegressionTests -- --baseline=<file> --threshold=<fraction>
+//                                    --repetitions=<n> --output=<file> --update
+//
+// If the baseline does not exist, or --update is passed, the current
+// measurements are written as the new baseline. Timings depend on the
+// machine and build type, so the baseline should be recorded on the machine
+// where the checks are run.
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/Instrumentation.hpp>
+
+#include <AIToolbox/MDP/IO.hpp>
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/MDP/Algorithms/MCTS.hpp>
+
+#include <AIToolbox/POMDP/IO.hpp>
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
+#include <AIToolbox/POMDP/Algorithms/PBVI.hpp>
+#include <AIToolbox/POMDP/Algorithms/SARSOP.hpp>
+#include <AIToolbox/POMDP/Algorithms/POMCP.hpp>
+
+#include <AIToolbox/Factored/Utils/Core.hpp>
+#include <AIToolbox/Factored/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/Factored/MDP/Algorithms/JointActionLearner.hpp>
+#include <AIToolbox/Factored/MDP/Environments/SysAdmin.hpp>
+#include <AIToolbox/Factored/MDP/Environments/TigerAntelope.hpp>
+#include <AIToolbox/Factored/Bandit/Environments/MiningProblem.hpp>
+#include <AIToolbox/Factored/Bandit/Policies/MAUCEPolicy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace ai = AIToolbox;
+namespace mdp = AIToolbox::MDP;
+namespace pomdp = AIToolbox::POMDP;
+namespace fm = AIToolbox::Factored::MDP;
+namespace fb = AIToolbox::Factored::Bandit;
+
+// ##############################
+// ####  ALLOCATION COUNTING  ###
+// ##############################
+
+namespace {
+    std::atomic<size_t> allocations = 0;
+}
+
+#ifdef __GLIBC__
+// Eigen allocates with malloc rather than operator new, so on glibc we
+// count at the malloc level, forwarding to the original implementations.
+extern "C" {
+    void * __libc_malloc(size_t size);
+    void * __libc_calloc(size_t n, size_t size);
+    void * __libc_realloc(void * p, size_t size);
+
+    void * malloc(size_t size) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void * calloc(size_t n, size_t size) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(n, size);
+    }
+
+    void * realloc(void * p, size_t size) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(p, size);
+    }
+}
+#else
+void * operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void * p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+#endif
+
+// ##############################
+// ####  MEASUREMENTS         ###
+// ##############################
+
+namespace {
+    struct Measurement {
+        double seconds = 0.0;
+        size_t iterations = 0;
+        size_t allocations = 0;
+        size_t peakRSS = 0; // In KB.
+    };
+
+    // Resets the peak resident memory of the process, where the OS allows it.
+    void resetPeakRSS() {
+#ifdef __linux__
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+
+    // Returns the peak resident memory in KB since the last reset. Where
+    // this cannot be reset, this is the peak of the whole process.
+    size_t getPeakRSS() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line); )
+            if (line.starts_with("VmHWM:"))
+                return std::stoul(line.substr(6));
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+    #ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+    #else
+        return usage.ru_maxrss;
+    #endif
+#else
+        return 0;
+#endif
+    }
+
+    struct Config {
+        std::string baseline = "performance_baseline.json";
+        std::string output = "performance_results.json";
+        double threshold = 1.0;
+        unsigned repetitions = 3;
+        bool update = false;
+    };
+
+    using Results = std::map<std::string, Measurement>;
+
+    Results readResults(const std::string & filename) {
+        namespace pt = boost::property_tree;
+
+        pt::ptree tree;
+        pt::read_json(filename, tree);
+
+        // We iterate rather than use paths, as these treat dots as separators.
+        Results retval;
+        for (const auto & [name, node] : tree.get_child("workloads")) {
+            auto & m = retval[name];
+            m.seconds     = node.get<double>("seconds");
+            m.iterations  = node.get<size_t>("iterations");
+            m.allocations = node.get<size_t>("allocations");
+            m.peakRSS     = node.get<size_t>("peak_rss_kb");
+        }
+        return retval;
+    }
+
+    void writeResults(const std::string & filename, const Results & results) {
+        std::ofstream file(filename);
+        file << "{\n    \"workloads\": {";
+        bool first = true;
+        for (const auto & [name, m] : results) {
+            file << (first ? "\n" : ",\n") << "        \"" << name << "\": {"
+                 << "\"seconds\": " << std::setprecision(6) << m.seconds
+                 << ", \"iterations\": " << m.iterations
+                 << ", \"allocations\": " << m.allocations
+                 << ", \"peak_rss_kb\": " << m.peakRSS << '}';
+            first = false;
+        }
+        file << "\n    }\n}\n";
+    }
+
+    struct Harness {
+        Harness() {
+            current = this;
+
+            const auto & suite = boost::unit_test::framework::master_test_suite();
+            for (int i = 1; i < suite.argc; ++i) {
+                const std::string arg = suite.argv[i];
+                const auto value = arg.substr(arg.find('=') + 1);
+
+                if      (arg.starts_with("--baseline="))    config.baseline = value;
+                else if (arg.starts_with("--output="))      config.output = value;
+                else if (arg.starts_with("--threshold="))   config.threshold = std::stod(value);
+                else if (arg.starts_with("--repetitions=")) config.repetitions = std::max(1ul, std::stoul(value));
+                else if (arg == "--update")                 config.update = true;
+                else BOOST_TEST_MESSAGE("Ignoring unknown option: " << arg);
+            }
+
+            if (!config.update && std::filesystem::exists(config.baseline)) {
+                baseline = readResults(config.baseline);
+                hasBaseline = true;
+            }
+
+            // Solvers only report their iterations when instrumented.
+            ai::setInstrumentationEnabled(true);
+        }
+
+        ~Harness() {
+            writeResults(config.output, results);
+            if (!hasBaseline) {
+                writeResults(config.baseline, results);
+                BOOST_TEST_MESSAGE("Recorded new performance baseline in " << config.baseline);
+            }
+            current = nullptr;
+        }
+
+        static Harness * current;
+
+        Config config;
+        Results baseline, results;
+        bool hasBaseline = false;
+    };
+
+    Harness * Harness::current = nullptr;
+
+    // Runs the workload multiple times, keeping the best measurements, and
+    // compares them against the baseline. The workload must return the
+    // number of iterations it performed.
+    template <typename F>
+    void check(const std::string & name, F && workload) {
+        using Clock = std::chrono::steady_clock;
+        auto & harness = *Harness::current;
+
+        Measurement best;
+        for (unsigned r = 0; r < harness.config.repetitions; ++r) {
+            ai::Seeder::setRootSeed(12345);
+            resetPeakRSS();
+
+            const auto allocationsStart = allocations.load();
+            const auto start = Clock::now();
+            const size_t iterations = workload();
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            const auto allocationsEnd = allocations.load();
+
+            Measurement m{elapsed.count(), iterations, allocationsEnd - allocationsStart, getPeakRSS()};
+            if (r == 0) {
+                best = m;
+            } else {
+                best.seconds     = std::min(best.seconds, m.seconds);
+                best.allocations = std::min(best.allocations, m.allocations);
+                best.peakRSS     = std::min(best.peakRSS, m.peakRSS);
+            }
+        }
+        harness.results[name] = best;
+
+        // A workload that does no work would not measure anything.
+        BOOST_CHECK_MESSAGE(best.iterations > 0, name << ": no iterations were performed");
+
+        BOOST_TEST_MESSAGE(name << ": " << best.seconds << " s, " << best.iterations << " iterations, "
+                                << best.allocations << " allocations, " << best.peakRSS << " KB peak RSS");
+
+        if (!harness.hasBaseline) return;
+        const auto it = harness.baseline.find(name);
+        if (it == harness.baseline.end()) {
+            BOOST_TEST_MESSAGE(name << ": not in the baseline, skipping comparison");
+            return;
+        }
+        const auto & base = it->second;
+
+        // The slack absorbs the noise of very small measurements.
+        const auto compare = [&](const char * metric, const double value, const double baseValue, const double slack) {
+            const double limit = baseValue * (1.0 + harness.config.threshold) + slack;
+            BOOST_CHECK_MESSAGE(value <= limit, name << ": " << metric << " regressed from " << baseValue << " to " << value
+                                                     << " (limit " << limit << ")");
+        };
+        compare("seconds",     best.seconds,     base.seconds,     0.005);
+        compare("iterations",  best.iterations,  base.iterations,  0.0);
+        compare("allocations", best.allocations, base.allocations, 0.0);
+        compare("peak RSS",    best.peakRSS,     base.peakRSS,     1024.0);
+    }
+}
+
+BOOST_TEST_GLOBAL_FIXTURE(Harness);
+
+// ##############################
+// ####  WORKLOADS            ###
+// ##############################
+
+BOOST_AUTO_TEST_CASE( corner_value_iteration ) {
+    check("corner/ValueIteration", [] {
+        std::ifstream file("./data/corner.MDP");
+        const auto model = mdp::parseCassandra(file);
+
+        // Zero tolerance forces the solver to run for the full horizon.
+        mdp::ValueIteration solver(200000, 0.0);
+        solver(model);
+        return solver.getStatistics().iterations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( corner_mcts ) {
+    check("corner/MCTS", [] {
+        std::ifstream file("./data/corner.MDP");
+        const auto model = mdp::parseCassandra(file);
+
+        mdp::MCTS solver(model, 200000, 5.0);
+        solver.sampleAction(1, 20);
+        return solver.getStatistics().simulations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( ejs4_incremental_pruning ) {
+    check("ejs4/IncrementalPruning", [] {
+        std::ifstream file("./data/ejs4.POMDP");
+        auto model = pomdp::parseCassandra(file);
+        model.setDiscount(0.95);
+
+        pomdp::IncrementalPruning solver(1000, 0.0);
+        solver(model);
+        return solver.getStatistics().iterations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( ejs4_pbvi ) {
+    check("ejs4/PBVI", [] {
+        std::ifstream file("./data/ejs4.POMDP");
+        auto model = pomdp::parseCassandra(file);
+        model.setDiscount(0.95);
+
+        pomdp::PBVI solver(1000, 100, 0.0);
+        solver(model);
+        return solver.getStatistics().iterations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( cheng_sarsop ) {
+    check("cheng/SARSOP", [] {
+        std::ifstream file("./data/cheng.D3-5.POMDP");
+        auto model = pomdp::parseCassandra(file);
+        model.setDiscount(0.95);
+
+        pomdp::Belief belief(model.getS());
+        belief.fill(1.0 / model.getS());
+
+        pomdp::SARSOP solver(0.3);
+        solver(model, belief);
+        return solver.getStatistics().iterations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( cheng_pomcp ) {
+    check("cheng/POMCP", [] {
+        std::ifstream file("./data/cheng.D3-5.POMDP");
+        auto model = pomdp::parseCassandra(file);
+        model.setDiscount(0.95);
+
+        pomdp::Belief belief(model.getS());
+        belief.fill(1.0 / model.getS());
+
+        pomdp::POMCP solver(model, 1000, 20000, 10.0);
+        solver.sampleAction(belief, 10);
+        return solver.getStatistics().simulations;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( sysadmin_value_iteration ) {
+    check("SysAdmin/ValueIteration", [] {
+        namespace af = AIToolbox::Factored;
+
+        const auto model = fm::makeSysAdminUniRing(2, 0.1, 0.2, 0.3, 0.4, 0.4, 0.4, 0.3);
+        const auto & S = model.getS();
+
+        // We use a basis function per state, and all states as samples.
+        std::vector<af::State> states;
+        for (af::PartialFactorsEnumerator e(S); e.isValid(); e.advance())
+            states.push_back(e->second);
+
+        const auto size = af::factorSpace(S);
+        af::PartialKeys tag(S.size());
+        for (size_t i = 0; i < tag.size(); ++i) tag[i] = i;
+
+        af::FactoredVector h;
+        for (size_t s = 0; s < size; ++s) {
+            h.bases.emplace_back(af::BasisFunction{tag, ai::Vector::Zero(size)});
+            h.bases.back().values[s] = 1.0;
+        }
+
+        fm::ValueIteration solver(1000, 1e-6);
+        solver(model, h, states);
+        return solver.getIterationStats().size();
+    });
+}
+
+BOOST_AUTO_TEST_CASE( mining_problem_mauce ) {
+    check("MiningProblem/MAUCE", [] {
+        const auto [A, workers, productivities] = fb::makeMiningParameters(1);
+        const fb::MiningBandit bandit(A, workers, productivities);
+
+        fb::Experience exp(A, bandit.getGroups());
+        const fb::MAUCEPolicy policy(exp, std::vector<double>(bandit.getGroups().size(), 1.0));
+
+        constexpr size_t timesteps = 100;
+        for (size_t t = 0; t < timesteps; ++t) {
+            const auto a = policy.sampleAction();
+            exp.record(a, bandit.sampleR(a));
+        }
+        return timesteps;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( tiger_antelope_joint_action_learner ) {
+    check("TigerAntelope/JointActionLearner", [] {
+        const fm::TigerAntelope env(5, 5);
+        const auto & S = env.getS();
+        const auto & A = env.getA();
+        const auto toIndex = [&S](const AIToolbox::Factored::State & s) { return s[0] * S[1] + s[1]; };
+
+        fm::JointActionLearner learner(S[0] * S[1], A, 0, env.getDiscount(), 0.1);
+
+        ai::RandomEngine rnd(ai::Seeder::getSeed());
+        std::uniform_int_distribution<size_t> actionDist(0, A[0] - 1);
+
+        constexpr size_t steps = 200000;
+        AIToolbox::Factored::State s{0, S[1] - 1};
+        AIToolbox::Factored::Action a(2);
+        for (size_t t = 0; t < steps; ++t) {
+            a[0] = actionDist(rnd);
+            a[1] = actionDist(rnd);
+
+            const auto [s1, rews] = env.sampleSRs(s, a);
+            learner.stepUpdateQ(toIndex(s), a, toIndex(s1), rews[0]);
+
+            s = env.isTerminalState(s1) ? AIToolbox::Factored::State{0, S[1] - 1} : s1;
+        }
+        return steps;
+    });
+}
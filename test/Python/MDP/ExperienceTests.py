@@ -3,6 +3,8 @@ import sys
 import os
 from builtins import range
 
+import pickle
+
 sys.path.append(os.getcwd())
 from AIToolbox import MDP
 
@@ -85,5 +87,43 @@ class MDPPythonExperienceTests(unittest.TestCase):
                 self.assertEqual( exp.getVisitsSum(s,a), visitsSum );
                 self.assertEqual( exp.getReward(s,a), rewards[s][a] );
 
+    def testViews(self):
+        S, A = 4, 3
+        exp = MDP.Experience(S, A)
+        exp.record(1, 2, 3, 4.0)
+        exp.record(1, 2, 3, 2.0)
+
+        visits = memoryview(exp.getVisitsTable(2))
+        self.assertEqual(visits.shape, (S, S))
+        self.assertEqual(visits[1, 3], 2)
+
+        rewards = memoryview(exp.getRewardMatrix())
+        self.assertEqual(rewards.shape, (S, A))
+        self.assertEqual(rewards[1, 2], 3.0)
+
+        # Views are not copies, so they see new data.
+        exp.record(1, 2, 0, 0.0)
+        self.assertEqual(visits[1, 0], 1)
+        self.assertEqual(memoryview(exp.getVisitsSumTable())[1, 2], 3)
+
+    def testPickle(self):
+        S, A = 4, 3
+        exp = MDP.Experience(S, A)
+        for i in range(20):
+            exp.record(i % S, i % A, (i * 7) % S, i * 0.5)
+
+        newExp = pickle.loads(pickle.dumps(exp))
+
+        self.assertEqual(newExp.getTimesteps(), exp.getTimesteps())
+        for s in range(S):
+            for a in range(A):
+                self.assertEqual(newExp.getVisitsSum(s,a), exp.getVisitsSum(s,a))
+                self.assertEqual(newExp.getReward(s,a), exp.getReward(s,a))
+                self.assertEqual(newExp.getM2(s,a), exp.getM2(s,a))
+                for s1 in range(S):
+                    self.assertEqual(newExp.getVisits(s,a,s1), exp.getVisits(s,a,s1))
+
+        self.assertRaises(ValueError, MDP.Experience(S + 1, A).__setstate__, exp.__getstate__())
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -1,6 +1,7 @@
 import unittest
 import sys
 import os
+import threading
 
 sys.path.append(os.getcwd())
 from AIToolbox import MDP
@@ -131,6 +132,91 @@ class MDPPythonMCTSTests(unittest.TestCase):
         self.assertEqual(mcts.sampleAction(13, 10), RIGHT)
         self.assertEqual(mcts.sampleAction(14, 10), RIGHT)
 
+    def testEscapeToCornersGenBatched(self):
+        # If the wrapped class also provides a batched sampling method, the
+        # wrapper can ask for many samples per call, which is much faster
+        # than calling into Python once per sample:
+        #
+        # class MyModel:
+        #     ...
+        #     def sampleSRBatch(self, states, actions): pass # Returns a (newStates, rewards) tuple of sequences
+        class BatchedModel:
+            def __init__(self, m): self.m = m
+            def getS(self): return self.m.getS()
+            def getA(self): return self.m.getA()
+            def getDiscount(self): return self.m.getDiscount()
+            def isTerminal(self, s): return self.m.isTerminal(s)
+            def sampleSR(self, s, a): return self.m.sampleSR(s, a)
+            def sampleSRBatch(self, states, actions):
+                self.calls += 1
+                samples = [self.m.sampleSR(s, a) for s, a in zip(states, actions)]
+                return [s1 for s1, _ in samples], [r for _, r in samples]
+
+        bm = BatchedModel(model)
+        bm.calls = 0
+
+        self.assertRaises(Exception, MDP.GenerativeModelPython, model, 64)
+
+        mm = MDP.GenerativeModelPython(bm, 64)
+        self.assertEqual(mm.getBatchSize(), 64)
+        self.assertEqual(mm.getS(), 16)
+        self.assertEqual(mm.getA(), 4)
+
+        mcts = MDP.MCTSGenerativeModelPython(mm, 10000, 5)
+
+        self.assertEqual(mcts.sampleAction(1, 10), LEFT)
+        self.assertEqual(mcts.sampleAction(4, 10), UP)
+        self.assertEqual(mcts.sampleAction(11, 10), DOWN)
+        self.assertEqual(mcts.sampleAction(14, 10), RIGHT)
+
+        # Each call gives 64 samples, so we need far fewer than one call per sample.
+        self.assertGreater(bm.calls, 0)
+        self.assertLess(bm.calls, 4 * 10000 * 10 / 64)
+
+        # The pool of unused samples is bounded, and can be dropped.
+        self.assertRaises(Exception, MDP.GenerativeModelPython, bm, 64, 32)
+
+        small = MDP.GenerativeModelPython(bm, 64, 128)
+        for s in range(16):
+            for a in range(4):
+                small.sampleSR(s, a)
+                self.assertLessEqual(small.getPooledSamples(), 128)
+        self.assertGreater(small.getPooledSamples(), 0)
+
+        small.clearCache()
+        self.assertEqual(small.getPooledSamples(), 0)
+
+    def testSharedGenBatchedConcurrent(self):
+        # Solvers release the GIL while planning, so two of them sharing a
+        # single wrapped model must be able to run on separate threads.
+        class BatchedModel:
+            def __init__(self, m): self.m = m
+            def getS(self): return self.m.getS()
+            def getA(self): return self.m.getA()
+            def getDiscount(self): return self.m.getDiscount()
+            def isTerminal(self, s): return self.m.isTerminal(s)
+            def sampleSR(self, s, a): return self.m.sampleSR(s, a)
+            def sampleSRBatch(self, states, actions):
+                samples = [self.m.sampleSR(s, a) for s, a in zip(states, actions)]
+                return [s1 for s1, _ in samples], [r for _, r in samples]
+
+        # A small pool, so that it is often dropped while both threads use it.
+        mm = MDP.GenerativeModelPython(BatchedModel(model), 16, 64)
+
+        results = {}
+        def plan(i, s):
+            mcts = MDP.MCTSGenerativeModelPython(mm, 5000, 5)
+            results[i] = mcts.sampleAction(s, 10)
+
+        threads = [threading.Thread(target=plan, args=(0, 1)),
+                   threading.Thread(target=plan, args=(1, 14))]
+        for t in threads: t.start()
+        for t in threads: t.join()
+
+        self.assertEqual(results[0], LEFT)
+        self.assertEqual(results[1], RIGHT)
+        self.assertLessEqual(mm.getPooledSamples(), 64)
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
 
@@ -151,6 +151,34 @@ class MDPPythonModelTests(unittest.TestCase):
                         newModel.getExpectedReward(s,a,s1)
                     )
 
+    def testPickleText(self):
+        # Pickles created before the binary format stored the model as text.
+        S, A = 3, 2
+        model = MDP.Model(S, A)
+        model.setTransitionFunction([[[0, 0.5, 0.5], [1, 0, 0]]] * S)
+
+        newModel = MDP.Model(S, A)
+        newModel.__setstate__((MDP.IO().writeModel(model),))
+        for s in range(S):
+            for a in range(A):
+                for s1 in range(S):
+                    self.assertEqual(model.getTransitionProbability(s,a,s1), newModel.getTransitionProbability(s,a,s1))
+
+    def testViews(self):
+        S, A = 3, 2
+        model = MDP.Model(S, A)
+        model.setTransitionFunction([[[0, 0.5, 0.5], [1, 0, 0]]] * S)
+
+        t = memoryview(model.getTransitionFunction(0))
+        self.assertEqual(t.format, 'd')
+        self.assertEqual(t.shape, (S, S))
+        for s in range(S):
+            for s1 in range(S):
+                self.assertEqual(t[s, s1], model.getTransitionProbability(s, 0, s1))
+
+        r = memoryview(model.getRewardFunction())
+        self.assertEqual(r.shape, (S, A))
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
 
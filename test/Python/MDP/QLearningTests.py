@@ -31,5 +31,19 @@ class MDPPythonQLearningTests(unittest.TestCase):
         self.assertEqual( solver.getQFunction()[1, 0], 0.0  )
         self.assertEqual( solver.getQFunction()[1, 1], 0.0  )
 
+    def testQFunctionView(self):
+        solver = MDP.QLearning(5, 3, 0.9, 0.5)
+
+        q = memoryview(solver.getQFunction())
+        self.assertEqual( q.shape, (5, 3) )
+        self.assertEqual( q.format, 'd' )
+
+        # The view shares memory with the solver in both directions.
+        solver.stepUpdateQ(0, 1, 1, 10)
+        self.assertEqual( q[0, 1], 5.0 )
+
+        q[2, 2] = 1.5
+        self.assertEqual( solver.getQFunction()[2, 2], 1.5 )
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
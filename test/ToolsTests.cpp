@@ -5,8 +5,13 @@
 #include "GlobalFixtures.hpp"
 
 #include <AIToolbox/Tools/Statistics.hpp>
+#include <AIToolbox/Tools/Experiments.hpp>
 #include <AIToolbox/Utils/Core.hpp>
 
+#include <random>
+#include <stdexcept>
+#include <string>
+
 BOOST_AUTO_TEST_CASE( mean_variance ) {
     std::vector<std::vector<double>> data {
         {19, 11, 8, 7, 7, 20, 0, 5, 4, 13},
@@ -44,3 +49,71 @@ BOOST_AUTO_TEST_CASE( mean_variance ) {
         BOOST_CHECK(AIToolbox::checkEqualGeneral(cumstd,  truth[3][i]));
     }
 }
+
+BOOST_AUTO_TEST_CASE( merge ) {
+    AIToolbox::Statistics all(3), first(3), second(3);
+
+    for (unsigned run = 0; run < 10; ++run) {
+        auto & half = run < 5 ? first : second;
+        for (size_t t = 0; t < 3; ++t) {
+            const double v = run * 3.0 + t * t;
+            all.record(v, t);
+            half.record(v, t);
+        }
+    }
+    first.merge(second);
+
+    const auto truth = all.process();
+    const auto merged = first.process();
+    for (size_t t = 0; t < 3; ++t) {
+        BOOST_CHECK(AIToolbox::checkEqualGeneral(std::get<0>(merged[t]), std::get<0>(truth[t])));
+        BOOST_CHECK(AIToolbox::checkEqualGeneral(std::get<1>(merged[t]), std::get<1>(truth[t])));
+        BOOST_CHECK(AIToolbox::checkEqualGeneral(std::get<2>(merged[t]), std::get<2>(truth[t])));
+        BOOST_CHECK(AIToolbox::checkEqualGeneral(std::get<3>(merged[t]), std::get<3>(truth[t])));
+    }
+
+    AIToolbox::Statistics other(4);
+    BOOST_CHECK_THROW(first.merge(other), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( run_episodes ) {
+    constexpr size_t episodes = 100, timesteps = 5;
+
+    auto episode = [](size_t, AIToolbox::RandomEngine & rnd, AIToolbox::Statistics & stats) {
+        std::normal_distribution<double> dist(1.0, 2.0);
+        for (size_t t = 0; t < timesteps; ++t)
+            stats.record(dist(rnd), t);
+    };
+
+    // The result must be exactly the same, independently of the threads.
+    const auto reference = AIToolbox::runEpisodes(episodes, timesteps, episode, 1).process();
+    for (const unsigned threads : {2u, 3u, 8u, 0u})
+        BOOST_CHECK(AIToolbox::runEpisodes(episodes, timesteps, episode, threads).process() == reference);
+
+    // Different streams give different results.
+    BOOST_CHECK(AIToolbox::runEpisodes(episodes, timesteps, episode, 2, episodes).process() != reference);
+
+    const auto mean = std::get<0>(reference[0]);
+    BOOST_CHECK(mean > 0.4 && mean < 1.6);
+
+    // Errors in the episodes are reported to the caller.
+    auto failing = [](size_t i, AIToolbox::RandomEngine &, AIToolbox::Statistics &) {
+        if (i == 42) throw std::runtime_error("episode failed");
+    };
+    BOOST_CHECK_THROW(AIToolbox::runEpisodes(episodes, timesteps, failing, 4), std::runtime_error);
+
+    // With multiple failures, the lowest failing episode is reported.
+    auto failingMany = [](size_t i, AIToolbox::RandomEngine &, AIToolbox::Statistics &) {
+        if (i == 37 || i == 90) throw std::runtime_error(std::to_string(i));
+    };
+    for (const unsigned threads : {1u, 2u, 8u}) {
+        for (unsigned rep = 0; rep < 10; ++rep) {
+            try {
+                AIToolbox::runEpisodes(episodes, timesteps, failingMany, threads);
+                BOOST_FAIL("runEpisodes did not throw");
+            } catch (const std::runtime_error & e) {
+                BOOST_CHECK_EQUAL(std::string(e.what()), "37");
+            }
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#define BOOST_TEST_MODULE UtilsFlatMap
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/FlatMap.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( basic_operations ) {
+    using namespace AIToolbox;
+
+    FlatMap<size_t, std::string> map;
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.find(3) == map.end());
+    BOOST_CHECK(map.begin() == map.end());
+
+    map[3] = "three";
+    const auto [it, inserted] = map.try_emplace(5, "five");
+    BOOST_CHECK(inserted);
+    BOOST_CHECK_EQUAL(it->first, 5);
+    BOOST_CHECK_EQUAL(it->second, "five");
+
+    const auto [it2, inserted2] = map.try_emplace(5, "cinque");
+    BOOST_CHECK(!inserted2);
+    BOOST_CHECK_EQUAL(it2->second, "five");
+
+    const auto [it3, inserted3] = map.insert(std::make_pair(7, std::string("seven")));
+    BOOST_CHECK(inserted3);
+    BOOST_CHECK_EQUAL(it3->second, "seven");
+
+    BOOST_CHECK_EQUAL(map.size(), 3);
+    BOOST_CHECK_EQUAL(map.count(3), 1);
+    BOOST_CHECK_EQUAL(map.count(4), 0);
+    BOOST_CHECK_EQUAL(map.find(3)->second, "three");
+
+    BOOST_CHECK_EQUAL(map.erase(3), 1);
+    BOOST_CHECK_EQUAL(map.erase(3), 0);
+    BOOST_CHECK_EQUAL(map.size(), 2);
+    BOOST_CHECK(map.find(3) == map.end());
+
+    size_t sum = 0;
+    for (const auto & [k, v] : map)
+        sum += k;
+    BOOST_CHECK_EQUAL(sum, 12);
+
+    map.clear();
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE( matches_unordered_map ) {
+    using namespace AIToolbox;
+
+    RandomEngine rand(Seeder::getSeed());
+    // Small key range so we get plenty of collisions and erasures.
+    std::uniform_int_distribution<size_t> keyDist(0, 3000);
+    std::uniform_int_distribution<int> opDist(0, 9);
+
+    FlatMap<size_t, unsigned> map;
+    std::unordered_map<size_t, unsigned> truth;
+
+    for (unsigned i = 0; i < 50000; ++i) {
+        const auto key = keyDist(rand);
+        const auto op = opDist(rand);
+        if (op < 6) {
+            map[key] += i;
+            truth[key] += i;
+        } else if (op < 9) {
+            BOOST_CHECK_EQUAL(map.erase(key), truth.erase(key));
+        } else {
+            const auto it = map.find(key);
+            const auto tt = truth.find(key);
+            BOOST_CHECK_EQUAL(it == map.end(), tt == truth.end());
+            if (it != map.end() && tt != truth.end())
+                BOOST_CHECK_EQUAL(it->second, tt->second);
+        }
+    }
+    BOOST_CHECK_EQUAL(map.size(), truth.size());
+
+    size_t iterated = 0;
+    for (const auto & [k, v] : map) {
+        ++iterated;
+        BOOST_CHECK_EQUAL(v, truth.at(k));
+    }
+    BOOST_CHECK_EQUAL(iterated, truth.size());
+}
+
+BOOST_AUTO_TEST_CASE( copy_move_swap ) {
+    using namespace AIToolbox;
+
+    FlatMap<size_t, std::vector<int>> map;
+    for (size_t i = 0; i < 100; ++i)
+        map[i * 7].push_back(i);
+
+    auto copy = map;
+    BOOST_CHECK_EQUAL(copy.size(), 100);
+    copy[0].push_back(42);
+    BOOST_CHECK_EQUAL(map[0].size(), 1);
+    BOOST_CHECK_EQUAL(copy[0].size(), 2);
+
+    auto moved = std::move(copy);
+    BOOST_CHECK_EQUAL(moved.size(), 100);
+    BOOST_CHECK_EQUAL(moved.find(21)->second[0], 3);
+
+    FlatMap<size_t, std::vector<int>> other;
+    other[1000].push_back(1);
+    other.swap(moved);
+    BOOST_CHECK_EQUAL(other.size(), 100);
+    BOOST_CHECK_EQUAL(moved.size(), 1);
+
+    moved = other;
+    BOOST_CHECK_EQUAL(moved.size(), 100);
+    BOOST_CHECK(moved.find(1000) == moved.end());
+}
+
+BOOST_AUTO_TEST_CASE( reserve_and_bad_hash ) {
+    using namespace AIToolbox;
+
+    FlatMap<size_t, size_t> map;
+    map.reserve(1000);
+    const auto capacity = map.capacity();
+    BOOST_CHECK(capacity >= 1000);
+    for (size_t i = 0; i < 1000; ++i)
+        map[i] = i;
+    BOOST_CHECK_EQUAL(map.capacity(), capacity);
+
+    // Keys which only differ in the high bits still work fine.
+    FlatMap<size_t, size_t> shifted;
+    for (size_t i = 0; i < 1000; ++i)
+        shifted[i << 40] = i;
+    for (size_t i = 0; i < 1000; ++i)
+        BOOST_CHECK_EQUAL(shifted[i << 40], i);
+}
+
+struct TreeNode;
+struct TreeNode {
+    // The mapped type may be incomplete, as in our tree search algorithms.
+    AIToolbox::FlatMap<size_t, TreeNode> children;
+    unsigned N = 0;
+};
+
+BOOST_AUTO_TEST_CASE( recursive_type ) {
+    TreeNode root;
+    auto * node = &root;
+    for (size_t i = 0; i < 10; ++i) {
+        node->N = i;
+        node = &node->children[i];
+    }
+    node = &root;
+    for (size_t i = 0; i < 10; ++i) {
+        BOOST_CHECK_EQUAL(node->N, i);
+        node = &node->children.find(i)->second;
+    }
+    // Moving the subtree out, as done when the root of the tree changes.
+    { auto tmp = std::move(root.children.find(0)->second); root = std::move(tmp); }
+    BOOST_CHECK_EQUAL(root.N, 1);
+}
@@ -8,6 +8,7 @@
 #include <AIToolbox/Utils/IO.hpp>
 
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <algorithm>
@@ -268,3 +269,17 @@ BOOST_AUTO_TEST_CASE( sparseTable2DReadWrite ) {
 }
 
 // TODO: Matrix3D, SparseMatrix3D, Table3D, SparseTable3D
+
+BOOST_AUTO_TEST_CASE( mappedFile ) {
+    const std::string inputFilename = "./data/corner.MDP";
+
+    std::ifstream inputFile(inputFilename);
+    if ( !inputFile ) BOOST_FAIL("Data to perform test could not be loaded: " + inputFilename);
+    std::ostringstream contents;
+    contents << inputFile.rdbuf();
+
+    const ai::MappedFile file(inputFilename);
+    BOOST_CHECK(file.getData() == contents.str());
+
+    BOOST_CHECK_THROW(ai::MappedFile("./data/does_not_exist.txt"), std::runtime_error);
+}
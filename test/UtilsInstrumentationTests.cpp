@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE UtilsInstrumentation
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Utils/Instrumentation.hpp>
+#include <AIToolbox/Utils/LP.hpp>
+
+namespace ai = AIToolbox;
+
+void solveLP() {
+    ai::LP lp(2, ai::LP::Backend::DenseSimplex);
+
+    lp.row << 1.0, 1.0;
+    lp.setObjective(true);
+    lp.row << 1.0, 2.0; lp.pushRow(ai::LP::Constraint::LessEqual, 4.0);
+
+    lp.solve(2);
+}
+
+BOOST_AUTO_TEST_CASE( disabled ) {
+    BOOST_CHECK(!ai::isInstrumentationEnabled());
+
+    ai::SolverStatistics stats;
+    stats.iterations = 5;
+    stats.residuals.push_back(1.0);
+    {
+        ai::SolverStatisticsRecorder record(stats);
+        BOOST_CHECK(!record);
+
+        // Old values are cleared even when not recording.
+        BOOST_CHECK_EQUAL(stats.iterations, 0);
+        BOOST_CHECK(stats.residuals.empty());
+
+        solveLP();
+    }
+    BOOST_CHECK_EQUAL(stats.lpCalls, 0);
+    BOOST_CHECK_EQUAL(stats.seconds, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( enabled ) {
+    ai::setInstrumentationEnabled(true);
+    BOOST_CHECK(ai::isInstrumentationEnabled());
+
+    const auto solves = ai::LP::getThreadSolves();
+
+    ai::SolverStatistics stats;
+    {
+        ai::SolverStatisticsRecorder record(stats);
+        BOOST_CHECK(record);
+
+        solveLP();
+        solveLP();
+    }
+    ai::setInstrumentationEnabled(false);
+
+    BOOST_CHECK_EQUAL(stats.lpCalls, 2);
+    BOOST_CHECK_EQUAL(ai::LP::getThreadSolves(), solves + 2);
+    BOOST_CHECK(stats.seconds > 0.0);
+
+    stats.simulations = 100;
+    stats.seconds = 0.5;
+    BOOST_CHECK_EQUAL(stats.getSimulationsPerSecond(), 200.0);
+
+    stats.seconds = 0.0;
+    BOOST_CHECK_EQUAL(stats.getSimulationsPerSecond(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( lp_calls_disabled ) {
+    ai::setInstrumentationEnabled(true);
+
+    ai::SolverStatistics stats;
+    {
+        ai::SolverStatisticsRecorder record(stats, false);
+        BOOST_CHECK(record);
+
+        solveLP();
+    }
+    ai::setInstrumentationEnabled(false);
+
+    BOOST_CHECK_EQUAL(stats.lpCalls, 0);
+    BOOST_CHECK(stats.seconds > 0.0);
+}
@@ -0,0 +1,238 @@
+#define BOOST_TEST_MODULE UtilsLP
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/Seeder.hpp>
+#include <AIToolbox/Utils/LP.hpp>
+#include <AIToolbox/Utils/Polytope.hpp>
+
+#include <array>
+
+namespace ai = AIToolbox;
+
+constexpr std::array<ai::LP::Backend, 2> backends{ai::LP::Backend::LpSolve, ai::LP::Backend::DenseSimplex};
+
+BOOST_AUTO_TEST_CASE( maximization ) {
+    for (const auto backend : backends) {
+        ai::LP lp(2, backend);
+        BOOST_CHECK(lp.getBackend() == backend);
+
+        // max 3x + 2y
+        lp.row << 3.0, 2.0;
+        lp.setObjective(true);
+
+        lp.row << 1.0, 1.0; lp.pushRow(ai::LP::Constraint::LessEqual, 4.0);
+        lp.row << 1.0, 3.0; lp.pushRow(ai::LP::Constraint::LessEqual, 6.0);
+        lp.row << 1.0, 0.0; lp.pushRow(ai::LP::Constraint::LessEqual, 3.0);
+
+        double objective;
+        const auto solution = lp.solve(2, &objective);
+
+        BOOST_REQUIRE(solution);
+        BOOST_CHECK_CLOSE((*solution)[0], 3.0, 1e-6);
+        BOOST_CHECK_CLOSE((*solution)[1], 1.0, 1e-6);
+        BOOST_CHECK_CLOSE(objective, 11.0, 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( minimizationWithEqualities ) {
+    for (const auto backend : backends) {
+        ai::LP lp(2, backend);
+
+        // min x + y
+        lp.row << 1.0, 1.0;
+        lp.setObjective(false);
+
+        lp.row << 1.0,  2.0; lp.pushRow(ai::LP::Constraint::GreaterEqual, 4.0);
+        lp.row << 3.0,  1.0; lp.pushRow(ai::LP::Constraint::GreaterEqual, 6.0);
+        lp.row << 1.0, -1.0; lp.pushRow(ai::LP::Constraint::Equal,        0.0);
+
+        double objective;
+        const auto solution = lp.solve(2, &objective);
+
+        BOOST_REQUIRE(solution);
+        BOOST_CHECK_CLOSE((*solution)[0], 1.5, 1e-6);
+        BOOST_CHECK_CLOSE((*solution)[1], 1.5, 1e-6);
+        BOOST_CHECK_CLOSE(objective, 3.0, 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( unboundedVariables ) {
+    for (const auto backend : backends) {
+        ai::LP lp(2, backend);
+
+        // min x - y, with x free.
+        lp.row << 1.0, -1.0;
+        lp.setObjective(false);
+        lp.setUnbounded(0);
+
+        lp.row << 1.0, 0.0; lp.pushRow(ai::LP::Constraint::GreaterEqual, -5.0);
+        lp.row << 0.0, 1.0; lp.pushRow(ai::LP::Constraint::LessEqual,     2.0);
+
+        double objective;
+        const auto solution = lp.solve(2, &objective);
+
+        BOOST_REQUIRE(solution);
+        BOOST_CHECK_CLOSE((*solution)[0], -5.0, 1e-6);
+        BOOST_CHECK_CLOSE((*solution)[1],  2.0, 1e-6);
+        BOOST_CHECK_CLOSE(objective, -7.0, 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( infeasible ) {
+    for (const auto backend : backends) {
+        ai::LP lp(2, backend);
+
+        lp.setObjective(0, true);
+
+        lp.row << 1.0, 1.0; lp.pushRow(ai::LP::Constraint::LessEqual,    1.0);
+        lp.row << 1.0, 1.0; lp.pushRow(ai::LP::Constraint::GreaterEqual, 2.0);
+
+        BOOST_CHECK(!lp.solve(2));
+
+        // Removing the offending row makes it solvable again.
+        lp.popRow();
+        const auto solution = lp.solve(2);
+        BOOST_REQUIRE(solution);
+        BOOST_CHECK_CLOSE((*solution)[0], 1.0, 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( unboundedObjective ) {
+    const auto defaultBackend = ai::LP::getDefaultBackend();
+
+    for (const auto backend : backends) {
+        ai::LP lp(2, backend);
+
+        // max x, with x - y <= 1.
+        lp.setObjective(0, true);
+        lp.row << 1.0, -1.0; lp.pushRow(ai::LP::Constraint::LessEqual, 1.0);
+
+        BOOST_CHECK(!lp.solve(2));
+
+        // Bounding y bounds x too.
+        lp.row << 0.0, 1.0; lp.pushRow(ai::LP::Constraint::LessEqual, 2.0);
+        const auto solution = lp.solve(2);
+        BOOST_REQUIRE(solution);
+        BOOST_CHECK_CLOSE((*solution)[0], 3.0, 1e-6);
+
+        // WitnessLP starts unbounded, and must find the same witnesses
+        // whatever the backend.
+        ai::LP::setDefaultBackend(backend);
+        ai::WitnessLP wlp(3);
+
+        ai::Hyperplane v(3), dominated(3);
+        v << 1.0, 3.0, 2.0;
+        dominated << 0.0, 2.0, 1.0;
+
+        const auto witness = wlp.findWitness(v);
+        BOOST_REQUIRE(witness);
+        BOOST_CHECK_EQUAL(*witness, ai::Point((ai::Point(3) << 0.0, 1.0, 0.0).finished()));
+
+        wlp.addOptimalRow(v);
+        BOOST_CHECK(!wlp.findWitness(dominated));
+
+        wlp.reset();
+        BOOST_CHECK(wlp.findWitness(dominated));
+    }
+    ai::LP::setDefaultBackend(defaultBackend);
+}
+
+BOOST_AUTO_TEST_CASE( warmStartMatchesColdStart ) {
+    constexpr size_t S = 6;
+    constexpr size_t Rows = 40;
+
+    auto rand = ai::RandomEngine(ai::Seeder::getSeed());
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    for (const auto backend : backends) {
+        // Witness-like problems: find a point in the simplex where the test
+        // row is better than all others by the largest margin.
+        ai::LP warm(S + 2, backend);
+        warm.setWarmStart(true);
+
+        auto setup = [](ai::LP & lp) {
+            lp.setObjective(S + 1, true);
+            lp.row.setZero();
+            lp.row.head(S).fill(1.0);
+            lp.pushRow(ai::LP::Constraint::Equal, 1.0);
+            lp.setUnbounded(S);
+        };
+        setup(warm);
+
+        ai::Matrix2D rows(Rows, S + 2);
+        for (size_t i = 0; i < Rows; ++i) {
+            for (size_t s = 0; s < S; ++s)
+                rows(i, s) = dist(rand);
+            rows(i, S) = -1.0;
+            rows(i, S + 1) = 1.0;
+        }
+
+        size_t solves = 0;
+        for (size_t i = 0; i < Rows; ++i) {
+            // Add the row to the warm LP, either one by one or in batches.
+            if (i % 3 == 0) {
+                warm.row = rows.row(i).transpose();
+                warm.pushRow(ai::LP::Constraint::LessEqual, 0.0);
+            } else if (i % 3 == 1) {
+                warm.pushRows(rows.middleRows(i, 2), ai::LP::Constraint::LessEqual, ai::Vector::Zero(2));
+            }
+
+            if (i % 3 == 2) continue;
+
+            for (size_t t = 0; t < 3; ++t) {
+                ai::Vector test(S + 2);
+                for (size_t s = 0; s < S; ++s)
+                    test[s] = dist(rand);
+                test[S] = -1.0; test[S + 1] = 0.0;
+
+                ai::LP cold(S + 2, backend);
+                setup(cold);
+                const auto added = i % 3 == 0 ? i + 1 : i + 2;
+                cold.pushRows(rows.topRows(added), ai::LP::Constraint::LessEqual, ai::Vector::Zero(added));
+
+                double warmValue, coldValue;
+                warm.row = test;
+                warm.pushRow(ai::LP::Constraint::Equal, 0.0);
+                const auto warmSolution = warm.solve(S, &warmValue);
+                warm.popRow();
+
+                cold.row = test;
+                cold.pushRow(ai::LP::Constraint::Equal, 0.0);
+                const auto coldSolution = cold.solve(S, &coldValue);
+
+                ++solves;
+
+                // Since delta is non-negative, the LP is infeasible if the
+                // test row is dominated.
+                BOOST_CHECK_EQUAL(bool(warmSolution), bool(coldSolution));
+                if (warmSolution && coldSolution)
+                    BOOST_CHECK_SMALL(warmValue - coldValue, 1e-6);
+            }
+        }
+        const auto & stats = warm.getStatistics();
+        BOOST_CHECK_EQUAL(stats.solves, solves);
+        BOOST_CHECK(stats.warmStarts > 0);
+        BOOST_CHECK(stats.seconds >= 0.0);
+
+        warm.resetStatistics();
+        BOOST_CHECK_EQUAL(warm.getStatistics().solves, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( backendSelection ) {
+    const auto oldDefault = ai::LP::getDefaultBackend();
+
+    ai::LP::setDefaultBackend(ai::LP::Backend::Automatic);
+    BOOST_CHECK(ai::LP(ai::LP::DenseSimplexMaxVariables).getBackend()     == ai::LP::Backend::DenseSimplex);
+    BOOST_CHECK(ai::LP(ai::LP::DenseSimplexMaxVariables + 1).getBackend() == ai::LP::Backend::LpSolve);
+
+    ai::LP::setDefaultBackend(ai::LP::Backend::LpSolve);
+    BOOST_CHECK(ai::LP(2).getBackend() == ai::LP::Backend::LpSolve);
+    BOOST_CHECK(ai::LP(2, ai::LP::Backend::DenseSimplex).getBackend() == ai::LP::Backend::DenseSimplex);
+
+    ai::LP::setDefaultBackend(oldDefault);
+}
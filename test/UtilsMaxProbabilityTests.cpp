@@ -0,0 +1,126 @@
+#define BOOST_TEST_MODULE UtilsMaxProbability
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Utils/MaxProbability.hpp>
+
+#include <atomic>
+#include <random>
+#include <stdexcept>
+
+namespace ai = AIToolbox;
+
+BOOST_AUTO_TEST_CASE( gaussians ) {
+    // Two Gaussians: P(X0 > X1) = Phi((m0 - m1) / sqrt(s0^2 + s1^2)).
+    const std::vector<ai::ValueDistribution> dists{
+        ai::ValueDistribution::gaussian(1.0, 2.0),
+        ai::ValueDistribution::gaussian(0.0, 1.5),
+    };
+    const auto p = ai::computeMaxProbabilities(dists);
+
+    const double truth = 0.5 * std::erfc(-(1.0 / 2.5) / std::sqrt(2.0));
+    BOOST_CHECK_CLOSE(p[0], truth, 1e-5);
+    BOOST_CHECK_CLOSE(p[1], 1.0 - truth, 1e-5);
+    BOOST_CHECK_CLOSE(ai::computeMaxProbability(dists, 0), truth, 1e-5);
+}
+
+BOOST_AUTO_TEST_CASE( identical_distributions ) {
+    const size_t A = 7;
+    std::vector<ai::ValueDistribution> dists;
+    for (size_t a = 0; a < A; ++a)
+        dists.push_back(ai::ValueDistribution::studentT(3.0, 0.5, 0.2));
+
+    const auto p = ai::computeMaxProbabilities(dists);
+    for (size_t a = 0; a < A; ++a)
+        BOOST_CHECK_CLOSE(p[a], 1.0 / A, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE( point_distributions ) {
+    const std::vector<ai::ValueDistribution> dists{
+        ai::ValueDistribution::point(1.0),
+        ai::ValueDistribution::gaussian(1.0, 0.0), // Also a point
+        ai::ValueDistribution::gaussian(0.0, 1.0),
+    };
+    const auto p = ai::computeMaxProbabilities(dists);
+
+    // Ties go to the lowest index.
+    const double below = 0.5 * std::erfc(-1.0 / std::sqrt(2.0));
+    BOOST_CHECK_CLOSE(p[0], below, 1e-6);
+    BOOST_CHECK_EQUAL(p[1], 0.0);
+    BOOST_CHECK_CLOSE(p[2], 1.0 - below, 1e-5);
+}
+
+BOOST_AUTO_TEST_CASE( mixed_against_sampling ) {
+    // Very different scales, to check that narrow steps are not missed.
+    const std::vector<ai::ValueDistribution> dists{
+        ai::ValueDistribution::studentT(1.0, 0.5, 0.3),
+        ai::ValueDistribution::studentT(200.0, 0.6, 0.001),
+        ai::ValueDistribution::gaussian(0.55, 0.05),
+        ai::ValueDistribution::beta(2.0, 3.0),
+        ai::ValueDistribution::beta(300.0, 200.0),
+    };
+    const auto p = ai::computeMaxProbabilities(dists);
+    BOOST_CHECK_CLOSE(p.sum(), 1.0, 1e-5);
+
+    std::student_t_distribution<double> t0(1.0), t1(200.0);
+    std::normal_distribution<double> n2(0.55, 0.05);
+    std::gamma_distribution<double> g2(2.0), g3(3.0), g300(300.0), g200(200.0);
+
+    auto sampler = [&](ai::RandomEngine & rnd) {
+        const double x3 = g2(rnd), x4 = g300(rnd);
+        const std::array<double, 5> v{
+            0.5 + 0.3 * t0(rnd),
+            0.6 + 0.001 * t1(rnd),
+            n2(rnd),
+            x3 / (x3 + g3(rnd)),
+            x4 / (x4 + g200(rnd)),
+        };
+        return static_cast<size_t>(std::max_element(std::begin(v), std::end(v)) - std::begin(v));
+    };
+
+    const auto est = ai::estimateFrequencies(dists.size(), sampler, 0.002);
+    for (size_t a = 0; a < dists.size(); ++a)
+        BOOST_CHECK_SMALL(p[a] - est[a], 0.01);
+}
+
+BOOST_AUTO_TEST_CASE( frequencies ) {
+    std::discrete_distribution<size_t> dist{0.1, 0.6, 0.3};
+    auto sampler = [&dist](ai::RandomEngine & rnd) {
+        // Distributions are not thread-safe, so we copy.
+        auto d = dist;
+        return d(rnd);
+    };
+
+    const auto single = ai::estimateFrequencies(3, sampler, 0.005);
+    const auto multi = ai::estimateFrequencies(3, sampler, 0.005, 3);
+
+    BOOST_CHECK_SMALL(single[0] - 0.1, 0.03);
+    BOOST_CHECK_SMALL(single[1] - 0.6, 0.03);
+    BOOST_CHECK_SMALL(multi[0] - 0.1, 0.03);
+    BOOST_CHECK_SMALL(multi[1] - 0.6, 0.03);
+    BOOST_CHECK_CLOSE(multi.sum(), 1.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( frequencies_many_batches ) {
+    std::atomic<unsigned long> calls = 0;
+    auto sampler = [&calls](ai::RandomEngine & rnd) -> size_t {
+        ++calls;
+        return rnd() % 4;
+    };
+
+    // A tight bound with a cap, so that many batches are synchronized.
+    const auto est = ai::estimateFrequencies(4, sampler, 1e-6, 4, 200000);
+    BOOST_CHECK(calls >= 200000);
+    BOOST_CHECK_CLOSE(est.sum(), 1.0, 1e-9);
+    for (size_t i = 0; i < 4; ++i)
+        BOOST_CHECK_SMALL(est[i] - 0.25, 0.01);
+
+    // Exceptions from worker threads reach the caller.
+    auto failing = [&calls](ai::RandomEngine & rnd) -> size_t {
+        if (++calls > 300000) throw std::runtime_error("sampler failure");
+        return rnd() % 4;
+    };
+    BOOST_CHECK_THROW(ai::estimateFrequencies(4, failing, 1e-6, 4), std::runtime_error);
+}
@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE UtilsPhilox
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "GlobalFixtures.hpp"
+
+#include <AIToolbox/Utils/Philox.hpp>
+#include <AIToolbox/Seeder.hpp>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ai = AIToolbox;
+
+BOOST_AUTO_TEST_CASE( known_answers ) {
+    // Known answer tests from the Random123 distribution.
+    const auto zero = ai::Philox::block({0, 0, 0, 0}, {0, 0});
+    BOOST_CHECK_EQUAL(zero[0], 0x6627e8d5u);
+    BOOST_CHECK_EQUAL(zero[1], 0xe169c58du);
+    BOOST_CHECK_EQUAL(zero[2], 0xbc57ac4cu);
+    BOOST_CHECK_EQUAL(zero[3], 0x9b00dbd8u);
+
+    const auto ones = ai::Philox::block({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    BOOST_CHECK_EQUAL(ones[0], 0x408f276du);
+    BOOST_CHECK_EQUAL(ones[1], 0x41c83b0eu);
+    BOOST_CHECK_EQUAL(ones[2], 0xa20bc7c6u);
+    BOOST_CHECK_EQUAL(ones[3], 0x6d5451fdu);
+
+    // The engine outputs the blocks of the counters in order.
+    ai::Philox engine;
+    for (unsigned i = 0; i < 4; ++i)
+        BOOST_CHECK_EQUAL(engine(), zero[i]);
+
+    const auto second = ai::Philox::block({1, 0, 0, 0}, {0, 0});
+    BOOST_CHECK_EQUAL(engine(), second[0]);
+}
+
+BOOST_AUTO_TEST_CASE( discard ) {
+    for (unsigned skip = 0; skip < 20; ++skip) {
+        for (unsigned start = 0; start < 5; ++start) {
+            ai::Philox a(42, 7), b(42, 7);
+            for (unsigned i = 0; i < start; ++i) { a(); b(); }
+
+            a.discard(skip);
+            for (unsigned i = 0; i < skip; ++i) b();
+
+            BOOST_CHECK_EQUAL(a(), b());
+            BOOST_CHECK(a == b);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( streams ) {
+    ai::Philox a(1, 0), b(1, 1), c(2, 0);
+    BOOST_CHECK_EQUAL(b.getKey(), 1);
+    BOOST_CHECK_EQUAL(b.getStream(), 1);
+
+    std::set<std::uint32_t> values;
+    for (unsigned i = 0; i < 1000; ++i) {
+        values.insert(a());
+        values.insert(b());
+        values.insert(c());
+    }
+    // Collisions among 3000 32 bit numbers are very unlikely.
+    BOOST_CHECK(values.size() > 2995);
+
+    b.seed(1, 0);
+    a.seed(1, 0);
+    BOOST_CHECK_EQUAL(a(), b());
+}
+
+BOOST_AUTO_TEST_CASE( seeder_streams ) {
+    const auto root = ai::Seeder::getRootSeed();
+
+    auto a = ai::Seeder::getStream(3);
+    ai::Seeder::getSeed();
+    auto b = ai::Seeder::getStream(3);
+    BOOST_CHECK(a == b);
+    BOOST_CHECK_EQUAL(a.getKey(), root);
+
+    auto e1 = ai::Seeder::getStreamEngine(5);
+    auto e2 = ai::Seeder::getStreamEngine(5);
+    auto e3 = ai::Seeder::getStreamEngine(6);
+    BOOST_CHECK(e1 == e2);
+    BOOST_CHECK(e1 != e3);
+
+    // Each thread gets its own engine, on a different stream.
+    ai::RandomEngine::result_type values[2];
+    std::thread t0([&]{ values[0] = ai::Seeder::getThreadEngine()(); });
+    std::thread t1([&]{ values[1] = ai::Seeder::getThreadEngine()(); });
+    t0.join(); t1.join();
+
+    BOOST_CHECK(values[0] != values[1]);
+    BOOST_CHECK(&ai::Seeder::getThreadEngine() == &ai::Seeder::getThreadEngine());
+}
+
+BOOST_AUTO_TEST_CASE( split ) {
+    const ai::Philox a(9, 4);
+
+    // Children depend only on the parent stream, not on its position.
+    auto b = a;
+    for (unsigned i = 0; i < 7; ++i) b();
+    BOOST_CHECK(a.split(1) == b.split(1));
+
+    const auto c1 = a.split(1), c2 = a.split(2);
+    BOOST_CHECK_EQUAL(c1.getKey(), 9);
+    BOOST_CHECK(c1.getStream() != c2.getStream());
+    BOOST_CHECK(c1.getStream() != a.getStream());
+    BOOST_CHECK(c1.split(1).getStream() != c1.getStream());
+    BOOST_CHECK(ai::Philox(9, 5).split(1).getStream() != c1.getStream());
+
+    std::set<std::uint64_t> ids;
+    for (std::uint64_t i = 0; i < 100; ++i)
+        for (std::uint64_t j = 0; j < 100; ++j)
+            ids.insert(a.split(i).split(j).getStream());
+    BOOST_CHECK_EQUAL(ids.size(), 10000);
+}
+
+BOOST_AUTO_TEST_CASE( stream_scopes ) {
+    auto seeds = [](std::uint64_t stream) {
+        std::vector<unsigned> retval;
+        ai::Seeder::StreamScope scope(stream);
+        for (unsigned i = 0; i < 3; ++i)
+            retval.push_back(ai::Seeder::getSeed());
+        {
+            ai::Seeder::StreamScope inner(1);
+            retval.push_back(ai::Seeder::getSeed());
+        }
+        retval.push_back(ai::Seeder::getSeed());
+        return retval;
+    };
+
+    const auto expected = seeds(11);
+    BOOST_CHECK(expected != seeds(12));
+
+    // Seeds in a scope do not depend on the shared generator, nor on
+    // other threads drawing seeds at the same time.
+    std::vector<std::vector<unsigned>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t)
+        threads.emplace_back([&, t]{
+            for (unsigned i = 0; i < 100; ++i) ai::Seeder::getSeed();
+            results[t] = seeds(11);
+        });
+    for (auto & t : threads) t.join();
+
+    for (const auto & r : results)
+        BOOST_CHECK(r == expected);
+
+    // The scope does not alias the engine of the same stream.
+    auto e = ai::Seeder::getStreamEngine(11);
+    BOOST_CHECK(e() != expected[0]);
+}
+
+BOOST_AUTO_TEST_CASE( stream_engines ) {
+    const auto stream = ai::Seeder::getStream(5).split(3);
+
+    auto e1 = ai::Seeder::getStreamEngine(stream);
+    auto e2 = ai::Seeder::getStreamEngine(stream);
+    BOOST_CHECK(e1 == e2);
+    BOOST_CHECK(e1 != ai::Seeder::getStreamEngine(5));
+    BOOST_CHECK(ai::Seeder::getStreamEngine(5) == ai::Seeder::getStreamEngine(ai::Seeder::getStream(5)));
+}
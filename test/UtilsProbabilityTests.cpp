@@ -63,3 +63,30 @@ BOOST_AUTO_TEST_CASE( vose_alias_sampling ) {
         BOOST_CHECK(std::abs(counters[i] - exactAmount) < percentageErrorAllowed * exactAmount);
     }
 }
+
+BOOST_AUTO_TEST_CASE( vose_alias_sampling_degenerate ) {
+    AIToolbox::RandomEngine rand(AIToolbox::Seeder::getSeed());
+
+    // Entries whose alias is the first element must not be mistaken for
+    // unpaired entries.
+    std::vector<AIToolbox::ProbabilityVector> ps(3, AIToolbox::ProbabilityVector(3));
+    ps[0] << 1.0, 0.0, 0.0;
+    ps[1] << 0.8, 0.2, 0.0;
+    ps[2] << 0.0, 0.0, 1.0;
+
+    constexpr size_t trials = 100'000;
+    for (const auto & p : ps) {
+        AIToolbox::VoseAliasSampler vose(p);
+
+        std::vector<size_t> counters(p.size());
+        for (size_t i = 0; i < trials; ++i)
+            ++counters[vose.sampleProbability(rand)];
+
+        for (size_t i = 0; i < counters.size(); ++i) {
+            if (p[i] == 0.0)
+                BOOST_CHECK_EQUAL(counters[i], 0);
+            else
+                BOOST_CHECK(std::abs(counters[i] - p[i] * trials) < 0.05 * p[i] * trials);
+        }
+    }
+}